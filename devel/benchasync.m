@@ -0,0 +1,40 @@
+function benchasync (n, len)
+% benchmark udpport reads with ReadAsyncMode manual and continuous
+%
+% the udpport sends n datagrams of len bytes to itself, does some work
+% and then reads them back, reporting the bytes recovered and dropped
+% in each mode.
+
+if nargin < 1
+  n = 2000;
+endif
+if nargin < 2
+  len = 1024;
+endif
+
+data = uint8 (mod (0:len-1, 256));
+
+for mode = {"manual", "continuous"}
+  a = udpport ("Timeout", 0.5);
+  a.ReadAsyncMode = mode{1};
+
+  start = tic;
+  for i=1:n
+    write (a, data, "127.0.0.1", a.LocalPort);
+  endfor
+  % busy interpreter while the data arrives
+  pause (0.5);
+
+  got = 0;
+  while a.NumBytesAvailable > 0
+    got += numel (read (a, a.NumBytesAvailable));
+  endwhile
+  elapsed = double (tic - start)/1e6;
+
+  printf ("%-10s: %d of %d bytes in %8.2f ms, %d dropped\n", mode{1}, ...
+    got, n*len, elapsed * 1e3, a.NumBytesDropped);
+
+  clear a
+endfor
+
+endfunction
@@ -0,0 +1,37 @@
+function benchbinblock (nbytes, n)
+% benchmark readbinblock throughput on a loopback tcp connection
+%
+% writes n binblocks of nbytes of double values from a tcpserver and
+% reports the MB per second achieved by readbinblock on the tcpclient side.
+% The block is written before it is read, so nbytes must fit in the
+% loopback socket buffers.
+
+if nargin < 1
+  nbytes = 1e6;
+endif
+if nargin < 2
+  n = 10;
+endif
+
+srv = tcpserver ("127.0.0.1", 0);
+cli = tcpclient ("127.0.0.1", srv.ServerPort, "Timeout", 5);
+st = srv.Connected;
+
+x = rand (1, round (nbytes / 8));
+
+elapsed = 0;
+for i=1:n
+  writebinblock (srv, x, "double");
+  start = tic;
+  got = readbinblock (cli, "double");
+  elapsed += double (tic - start)/1e6;
+endfor
+
+if ! isequal (got, x)
+  error ("benchbinblock: data mismatch");
+endif
+
+printf ("%d blocks of %d bytes: %8.1f MB/s\n", n, numel (x)*8, n*numel (x)*8 / elapsed / 1e6);
+
+clear cli srv
+endfunction
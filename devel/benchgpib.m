@@ -0,0 +1,60 @@
+function benchgpib (n)
+% benchmark gpib query latency against the gpibstub library
+%
+% see gpibstub.c for how to build and load the stub. Each query is a
+% gpib_write of a command and a gpib_read of the reply, and the mean
+% time per query is reported.
+
+if nargin < 1
+  n = 1000;
+endif
+
+dev = gpib (1);
+
+start = tic;
+for i=1:n
+  gpib_write (dev, "MEAS:VOLT?\n");
+  [data, count] = gpib_read (dev, 256);
+endfor
+elapsed = double (tic - start)/1e6;
+
+if count == 0
+  error ("benchgpib: no reply, is the gpibstub library loaded?");
+endif
+
+printf ("%d queries: %8.2f us/query\n", n, elapsed / n * 1e6);
+
+% same again, starting the read in the background
+start = tic;
+for i=1:n
+  gpib_write (dev, "MEAS:VOLT?\n");
+  gpib_read (dev, 256, true);
+  [done, data, count] = gpib_wait (dev);
+endfor
+elapsed = double (tic - start)/1e6;
+
+printf ("%d async queries: %8.2f us/query\n", n, elapsed / n * 1e6);
+
+% serial poll of a bus of 14 devices, one at a time and all at once
+devs = arrayfun (@(addr) gpib (addr), 2:15, "uniformoutput", false);
+
+start = tic;
+for i=1:n
+  for j=1:numel (devs)
+    __gpib_spoll__ (devs{j});
+  endfor
+endfor
+elapsed = double (tic - start)/1e6;
+printf ("%d polls of %d devices one at a time: %8.2f us/poll\n", n, numel (devs), elapsed / n * 1e6);
+
+start = tic;
+for i=1:n
+  spoll (devs);
+endfor
+elapsed = double (tic - start)/1e6;
+printf ("%d polls of %d devices together:      %8.2f us/poll\n", n, numel (devs), elapsed / n * 1e6);
+
+cellfun (@gpib_close, devs);
+
+gpib_close (dev);
+endfunction
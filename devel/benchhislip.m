@@ -0,0 +1,81 @@
+function benchhislip (n, host, port)
+% benchmark hislip query latency against the hislipserver stand in
+%
+% see hislipserver.c for how to build and run the server. Each query is a
+% writeread of a command, and the mean time per query is reported for
+% synchronized mode and for overlapped mode with the queries sent before
+% the responses are read, along with the rate of a large transfer and the
+% cost of service requests and device clears.
+
+if nargin < 1
+  n = 1000;
+endif
+if nargin < 2
+  host = "127.0.0.1";
+endif
+if nargin < 3
+  port = 4880;
+endif
+
+dev = hislip (host, "hislip0", "Port", port, "Overlapped", false);
+
+start = tic;
+for i=1:n
+  data = writeread (dev, "MEAS:VOLT?");
+endfor
+elapsed = double (tic - start)/1e6;
+
+printf ("%d queries: %8.2f us/query\n", n, elapsed / n * 1e6);
+
+% overlapped mode keeps the responses to queries sent back to back
+dev.Overlapped = true;
+depth = 10;
+start = tic;
+for i=1:depth:n
+  for j=1:depth
+    write (dev, "MEAS:VOLT?");
+  endfor
+  for j=1:depth
+    data = readline (dev);
+  endfor
+endfor
+elapsed = double (tic - start)/1e6;
+
+printf ("%d overlapped queries: %8.2f us/query\n", n, elapsed / n * 1e6);
+dev.Overlapped = false;
+
+% a large response read in one call
+write (dev, "WAV?");
+start = tic;
+data = read (dev);
+elapsed = double (tic - start)/1e6;
+
+printf ("%d byte response: %8.2f MB/s\n", numel (data), numel (data) / elapsed / 1e6);
+
+% latency of a service request, from the write that asks for one to its
+% arrival on the asynchronous channel, less the server's delay
+m = min (n, 20);
+delay = str2double (getenv ("HISLIPSERVER_SRQ_MS"));
+if isnan (delay)
+  delay = 100;
+endif
+start = tic;
+for i=1:m
+  write (dev, "*SRQ");
+  hislip_waitsrq (dev, 5);
+endfor
+elapsed = double (tic - start)/1e6;
+
+printf ("%d service requests: %8.2f us/request\n", m, (elapsed / m - delay / 1000) * 1e6);
+
+% round trip of a device clear over both channels
+start = tic;
+for i=1:m
+  clrdevice (dev);
+endfor
+elapsed = double (tic - start)/1e6;
+
+printf ("%d device clears: %8.2f us/clear\n", m, elapsed / m * 1e6);
+
+clear dev
+endfunction
@@ -0,0 +1,63 @@
+function benchmodbus (n, host, port)
+% benchmark modbus reads and writes against the modbusserver stand in
+%
+% see modbusserver.c for how to build and run the server. Set its
+% MODBUSSERVER_DELAY_US to see the effect of network latency.
+%
+% The mean time of a single request is reported, along with the rate of
+% reads and writes larger than a single request allows, which are split
+% into several requests, at each PipelineDepth.
+
+if nargin < 1
+  n = 100;
+endif
+if nargin < 2
+  host = "127.0.0.1";
+endif
+if nargin < 3
+  port = 1502;
+endif
+
+dev = modbus ("tcpip", host, port);
+
+% a single request
+start = tic;
+for i=1:n
+  data = read (dev, "holdingregs", 0, 125);
+endfor
+elapsed = double (tic - start)/1e6;
+
+printf ("%d reads of 125 registers: %8.2f us/read\n", n, elapsed / n * 1e6);
+
+m = max (1, round (n / 10));
+regs = uint16 (mod (0:9999, 65536));
+for depth = [1 4 16]
+  dev.PipelineDepth = depth;
+
+  start = tic;
+  for i=1:m
+    data = read (dev, "holdingregs", 0, 10000);
+  endfor
+  elapsed = double (tic - start)/1e6;
+  printf ("PipelineDepth %2d: read 10000 registers  %10.0f registers/s\n", depth, m * 10000 / elapsed);
+
+  start = tic;
+  for i=1:m
+    data = read (dev, "coils", 0, 20000);
+  endfor
+  elapsed = double (tic - start)/1e6;
+  printf ("PipelineDepth %2d: read 20000 coils      %10.0f coils/s\n", depth, m * 20000 / elapsed);
+
+  start = tic;
+  for i=1:m
+    write (dev, "holdingregs", 0, regs);
+  endfor
+  elapsed = double (tic - start)/1e6;
+  printf ("PipelineDepth %2d: write 10000 registers %10.0f registers/s\n", depth, m * 10000 / elapsed);
+endfor
+
+% the split transfers arrive in order
+assert (read (dev, "holdingregs", 0, 10000), regs);
+
+clear dev
+endfunction
@@ -0,0 +1,39 @@
+function benchproperties (n)
+% benchmark property access on tcpclient, tcpserver and udpport objects
+%
+% prints the average time per access for obj.Property (subsref) and
+% the __*_properties__ function used by get/set.
+
+if nargin < 1
+  n = 10000;
+endif
+
+srv = tcpserver ("127.0.0.1", 0);
+cli = tcpclient ("127.0.0.1", srv.ServerPort);
+udp = udpport ();
+
+printf ("%d iterations\n", n);
+
+bench ("tcpclient.Timeout", @() cli.Timeout, n);
+bench ("__tcpclient_properties__ timeout", @() __tcpclient_properties__ (cli, "timeout"), n);
+bench ("tcpclient.NumBytesAvailable", @() cli.NumBytesAvailable, n);
+bench ("tcpserver.Connected", @() srv.Connected, n);
+bench ("udpport.Timeout", @() udp.Timeout, n);
+bench ("__udpport_properties__ timeout", @() __udpport_properties__ (udp, "timeout"), n);
+
+start = tic;
+for i=1:n
+  cli.UserData = i;
+endfor
+printf ("%-36s %8.2f us\n", "tcpclient.UserData = x", double (tic - start)/n);
+
+clear cli srv udp
+endfunction
+
+function bench (label, fn, n)
+  start = tic;
+  for i=1:n
+    fn ();
+  endfor
+  printf ("%-36s %8.2f us\n", label, double (tic - start)/n);
+endfunction
@@ -0,0 +1,35 @@
+function benchread (sizes)
+% benchmark raw uint8 read throughput on a loopback tcp connection
+%
+% writes blocks of each size from a tcpclient to a tcpserver and reports
+% the MB/s achieved by read on the server side. Sizes are kept within
+% what the loopback socket buffers hold as the write completes first.
+
+if nargin < 1
+  sizes = [1e3 1e4 1e5 1e6];
+endif
+
+srv = tcpserver ("127.0.0.1", 0);
+cli = tcpclient ("127.0.0.1", srv.ServerPort);
+
+for n = sizes
+  data = uint8 (mod (0:n-1, 256));
+  reps = max (1, round (16e6 / n));
+
+  elapsed = 0;
+  for i=1:reps
+    write (cli, data);
+    start = tic;
+    got = read (srv, n);
+    elapsed += double (tic - start);
+  endfor
+
+  if ! isequal (got, data)
+    error ("benchread: data mismatch for %d bytes", n);
+  endif
+
+  printf ("%10d bytes: %8.1f MB/s\n", n, (n*reps) / elapsed);
+endfor
+
+clear cli srv
+endfunction
@@ -0,0 +1,34 @@
+function benchreadline (n)
+% benchmark readline throughput on a loopback tcp connection
+%
+% writes n short SCPI style lines from a tcpserver and reports the lines
+% per second achieved by readline on the tcpclient side.
+
+if nargin < 1
+  n = 10000;
+endif
+
+srv = tcpserver ("127.0.0.1", 0);
+cli = tcpclient ("127.0.0.1", srv.ServerPort, "Timeout", 1);
+st = srv.Connected;
+
+line = "+1.234567890E+00,+2.345678901E+00";
+block = repmat ([line "\n"], 1, 100);
+
+start = tic;
+for i=1:n/100
+  write (srv, block);
+  for j=1:100
+    got = readline (cli);
+  endfor
+endfor
+elapsed = double (tic - start)/1e6;
+
+if ! strcmp (got, line)
+  error ("benchreadline: data mismatch");
+endif
+
+printf ("%d lines: %10.0f lines/s\n", n, n / elapsed);
+
+clear cli srv
+endfunction
@@ -0,0 +1,22 @@
+function benchtimeout (timeouts)
+% measure how closely a read with no data keeps to the object Timeout
+%
+% reads from an idle loopback udpport and reports the requested and
+% measured time for each timeout value.
+
+if nargin < 1
+  timeouts = [0 0.001 0.05 0.5 1.5 2.25];
+endif
+
+a = udpport ();
+
+for t = timeouts
+  a.Timeout = t;
+  start = tic;
+  data = read (a, 1);
+  elapsed = double (tic - start)/1e6;
+  printf ("timeout %8.3f s: %8.3f s (%+.3f ms)\n", t, elapsed, (elapsed - t) * 1e3);
+endfor
+
+clear a
+endfunction
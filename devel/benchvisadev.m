@@ -0,0 +1,123 @@
+function benchvisadev (n, resource)
+% benchmark visadev per call overhead against the visastub stand in
+%
+% see visastub.c for how to build it. Octave must be started with
+% VISA_LIBRARY set to the built library. With the stub's VISASTUB_IO_US
+% and VISASTUB_MBPS left unset the times are the cost of the visadev
+% layer itself; set them to see how that compares with an instrument.
+%
+% The mean time per write, read, readline, writeread and property access
+% is reported, along with the time of a sequence of commands with and
+% without write buffering and the rate of readbinblock.
+
+if nargin < 1
+  n = 1000;
+endif
+if nargin < 2
+  resource = "TCPIP0::127.0.0.1::inst0::INSTR";
+endif
+
+dev = visadev (resource);
+
+printf ("%d iterations\n", n);
+
+% a command with no reply
+start = tic;
+for i=1:n
+  write (dev, "*CLS\n");
+endfor
+report ("write", double (tic - start), n);
+
+% reads of a reply, with the query written outside the timing
+elapsed = 0;
+for i=1:n
+  write (dev, "MEAS:VOLT?\n");
+  start = tic;
+  data = read (dev, 4);
+  elapsed += double (tic - start);
+endfor
+report ("read", elapsed, n);
+
+elapsed = 0;
+for i=1:n
+  write (dev, "MEAS:VOLT?\n");
+  start = tic;
+  data = readline (dev);
+  elapsed += double (tic - start);
+endfor
+report ("readline", elapsed, n);
+
+start = tic;
+for i=1:n
+  data = writeread (dev, "MEAS:VOLT?");
+endfor
+report ("writeread", double (tic - start), n);
+
+% properties
+bench ("dev.Timeout", @() dev.Timeout, n);
+bench ("dev.NumBytesWritten", @() dev.NumBytesWritten, n);
+bench ("dev.ResourceName", @() dev.ResourceName, n);
+bench ("get (dev, 'Timeout')", @() get (dev, "Timeout"), n);
+
+names = {"Timeout", "NumBytesWritten", "ResourceName", "ByteOrder", ...
+         "ReadChunkSize", "Tag"};
+bench (sprintf ("%d x dev.(name)", numel (names)), @() cellfun (@(x) dev.(x), names, "UniformOutput", false), n);
+bench (sprintf ("get (dev, {%d names})", numel (names)), @() get (dev, names), n);
+bench ("get (dev)", @() get (dev), n);
+
+start = tic;
+for i=1:n
+  dev.Tag = "bench";
+endfor
+report ("dev.Tag = x", double (tic - start), n);
+
+s = struct ("Tag", "bench", "ByteOrder", "little-endian", "ReadChunkSize", 1048576);
+bench ("set (dev, struct)", @() set (dev, s), n);
+
+% a configuration sequence of commands with no reply, written one
+% transfer at a time and then queued in the VISA write buffer
+cmds = {"*CLS", "VOLT 1.0", "CURR 0.1", "VOLT:PROT 2.0", "CURR:PROT 0.2", ...
+        "OUTP:DEL 0.1", "TRIG:SOUR BUS", "INIT:CONT OFF", "OUTP ON", "*OPC"};
+cmds = strcat (cmds, "\n");
+m = ceil (n / numel (cmds));
+for mode = {"off", "manual"}
+  dev.BufferMode = mode{1};
+  start = tic;
+  for i=1:m
+    for j=1:numel (cmds)
+      write (dev, cmds{j});
+    endfor
+    visaflush (dev);
+  endfor
+  report (sprintf ("%d commands, BufferMode %s", numel (cmds), mode{1}), double (tic - start), m);
+endfor
+dev.BufferMode = "off";
+
+% a large binblock, with the query written outside the timing
+m = min (n, 20);
+elapsed = 0;
+for i=1:m
+  write (dev, "WAV?");
+  start = tic;
+  data = readbinblock (dev);
+  elapsed += double (tic - start)/1e6;
+  % the block is followed by a newline
+  flush (dev, "input");
+endfor
+
+printf ("%-36s %8.2f MB/s\n", sprintf ("%d byte readbinblock", numel (data)), numel (data) * m / elapsed / 1e6);
+
+clear dev
+endfunction
+
+function report (label, elapsed_us, n)
+  printf ("%-36s %8.2f us\n", label, elapsed_us / n);
+endfunction
+
+function bench (label, fn, n)
+  start = tic;
+  for i=1:n
+    fn ();
+  endfor
+  report (label, double (tic - start), n);
+endfunction
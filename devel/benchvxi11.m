@@ -0,0 +1,75 @@
+function benchvxi11 (n, host)
+% benchmark vxi11 query latency against the vxi11server stand in
+%
+% see vxi11server.c for how to build and run the server. Each query is a
+% vxi11_write of a command and a vxi11_read of the reply, and the mean
+% time per query and per vxi11 object opened is reported, along with the
+% rate of a large transfer and the cost of service requests and aborts.
+
+if nargin < 1
+  n = 1000;
+endif
+if nargin < 2
+  host = "127.0.0.1";
+endif
+
+dev = vxi11 (host);
+
+start = tic;
+for i=1:n
+  vxi11_write (dev, "MEAS:VOLT?\n");
+  [data, count] = vxi11_read (dev, 256);
+endfor
+elapsed = double (tic - start)/1e6;
+
+printf ("%d queries: %8.2f us/query\n", n, elapsed / n * 1e6);
+
+% further objects to the same instrument share the open link
+m = min (n, 100);
+start = tic;
+for i=1:m
+  other = vxi11 (host);
+  vxi11_write (other, "*IDN?\n");
+  vxi11_read (other, 256);
+  vxi11_close (other);
+endfor
+elapsed = double (tic - start)/1e6;
+
+printf ("%d opens and queries: %8.2f us/open\n", m, elapsed / m * 1e6);
+
+% a large response read in one call
+vxi11_write (dev, "WAV?");
+start = tic;
+[data, count] = vxi11_read (dev, Inf);
+elapsed = double (tic - start)/1e6;
+
+printf ("%d byte response: %8.2f MB/s\n", count, count / elapsed / 1e6);
+
+% latency of a service request, from the write that asks for one to its
+% arrival on the interrupt channel, less the server's delay
+dev.EnableSRQ = true;
+m = min (n, 20);
+delay = str2double (getenv ("VXI11SERVER_SRQ_MS"));
+if isnan (delay)
+  delay = 100;
+endif
+start = tic;
+for i=1:m
+  vxi11_write (dev, "*SRQ");
+  vxi11_waitsrq (dev, 5);
+endfor
+elapsed = double (tic - start)/1e6;
+
+printf ("%d service requests: %8.2f us/request\n", m, (elapsed / m - delay / 1000) * 1e6);
+
+% round trip of an abort on the abort channel
+start = tic;
+for i=1:m
+  vxi11_abort (dev);
+endfor
+elapsed = double (tic - start)/1e6;
+
+printf ("%d aborts: %8.2f us/abort\n", m, elapsed / m * 1e6);
+
+vxi11_close (dev);
+endfunction
@@ -0,0 +1,30 @@
+function benchwriteread (n)
+% benchmark writeread query latency on a loopback udpport
+%
+% the udpport sends to itself, so each query is answered by its own
+% command, and reports the mean time per writeread call.
+
+if nargin < 1
+  n = 10000;
+endif
+
+a = udpport ("Timeout", 1);
+write (a, "a", "127.0.0.1", a.LocalPort);
+flush (a);
+
+cmd = "MEAS:VOLT?";
+
+start = tic;
+for i=1:n
+  got = writeread (a, cmd);
+endfor
+elapsed = double (tic - start)/1e6;
+
+if ! strcmp (got, cmd)
+  error ("benchwriteread: data mismatch");
+endif
+
+printf ("%d queries: %8.2f us/query\n", n, elapsed / n * 1e6);
+
+clear a
+endfunction
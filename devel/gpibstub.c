@@ -0,0 +1,193 @@
+/*
+ * Minimal stand in for the linux-gpib library, used by benchgpib.m to
+ * measure the cost of the gpib functions without a bus.
+ *
+ * Build it as the library gpib.oct was linked against and put it first
+ * in the library path:
+ *
+ *   gcc -O2 -shared -fPIC -o libgpib.so.0 gpibstub.c
+ *   LD_LIBRARY_PATH=$PWD octave --eval "benchgpib"
+ *
+ * Opening or closing a descriptor costs GPIBSTUB_OPEN_US (default 1000)
+ * and every bus transaction GPIBSTUB_IO_US (default 50) microseconds. A
+ * write of a command ending in '?' queues a reply for the next read.
+ * GPIBSTUB_REPORT set in the environment prints the call counts at exit.
+ * A bulk serial poll costs one transaction.
+ */
+
+#include <gpib/ib.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+static int sta, err;
+static long cnt;
+static int next_ud = 1;
+static char reply[256];
+static size_t reply_len;
+static long opens, closes, transactions;
+
+static long
+env_us (const char *name, long def)
+{
+  const char *v = getenv (name);
+  return v ? atol (v) : def;
+}
+
+static void
+report (void)
+{
+  fprintf (stderr, "gpibstub: %ld opens, %ld closes, %ld transactions\n",
+           opens, closes, transactions);
+}
+
+static int
+done (int ok, long count)
+{
+  sta = ok ? CMPL : (ERR | CMPL);
+  cnt = count;
+  return sta;
+}
+
+static void
+bus_delay (void)
+{
+  transactions++;
+  usleep (env_us ("GPIBSTUB_IO_US", 50));
+}
+
+int
+ibdev (int board_index, int pad, int sad, int timo, int send_eoi, int eosmode)
+{
+  static int reporting = 0;
+  if (! reporting && getenv ("GPIBSTUB_REPORT"))
+    {
+      reporting = 1;
+      atexit (report);
+    }
+
+  opens++;
+  usleep (env_us ("GPIBSTUB_OPEN_US", 1000));
+  done (1, 0);
+  return next_ud++;
+}
+
+int
+ibonl (int ud, int onl)
+{
+  closes++;
+  usleep (env_us ("GPIBSTUB_OPEN_US", 1000));
+  return done (1, 0);
+}
+
+int
+ibwrt (int ud, const void *buf, long count)
+{
+  const char *cmd = (const char *) buf;
+
+  bus_delay ();
+
+  reply_len = 0;
+  while (count > 0 && (cmd[count-1] == '\n' || cmd[count-1] == '\r'))
+    count--;
+  if (count > 0 && cmd[count-1] == '?')
+    {
+      snprintf (reply, sizeof (reply), "+1.23456789E+00\n");
+      reply_len = strlen (reply);
+    }
+
+  return done (1, count);
+}
+
+int
+ibwrta (int ud, const void *buf, long count)
+{
+  return ibwrt (ud, buf, count);
+}
+
+int
+ibrd (int ud, void *buf, long count)
+{
+  bus_delay ();
+
+  if (reply_len == 0)
+    {
+      err = EABO;
+      return sta = ERR | TIMO;
+    }
+
+  if ((size_t) count > reply_len)
+    count = reply_len;
+  memcpy (buf, reply, count);
+  reply_len = 0;
+
+  done (1, count);
+  return sta |= END;
+}
+
+int
+ibrda (int ud, void *buf, long count)
+{
+  return ibrd (ud, buf, count);
+}
+
+int
+ibwait (int ud, int mask)
+{
+  return sta | CMPL;
+}
+
+int
+ibstop (int ud)
+{
+  return done (1, cnt);
+}
+
+int
+ibrsp (int ud, char *spr)
+{
+  bus_delay ();
+  *spr = 0;
+  return done (1, 0);
+}
+
+/* every device answers a serial poll without requesting service */
+void
+AllSpoll (int board, const Addr4882_t addrs[], short results[])
+{
+  int i;
+
+  bus_delay ();
+  for (i = 0; addrs[i] != NOADDR; i++)
+    results[i] = 0;
+  done (1, i);
+}
+
+void
+FindRQS (int board, const Addr4882_t addrs[], short *result)
+{
+  bus_delay ();
+  *result = 0;
+  err = ETAB;
+  sta = ERR | CMPL;
+}
+
+int
+ibask (int ud, int option, int *value)
+{
+  *value = T3s;
+  return done (1, 0);
+}
+
+int ibtrg (int ud) { bus_delay (); return done (1, 0); }
+int ibclr (int ud) { bus_delay (); return done (1, 0); }
+int ibloc (int ud) { bus_delay (); return done (1, 0); }
+int ibtmo (int ud, int v) { return done (1, 0); }
+int ibeos (int ud, int v) { return done (1, 0); }
+
+int ThreadIbsta (void) { return sta; }
+int ThreadIberr (void) { return err; }
+int ThreadIbcnt (void) { return (int) cnt; }
+long ThreadIbcntl (void) { return cnt; }
@@ -0,0 +1,514 @@
+/*
+ * Minimal HiSLIP instrument, used by benchhislip.m to measure the cost of
+ * the hislip functions without an instrument.
+ *
+ *   gcc -O2 -o hislipserver hislipserver.c
+ *   ./hislipserver [port] &
+ *   octave --eval "benchhislip"
+ *
+ * The port defaults to 4880, the HiSLIP port, and 0 picks a free one. The
+ * port in use is printed on startup.
+ *
+ * A message ending in '?' queues a reply, sent with the MessageID of the
+ * query. The reply to "WAV?" is HISLIPSERVER_WAVE (default 1048576) bytes
+ * long, for measuring large transfers. Messages larger than
+ * HISLIPSERVER_MAXMSG (default 1048576) bytes must be split by the client.
+ * New sessions start in overlapped mode if HISLIPSERVER_OVERLAP is set,
+ * and either mode is accepted on a device clear.
+ *
+ * "*SRQ" sends an AsyncServiceRequest HISLIPSERVER_SRQ_MS (default 100)
+ * milliseconds later. The status byte has the RQS bit set until it is
+ * read with an AsyncStatusQuery.
+ * HISLIPSERVER_REPORT set in the environment prints the number of
+ * sessions, messages and device clears on exit or SIGINT.
+ */
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#define MAX_CONNS 64
+#define HEADER_SIZE 16
+
+enum
+{
+  INITIALIZE = 0,
+  INITIALIZE_RESPONSE = 1,
+  FATAL_ERROR = 2,
+  ERROR = 3,
+  DATA = 6,
+  DATA_END = 7,
+  DEVICE_CLEAR_COMPLETE = 8,
+  DEVICE_CLEAR_ACKNOWLEDGE = 9,
+  TRIGGER = 12,
+  ASYNC_MAXIMUM_MESSAGE_SIZE = 15,
+  ASYNC_MAXIMUM_MESSAGE_SIZE_RESPONSE = 16,
+  ASYNC_INITIALIZE = 17,
+  ASYNC_INITIALIZE_RESPONSE = 18,
+  ASYNC_DEVICE_CLEAR = 19,
+  ASYNC_SERVICE_REQUEST = 20,
+  ASYNC_STATUS_QUERY = 21,
+  ASYNC_STATUS_RESPONSE = 22,
+  ASYNC_DEVICE_CLEAR_ACKNOWLEDGE = 23
+};
+
+struct conn
+{
+  int fd;
+  /* session the connection belongs to, and whether it is the
+     asynchronous channel */
+  int session;
+  int is_async;
+
+  unsigned char *in;
+  size_t in_len, in_size;
+  unsigned char *out;
+  size_t out_len, out_pos, out_size;
+
+  /* synchronous channel state */
+  char cmd[4096];
+  size_t cmd_len;
+  int overlapped;
+  int stb;
+  double srq_at;
+};
+
+static struct conn conns[MAX_CONNS];
+static int next_session = 1;
+static long sessions, messages, clears, triggers, srqs;
+
+static long
+env_long (const char *name, long def)
+{
+  const char *v = getenv (name);
+  return v ? atol (v) : def;
+}
+
+static double
+now_ms (void)
+{
+  struct timespec ts;
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+static void
+report (void)
+{
+  fprintf (stderr, "hislipserver: %ld sessions, %ld messages, %ld device clears, "
+           "%ld triggers, %ld service requests\n",
+           sessions, messages, clears, triggers, srqs);
+}
+
+static void
+on_sigint (int sig)
+{
+  exit (0);
+}
+
+static void
+put_u32 (unsigned char *p, uint32_t v)
+{
+  p[0] = v >> 24;
+  p[1] = v >> 16;
+  p[2] = v >> 8;
+  p[3] = v;
+}
+
+static uint32_t
+get_u32 (const unsigned char *p)
+{
+  return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static uint64_t
+get_u64 (const unsigned char *p)
+{
+  return ((uint64_t)get_u32 (p) << 32) | get_u32 (p + 4);
+}
+
+static void
+reserve (unsigned char **buf, size_t *size, size_t want)
+{
+  if (want <= *size)
+    return;
+
+  while (*size < want)
+    *size = *size ? *size * 2 : 65536;
+  *buf = realloc (*buf, *size);
+  if (! *buf)
+    {
+      perror ("realloc");
+      exit (1);
+    }
+}
+
+/* queue a message on a connection, sent as the socket allows */
+static void
+queue_message (struct conn *c, int type, int control, uint32_t param,
+               const void *payload, uint64_t len)
+{
+  unsigned char *p;
+
+  if (c->out_pos == c->out_len)
+    c->out_pos = c->out_len = 0;
+
+  reserve (&c->out, &c->out_size, c->out_len + HEADER_SIZE + len);
+  p = c->out + c->out_len;
+
+  p[0] = 'H';
+  p[1] = 'S';
+  p[2] = type;
+  p[3] = control;
+  put_u32 (p + 4, param);
+  put_u32 (p + 8, (uint64_t)len >> 32);
+  put_u32 (p + 12, len);
+  if (len > 0)
+    memcpy (p + HEADER_SIZE, payload, len);
+
+  c->out_len += HEADER_SIZE + len;
+}
+
+static struct conn *
+find_channel (int session, int is_async)
+{
+  int i;
+
+  for (i = 0; i < MAX_CONNS; i++)
+    if (conns[i].fd >= 0 && conns[i].session == session && conns[i].is_async == is_async)
+      return &conns[i];
+
+  return NULL;
+}
+
+static void
+drop (struct conn *c)
+{
+  close (c->fd);
+  free (c->in);
+  free (c->out);
+  memset (c, 0, sizeof (*c));
+  c->fd = -1;
+}
+
+/* act on a whole message from the client */
+static void
+command (struct conn *c, uint32_t id)
+{
+  size_t len = c->cmd_len;
+
+  while (len > 0 && (c->cmd[len-1] == '\n' || c->cmd[len-1] == '\r'))
+    len--;
+
+  if (len == 4 && memcmp (c->cmd, "*SRQ", 4) == 0)
+    c->srq_at = now_ms () + env_long ("HISLIPSERVER_SRQ_MS", 100);
+  else if (len == 4 && memcmp (c->cmd, "WAV?", 4) == 0)
+    {
+      size_t n = env_long ("HISLIPSERVER_WAVE", 1048576);
+      char *wave = malloc (n > 0 ? n : 1);
+      memset (wave, '#', n);
+      queue_message (c, DATA_END, 0, id, wave, n);
+      free (wave);
+    }
+  else if (len > 0 && c->cmd[len-1] == '?')
+    {
+      static const char reply[] = "+1.23456789E+00\n";
+      queue_message (c, DATA_END, 0, id, reply, strlen (reply));
+    }
+
+  c->cmd_len = 0;
+}
+
+static void
+sync_message (struct conn *c, int type, int control, uint32_t param,
+              const unsigned char *payload, uint64_t len)
+{
+  switch (type)
+    {
+    case DATA:
+    case DATA_END:
+      messages++;
+      /* only the end of a long message is kept */
+      if (len >= sizeof (c->cmd))
+        {
+          payload += len - (sizeof (c->cmd) - 1);
+          len = sizeof (c->cmd) - 1;
+        }
+      if (c->cmd_len + len >= sizeof (c->cmd))
+        c->cmd_len = 0;
+      memcpy (c->cmd + c->cmd_len, payload, len);
+      c->cmd_len += len;
+      if (type == DATA_END)
+        command (c, param);
+      break;
+
+    case DEVICE_CLEAR_COMPLETE:
+      clears++;
+      c->cmd_len = 0;
+      c->srq_at = 0;
+      c->overlapped = control & 1;
+      queue_message (c, DEVICE_CLEAR_ACKNOWLEDGE, c->overlapped, 0, NULL, 0);
+      break;
+
+    case TRIGGER:
+      triggers++;
+      break;
+
+    default:
+      queue_message (c, ERROR, 0, 0, "unexpected message", 18);
+      break;
+    }
+}
+
+static void
+async_message (struct conn *c, int type, int control, uint32_t param,
+               const unsigned char *payload, uint64_t len)
+{
+  struct conn *s = find_channel (c->session, 0);
+  unsigned char size[8];
+  uint64_t max = env_long ("HISLIPSERVER_MAXMSG", 1048576);
+
+  switch (type)
+    {
+    case ASYNC_MAXIMUM_MESSAGE_SIZE:
+      put_u32 (size, max >> 32);
+      put_u32 (size + 4, max);
+      queue_message (c, ASYNC_MAXIMUM_MESSAGE_SIZE_RESPONSE, 0, 0, size, 8);
+      break;
+
+    case ASYNC_DEVICE_CLEAR:
+      queue_message (c, ASYNC_DEVICE_CLEAR_ACKNOWLEDGE, s ? s->overlapped : 0, 0, NULL, 0);
+      break;
+
+    case ASYNC_STATUS_QUERY:
+      queue_message (c, ASYNC_STATUS_RESPONSE, s ? s->stb : 0, 0, NULL, 0);
+      if (s)
+        s->stb &= ~0x40;
+      break;
+
+    default:
+      queue_message (c, ERROR, 0, 0, "unexpected message", 18);
+      break;
+    }
+}
+
+static void
+message (struct conn *c, int type, int control, uint32_t param,
+         const unsigned char *payload, uint64_t len)
+{
+  char device[256];
+
+  if (type == INITIALIZE && c->session == 0)
+    {
+      snprintf (device, sizeof (device), "%.*s", (int)(len < 255 ? len : 255), payload);
+      c->session = next_session++;
+      c->overlapped = getenv ("HISLIPSERVER_OVERLAP") != NULL;
+      sessions++;
+      queue_message (c, INITIALIZE_RESPONSE, c->overlapped,
+                     (0x0100 << 16) | c->session, NULL, 0);
+    }
+  else if (type == ASYNC_INITIALIZE && c->session == 0)
+    {
+      c->session = param & 0xffff;
+      c->is_async = 1;
+      if (! find_channel (c->session, 0))
+        queue_message (c, FATAL_ERROR, 1, 0, "unknown session", 15);
+      else
+        queue_message (c, ASYNC_INITIALIZE_RESPONSE, 0, 0x4f43, NULL, 0);
+    }
+  else if (c->session == 0)
+    queue_message (c, FATAL_ERROR, 1, 0, "not initialized", 15);
+  else if (c->is_async)
+    async_message (c, type, control, param, payload, len);
+  else
+    sync_message (c, type, control, param, payload, len);
+}
+
+/* read what is available and act on any whole messages */
+static int
+receive (struct conn *c)
+{
+  size_t pos = 0;
+  ssize_t n;
+
+  reserve (&c->in, &c->in_size, c->in_len + 65536);
+  n = recv (c->fd, c->in + c->in_len, c->in_size - c->in_len, 0);
+  if (n < 0 && errno == EAGAIN)
+    return 0;
+  if (n <= 0)
+    return -1;
+  c->in_len += n;
+
+  while (c->in_len - pos >= HEADER_SIZE)
+    {
+      const unsigned char *h = c->in + pos;
+      uint64_t len = get_u64 (h + 8);
+
+      if (h[0] != 'H' || h[1] != 'S')
+        return -1;
+      if (c->in_len - pos < HEADER_SIZE + len)
+        {
+          reserve (&c->in, &c->in_size, HEADER_SIZE + len);
+          break;
+        }
+
+      message (c, h[2], h[3], get_u32 (h + 4), h + HEADER_SIZE, len);
+      pos += HEADER_SIZE + len;
+    }
+
+  memmove (c->in, c->in + pos, c->in_len - pos);
+  c->in_len -= pos;
+
+  return 0;
+}
+
+static int
+transmit (struct conn *c)
+{
+  ssize_t n = send (c->fd, c->out + c->out_pos, c->out_len - c->out_pos, MSG_NOSIGNAL);
+  if (n < 0)
+    return errno == EAGAIN ? 0 : -1;
+
+  c->out_pos += n;
+  return 0;
+}
+
+int
+main (int argc, char *argv[])
+{
+  struct sockaddr_in addr;
+  socklen_t addrlen = sizeof (addr);
+  int one = 1;
+  int lfd, i;
+
+  if (getenv ("HISLIPSERVER_REPORT"))
+    {
+      atexit (report);
+      signal (SIGINT, on_sigint);
+    }
+
+  for (i = 0; i < MAX_CONNS; i++)
+    conns[i].fd = -1;
+
+  lfd = socket (AF_INET, SOCK_STREAM, 0);
+  setsockopt (lfd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof (one));
+
+  memset (&addr, 0, sizeof (addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl (INADDR_ANY);
+  addr.sin_port = htons (argc > 1 ? atoi (argv[1]) : 4880);
+
+  if (bind (lfd, (struct sockaddr *)&addr, sizeof (addr)) < 0 || listen (lfd, 8) < 0)
+    {
+      perror ("hislipserver");
+      return 1;
+    }
+
+  getsockname (lfd, (struct sockaddr *)&addr, &addrlen);
+  printf ("hislipserver: listening on port %d\n", ntohs (addr.sin_port));
+  fflush (stdout);
+
+  while (1)
+    {
+      struct pollfd fds[MAX_CONNS + 1];
+      int idx[MAX_CONNS + 1];
+      int nfds = 1;
+      int timeout = -1;
+      double now = now_ms ();
+
+      fds[0].fd = lfd;
+      fds[0].events = POLLIN;
+
+      for (i = 0; i < MAX_CONNS; i++)
+        {
+          struct conn *c = &conns[i];
+          if (c->fd < 0)
+            continue;
+
+          /* send any service request that is due */
+          if (c->srq_at > 0 && ! c->is_async)
+            {
+              if (c->srq_at <= now)
+                {
+                  struct conn *a = find_channel (c->session, 1);
+                  c->srq_at = 0;
+                  c->stb |= 0x40;
+                  srqs++;
+                  if (a)
+                    queue_message (a, ASYNC_SERVICE_REQUEST, c->stb, 0, NULL, 0);
+                }
+              else if (timeout < 0 || c->srq_at - now < timeout)
+                timeout = (int)(c->srq_at - now) + 1;
+            }
+        }
+
+      for (i = 0; i < MAX_CONNS; i++)
+        {
+          struct conn *c = &conns[i];
+          if (c->fd < 0)
+            continue;
+
+          fds[nfds].fd = c->fd;
+          fds[nfds].events = POLLIN | (c->out_pos < c->out_len ? POLLOUT : 0);
+          idx[nfds] = i;
+          nfds++;
+        }
+
+      if (poll (fds, nfds, timeout) < 0)
+        {
+          if (errno == EINTR)
+            continue;
+          perror ("poll");
+          return 1;
+        }
+
+      for (i = 1; i < nfds; i++)
+        {
+          struct conn *c = &conns[idx[i]];
+          int failed = 0;
+
+          if (fds[i].revents & POLLOUT)
+            failed = transmit (c) < 0;
+          if (! failed && (fds[i].revents & (POLLIN | POLLHUP | POLLERR)))
+            failed = receive (c) < 0;
+          if (! failed && c->out_pos < c->out_len)
+            failed = transmit (c) < 0;
+
+          if (failed)
+            drop (c);
+        }
+
+      if (fds[0].revents & POLLIN)
+        {
+          int fd = accept (lfd, NULL, NULL);
+          if (fd < 0)
+            continue;
+
+          for (i = 0; i < MAX_CONNS && conns[i].fd >= 0; i++)
+            ;
+          if (i == MAX_CONNS)
+            {
+              close (fd);
+              continue;
+            }
+
+          setsockopt (fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof (one));
+          fcntl (fd, F_SETFL, fcntl (fd, F_GETFL) | O_NONBLOCK);
+          memset (&conns[i], 0, sizeof (conns[i]));
+          conns[i].fd = fd;
+        }
+    }
+
+  return 0;
+}
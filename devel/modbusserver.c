@@ -0,0 +1,547 @@
+/*
+ * Minimal Modbus TCP server, standing in for a libmodbus server such as
+ * its unit-test-server, used by benchmodbus.m to measure the cost of the
+ * modbus functions without a device and by testmodbus.m to test them.
+ *
+ *   gcc -O2 -o modbusserver modbusserver.c
+ *   ./modbusserver [port] &
+ *   octave --eval "benchmodbus"
+ *
+ * The port defaults to 1502, and 0 picks a free one. The port in use is
+ * printed on startup.
+ *
+ * It answers read coils, read discrete inputs, read holding registers,
+ * read input registers, write single coil, write single register, write
+ * multiple coils, write multiple registers and read/write registers for
+ * any unit id, within the count limits of the protocol. All 65536 of
+ * each exist. Holding and input registers start out holding their own
+ * address and discrete input i is i & 1.
+ *
+ * Each response is held until MODBUSSERVER_DELAY_US (default 0)
+ * microseconds after its request arrived, like the latency of a network
+ * or gateway, so responses to requests sent back to back overlap their
+ * delays. Up to MODBUSSERVER_MAXPENDING (default 16) requests are taken
+ * from a connection before their responses go out.
+ * MODBUSSERVER_GAP set to an address leaves that coil, discrete input
+ * and register out, so requests covering it get an illegal data address
+ * exception, as from a device with a gap in its address map.
+ * MODBUSSERVER_REORDER set in the environment answers each second request
+ * before the one ahead of it, when both are waiting, as a server may
+ * answer requests out of order.
+ * MODBUSSERVER_REPORT set in the environment prints the number of
+ * connections, requests and exceptions and the most requests waiting at
+ * once on exit or SIGINT.
+ */
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#define MAX_CONNS 64
+#define MAX_PENDING 256
+#define MBAP_SIZE 7
+#define MAX_ADU 260
+
+#define ILLEGAL_FUNCTION 1
+#define ILLEGAL_DATA_ADDRESS 2
+#define ILLEGAL_DATA_VALUE 3
+
+struct response
+{
+  double due;
+  size_t len;
+  unsigned char adu[MAX_ADU];
+};
+
+struct conn
+{
+  int fd;
+
+  unsigned char in[8192];
+  size_t in_len;
+  unsigned char *out;
+  size_t out_len, out_pos, out_size;
+
+  /* responses waiting for their delay, oldest first */
+  struct response pending[MAX_PENDING];
+  int first, npending;
+};
+
+static struct conn conns[MAX_CONNS];
+static uint8_t coils[65536];
+static uint8_t inputs[65536];
+static uint16_t holding[65536];
+static uint16_t input_regs[65536];
+
+static double delay_ms;
+static int max_pending;
+static int reorder;
+static long gap;
+static long connections, requests, exceptions;
+static int most_pending;
+
+static long
+env_long (const char *name, long def)
+{
+  const char *v = getenv (name);
+  return v ? atol (v) : def;
+}
+
+static double
+now_ms (void)
+{
+  struct timespec ts;
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+static void
+report (void)
+{
+  fprintf (stderr, "modbusserver: %ld connections, %ld requests, %ld exceptions, "
+           "%d most waiting\n",
+           connections, requests, exceptions, most_pending);
+}
+
+static void
+on_sigint (int sig)
+{
+  exit (0);
+}
+
+static unsigned int
+get_u16 (const unsigned char *p)
+{
+  return (p[0] << 8) | p[1];
+}
+
+static void
+put_u16 (unsigned char *p, unsigned int v)
+{
+  p[0] = v >> 8;
+  p[1] = v;
+}
+
+/* the data of a read of count bits from table, packed as the protocol
+   has them, returning its length */
+static size_t
+pack_bits (unsigned char *p, const uint8_t *table, unsigned int addr, unsigned int count)
+{
+  unsigned int i;
+  size_t n = (count + 7) / 8;
+
+  p[0] = n;
+  memset (p + 1, 0, n);
+  for (i = 0; i < count; i++)
+    if (table[addr + i])
+      p[1 + i/8] |= 1 << (i % 8);
+
+  return 1 + n;
+}
+
+static size_t
+pack_regs (unsigned char *p, const uint16_t *table, unsigned int addr, unsigned int count)
+{
+  unsigned int i;
+
+  p[0] = count * 2;
+  for (i = 0; i < count; i++)
+    put_u16 (p + 1 + 2*i, table[addr + i]);
+
+  return 1 + count * 2;
+}
+
+/* whether any of count addresses from addr do not exist */
+static int
+bad_address (unsigned int addr, unsigned int count)
+{
+  return addr + count > 65536 || (gap >= addr && gap < (long)(addr + count));
+}
+
+/* act on the pdu of a request, leaving the pdu of the response in rsp
+   and returning its length */
+static size_t
+pdu (const unsigned char *req, size_t len, unsigned char *rsp)
+{
+  unsigned int fc = req[0];
+  unsigned int addr = len >= 3 ? get_u16 (req + 1) : 0;
+  unsigned int count = len >= 5 ? get_u16 (req + 3) : 0;
+  unsigned int waddr, wcount, i;
+  int err = 0;
+
+  rsp[0] = fc;
+
+  switch (fc)
+    {
+      case 0x01:
+      case 0x02:
+        if (len != 5 || count < 1 || count > 2000)
+          err = ILLEGAL_DATA_VALUE;
+        else if (bad_address (addr, count))
+          err = ILLEGAL_DATA_ADDRESS;
+        else
+          return 1 + pack_bits (rsp + 1, fc == 0x01 ? coils : inputs, addr, count);
+        break;
+
+      case 0x03:
+      case 0x04:
+        if (len != 5 || count < 1 || count > 125)
+          err = ILLEGAL_DATA_VALUE;
+        else if (bad_address (addr, count))
+          err = ILLEGAL_DATA_ADDRESS;
+        else
+          return 1 + pack_regs (rsp + 1, fc == 0x03 ? holding : input_regs, addr, count);
+        break;
+
+      case 0x05:
+        if (len != 5 || (count != 0xff00 && count != 0))
+          err = ILLEGAL_DATA_VALUE;
+        else
+          {
+            coils[addr] = count != 0;
+            memcpy (rsp, req, 5);
+            return 5;
+          }
+        break;
+
+      case 0x06:
+        if (len != 5)
+          err = ILLEGAL_DATA_VALUE;
+        else
+          {
+            holding[addr] = count;
+            memcpy (rsp, req, 5);
+            return 5;
+          }
+        break;
+
+      case 0x0f:
+        if (len < 6 || count < 1 || count > 1968 || req[5] != (count + 7) / 8
+            || len != 6 + req[5])
+          err = ILLEGAL_DATA_VALUE;
+        else if (bad_address (addr, count))
+          err = ILLEGAL_DATA_ADDRESS;
+        else
+          {
+            for (i = 0; i < count; i++)
+              coils[addr + i] = (req[6 + i/8] >> (i % 8)) & 1;
+            memcpy (rsp, req, 5);
+            return 5;
+          }
+        break;
+
+      case 0x10:
+        if (len < 6 || count < 1 || count > 123 || req[5] != count * 2
+            || len != 6 + req[5])
+          err = ILLEGAL_DATA_VALUE;
+        else if (bad_address (addr, count))
+          err = ILLEGAL_DATA_ADDRESS;
+        else
+          {
+            for (i = 0; i < count; i++)
+              holding[addr + i] = get_u16 (req + 6 + 2*i);
+            memcpy (rsp, req, 5);
+            return 5;
+          }
+        break;
+
+      case 0x17:
+        /* read address and count, then the write */
+        waddr = len >= 7 ? get_u16 (req + 5) : 0;
+        wcount = len >= 9 ? get_u16 (req + 7) : 0;
+        if (len < 10 || count < 1 || count > 125 || wcount < 1 || wcount > 121
+            || req[9] != wcount * 2 || len != 10 + req[9])
+          err = ILLEGAL_DATA_VALUE;
+        else if (bad_address (addr, count) || bad_address (waddr, wcount))
+          err = ILLEGAL_DATA_ADDRESS;
+        else
+          {
+            for (i = 0; i < wcount; i++)
+              holding[waddr + i] = get_u16 (req + 10 + 2*i);
+            return 1 + pack_regs (rsp + 1, holding, addr, count);
+          }
+        break;
+
+      default:
+        err = ILLEGAL_FUNCTION;
+        break;
+    }
+
+  exceptions++;
+  rsp[0] = fc | 0x80;
+  rsp[1] = err;
+  return 2;
+}
+
+static void
+reserve (unsigned char **buf, size_t *size, size_t want)
+{
+  if (want <= *size)
+    return;
+
+  while (*size < want)
+    *size = *size ? *size * 2 : 65536;
+  *buf = realloc (*buf, *size);
+  if (! *buf)
+    {
+      perror ("realloc");
+      exit (1);
+    }
+}
+
+/* responses that are due go to the output, in order */
+static void
+release (struct conn *c, double now)
+{
+  while (c->npending > 0 && c->pending[c->first].due <= now)
+    {
+      struct response *r = &c->pending[c->first];
+
+      if (c->out_pos == c->out_len)
+        c->out_pos = c->out_len = 0;
+      reserve (&c->out, &c->out_size, c->out_len + r->len);
+      memcpy (c->out + c->out_len, r->adu, r->len);
+      c->out_len += r->len;
+
+      c->first = (c->first + 1) % MAX_PENDING;
+      c->npending--;
+    }
+}
+
+static void
+drop (struct conn *c)
+{
+  close (c->fd);
+  free (c->out);
+  memset (c, 0, sizeof (*c));
+  c->fd = -1;
+}
+
+/* answer the whole requests read, as far as there is room to keep the
+   responses */
+static int
+take_requests (struct conn *c)
+{
+  size_t pos = 0;
+  double now = now_ms ();
+
+  while (c->in_len - pos >= MBAP_SIZE && c->npending < max_pending)
+    {
+      const unsigned char *h = c->in + pos;
+      unsigned int len = get_u16 (h + 4);
+      struct response *r;
+
+      /* the length counts the unit id and the pdu */
+      if (get_u16 (h + 2) != 0 || len < 2 || len > MAX_ADU - 6)
+        return -1;
+      if (c->in_len - pos < 6 + len)
+        break;
+
+      r = &c->pending[(c->first + c->npending) % MAX_PENDING];
+      memcpy (r->adu, h, MBAP_SIZE);
+      r->len = MBAP_SIZE + pdu (h + MBAP_SIZE, len - 1, r->adu + MBAP_SIZE);
+      put_u16 (r->adu + 4, r->len - 6);
+      r->due = now + delay_ms;
+
+      /* swap the responses, keeping the time the first is due */
+      if (reorder && requests % 2 == 1 && c->npending > 0)
+        {
+          struct response *prev = &c->pending[(c->first + c->npending - 1) % MAX_PENDING];
+          struct response tmp = *prev;
+
+          *prev = *r;
+          prev->due = tmp.due;
+          *r = tmp;
+          r->due = now + delay_ms;
+        }
+
+      c->npending++;
+      if (c->npending > most_pending)
+        most_pending = c->npending;
+      requests++;
+      pos += 6 + len;
+    }
+
+  memmove (c->in, c->in + pos, c->in_len - pos);
+  c->in_len -= pos;
+
+  return 0;
+}
+
+/* read what is available */
+static int
+receive (struct conn *c)
+{
+  ssize_t n;
+
+  if (c->in_len == sizeof (c->in))
+    return take_requests (c);
+
+  n = recv (c->fd, c->in + c->in_len, sizeof (c->in) - c->in_len, 0);
+  if (n < 0 && errno == EAGAIN)
+    return 0;
+  if (n <= 0)
+    return -1;
+  c->in_len += n;
+
+  return take_requests (c);
+}
+
+static int
+transmit (struct conn *c)
+{
+  ssize_t n = send (c->fd, c->out + c->out_pos, c->out_len - c->out_pos, MSG_NOSIGNAL);
+  if (n < 0)
+    return errno == EAGAIN ? 0 : -1;
+
+  c->out_pos += n;
+  return 0;
+}
+
+int
+main (int argc, char *argv[])
+{
+  struct sockaddr_in addr;
+  socklen_t addrlen = sizeof (addr);
+  int one = 1;
+  int lfd, i;
+
+  delay_ms = env_long ("MODBUSSERVER_DELAY_US", 0) / 1000.0;
+  max_pending = env_long ("MODBUSSERVER_MAXPENDING", 16);
+  if (max_pending < 1)
+    max_pending = 1;
+  if (max_pending > MAX_PENDING)
+    max_pending = MAX_PENDING;
+  reorder = getenv ("MODBUSSERVER_REORDER") != NULL;
+  gap = env_long ("MODBUSSERVER_GAP", -1);
+
+  if (getenv ("MODBUSSERVER_REPORT"))
+    {
+      atexit (report);
+      signal (SIGINT, on_sigint);
+    }
+
+  for (i = 0; i < 65536; i++)
+    {
+      inputs[i] = i & 1;
+      holding[i] = i;
+      input_regs[i] = i;
+    }
+
+  for (i = 0; i < MAX_CONNS; i++)
+    conns[i].fd = -1;
+
+  lfd = socket (AF_INET, SOCK_STREAM, 0);
+  setsockopt (lfd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof (one));
+
+  memset (&addr, 0, sizeof (addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl (INADDR_ANY);
+  addr.sin_port = htons (argc > 1 ? atoi (argv[1]) : 1502);
+
+  if (bind (lfd, (struct sockaddr *)&addr, sizeof (addr)) < 0 || listen (lfd, 8) < 0)
+    {
+      perror ("modbusserver");
+      return 1;
+    }
+
+  getsockname (lfd, (struct sockaddr *)&addr, &addrlen);
+  printf ("modbusserver: listening on port %d\n", ntohs (addr.sin_port));
+  fflush (stdout);
+
+  while (1)
+    {
+      struct pollfd fds[MAX_CONNS + 1];
+      int idx[MAX_CONNS + 1];
+      int nfds = 1;
+      int timeout = -1;
+      double now = now_ms ();
+
+      fds[0].fd = lfd;
+      fds[0].events = POLLIN;
+
+      for (i = 0; i < MAX_CONNS; i++)
+        {
+          struct conn *c = &conns[i];
+          if (c->fd < 0)
+            continue;
+
+          release (c, now);
+          if (take_requests (c) < 0 || (c->out_pos < c->out_len && transmit (c) < 0))
+            {
+              drop (c);
+              continue;
+            }
+
+          /* wake for the next response that is due, rounding up */
+          if (c->npending > 0)
+            {
+              double wait = c->pending[c->first].due - now;
+              if (timeout < 0 || wait < timeout)
+                timeout = (int)wait + 1;
+            }
+
+          fds[nfds].fd = c->fd;
+          fds[nfds].events = (c->npending < max_pending && c->in_len < sizeof (c->in) ? POLLIN : 0)
+                             | (c->out_pos < c->out_len ? POLLOUT : 0);
+          idx[nfds] = i;
+          nfds++;
+        }
+
+      if (poll (fds, nfds, timeout) < 0)
+        {
+          if (errno == EINTR)
+            continue;
+          perror ("poll");
+          return 1;
+        }
+
+      for (i = 1; i < nfds; i++)
+        {
+          struct conn *c = &conns[idx[i]];
+          int failed = 0;
+
+          if (fds[i].revents & POLLOUT)
+            failed = transmit (c) < 0;
+          if (! failed && (fds[i].revents & (POLLIN | POLLHUP | POLLERR)))
+            failed = receive (c) < 0;
+
+          if (failed)
+            drop (c);
+        }
+
+      if (fds[0].revents & POLLIN)
+        {
+          int fd = accept (lfd, NULL, NULL);
+          if (fd < 0)
+            continue;
+
+          for (i = 0; i < MAX_CONNS && conns[i].fd >= 0; i++)
+            ;
+          if (i == MAX_CONNS)
+            {
+              close (fd);
+              continue;
+            }
+
+          setsockopt (fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof (one));
+          fcntl (fd, F_SETFL, fcntl (fd, F_GETFL) | O_NONBLOCK);
+          memset (&conns[i], 0, sizeof (conns[i]));
+          conns[i].fd = fd;
+          connections++;
+        }
+    }
+
+  return 0;
+}
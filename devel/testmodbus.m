@@ -0,0 +1,62 @@
+function testmodbus (host, port)
+% test modbus reads and writes split into several requests against the
+% modbusserver stand in
+%
+% see modbusserver.c for how to build it. Run it with MODBUSSERVER_GAP
+% set to 64600 for the exceptions to come in the middle of a transfer,
+% and with MODBUSSERVER_DELAY_US and MODBUSSERVER_REORDER set for the
+% responses to overlap and come out of order.
+
+if nargin < 1
+  host = "127.0.0.1";
+endif
+if nargin < 2
+  port = 1502;
+endif
+
+dev = modbus ("tcpip", host, port);
+regs = uint16 (0:9999);
+
+for depth = [1 4 16]
+  dev.PipelineDepth = depth;
+
+  write (dev, "holdingregs", 0, regs);
+  assert (read (dev, "holdingregs", 0, 10000), regs);
+
+  % a single request and the smallest split
+  assert (read (dev, "holdingregs", 7, 125), regs(8:132));
+  assert (read (dev, "holdingregs", 7, 126), regs(8:133));
+
+  % coil counts that are not a multiple of 8 nor of a request
+  for n = [2001 3939 5555]
+    bits = mod ((0:n-1) * 5 + depth, 3) == 0;
+    write (dev, "coils", 101, bits);
+    assert (double (read (dev, "coils", 101, n)), double (bits));
+  endfor
+
+  % an exception from a request in the middle, with the requests after
+  % it already sent, leaves nothing behind for the next read
+  fail_read (dev, "holdingregs", 64000, 1000);
+  assert (read (dev, "holdingregs", 30, 10), regs(31:40));
+  fail_read (dev, "coils", 56000, 9000);
+  assert (read (dev, "holdingregs", 40, 10), regs(41:50));
+
+  % a transfer past the last address is refused, not wrapped round
+  fail_read (dev, "holdingregs", 65500, 100);
+
+  printf ("PipelineDepth %2d: passed\n", depth);
+endfor
+
+assert (read (dev, "holdingregs", 0, 10000), regs);
+
+clear dev
+endfunction
+
+function fail_read (dev, target, address, count)
+  try
+    read (dev, target, address, count);
+    error ("expected an exception reading %d from %d", count, address);
+  catch err
+    assert (! isempty (strfind (err.message, "modbus_read")), err.message);
+  end_try_catch
+endfunction
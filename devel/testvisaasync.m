@@ -0,0 +1,59 @@
+function testvisaasync
+% test the asynchronous visadev functions against the visastub stand in
+%
+% see visastub.c for how to build it. Octave must be started with
+% VISA_LIBRARY set to the built library.
+
+dev = visadev ("TCPIP0::127.0.0.1::inst0::INSTR");
+
+% a write and a read both in progress
+visawriteasync (dev, "*IDN?\n");
+visareadasync (dev, 64);
+status = dev.TransferStatus
+assert (visawaitasync (dev, 5));
+assert (dev.TransferStatus, "idle");
+assert (dev.NumBytesWritten, 6);
+
+% the completed read is returned by read
+data = char (read (dev, 64))
+assert (strncmp (data, "VISASTUB", 8));
+
+% check without waiting, then wait for it
+write (dev, "MEAS:VOLT?\n");
+visareadasync (dev, 64);
+done = visawaitasync (dev, 0)
+assert (visawaitasync (dev));
+assert (readline (dev), "1.0");
+
+% a read with nothing to read is stopped before it times out
+dev.Timeout = 5;
+visareadasync (dev, 64);
+start = tic;
+visastopasync (dev);
+elapsed = double (tic - start)/1e6
+assert (elapsed < 1);
+assert (dev.TransferStatus, "idle");
+
+% a read that times out is an error
+dev.Timeout = 0.1;
+visareadasync (dev, 64);
+try
+  visawaitasync (dev);
+  error ("expected a timeout");
+catch err
+  disp (err.message)
+end_try_catch
+
+% a synchronous read while a read is in progress is an error
+dev.Timeout = 5;
+visareadasync (dev, 64);
+try
+  read (dev, 10);
+  error ("expected an error");
+catch err
+  disp (err.message)
+end_try_catch
+visastopasync (dev);
+
+clear dev
+endfunction
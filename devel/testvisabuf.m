@@ -0,0 +1,60 @@
+function testvisabuf
+% test visadev write buffering against the visastub stand in
+%
+% see visastub.c for how to build it. Octave must be started with
+% VISA_LIBRARY set to the built library.
+
+dev = visadev ("TCPIP0::127.0.0.1::inst0::INSTR");
+dev.Timeout = 0.5;
+
+assert (dev.BufferMode, "off");
+assert (dev.BufferSize, 4096);
+
+% queued writes are not sent until flushed
+dev.BufferMode = "manual";
+write (dev, "*CLS\n");
+write (dev, "*IDN?\n");
+assert (dev.NumBytesWritten, 11);
+visaflush (dev);
+assert (strncmp (readline (dev), "VISASTUB", 8));
+
+% a read sends the queued query first
+write (dev, "MEAS:VOLT?\n");
+assert (readline (dev), "1.0");
+assert (writeread (dev, "MEAS:VOLT?"), "1.0");
+
+% discarded writes are never sent
+write (dev, "MEAS:VOLT?\n");
+flush (dev, "output");
+try
+  read (dev, 10);
+  error ("expected a timeout");
+catch err
+  disp (err.message)
+end_try_catch
+
+% a write ending with the terminator is sent at once
+dev.BufferMode = "terminator";
+write (dev, "MEAS:");
+write (dev, "VOLT?\n");
+assert (readline (dev), "1.0");
+
+% a smaller buffer is sent each time it fills
+dev.BufferSize = 8;
+write (dev, "*CLS\n*IDN?\n");
+assert (strncmp (readline (dev), "VISASTUB", 8));
+
+% writes are sent as they are made again
+dev.BufferMode = "off";
+write (dev, "MEAS:VOLT?\n");
+assert (read (dev, 4), uint8 ("1.0\n"));
+
+try
+  dev.BufferMode = "always";
+  error ("expected an error");
+catch err
+  disp (err.message)
+end_try_catch
+
+clear dev
+endfunction
@@ -0,0 +1,37 @@
+function testvisaprops
+% test visadev property access for each kind of interface against the
+% visastub stand in
+%
+% see visastub.c for how to build it. Octave must be started with
+% VISA_LIBRARY set to the built library.
+%
+% Every property of each interface is read with get(dev), which reads the
+% whole property map, and then one at a time.
+
+resources = {
+  "ASRL1::INSTR", "serial";
+  "GPIB0::1::INSTR", "gpib";
+  "GPIB-VXI0::1::INSTR", "vxi";
+  "VXI0::1::INSTR", "vxi";
+  "PXI0::1-2.0::INSTR", "pxi";
+  "USB0::0x1234::0x5678::SN1::INSTR", "usb";
+  "TCPIP0::127.0.0.1::inst0::INSTR", "tcpip";
+  "TCPIP0::127.0.0.1::5025::SOCKET", "socket";
+};
+
+for i=1:rows (resources)
+  dev = visadev (resources{i,1});
+  assert (dev.Type, resources{i,2});
+
+  props = get (dev);
+  assert (isstruct (props));
+  names = fieldnames (props);
+  for j=1:numel (names)
+    get (dev, names{j});
+  endfor
+
+  printf ("%-34s %-7s %d properties\n", resources{i,1}, dev.Type, numel (names));
+  clear dev
+endfor
+
+endfunction
@@ -0,0 +1,33 @@
+function testvisasrq
+% test visawaitsrq against the visastub stand in
+%
+% see visastub.c for how to build it. Octave must be started with
+% VISA_LIBRARY set to the built library.
+
+dev = visadev ("TCPIP0::127.0.0.1::inst0::INSTR");
+
+% nothing requested
+dev.EnableSRQ = true;
+assert (visawaitsrq (dev, 0), false);
+
+% a service request arrives about 100 ms after the write
+write (dev, "*SRQ");
+start = tic;
+[srq, stb] = visawaitsrq (dev, 5)
+elapsed = double (tic - start)/1e6
+assert (srq);
+assert (bitand (stb, 64), 64);
+assert (elapsed < 1);
+
+% and the wait times out when there is none
+start = tic;
+[srq, stb] = visawaitsrq (dev, 0.2)
+elapsed = double (tic - start)/1e6
+assert (srq, false);
+assert (elapsed >= 0.2);
+
+dev.EnableSRQ = false;
+assert (dev.EnableSRQ, false);
+
+clear dev
+endfunction
@@ -0,0 +1,1058 @@
+/*
+ * Minimal stand in for a VISA library, used to test and measure the
+ * visadev functions without an instrument.
+ *
+ * Build it and point visadev at it with VISA_LIBRARY:
+ *
+ *   gcc -O2 -shared -fPIC -o libvisa.so visastub.c -lpthread
+ *   VISA_LIBRARY=$PWD/libvisa.so octave
+ *
+ * It lists a single instrument, TCPIP0::127.0.0.1::inst0::INSTR, but opens
+ * any resource name, reporting the interface type its prefix gives (ASRL,
+ * GPIB, GPIB-VXI, VXI, PXI, USB or TCPIP), so the properties of each kind
+ * of interface can be tried. All of them answer as the one instrument.
+ * A write of a command ending in '?' queues a reply message for the next
+ * reads, which end with END at the end of each message. Reads with no
+ * reply queued time out after VI_ATTR_TMO_VALUE milliseconds.
+ *
+ * Replies are looked up in the file named by VISASTUB_RESPONSES, if set,
+ * which has a line for each command of the command, a tab and the
+ * reply, to which a newline is added. Lines starting with '#' are
+ * ignored. Otherwise "*IDN?" answers with an identity, "WAV?" with a
+ * binblock of VISASTUB_WAVE (default 1048576) bytes and any other query
+ * with "1.0".
+ *
+ * Each viRead and viWrite costs VISASTUB_IO_US (default 0) microseconds,
+ * plus the time to move the data at VISASTUB_MBPS MB/s if that is set.
+ * The settings are read when the resource manager is opened.
+ *
+ * Each line of a write is taken as a command, so a write buffered with
+ * viBufWrite can carry several. viBufWrite queues writes in a buffer of
+ * the size given to viSetBuf (default 4096 bytes). It is sent as one
+ * transfer on viFlush or on every call with VI_ATTR_WR_BUF_OPER_MODE set
+ * to VI_FLUSH_ON_ACCESS, and without END when it fills, so a command cut
+ * off there is completed by the next transfer. viBufRead reads through a
+ * buffer of the same size.
+ *
+ * viReadAsync and viWriteAsync run each job on a thread that sleeps
+ * VISASTUB_ASYNC_US (default 1000) microseconds and then does the
+ * transfer, queueing a VI_EVENT_IO_COMPLETION event for viWaitOnEvent.
+ * viTerminate ends a job with VI_ERROR_ABORT.
+ *
+ * A write of "*SRQ" requests service VISASTUB_SRQ_MS (default 100)
+ * milliseconds later, queueing a VI_EVENT_SERVICE_REQ event and setting
+ * bit 6 of the status byte until the next viReadSTB.
+ */
+
+#include <visa.h>
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define RM_SESSION 1
+#define INSTR_SESSION 2
+#define FIND_LIST 3
+#define FIRST_EVENT 100
+
+#define RSRC_NAME "TCPIP0::127.0.0.1::inst0::INSTR"
+#define IDN_REPLY "VISASTUB,Stand in,0,1.0\n"
+#define DEFAULT_REPLY "1.0\n"
+
+#define MAX_EVENTS 32
+#define MAX_REPLIES 64
+
+struct event
+{
+  ViEvent id;
+  ViEventType type;
+  ViJobId job;
+  ViStatus status;
+  ViUInt32 count;
+};
+
+struct job
+{
+  ViJobId id;
+  int write;
+  ViBuf buf;
+  ViUInt32 cnt;
+  int terminated;
+};
+
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t changed = PTHREAD_COND_INITIALIZER;
+
+static int instr_open;
+static char rsrc_name[256] = RSRC_NAME;
+static ViUInt32 timeout_ms = 2000;
+/* replies waiting to be read, one message after another from
+   reply_start, and the length left of each message */
+static char *reply;
+static size_t reply_start, reply_len, reply_size;
+static size_t msg_len[MAX_REPLIES];
+static int nmsg;
+
+struct response
+{
+  char *cmd;
+  char *reply;
+};
+
+static struct response *responses;
+static int nresponses;
+static char *wave;
+static size_t wave_len;
+static long io_us;
+static double mbps;
+
+/* formatted io buffers */
+static char *wbuf;
+static size_t wbuf_len, wbuf_size = 4096;
+static ViUInt16 wbuf_mode = VI_FLUSH_WHEN_FULL;
+/* a command sent in part, without END */
+static char *partial;
+static size_t partial_len, partial_size;
+static char *rbuf;
+static size_t rbuf_start, rbuf_len, rbuf_size = 4096;
+/* status of the viRead that filled rbuf */
+static ViStatus rbuf_status;
+
+static int io_events;
+static int srq_events;
+static ViUInt16 stb;
+static struct event queue[MAX_EVENTS];
+static int queued;
+static ViEvent next_event = FIRST_EVENT;
+/* events handed out by viWaitOnEvent and not yet closed */
+static struct event taken[MAX_EVENTS];
+static int ntaken;
+
+static ViJobId next_job = 1;
+static struct job *jobs[MAX_EVENTS];
+
+static long
+env_us (const char *name, long def)
+{
+  const char *v = getenv (name);
+  return v ? atol (v) : def;
+}
+
+static void
+deadline_in (struct timespec *ts, ViUInt32 ms)
+{
+  clock_gettime (CLOCK_REALTIME, ts);
+  ts->tv_sec += ms / 1000;
+  ts->tv_nsec += (long)(ms % 1000) * 1000000;
+  if (ts->tv_nsec >= 1000000000)
+    {
+      ts->tv_sec++;
+      ts->tv_nsec -= 1000000000;
+    }
+}
+
+/* called with lock held */
+static void
+queue_event (ViEventType type, ViJobId job, ViStatus status, ViUInt32 count)
+{
+  if (queued == MAX_EVENTS)
+    return;
+
+  queue[queued].id = next_event++;
+  queue[queued].type = type;
+  queue[queued].job = job;
+  queue[queued].status = status;
+  queue[queued].count = count;
+  queued++;
+  pthread_cond_broadcast (&changed);
+}
+
+static void *
+run_srq (void *arg)
+{
+  usleep (env_us ("VISASTUB_SRQ_MS", 100) * 1000);
+
+  pthread_mutex_lock (&lock);
+  if (instr_open)
+    {
+      stb |= 0x40;
+      if (srq_events)
+        queue_event (VI_EVENT_SERVICE_REQ, 0, VI_SUCCESS, 0);
+    }
+  pthread_mutex_unlock (&lock);
+
+  return NULL;
+}
+
+/* called with lock held */
+static void
+append_reply (const char *data, size_t len)
+{
+  if (nmsg == MAX_REPLIES)
+    return;
+
+  if (reply_start > 0)
+    {
+      memmove (reply, reply + reply_start, reply_len);
+      reply_start = 0;
+    }
+  if (reply_len + len > reply_size)
+    {
+      char *p = realloc (reply, reply_len + len);
+      if (! p)
+        return;
+      reply = p;
+      reply_size = reply_len + len;
+    }
+
+  memcpy (reply + reply_len, data, len);
+  reply_len += len;
+  msg_len[nmsg++] = len;
+  pthread_cond_broadcast (&changed);
+}
+
+/* called with lock held */
+static void
+clear_replies (void)
+{
+  reply_start = 0;
+  reply_len = 0;
+  nmsg = 0;
+}
+
+/* called with lock held */
+static void
+queue_reply (const char *cmd, size_t len)
+{
+  const char *r;
+  pthread_t thread;
+  int i;
+
+  while (len > 0 && (cmd[len-1] == '\n' || cmd[len-1] == '\r'))
+    len--;
+  if (len == 4 && memcmp (cmd, "*SRQ", 4) == 0)
+    {
+      if (pthread_create (&thread, NULL, run_srq, NULL) == 0)
+        pthread_detach (thread);
+      return;
+    }
+
+  for (i = 0; i < nresponses; i++)
+    {
+      if (strlen (responses[i].cmd) == len && memcmp (responses[i].cmd, cmd, len) == 0)
+        {
+          append_reply (responses[i].reply, strlen (responses[i].reply));
+          return;
+        }
+    }
+
+  if (len == 4 && memcmp (cmd, "WAV?", 4) == 0)
+    {
+      append_reply (wave, wave_len);
+      return;
+    }
+
+  if (len == 0 || cmd[len-1] != '?')
+    return;
+
+  r = (len == 5 && memcmp (cmd, "*IDN?", 5) == 0) ? IDN_REPLY : DEFAULT_REPLY;
+  append_reply (r, strlen (r));
+}
+
+/* called with lock held. Waits for a reply unless *terminated is set */
+static ViStatus
+take_reply (ViBuf buf, ViUInt32 cnt, ViPUInt32 ret, const int *terminated)
+{
+  struct timespec ts;
+  size_t n;
+
+  deadline_in (&ts, timeout_ms);
+  while (nmsg == 0 && ! (terminated && *terminated))
+    {
+      if (pthread_cond_timedwait (&changed, &lock, &ts) != 0)
+        break;
+    }
+
+  if (ret)
+    *ret = 0;
+  if (terminated && *terminated)
+    return VI_ERROR_ABORT;
+  if (nmsg == 0)
+    return VI_ERROR_TMO;
+
+  n = msg_len[0] < cnt ? msg_len[0] : cnt;
+  memcpy (buf, reply + reply_start, n);
+  reply_start += n;
+  reply_len -= n;
+  msg_len[0] -= n;
+  if (ret)
+    *ret = n;
+
+  if (msg_len[0] > 0)
+    return VI_SUCCESS_MAX_CNT;
+
+  memmove (msg_len, msg_len + 1, --nmsg * sizeof (msg_len[0]));
+  if (reply_len == 0)
+    reply_start = 0;
+
+  return VI_SUCCESS;
+}
+
+/* time taken by a transfer of len bytes. Short delays spin rather than
+   sleep, as a sleep can overrun by tens of microseconds */
+static void
+io_delay (size_t len)
+{
+  struct timespec start, now;
+  long us = io_us;
+
+  if (mbps > 0)
+    us += (long)(len / mbps);
+  if (us <= 0)
+    return;
+  if (us >= 1000)
+    {
+      usleep (us);
+      return;
+    }
+
+  clock_gettime (CLOCK_MONOTONIC, &start);
+  do
+    clock_gettime (CLOCK_MONOTONIC, &now);
+  while ((now.tv_sec - start.tv_sec) * 1000000 + (now.tv_nsec - start.tv_nsec) / 1000 < us);
+}
+
+static void
+load_responses (const char *path)
+{
+  FILE *fp;
+  char *line = NULL;
+  size_t size = 0;
+  ssize_t n;
+  char *tab;
+  struct response *p;
+
+  fp = fopen (path, "r");
+  if (! fp)
+    {
+      fprintf (stderr, "visastub: could not open %s\n", path);
+      return;
+    }
+
+  while ((n = getline (&line, &size, fp)) > 0)
+    {
+      while (n > 0 && (line[n-1] == '\n' || line[n-1] == '\r'))
+        line[--n] = 0;
+      tab = strchr (line, '\t');
+      if (line[0] == '#' || ! tab)
+        continue;
+      *tab = 0;
+
+      p = realloc (responses, (nresponses + 1) * sizeof (*p));
+      if (! p)
+        break;
+      responses = p;
+      responses[nresponses].cmd = strdup (line);
+      responses[nresponses].reply = malloc (strlen (tab + 1) + 2);
+      sprintf (responses[nresponses].reply, "%s\n", tab + 1);
+      nresponses++;
+    }
+
+  free (line);
+  fclose (fp);
+}
+
+/* read the settings, once */
+static void
+load_config (void)
+{
+  static int loaded;
+  const char *v;
+  size_t n, i;
+  int digits;
+
+  if (loaded)
+    return;
+  loaded = 1;
+
+  io_us = env_us ("VISASTUB_IO_US", 0);
+  v = getenv ("VISASTUB_MBPS");
+  mbps = v ? atof (v) : 0;
+
+  v = getenv ("VISASTUB_RESPONSES");
+  if (v)
+    load_responses (v);
+
+  /* "#<digits><length><data>\n" */
+  n = env_us ("VISASTUB_WAVE", 1048576);
+  digits = snprintf (NULL, 0, "%zu", n);
+  wave = malloc (n + 32);
+  if (wave)
+    {
+      wave_len = sprintf (wave, "#%d%zu", digits, n);
+      for (i = 0; i < n; i++)
+        wave[wave_len + i] = i & 0xff;
+      wave_len += n;
+      wave[wave_len++] = '\n';
+    }
+}
+
+/* the interface type of a resource name, from its prefix */
+static ViUInt16
+rsrc_intf (const char *name)
+{
+  if (strncmp (name, "ASRL", 4) == 0)
+    return VI_INTF_ASRL;
+  if (strncmp (name, "GPIB-VXI", 8) == 0)
+    return VI_INTF_GPIB_VXI;
+  if (strncmp (name, "GPIB", 4) == 0)
+    return VI_INTF_GPIB;
+  if (strncmp (name, "VXI", 3) == 0)
+    return VI_INTF_VXI;
+  if (strncmp (name, "PXI", 3) == 0)
+    return VI_INTF_PXI;
+  if (strncmp (name, "USB", 3) == 0)
+    return VI_INTF_USB;
+  return VI_INTF_TCPIP;
+}
+
+ViStatus _VI_FUNC
+viOpenDefaultRM (ViPSession vi)
+{
+  load_config ();
+  *vi = RM_SESSION;
+  return VI_SUCCESS;
+}
+
+ViStatus _VI_FUNC
+viFindRsrc (ViSession sesn, ViConstString expr, ViPFindList vi,
+            ViPUInt32 retCnt, ViChar _VI_FAR desc[])
+{
+  *vi = FIND_LIST;
+  if (retCnt)
+    *retCnt = 1;
+  strcpy (desc, RSRC_NAME);
+  return VI_SUCCESS;
+}
+
+ViStatus _VI_FUNC
+viFindNext (ViFindList vi, ViChar _VI_FAR desc[])
+{
+  return VI_ERROR_RSRC_NFOUND;
+}
+
+ViStatus _VI_FUNC
+viParseRsrc (ViSession rmSesn, ViConstRsrc rsrcName,
+             ViPUInt16 intfType, ViPUInt16 intfNum)
+{
+  *intfType = rsrc_intf (rsrcName);
+  *intfNum = 0;
+  return VI_SUCCESS;
+}
+
+ViStatus _VI_FUNC
+viParseRsrcEx (ViSession rmSesn, ViConstRsrc rsrcName, ViPUInt16 intfType,
+               ViPUInt16 intfNum, ViChar _VI_FAR rsrcClass[],
+               ViChar _VI_FAR expandedUnaliasedName[],
+               ViChar _VI_FAR aliasIfExists[])
+{
+  *intfType = rsrc_intf (rsrcName);
+  *intfNum = 0;
+  if (rsrcClass)
+    strcpy (rsrcClass, "INSTR");
+  if (expandedUnaliasedName)
+    strcpy (expandedUnaliasedName, rsrcName);
+  if (aliasIfExists)
+    aliasIfExists[0] = 0;
+  return VI_SUCCESS;
+}
+
+ViStatus _VI_FUNC
+viOpen (ViSession sesn, ViConstRsrc name, ViAccessMode mode,
+        ViUInt32 timeout, ViPSession vi)
+{
+  pthread_mutex_lock (&lock);
+  instr_open = 1;
+  snprintf (rsrc_name, sizeof (rsrc_name), "%s", name);
+  clear_replies ();
+  pthread_mutex_unlock (&lock);
+
+  *vi = INSTR_SESSION;
+  return VI_SUCCESS;
+}
+
+ViStatus _VI_FUNC
+viClose (ViObject vi)
+{
+  int i;
+
+  pthread_mutex_lock (&lock);
+  if (vi == INSTR_SESSION)
+    {
+      /* closing a session ends its jobs */
+      for (i = 0; i < MAX_EVENTS; i++)
+        if (jobs[i])
+          jobs[i]->terminated = 1;
+      pthread_cond_broadcast (&changed);
+      instr_open = 0;
+      io_events = 0;
+      srq_events = 0;
+      stb = 0;
+      queued = 0;
+      wbuf_len = 0;
+      rbuf_len = 0;
+      partial_len = 0;
+    }
+  else if (vi >= FIRST_EVENT)
+    {
+      for (i = 0; i < ntaken; i++)
+        if (taken[i].id == vi)
+          {
+            taken[i] = taken[--ntaken];
+            break;
+          }
+    }
+  pthread_mutex_unlock (&lock);
+
+  return VI_SUCCESS;
+}
+
+ViStatus _VI_FUNC
+viGetAttribute (ViObject vi, ViAttr attrName, void _VI_PTR attrValue)
+{
+  ViStatus status = VI_SUCCESS;
+  int i;
+
+  if (vi >= FIRST_EVENT)
+    {
+      pthread_mutex_lock (&lock);
+      for (i = 0; i < ntaken; i++)
+        if (taken[i].id == vi)
+          break;
+      if (i == ntaken)
+        status = VI_ERROR_INV_OBJECT;
+      else if (attrName == VI_ATTR_JOB_ID)
+        *(ViJobId *)attrValue = taken[i].job;
+      else if (attrName == VI_ATTR_STATUS)
+        *(ViStatus *)attrValue = taken[i].status;
+      else if (attrName == VI_ATTR_RET_COUNT)
+        *(ViUInt32 *)attrValue = taken[i].count;
+      else if (attrName == VI_ATTR_EVENT_TYPE)
+        *(ViEventType *)attrValue = taken[i].type;
+      else
+        status = VI_ERROR_NSUP_ATTR;
+      pthread_mutex_unlock (&lock);
+      return status;
+    }
+
+  switch (attrName)
+    {
+      case VI_ATTR_RSRC_NAME:
+        strcpy ((char *)attrValue, rsrc_name);
+        break;
+      case VI_ATTR_RSRC_CLASS:
+        strcpy ((char *)attrValue, "INSTR");
+        break;
+      case VI_ATTR_TCPIP_ADDR:
+      case VI_ATTR_TCPIP_HOSTNAME:
+        strcpy ((char *)attrValue, "127.0.0.1");
+        break;
+      case VI_ATTR_MANF_NAME:
+        strcpy ((char *)attrValue, "VISASTUB");
+        break;
+      case VI_ATTR_MODEL_NAME:
+        strcpy ((char *)attrValue, "Stand in");
+        break;
+      case VI_ATTR_INTF_TYPE:
+        *(ViUInt16 *)attrValue = rsrc_intf (rsrc_name);
+        break;
+      case VI_ATTR_INTF_NUM:
+        *(ViUInt16 *)attrValue = 0;
+        break;
+      case VI_ATTR_RM_SESSION:
+        *(ViSession *)attrValue = RM_SESSION;
+        break;
+      case VI_ATTR_TMO_VALUE:
+        *(ViUInt32 *)attrValue = timeout_ms;
+        break;
+      case VI_ATTR_TCPIP_PORT:
+        *(ViUInt16 *)attrValue = 0;
+        break;
+      case VI_ATTR_WR_BUF_OPER_MODE:
+        *(ViUInt16 *)attrValue = wbuf_mode;
+        break;
+      default:
+        status = VI_ERROR_NSUP_ATTR;
+        break;
+    }
+
+  return status;
+}
+
+ViStatus _VI_FUNC
+viSetAttribute (ViObject vi, ViAttr attrName, ViAttrState attrValue)
+{
+  if (attrName == VI_ATTR_TMO_VALUE)
+    {
+      timeout_ms = (ViUInt32)attrValue;
+      return VI_SUCCESS;
+    }
+  if (attrName == VI_ATTR_WR_BUF_OPER_MODE)
+    {
+      wbuf_mode = (ViUInt16)attrValue;
+      return VI_SUCCESS;
+    }
+  return VI_ERROR_NSUP_ATTR;
+}
+
+ViStatus _VI_FUNC
+viStatusDesc (ViObject vi, ViStatus status, ViChar _VI_FAR desc[])
+{
+  switch (status)
+    {
+      case VI_ERROR_TMO:
+        strcpy (desc, "VI_ERROR_TMO: Timeout expired before operation completed.");
+        break;
+      case VI_ERROR_ABORT:
+        strcpy (desc, "VI_ERROR_ABORT: User abort occurred during transfer.");
+        break;
+      default:
+        sprintf (desc, "visastub status 0x%08lX", (unsigned long)status);
+        break;
+    }
+  return VI_SUCCESS;
+}
+
+ViStatus _VI_FUNC
+viRead (ViSession vi, ViPBuf buf, ViUInt32 cnt, ViPUInt32 retCnt)
+{
+  ViStatus status;
+
+  ViUInt32 n = 0;
+
+  pthread_mutex_lock (&lock);
+  status = take_reply (buf, cnt, &n, NULL);
+  pthread_mutex_unlock (&lock);
+
+  io_delay (n);
+
+  if (retCnt)
+    *retCnt = n;
+  return status;
+}
+
+/* a transfer, taking each line as a command. Without END the last part
+   of a line is kept for the next transfer */
+static ViStatus
+transfer (const char *buf, size_t cnt, int end)
+{
+  const char *p, *last, *nl;
+  char *n;
+
+  io_delay (cnt);
+
+  pthread_mutex_lock (&lock);
+  if (partial_len + cnt > partial_size)
+    {
+      n = realloc (partial, partial_len + cnt);
+      if (! n)
+        {
+          pthread_mutex_unlock (&lock);
+          return VI_ERROR_ALLOC;
+        }
+      partial = n;
+      partial_size = partial_len + cnt;
+    }
+  memcpy (partial + partial_len, buf, cnt);
+  partial_len += cnt;
+
+  p = partial;
+  last = partial + partial_len;
+  while (p < last)
+    {
+      nl = memchr (p, '\n', last - p);
+      if (! nl && ! end)
+        break;
+      nl = nl ? nl + 1 : last;
+      queue_reply (p, nl - p);
+      p = nl;
+    }
+  partial_len = last - p;
+  memmove (partial, p, partial_len);
+  pthread_mutex_unlock (&lock);
+
+  return VI_SUCCESS;
+}
+
+ViStatus _VI_FUNC
+viWrite (ViSession vi, ViConstBuf buf, ViUInt32 cnt, ViPUInt32 retCnt)
+{
+  ViStatus status = transfer ((const char *)buf, cnt, 1);
+
+  if (retCnt)
+    *retCnt = status == VI_SUCCESS ? cnt : 0;
+  return status;
+}
+
+/* a full buffer goes out without END */
+static ViStatus
+send_wbuf (ViSession vi, int end)
+{
+  ViStatus status = VI_SUCCESS;
+
+  if (wbuf_len > 0 || end)
+    status = transfer (wbuf, wbuf_len, end);
+  wbuf_len = 0;
+  return status;
+}
+
+ViStatus _VI_FUNC
+viSetBuf (ViSession vi, ViUInt16 mask, ViUInt32 size)
+{
+  char *p;
+
+  if (size == 0)
+    return VI_ERROR_ALLOC;
+
+  if (mask & VI_WRITE_BUF)
+    {
+      send_wbuf (vi, 1);
+      p = realloc (wbuf, size);
+      if (! p)
+        return VI_ERROR_ALLOC;
+      wbuf = p;
+      wbuf_size = size;
+    }
+  if (mask & VI_READ_BUF)
+    {
+      p = realloc (rbuf, size);
+      if (! p)
+        return VI_ERROR_ALLOC;
+      rbuf = p;
+      rbuf_size = size;
+      rbuf_len = 0;
+    }
+  return VI_SUCCESS;
+}
+
+ViStatus _VI_FUNC
+viBufWrite (ViSession vi, ViConstBuf buf, ViUInt32 cnt, ViPUInt32 retCnt)
+{
+  ViStatus status = VI_SUCCESS;
+  ViUInt32 done = 0;
+  size_t n;
+
+  if (! wbuf && viSetBuf (vi, VI_WRITE_BUF, wbuf_size) != VI_SUCCESS)
+    return VI_ERROR_ALLOC;
+
+  while (done < cnt && status >= VI_SUCCESS)
+    {
+      n = wbuf_size - wbuf_len;
+      if (n > cnt - done)
+        n = cnt - done;
+      memcpy (wbuf + wbuf_len, buf + done, n);
+      wbuf_len += n;
+      done += n;
+      if (wbuf_len == wbuf_size)
+        status = send_wbuf (vi, 0);
+    }
+  if (status >= VI_SUCCESS && wbuf_mode == VI_FLUSH_ON_ACCESS)
+    status = send_wbuf (vi, 1);
+
+  if (retCnt)
+    *retCnt = done;
+  return status;
+}
+
+ViStatus _VI_FUNC
+viBufRead (ViSession vi, ViPBuf buf, ViUInt32 cnt, ViPUInt32 retCnt)
+{
+  ViStatus status;
+  ViUInt32 done = 0, got;
+  size_t n;
+
+  if (! rbuf && viSetBuf (vi, VI_READ_BUF, rbuf_size) != VI_SUCCESS)
+    return VI_ERROR_ALLOC;
+
+  if (retCnt)
+    *retCnt = 0;
+
+  while (done < cnt)
+    {
+      if (rbuf_len == 0)
+        {
+          status = viRead (vi, (ViPBuf)rbuf, rbuf_size, &got);
+          if (status < VI_SUCCESS)
+            {
+              if (retCnt)
+                *retCnt = done;
+              return status;
+            }
+          rbuf_start = 0;
+          rbuf_len = got;
+          rbuf_status = status;
+        }
+
+      n = rbuf_len < cnt - done ? rbuf_len : cnt - done;
+      memcpy (buf + done, rbuf + rbuf_start, n);
+      rbuf_start += n;
+      rbuf_len -= n;
+      done += n;
+
+      /* the end of the message */
+      if (rbuf_len == 0 && rbuf_status != VI_SUCCESS_MAX_CNT)
+        {
+          if (retCnt)
+            *retCnt = done;
+          return VI_SUCCESS;
+        }
+    }
+
+  if (retCnt)
+    *retCnt = done;
+  return VI_SUCCESS_MAX_CNT;
+}
+
+ViStatus _VI_FUNC
+viReadSTB (ViSession vi, ViPUInt16 status)
+{
+  pthread_mutex_lock (&lock);
+  *status = stb | (nmsg > 0 ? 0x10 : 0);
+  stb &= ~0x40;
+  pthread_mutex_unlock (&lock);
+  return VI_SUCCESS;
+}
+
+ViStatus _VI_FUNC
+viClear (ViSession vi)
+{
+  pthread_mutex_lock (&lock);
+  clear_replies ();
+  pthread_mutex_unlock (&lock);
+  return VI_SUCCESS;
+}
+
+ViStatus _VI_FUNC
+viFlush (ViSession vi, ViUInt16 mask)
+{
+  ViStatus status = VI_SUCCESS;
+
+  if (mask & VI_WRITE_BUF)
+    status = send_wbuf (vi, 1);
+  if (mask & VI_WRITE_BUF_DISCARD)
+    wbuf_len = 0;
+  if (mask & (VI_READ_BUF | VI_READ_BUF_DISCARD))
+    {
+      rbuf_len = 0;
+      viClear (vi);
+    }
+  return status;
+}
+
+ViStatus _VI_FUNC
+viAssertTrigger (ViSession vi, ViUInt16 protocol)
+{
+  return VI_SUCCESS;
+}
+
+ViStatus _VI_FUNC
+viEnableEvent (ViSession vi, ViEventType eventType, ViUInt16 mechanism,
+               ViEventFilter context)
+{
+  if (mechanism != VI_QUEUE)
+    return VI_ERROR_INV_MECH;
+
+  pthread_mutex_lock (&lock);
+  if (eventType == VI_EVENT_IO_COMPLETION)
+    io_events = 1;
+  else if (eventType == VI_EVENT_SERVICE_REQ)
+    srq_events = 1;
+  pthread_mutex_unlock (&lock);
+  return VI_SUCCESS;
+}
+
+ViStatus _VI_FUNC
+viDisableEvent (ViSession vi, ViEventType eventType, ViUInt16 mechanism)
+{
+  pthread_mutex_lock (&lock);
+  if (eventType == VI_EVENT_IO_COMPLETION)
+    io_events = 0;
+  else if (eventType == VI_EVENT_SERVICE_REQ)
+    srq_events = 0;
+  pthread_mutex_unlock (&lock);
+  return VI_SUCCESS;
+}
+
+/* called with lock held. Index of the first queued event of the type */
+static int
+find_event (ViEventType type)
+{
+  int i;
+
+  for (i = 0; i < queued; i++)
+    if (type == VI_ALL_ENABLED_EVENTS || queue[i].type == type)
+      return i;
+  return -1;
+}
+
+ViStatus _VI_FUNC
+viDiscardEvents (ViSession vi, ViEventType eventType, ViUInt16 mechanism)
+{
+  int i;
+
+  pthread_mutex_lock (&lock);
+  while ((i = find_event (eventType)) >= 0)
+    memmove (queue + i, queue + i + 1, (--queued - i) * sizeof (queue[0]));
+  pthread_mutex_unlock (&lock);
+  return VI_SUCCESS;
+}
+
+ViStatus _VI_FUNC
+viWaitOnEvent (ViSession vi, ViEventType inEventType, ViUInt32 timeout,
+               ViPEventType outEventType, ViPEvent outContext)
+{
+  struct timespec ts;
+  ViStatus status = VI_SUCCESS;
+  int i;
+
+  pthread_mutex_lock (&lock);
+  if (timeout != VI_TMO_INFINITE)
+    deadline_in (&ts, timeout);
+  while ((i = find_event (inEventType)) < 0)
+    {
+      if (timeout == VI_TMO_IMMEDIATE)
+        break;
+      else if (timeout == VI_TMO_INFINITE)
+        pthread_cond_wait (&changed, &lock);
+      else if (pthread_cond_timedwait (&changed, &lock, &ts) != 0)
+        break;
+    }
+
+  if (i < 0)
+    status = VI_ERROR_TMO;
+  else
+    {
+      if (outEventType)
+        *outEventType = queue[i].type;
+      if (outContext && ntaken < MAX_EVENTS)
+        {
+          *outContext = queue[i].id;
+          taken[ntaken++] = queue[i];
+        }
+      memmove (queue + i, queue + i + 1, (--queued - i) * sizeof (queue[0]));
+    }
+  pthread_mutex_unlock (&lock);
+
+  return status;
+}
+
+static void *
+run_job (void *arg)
+{
+  struct job *j = (struct job *)arg;
+  ViUInt32 count = 0;
+  ViStatus status = VI_SUCCESS;
+  int i;
+
+  usleep (env_us ("VISASTUB_ASYNC_US", 1000));
+
+  pthread_mutex_lock (&lock);
+  if (j->terminated)
+    status = VI_ERROR_ABORT;
+  else if (j->write)
+    {
+      queue_reply ((const char *)j->buf, j->cnt);
+      count = j->cnt;
+    }
+  else
+    status = take_reply (j->buf, j->cnt, &count, &j->terminated);
+
+  if (io_events)
+    queue_event (VI_EVENT_IO_COMPLETION, j->id, status, count);
+
+  for (i = 0; i < MAX_EVENTS; i++)
+    if (jobs[i] == j)
+      jobs[i] = NULL;
+  pthread_cond_broadcast (&changed);
+  pthread_mutex_unlock (&lock);
+
+  free (j);
+  return NULL;
+}
+
+static ViStatus
+start_job (int write, ViBuf buf, ViUInt32 cnt, ViPJobId jobId)
+{
+  pthread_t thread;
+  struct job *j;
+  int i;
+
+  j = calloc (1, sizeof (*j));
+  if (! j)
+    return VI_ERROR_ALLOC;
+
+  pthread_mutex_lock (&lock);
+  for (i = 0; i < MAX_EVENTS; i++)
+    if (! jobs[i])
+      break;
+  if (i == MAX_EVENTS)
+    {
+      pthread_mutex_unlock (&lock);
+      free (j);
+      return VI_ERROR_QUEUE_OVERFLOW;
+    }
+  j->id = next_job++;
+  j->write = write;
+  j->buf = buf;
+  j->cnt = cnt;
+  jobs[i] = j;
+  if (jobId)
+    *jobId = j->id;
+  pthread_mutex_unlock (&lock);
+
+  if (pthread_create (&thread, NULL, run_job, j) != 0)
+    {
+      pthread_mutex_lock (&lock);
+      jobs[i] = NULL;
+      pthread_mutex_unlock (&lock);
+      free (j);
+      return VI_ERROR_SYSTEM_ERROR;
+    }
+  pthread_detach (thread);
+
+  return VI_SUCCESS;
+}
+
+ViStatus _VI_FUNC
+viReadAsync (ViSession vi, ViPBuf buf, ViUInt32 cnt, ViPJobId jobId)
+{
+  return start_job (0, buf, cnt, jobId);
+}
+
+ViStatus _VI_FUNC
+viWriteAsync (ViSession vi, ViConstBuf buf, ViUInt32 cnt, ViPJobId jobId)
+{
+  return start_job (1, (ViBuf)buf, cnt, jobId);
+}
+
+ViStatus _VI_FUNC
+viTerminate (ViObject vi, ViUInt16 degree, ViJobId jobId)
+{
+  ViStatus status = VI_ERROR_INV_JOB_ID;
+  int i;
+
+  pthread_mutex_lock (&lock);
+  for (i = 0; i < MAX_EVENTS; i++)
+    if (jobs[i] && (jobId == VI_NULL || jobs[i]->id == jobId))
+      {
+        jobs[i]->terminated = 1;
+        status = VI_SUCCESS;
+      }
+  pthread_cond_broadcast (&changed);
+  pthread_mutex_unlock (&lock);
+
+  return status;
+}
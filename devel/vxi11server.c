@@ -0,0 +1,513 @@
+/*
+ * Minimal VXI-11 instrument, used by benchvxi11.m to measure the cost of
+ * the vxi11 functions without an instrument.
+ *
+ * Build it from the same vxi11.x as the package, and run it alongside
+ * rpcbind:
+ *
+ *   rpcgen -M -m -o vxi11_svc.c ../src/vxi11/vxi11.x
+ *   rpcgen -M -c -o vxi11_xdr.c ../src/vxi11/vxi11.x
+ *   rpcgen -M -h -o vxi11.h ../src/vxi11/vxi11.x
+ *   rpcgen -M -l -o vxi11_clnt.c ../src/vxi11/vxi11.x
+ *   gcc -O2 -I/usr/include/tirpc -o vxi11server vxi11server.c vxi11_svc.c vxi11_xdr.c vxi11_clnt.c -ltirpc
+ *   ./vxi11server &
+ *   octave --eval "benchvxi11"
+ *
+ * A write of a command ending in '?' queues a reply for the next read.
+ * The reply to "WAV?" is VXI11SERVER_WAVE (default 1048576) bytes long,
+ * for measuring large transfers.
+ * VXI11SERVER_REPORT set in the environment prints the number of links
+ * created and destroyed on exit or SIGINT.
+ *
+ * "*SRQ" requests service on the interrupt channel VXI11SERVER_SRQ_MS
+ * (default 100) milliseconds later, if service requests are enabled.
+ * After "HANG?" the next read blocks until the io timeout, or until it is
+ * ended by device_abort, for exercising the abort channel.
+ */
+
+#include "vxi11.h"
+
+#include <rpc/pmap_clnt.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define MAX_LINKS 64
+
+struct link_state
+{
+  int in_use;
+  char *reply;
+  size_t reply_pos;
+  size_t reply_len;
+  int hang;
+  int aborted;
+  int srq_enabled;
+  char srq_handle[40];
+  u_int srq_handle_len;
+  double srq_at;
+};
+
+static struct link_state links[MAX_LINKS];
+static long links_created, links_destroyed, writes, reads, aborts, srqs;
+static int abort_port;
+static CLIENT *intr_client;
+
+extern void device_core_1 (struct svc_req *, SVCXPRT *);
+extern void device_async_1 (struct svc_req *, SVCXPRT *);
+
+static double
+now_ms (void)
+{
+  struct timespec ts;
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+static struct link_state *
+find_link (Device_Link lid)
+{
+  if (lid < 0 || lid >= MAX_LINKS || ! links[lid].in_use)
+    return NULL;
+  return &links[lid];
+}
+
+static void
+report (void)
+{
+  fprintf (stderr, "vxi11server: %ld links created, %ld destroyed, %ld writes, %ld reads, %ld aborts, %ld srqs\n",
+           links_created, links_destroyed, writes, reads, aborts, srqs);
+}
+
+static void
+on_signal (int sig)
+{
+  exit (0);
+}
+
+bool_t
+create_link_1_svc (Create_LinkParms *parms, Create_LinkResp *resp, struct svc_req *req)
+{
+  int i;
+
+  memset (resp, 0, sizeof (*resp));
+
+  for (i = 0; i < MAX_LINKS && links[i].in_use; i++)
+    ;
+
+  if (i == MAX_LINKS)
+    {
+      resp->error = VXI11_ERR_RESOURCES;
+      return TRUE;
+    }
+
+  memset (&links[i], 0, sizeof (links[i]));
+  links[i].in_use = 1;
+  links_created++;
+
+  resp->lid = i;
+  resp->abortPort = abort_port;
+  resp->maxRecvSize = 1024*1024;
+  return TRUE;
+}
+
+bool_t
+destroy_link_1_svc (Device_Link *lid, Device_Error *resp, struct svc_req *req)
+{
+  struct link_state *l = find_link (*lid);
+
+  resp->error = l ? VXI11_ERR_SUCCESS : VXI11_ERR_LINKINVAL;
+  if (l)
+    {
+      free (l->reply);
+      l->in_use = 0;
+      links_destroyed++;
+    }
+  return TRUE;
+}
+
+bool_t
+device_write_1_svc (Device_WriteParms *parms, Device_WriteResp *resp, struct svc_req *req)
+{
+  struct link_state *l = find_link (parms->lid);
+  const char *cmd = parms->data.data_val;
+  u_int len = parms->data.data_len;
+
+  memset (resp, 0, sizeof (*resp));
+  if (! l)
+    {
+      resp->error = VXI11_ERR_LINKINVAL;
+      return TRUE;
+    }
+
+  writes++;
+  resp->size = len;
+
+  while (len > 0 && (cmd[len-1] == '\n' || cmd[len-1] == '\r'))
+    len--;
+
+  free (l->reply);
+  l->reply = NULL;
+  l->reply_pos = l->reply_len = 0;
+  l->hang = 0;
+
+  if (len == 4 && strncmp (cmd, "*SRQ", 4) == 0)
+    {
+      const char *v = getenv ("VXI11SERVER_SRQ_MS");
+      if (l->srq_enabled)
+        l->srq_at = now_ms () + (v ? atof (v) : 100);
+    }
+  else if (len == 5 && strncmp (cmd, "HANG?", 5) == 0)
+    l->hang = 1;
+  else if (len == 4 && strncmp (cmd, "WAV?", 4) == 0)
+    {
+      const char *v = getenv ("VXI11SERVER_WAVE");
+      size_t i;
+
+      l->reply_len = v ? strtoul (v, NULL, 0) : 1048576;
+      l->reply = malloc (l->reply_len);
+      for (i = 0; i < l->reply_len; i++)
+        l->reply[i] = (char) (i & 0x7f);
+    }
+  else if (len > 0 && cmd[len-1] == '?')
+    {
+      l->reply = strdup ("+1.23456789E+00\n");
+      l->reply_len = strlen (l->reply);
+    }
+
+  return TRUE;
+}
+
+bool_t
+device_read_1_svc (Device_ReadParms *parms, Device_ReadResp *resp, struct svc_req *req)
+{
+  struct link_state *l = find_link (parms->lid);
+  size_t n, left;
+  const char *term = NULL;
+
+  memset (resp, 0, sizeof (*resp));
+  if (! l)
+    {
+      resp->error = VXI11_ERR_LINKINVAL;
+      return TRUE;
+    }
+
+  reads++;
+
+  if (l->hang)
+    {
+      /* serve the other connections, which include the abort channel,
+         until the io timeout or an abort */
+      double end = now_ms () + parms->io_timeout;
+      int core_fd = req->rq_xprt->xp_fd;
+
+      l->hang = 0;
+      l->aborted = 0;
+      while (! l->aborted && now_ms () < end)
+        {
+          struct pollfd fds[svc_max_pollfd > 0 ? svc_max_pollfd : 1];
+          int i, ret;
+
+          for (i = 0; i < svc_max_pollfd; i++)
+            {
+              fds[i] = svc_pollfd[i];
+              if (fds[i].fd == core_fd)
+                fds[i].fd = -1;
+            }
+
+          ret = poll (fds, svc_max_pollfd, 50);
+          if (ret > 0)
+            svc_getreq_poll (fds, ret);
+        }
+
+      resp->error = l->aborted ? VXI11_ERR_ABORT : VXI11_ERR_IOTIMEOUT;
+      return TRUE;
+    }
+
+  left = l->reply_len - l->reply_pos;
+  if (left == 0)
+    {
+      resp->error = VXI11_ERR_IOTIMEOUT;
+      return TRUE;
+    }
+
+  n = left < parms->requestSize ? left : parms->requestSize;
+  if (parms->flags & VXI11_FLAG_TERMCHRSET)
+    {
+      term = memchr (l->reply + l->reply_pos, parms->termChar, n);
+      if (term)
+        n = term - (l->reply + l->reply_pos) + 1;
+    }
+
+  resp->data.data_val = malloc (n);
+  memcpy (resp->data.data_val, l->reply + l->reply_pos, n);
+  resp->data.data_len = n;
+  l->reply_pos += n;
+
+  if (l->reply_pos == l->reply_len)
+    resp->reason = VXI11_REASON_END;
+  else if (term)
+    resp->reason = VXI11_REASON_CHR;
+  else
+    resp->reason = VXI11_REASON_REQCNT;
+  return TRUE;
+}
+
+static bool_t
+not_supported (Device_Error *resp)
+{
+  resp->error = VXI11_ERR_NOTSUPP;
+  return TRUE;
+}
+
+bool_t
+device_readstb_1_svc (Device_GenericParms *parms, Device_ReadStbResp *resp, struct svc_req *req)
+{
+  memset (resp, 0, sizeof (*resp));
+  resp->error = find_link (parms->lid) ? VXI11_ERR_SUCCESS : VXI11_ERR_LINKINVAL;
+  return TRUE;
+}
+
+bool_t
+device_trigger_1_svc (Device_GenericParms *parms, Device_Error *resp, struct svc_req *req)
+{
+  resp->error = find_link (parms->lid) ? VXI11_ERR_SUCCESS : VXI11_ERR_LINKINVAL;
+  return TRUE;
+}
+
+bool_t
+device_clear_1_svc (Device_GenericParms *parms, Device_Error *resp, struct svc_req *req)
+{
+  struct link_state *l = find_link (parms->lid);
+
+  resp->error = l ? VXI11_ERR_SUCCESS : VXI11_ERR_LINKINVAL;
+  if (l)
+    l->reply_pos = l->reply_len;
+  return TRUE;
+}
+
+bool_t
+device_remote_1_svc (Device_GenericParms *parms, Device_Error *resp, struct svc_req *req)
+{
+  return not_supported (resp);
+}
+
+bool_t
+device_local_1_svc (Device_GenericParms *parms, Device_Error *resp, struct svc_req *req)
+{
+  return not_supported (resp);
+}
+
+bool_t
+device_lock_1_svc (Device_LockParms *parms, Device_Error *resp, struct svc_req *req)
+{
+  return not_supported (resp);
+}
+
+bool_t
+device_unlock_1_svc (Device_Link *lid, Device_Error *resp, struct svc_req *req)
+{
+  return not_supported (resp);
+}
+
+bool_t
+device_enable_srq_1_svc (Device_EnableSrqParms *parms, Device_Error *resp, struct svc_req *req)
+{
+  struct link_state *l = find_link (parms->lid);
+
+  resp->error = l ? VXI11_ERR_SUCCESS : VXI11_ERR_LINKINVAL;
+  if (l)
+    {
+      u_int n = parms->handle.handle_len;
+      if (n > sizeof (l->srq_handle))
+        n = sizeof (l->srq_handle);
+
+      l->srq_enabled = parms->enable;
+      memcpy (l->srq_handle, parms->handle.handle_val, n);
+      l->srq_handle_len = n;
+      l->srq_at = 0;
+    }
+  return TRUE;
+}
+
+bool_t
+device_docmd_1_svc (Device_DocmdParms *parms, Device_DocmdResp *resp, struct svc_req *req)
+{
+  memset (resp, 0, sizeof (*resp));
+  resp->error = VXI11_ERR_NOTSUPP;
+  return TRUE;
+}
+
+bool_t
+create_intr_chan_1_svc (Device_RemoteFunc *parms, Device_Error *resp, struct svc_req *req)
+{
+  struct sockaddr_in addr;
+  int sock = RPC_ANYSOCK;
+
+  if (parms->progFamily != DEVICE_TCP)
+    return not_supported (resp);
+
+  if (intr_client)
+    {
+      resp->error = VXI11_ERR_CHANEST;
+      return TRUE;
+    }
+
+  memset (&addr, 0, sizeof (addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl (parms->hostAddr);
+  addr.sin_port = htons (parms->hostPort);
+
+  intr_client = clnttcp_create (&addr, parms->progNum, parms->progVers, &sock, 0, 0);
+  resp->error = intr_client ? VXI11_ERR_SUCCESS : VXI11_ERR_NOCHAN;
+  return TRUE;
+}
+
+bool_t
+destroy_intr_chan_1_svc (void *parms, Device_Error *resp, struct svc_req *req)
+{
+  if (! intr_client)
+    {
+      resp->error = VXI11_ERR_NOCHAN;
+      return TRUE;
+    }
+
+  clnt_destroy (intr_client);
+  intr_client = NULL;
+  resp->error = VXI11_ERR_SUCCESS;
+  return TRUE;
+}
+
+bool_t
+device_abort_1_svc (Device_Link *lid, Device_Error *resp, struct svc_req *req)
+{
+  struct link_state *l = find_link (*lid);
+
+  resp->error = l ? VXI11_ERR_SUCCESS : VXI11_ERR_LINKINVAL;
+  if (l)
+    {
+      l->aborted = 1;
+      aborts++;
+    }
+  return TRUE;
+}
+
+bool_t
+device_intr_srq_1_svc (Device_SrqParms *parms, void *resp, struct svc_req *req)
+{
+  return FALSE;
+}
+
+/* send the service requests that are due, returning the time in ms to
+   the next one or -1 */
+static int
+send_srqs (void)
+{
+  double t = now_ms (), next = -1;
+  int i;
+
+  for (i = 0; i < MAX_LINKS; i++)
+    {
+      struct link_state *l = &links[i];
+      Device_SrqParms parms;
+      char dummy;
+
+      if (! l->in_use || l->srq_at == 0)
+        continue;
+
+      if (l->srq_at > t)
+        {
+          if (next < 0 || l->srq_at - t < next)
+            next = l->srq_at - t;
+          continue;
+        }
+
+      l->srq_at = 0;
+      if (! intr_client || ! l->srq_enabled)
+        continue;
+
+      parms.handle.handle_len = l->srq_handle_len;
+      parms.handle.handle_val = l->srq_handle;
+      if (device_intr_srq_1 (&parms, &dummy, intr_client) == RPC_SUCCESS)
+        srqs++;
+    }
+
+  return next < 0 ? -1 : (int) next + 1;
+}
+
+int
+device_async_1_freeresult (SVCXPRT *transp, xdrproc_t xdr_result, caddr_t result)
+{
+  xdr_free (xdr_result, result);
+  return 1;
+}
+
+int
+device_intr_1_freeresult (SVCXPRT *transp, xdrproc_t xdr_result, caddr_t result)
+{
+  return 1;
+}
+
+int
+device_core_1_freeresult (SVCXPRT *transp, xdrproc_t xdr_result, caddr_t result)
+{
+  xdr_free (xdr_result, result);
+  return 1;
+}
+
+int
+main (int argc, char **argv)
+{
+  SVCXPRT *transp, *abort_transp;
+
+  if (getenv ("VXI11SERVER_REPORT"))
+    atexit (report);
+  signal (SIGINT, on_signal);
+  signal (SIGTERM, on_signal);
+
+  pmap_unset (DEVICE_CORE, DEVICE_CORE_VERSION);
+
+  transp = svctcp_create (RPC_ANYSOCK, 0, 0);
+  if (transp == NULL)
+    {
+      fprintf (stderr, "vxi11server: cannot create tcp service\n");
+      return 1;
+    }
+
+  if (! svc_register (transp, DEVICE_CORE, DEVICE_CORE_VERSION, device_core_1, IPPROTO_TCP))
+    {
+      fprintf (stderr, "vxi11server: cannot register with the portmapper, is rpcbind running?\n");
+      return 1;
+    }
+
+  /* the abort channel is found from the create_link reply, not the
+     portmapper */
+  abort_transp = svctcp_create (RPC_ANYSOCK, 0, 0);
+  if (abort_transp == NULL
+      || ! svc_register (abort_transp, DEVICE_ASYNC, DEVICE_ASYNC_VERSION, device_async_1, 0))
+    {
+      fprintf (stderr, "vxi11server: cannot create the abort channel\n");
+      return 1;
+    }
+  abort_port = abort_transp->xp_port;
+
+  fprintf (stderr, "vxi11server: listening on port %d\n", transp->xp_port);
+
+  while (1)
+    {
+      struct pollfd fds[svc_max_pollfd > 0 ? svc_max_pollfd : 1];
+      int ret;
+
+      memcpy (fds, svc_pollfd, svc_max_pollfd * sizeof (fds[0]));
+      ret = poll (fds, svc_max_pollfd, send_srqs ());
+      if (ret > 0)
+        svc_getreq_poll (fds, ret);
+    }
+
+  return 1;
+}
@@ -0,0 +1,46 @@
+## Copyright (C) 2026 John Donoghue <john.donoghue@ieee.org>
+##
+## This program is free software; you can redistribute it and/or modify it under
+## the terms of the GNU General Public License as published by the Free Software
+## Foundation; either version 3 of the License, or (at your option) any later
+## version.
+##
+## This program is distributed in the hope that it will be useful, but WITHOUT
+## ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+## FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+## details.
+##
+## You should have received a copy of the GNU General Public License along with
+## this program; if not, see <http://www.gnu.org/licenses/>.
+
+## -*- texinfo -*-
+## @deftypefn {} {@var{data} =} read (@var{obj})
+## @deftypefnx {} {@var{data} =} read (@var{obj}, @var{size})
+## @deftypefnx {} {@var{data} =} read (@var{obj}, @var{size}, @var{datatype})
+## Reads @var{data} from HiSLIP instrument
+##
+## @subsubheading Inputs
+## @var{obj} is a hislip object.@*
+## @var{size} Number of values to read. (Default: the rest of the message).@*
+## @var{datatype} datatype of data.@*
+##
+## A read stops early at the END of a message.
+##
+## @subsubheading Outputs
+## @var{data} data read.@*
+##
+## @end deftypefn
+
+function data = read (obj, cnt, datatype)
+
+  if (nargin < 2)
+    cnt = -1;
+  endif
+
+  if (nargin < 3)
+    data = __hislip_read__ (obj, cnt, get(obj, 'Timeout')*1000);
+  else
+    data = __hislip_read__ (obj, cnt, get(obj, 'Timeout')*1000, datatype);
+  endif
+
+endfunction
@@ -0,0 +1,98 @@
+## Copyright (C) 2026 John Donoghue <john.donoghue@ieee.org>
+##
+## This program is free software; you can redistribute it and/or modify it under
+## the terms of the GNU General Public License as published by the Free Software
+## Foundation; either version 3 of the License, or (at your option) any later
+## version.
+##
+## This program is distributed in the hope that it will be useful, but WITHOUT
+## ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+## FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+## details.
+##
+## You should have received a copy of the GNU General Public License along with
+## this program; if not, see <http://www.gnu.org/licenses/>.
+
+## -*- texinfo -*-
+## @deftypefn {} set (@var{obj}, @var{property},@var{value})
+## @deftypefnx {} set (@var{obj}, @var{property},@var{value},@dots{})
+## Set the properties of hislip object.
+##
+## @subsubheading Inputs
+## If @var{property} is a cell so must be @var{value}, it sets the values of
+## all matching properties.
+##
+## The function also accepts property-value pairs.
+##
+## @subsubheading Properties
+## @table @var
+## @item 'Name'
+## Set the name for the hislip session.
+##
+## @item 'UserData'
+## Set user data for the hislip session.
+##
+## @item 'Timeout'
+## Set the timeout value in seconds. Value of -1 means a
+## blocking call.
+##
+## @item 'Tag'
+## Set user tag to identify the session
+##
+## @item 'Overlapped'
+## true for overlapped mode, where several queries may be sent before the
+## responses are read, or false for synchronized mode. Changing the mode
+## does a device clear.
+##
+## @item 'ByteOrder'
+## 'little-endian' or 'big-endian' order of the values written and read
+## with a datatype.
+##
+## @end table
+##
+## @subsubheading Outputs
+## None
+##
+## @seealso{@@octave_hislip/get}
+## @end deftypefn
+
+function set (hislip, varargin)
+
+  properties = {'Timeout', 'Name', 'UserData', 'Tag', ...
+                'Overlapped', 'ByteOrder'};
+
+  if numel (varargin) == 1 && isstruct (varargin{1})
+    property = fieldnames (varargin{1});
+    func  = @(x) getfield (varargin{1}, x);
+    value = cellfun (func, property, 'UniformOutput', false);
+  elseif numel (varargin) == 2 && iscell (varargin{1}) && iscell (varargin{2})
+    %% The arguments are two cells, expecting fields and values.
+    property = varargin{1};
+    value = varargin{2};
+  else
+    property = {varargin{1:2:end}};
+    value = {varargin{2:2:end}};
+  endif
+
+  if numel (property) != numel (value)
+    error ('hislip:set:InvalidArgument', ...
+           'PROPERIES and VALUES must have the same number of elements.');
+  endif
+
+  valid     = ismember (property, properties);
+  not_found = {property{!valid}};
+
+  if !isempty (not_found)
+    msg = @(x) error ("hislip:set:InvalidArgument", ...
+                      "Property '%s' not found in hislip object.\n",x);
+    cellfun (msg, not_found);
+  endif
+
+  property = {property{valid}};
+  value = {value{valid}};
+
+  for i=1:length(property)
+    __hislip_properties__ (hislip, property{i}, value{i});
+  endfor
+
+endfunction
@@ -0,0 +1,39 @@
+## Copyright (C) 2026 John Donoghue <john.donoghue@ieee.org>
+##
+## This program is free software; you can redistribute it and/or modify it under
+## the terms of the GNU General Public License as published by the Free Software
+## Foundation; either version 3 of the License, or (at your option) any later
+## version.
+##
+## This program is distributed in the hope that it will be useful, but WITHOUT
+## ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+## FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+## details.
+##
+## You should have received a copy of the GNU General Public License along with
+## this program; if not, see <http://www.gnu.org/licenses/>.
+
+## -*- texinfo -*-
+## @deftypefn {} {@var{numbytes} = } write (@var{obj}, @var{data})
+## @deftypefnx {} {@var{numbytes} =} write (@var{obj}, @var{data}, @var{datatype})
+## Writes @var{data} to HiSLIP instrument as one message
+##
+## @subsubheading Inputs
+## @var{obj} is a hislip object.@*
+## @var{data} data to write.@*
+## @var{datatype} datatype of data. If not specified, it defaults to "uint8".@*
+##
+## @subsubheading Outputs
+## returns number of bytes written.
+## @end deftypefn
+
+function numbytes = write(obj, data, datatype)
+
+  if (nargin < 2)
+    print_usage ();
+  elseif (nargin < 3)
+    datatype = "uint8";
+  endif
+
+  numbytes = __hislip_write__ (obj, data, datatype);
+endfunction
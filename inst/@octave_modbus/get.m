@@ -34,7 +34,7 @@ function retval = get (dev, property)
   if strcmp( __modbus_properties__ (dev, "Transport"),  "tcpip")
       properties = {'Type', 'WordOrder', 'ByteOrder', 'Name', ...
 		'Timeout', 'UserData', 'Transport', 'Port', ...
-                'DeviceAddress', 'NumRetries' };
+                'DeviceAddress', 'NumRetries', 'PipelineDepth' };
   else
       properties = {'Type', 'WordOrder', 'ByteOrder', 'Name', ...
 		'Timeout', 'UserData', 'Transport', 'Port', ...
@@ -24,6 +24,9 @@
 ## @var{address} - address to start reading from.
 ##
 ## @var{count} - number of elements to read. If not provided, count is 1.
+## Reads of more registers or bits than a single request allows (125
+## registers or 2000 bits) are split into several requests, which over
+## tcpip are sent PipelineDepth at a time.
 ##
 ## @var{serverId} - address to send to (0-247). Default of 1 is used if not specified.
 ##
@@ -99,11 +102,11 @@ function data = read (dev, target, address, count, serverid, precision)
 
   switch (target)
   case "coils"
-    # single bit output bits (count = 1 .. 2000)
+    # single bit output bits (count = 1 .. 2000 per request)
   case "inputs"
     # single bit input regs
   case "inputregs"
-    # 16 bit input read regs (count = 1 ... 125)
+    # 16 bit input read regs (count = 1 ... 125 per request)
   case "holdingregs"
     # 16 bit read/write reg
   otherwise
@@ -47,6 +47,9 @@
 ## @item 'UserData'
 ## Set the userdata value
 ##
+## @item 'PipelineDepth'
+## Set the number of requests sent before waiting for their responses
+##
 ## @end table
 ##
 ## @subsubheading Outputs
@@ -58,7 +61,7 @@
 function set (dev, varargin)
 
   properties = {'Name', 'Timeout', 'ByteOrder', 'WordOrder', ...
-                'UserData', 'NumRetries'};
+                'UserData', 'NumRetries', 'PipelineDepth'};
 
   if numel (varargin) == 1 && isstruct (varargin{1})
     property = fieldnames (varargin{1});
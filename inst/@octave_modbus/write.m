@@ -22,7 +22,9 @@
 ##
 ## @var{address} - address to start reading from.
 ##
-## @var{data} - data to write.
+## @var{data} - data to write. Writes of more registers or coils than a
+## single request allows (123 registers or 1968 coils) are split into
+## several requests.
 ##
 ## @var{serverId} - address to send to (0-247). Default of 1 is used if not specified.
 ##
@@ -92,7 +94,7 @@ function write (dev, target, address, data, serverid, precision)
 
   switch (target)
   case "coils"
-    # single bit output bits (count = 1 .. 2000)
+    # single bit output bits (count = 1 .. 1968 per request)
     data = uint8(data);
   case "holdingregs"
     # 16 bit read/write reg
@@ -17,6 +17,9 @@
 ## Write data @var{values} to the modbus device @var{dev} holding registers starting at address @var{writeAddress}
 ## and then read @var{readCount} register values starting at address @var{readAddress}.
 ##
+## More than 121 values or 125 reads are split into several requests, with
+## all of the writes made before any of the reads.
+##
 ## @subsubheading Inputs
 ## @var{dev} - connected modbus device
 ##
@@ -0,0 +1,45 @@
+## Copyright (C) 2026 John Donoghue
+##
+## This program is free software; you can redistribute it and/or modify it under
+## the terms of the GNU General Public License as published by the Free Software
+## Foundation; either version 3 of the License, or (at your option) any later
+## version.
+##
+## This program is distributed in the hope that it will be useful, but WITHOUT
+## ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+## FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+## details.
+##
+## You should have received a copy of the GNU General Public License along with
+## this program; if not, see <http://www.gnu.org/licenses/>.
+
+## -*- texinfo -*-
+## @deftypefn {} {} configureCallback (@var{serial}, "off")
+## @deftypefnx {} {} configureCallback (@var{serial}, "terminator", @var{fcn})
+## @deftypefnx {} {} configureCallback (@var{serial}, "byte", @var{count}, @var{fcn})
+## Set the BytesAvailableFcn callback of a serialport object
+##
+## @subsubheading Inputs
+## @var{serial} - serialport object@*
+## @var{count} - number of bytes received between each call of @var{fcn}@*
+## @var{fcn} - function handle called as @var{fcn} (@var{serial}, @var{evt})@*
+##
+## Setting a callback switches ReadAsyncMode to "continuous", so data is read
+## in the background as it arrives. Callbacks are run when octave is idle at
+## the prompt and whenever the object is read.
+##
+## @subsubheading Outputs
+## None
+##
+## @seealso{serialport}
+## @end deftypefn
+
+function configureCallback (serial, varargin)
+
+  if nargin < 2
+    print_usage ();
+  endif
+
+  __srlp_properties__ (serial, '__configurecallback__', varargin{:});
+
+endfunction
@@ -33,7 +33,9 @@ function retval = get (serial, property)
 
   properties = {'Port', 'BaudRate', 'NumBytesAvailable', 'NumBytesWritten', ...
 		'ByteOrder', 'DataBits', 'StopBits', 'Parity', 'FlowControl', ...
-		'Timeout', 'Terminator', 'UserData', 'Tag'};
+		'Timeout', 'Terminator', 'UserData', 'Tag', ...
+		'ReadAsyncMode', 'BytesAvailableFcn', 'BytesAvailableFcnCount', ...
+		'BytesAvailableFcnMode', 'InputBufferSize', 'NumBytesDropped'};
 
   if (nargin == 1)
     property = properties;
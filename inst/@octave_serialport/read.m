@@ -42,77 +42,6 @@ function data = read (dev, count, precision)
     error ("Expected precision to be a character type");
   endif
 
-  toread = count;
+  data = __srlp_read__ (dev, count, precision);
 
-  switch (precision)
-  case {"string"}
-    toclass = "char";
-    tosize = 1;
-  case {"char" "schar" "int8"}
-    toclass = "int8";
-    tosize = 1;
-  case {"uchar" "uint8"}
-    toclass = "uint8";
-    tosize = 1;
-  case {"int16" "short"}
-    toclass = "int16";
-    tosize = 2;
-    toread = toread * 2;
-  case {"uint16" "ushort"}
-    toclass = "uint16";
-    tosize = 2;
-    toread = toread * 2;
-  case {"int32" "int"}
-    toclass = "int32";
-    tosize = 4;
-    toread = toread * 4;
-  case {"uint32" "uint"}
-    toclass = "uint32";
-    tosize = 4;
-    toread = toread * 4;
-  case {"long" "int64"}
-    toclass = "int64";
-    toread = toread * 8;
-    tosize = 8;
-  case {"ulong" "uint64"}
-    toclass = "uint64";
-    toread = toread * 8;
-    tosize = 8;
-  case {"single" "float" "float32"}
-    toclass = "single";
-    tosize = 4;
-    toread = toread * 4;
-  case {"double" "float64"}
-    toclass = "double";
-    tosize = 8;
-    toread = toread * 8;
-  otherwise
-    error ("precision not supported");
-  endswitch
-
-  eoi=0; tmp=[]; count=0;
-  while ((!eoi) && (toread > 0))
-    tmp1 = __srlp_read__ (dev, toread);
-    if !isempty(tmp1)
-      wasread = numel(tmp1);
-      count = count + wasread;
-      toread = toread - wasread;
-    else
-      break;
-    endif
-    tmp = [tmp tmp1];
-  endwhile
-
-  data = typecast(tmp,toclass);
-
-  if tosize > 1
-    [~,~,endian] = computer();
-    e = upper(dev.ByteOrder);
-
-    if e(1) != endian
-      # need change endian
-      data = swapbytes(data);
-    endif
-  endif
- 
 endfunction
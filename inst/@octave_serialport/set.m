@@ -59,6 +59,24 @@
 ## @item 'dataterminalready'
 ## Set the dataterminalready (DTR) line.
 ##
+## @item 'readasyncmode'
+## 'continuous' to read data in the background as it arrives, or 'manual'
+## to read it only when requested.
+##
+## @item 'bytesavailablefcn'
+## Function handle called as fcn (obj, evt) when data is available,
+## according to 'BytesAvailableFcnMode'.
+##
+## @item 'bytesavailablefcnmode'
+## 'off', 'byte' to call the function each time 'BytesAvailableFcnCount'
+## bytes are received, or 'terminator' to call it for each terminator.
+##
+## @item 'bytesavailablefcncount'
+## Number of bytes for 'byte' mode callbacks.
+##
+## @item 'inputbuffersize'
+## Size in bytes of the buffer used by the background reader.
+##
 ## @end table
 ##
 ## @subsubheading Outputs
@@ -70,7 +88,9 @@
 function set (serial, varargin)
 
   properties = {'name', 'baudrate','databits','parity','stopbits','timeout', ...
-                'flowcontrol', 'userdata', 'tag'};
+                'flowcontrol', 'userdata', 'tag', 'readasyncmode', ...
+                'bytesavailablefcn', 'bytesavailablefcncount', ...
+                'bytesavailablefcnmode', 'inputbuffersize'};
 
   if numel (varargin) == 1 && isstruct (varargin{1})
     property = fieldnames (varargin{1});
@@ -35,49 +35,14 @@ function numbytes = write(obj, data, precision)
     precision = [];
   endif
 
-  switch (precision)
-    case {"char" "schar" "int8"}
-      data = int8 (data);
-    case {"uchar" "uint8"}
-      data = uint8 (data);
-    case {"int16" "short"}
-      data = int16 (data);
-    case {"uint16" "ushort"}
-      data = uint16 (data);
-    case {"int32" "int"}
-      data = int32 (data);
-    case {"uint32" "uint"}
-      data = uint32 (data);
-    case {"long" "int64"}
-      data = int64 (data);
-    case {"ulong" "uint64"}
-      data = uint64 (data);
-    case {"single" "float" "float32"}
-      data = single (data);
-    case {"double" "float64"}
-      data = double (data);
-    case []
-      %% use data as it is
-    otherwise
-    error ("precision not supported");
-  endswitch
+  if isempty (precision)
+    precision = class (data);
+  endif
 
   if length(data) == 0
     numbytes = 0;
   else
-    # if a data element > 1 byte, need handle endian
-    tosize = length(typecast(data(1),'uint8'));
-    if tosize > 1
-      [~,~,endian] = computer();
-      e = upper(obj.ByteOrder);
-
-      if e(1) != endian
-        # need change endian
-        data = swapbytes(data);
-      endif
-    endif
- 
-    numbytes = __srlp_write__ (obj, typecast(data,'uint8'));
+    numbytes = __srlp_write__ (obj, data, precision);
   endif
 
 endfunction
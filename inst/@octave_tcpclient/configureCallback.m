@@ -0,0 +1,65 @@
+## Copyright (C) 2026 John Donoghue
+##
+## This program is free software; you can redistribute it and/or modify it under
+## the terms of the GNU General Public License as published by the Free Software
+## Foundation; either version 3 of the License, or (at your option) any later
+## version.
+##
+## This program is distributed in the hope that it will be useful, but WITHOUT
+## ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+## FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+## details.
+##
+## You should have received a copy of the GNU General Public License along with
+## this program; if not, see <http://www.gnu.org/licenses/>.
+
+## -*- texinfo -*-
+## @deftypefn {} {} configureCallback (@var{tcp}, "off")
+## @deftypefnx {} {} configureCallback (@var{tcp}, "terminator", @var{fcn})
+## @deftypefnx {} {} configureCallback (@var{tcp}, "byte", @var{count}, @var{fcn})
+## Set the BytesAvailableFcn callback of a tcpclient object
+##
+## @subsubheading Inputs
+## @var{tcp} - tcpclient object@*
+## @var{count} - number of bytes received between each call of @var{fcn}@*
+## @var{fcn} - function handle called as @var{fcn} (@var{tcp}, @var{evt})@*
+##
+## Setting a callback switches ReadAsyncMode to "continuous", so data is read
+## in the background as it arrives. Callbacks are run when octave is idle at
+## the prompt and whenever the object is read.
+##
+## @subsubheading Outputs
+## None
+##
+## @seealso{tcpclient}
+## @end deftypefn
+
+function configureCallback (tcp, varargin)
+
+  if nargin < 2
+    print_usage ();
+  endif
+
+  __tcpclient_properties__ (tcp, 'configurecallback', varargin{:});
+
+endfunction
+
+%!test
+%! s = tcpserver (0);
+%! c = tcpclient ("127.0.0.1", s.ServerPort, 'Timeout', 1);
+%! st = s.Connected;
+%! c.UserData = 0;
+%! configureCallback (c, "byte", 4, @(o, e) set (o, "UserData", o.UserData + 1));
+%! assert (c.ReadAsyncMode, "continuous");
+%! assert (c.BytesAvailableFcnMode, "byte");
+%! assert (c.BytesAvailableFcnCount, 4);
+%! write (s, uint8 (1:8));
+%! pause (0.5);
+%! assert (c.NumBytesAvailable, 8);
+%! __tcpclient_async_callbacks__ ();
+%! assert (c.UserData, 2);
+%! assert (read (c, 8), uint8 (1:8));
+%! configureCallback (c, "off");
+%! assert (c.BytesAvailableFcnMode, "off");
+%! c.ReadAsyncMode = "manual";
+%! clear c s
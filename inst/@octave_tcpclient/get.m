@@ -34,7 +34,9 @@ function retval = get (tcpclient, property)
   properties = {'Name', 'Address', 'Port', ...
                 'Type', 'Status', 'Timeout', 'UserData', ...
 		'NumBytesAvailable', 'NumBytesWritten', ...
-		'Terminator', 'EnableTransferDelay', 'Tag' };
+		'Terminator', 'EnableTransferDelay', 'Tag', ...
+		'ReadAsyncMode', 'BytesAvailableFcn', 'BytesAvailableFcnCount', ...
+		'BytesAvailableFcnMode', 'InputBufferSize', 'NumBytesDropped' };
 
   if (nargin == 1)
     property = properties;
@@ -39,6 +39,24 @@
 ## @item 'Tag'
 ## Set user tag to identify the port
 ##
+## @item 'ReadAsyncMode'
+## 'continuous' to read data in the background as it arrives, or 'manual'
+## to read it only when requested.
+##
+## @item 'BytesAvailableFcn'
+## Function handle called as fcn (obj, evt) when data is available,
+## according to 'BytesAvailableFcnMode'.
+##
+## @item 'BytesAvailableFcnMode'
+## 'off', 'byte' to call the function each time 'BytesAvailableFcnCount'
+## bytes are received, or 'terminator' to call it for each terminator.
+##
+## @item 'BytesAvailableFcnCount'
+## Number of bytes for 'byte' mode callbacks.
+##
+## @item 'InputBufferSize'
+## Size in bytes of the buffer used by the background reader.
+##
 ## @end table
 ##
 ## @subsubheading Outputs
@@ -49,7 +67,9 @@
 
 function set (tcpclient, varargin)
 
-  properties = {'Timeout', 'Name', 'UserData', 'Tag' };
+  properties = {'Timeout', 'Name', 'UserData', 'Tag', ...
+                'ReadAsyncMode', 'BytesAvailableFcn', 'BytesAvailableFcnCount', ...
+                'BytesAvailableFcnMode', 'InputBufferSize'};
 
   if numel (varargin) == 1 && isstruct (varargin{1})
     property = fieldnames (varargin{1});
@@ -35,7 +35,9 @@ function retval = get (tcpserver, property)
                 'ClientAddress', 'ClientPort', ...
                 'Type', 'Status', 'Timeout', 'UserData', ...
 		'NumBytesAvailable', 'NumBytesWritten', ...
-		'Terminator', 'Connected' };
+		'Terminator', 'Connected', ...
+		'ReadAsyncMode', 'BytesAvailableFcn', 'BytesAvailableFcnCount', ...
+		'BytesAvailableFcnMode', 'InputBufferSize', 'NumBytesDropped' };
 
   if (nargin == 1)
     property = properties;
@@ -35,47 +35,6 @@ function numbytes = write(obj, data, datatype)
     datatype = "uint8";
   endif
 
-  switch (datatype)
-    case {"string"}
-      data = int8 (data);
-    case {"char" "schar" "int8"}
-      data = int8 (data);
-    case {"uchar" "uint8"}
-      data = uint8 (data);
-    case {"int16" "short"}
-      data = int16 (data);
-    case {"uint16" "ushort"}
-      data = uint16 (data);
-    case {"int32" "int"}
-      data = int32 (data);
-    case {"uint32" "uint"}
-      data = uint32 (data);
-    case {"long" "int64"}
-      data = int64 (data);
-    case {"ulong" "uint64"}
-      data = uint64 (data);
-    case {"single" "float" "float32"}
-      data = single (data);
-    case {"double" "float64"}
-      data = double (data);
-    otherwise
-      error ("precision not supported");
-  endswitch
-
-  if length(data) > 0
-    # if a data element > 1 byte, need handle endian
-    tosize = length(typecast(data(1),'uint8'));
-    if tosize > 1
-      [~,~,endian] = computer();
-      e = upper(obj.ByteOrder);
-
-      if e(1) != endian
-        # need change endian
-        data = swapbytes(data);
-      endif
-    endif
-  endif
- 
-  numbytes = __tcpserver_write__ (obj, typecast(data,'uint8'));
+  numbytes = __tcpserver_write__ (obj, data, datatype);
 
 endfunction
@@ -0,0 +1,61 @@
+## Copyright (C) 2026 John Donoghue
+##
+## This program is free software; you can redistribute it and/or modify it under
+## the terms of the GNU General Public License as published by the Free Software
+## Foundation; either version 3 of the License, or (at your option) any later
+## version.
+##
+## This program is distributed in the hope that it will be useful, but WITHOUT
+## ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+## FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+## details.
+##
+## You should have received a copy of the GNU General Public License along with
+## this program; if not, see <http://www.gnu.org/licenses/>.
+
+## -*- texinfo -*-
+## @deftypefn {} {} configureCallback (@var{udp}, "off")
+## @deftypefnx {} {} configureCallback (@var{udp}, "terminator", @var{fcn})
+## @deftypefnx {} {} configureCallback (@var{udp}, "byte", @var{count}, @var{fcn})
+## Set the BytesAvailableFcn callback of a udpport object
+##
+## @subsubheading Inputs
+## @var{udp} - udpport object@*
+## @var{count} - number of bytes received between each call of @var{fcn}@*
+## @var{fcn} - function handle called as @var{fcn} (@var{udp}, @var{evt})@*
+##
+## Setting a callback switches ReadAsyncMode to "continuous", so data is read
+## in the background as it arrives. Callbacks are run when octave is idle at
+## the prompt and whenever the object is read.
+##
+## @subsubheading Outputs
+## None
+##
+## @seealso{udpport}
+## @end deftypefn
+
+function configureCallback (udp, varargin)
+
+  if nargin < 2
+    print_usage ();
+  endif
+
+  __udpport_properties__ (udp, 'configurecallback', varargin{:});
+
+endfunction
+
+%!test
+%! a = udpport ();
+%! a.Timeout = 1;
+%! a.UserData = 0;
+%! configureCallback (a, "byte", 2, @(o, e) set (o, "UserData", o.UserData + 1));
+%! assert (a.ReadAsyncMode, "continuous");
+%! write (a, uint8 ([1 2 3 4]), "127.0.0.1", a.LocalPort);
+%! pause (0.5);
+%! __udpport_async_callbacks__ ();
+%! assert (a.UserData, 2);
+%! assert (read (a, 4), uint8 ([1 2 3 4]));
+%! configureCallback (a, "off");
+%! a.ReadAsyncMode = "manual";
+%! assert (a.ReadAsyncMode, "manual");
+%! clear a
@@ -36,7 +36,9 @@ function retval = get (udpport, property)
                 'LocalPort', 'LocalHost', 'Type', 'Terminator', ...
                 'Status', 'Timeout', 'NumBytesAvailable', 'NumBytesWritten', ...
 		'MulticastGroup', 'EnableMulticast', 'EnableMulticastLoopback', ...
-		'EnablePortSharing', 'EnableBroadcast', 'ByteOrder', 'Tag'};
+		'EnablePortSharing', 'EnableBroadcast', 'ByteOrder', 'Tag', ...
+		'ReadAsyncMode', 'BytesAvailableFcn', 'BytesAvailableFcnCount', ...
+		'BytesAvailableFcnMode', 'InputBufferSize', 'NumBytesDropped'};
 
   if (nargin == 1)
     property = properties;
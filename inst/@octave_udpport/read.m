@@ -35,66 +35,10 @@ function data = read (obj, cnt, datatype)
     datatype = 'uint8';
   endif
 
-  switch (datatype)
-    case {"string"}
-      toclass = "char";
-      tosize=1;
-    case {"char" "schar" "int8"}
-      toclass = "int8";
-      tosize=1;
-    case {"uchar" "uint8"}
-      toclass = "uint8";
-      tosize=1;
-    case {"int16" "short"}
-      toclass = "int16";
-      tosize=2;
-    case {"uint16" "ushort"}
-      toclass = "uint16";
-      tosize=2;
-    case {"int32" "int"}
-      toclass = "int32";
-      tosize=4;
-    case {"uint32" "uint"}
-      toclass = "uint32";
-      tosize=4;
-    case {"long" "int64"}
-      toclass = "int64";
-      tosize=8;
-    case {"ulong" "uint64"}
-      toclass = "uint64";
-      tosize=8;
-    case {"single" "float" "float32"}
-      toclass = "single";
-      tosize=4;
-    case {"double" "float64"}
-      toclass = "double";
-      tosize=8;
-    otherwise
-      error ("precision not supported");
-  endswitch
-
   if (nargin < 2)
-    cnt = int32(obj.NumBytesAvailable/tosize);
-  endif
-
-  cnt = cnt*tosize;
-
-  if cnt > 0
-    tmp = __udpport_read__ (obj, cnt, get(obj, 'Timeout')*1000);
-  else
-    tmp = [];
+    cnt = -1;
   endif
 
-  data = typecast(tmp,toclass);
-
-  if tosize > 1
-    [~,~,endian] = computer();
-    e = upper(obj.ByteOrder);
+  data = __udpport_read__ (obj, cnt, get(obj, 'Timeout')*1000, datatype);
 
-    if e(1) != endian
-      # need change endian
-      data = swapbytes(data);
-    endif
-  endif
- 
 endfunction
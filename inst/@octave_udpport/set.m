@@ -42,6 +42,24 @@
 ## Set the timeout value in seconds. Value of -1 means a
 ## blocking call.
 ##
+## @item 'ReadAsyncMode'
+## 'continuous' to read data in the background as it arrives, or 'manual'
+## to read it only when requested.
+##
+## @item 'BytesAvailableFcn'
+## Function handle called as fcn (obj, evt) when data is available,
+## according to 'BytesAvailableFcnMode'.
+##
+## @item 'BytesAvailableFcnMode'
+## 'off', 'byte' to call the function each time 'BytesAvailableFcnCount'
+## bytes are received, or 'terminator' to call it for each terminator.
+##
+## @item 'BytesAvailableFcnCount'
+## Number of bytes for 'byte' mode callbacks.
+##
+## @item 'InputBufferSize'
+## Size in bytes of the buffer used by the background reader.
+##
 ## @end table
 ##
 ## @subsubheading Outputs
@@ -52,7 +70,9 @@
 
 function set (udpport, varargin)
 
-  properties = {'UserData','Timeout', 'Name', 'EnableBroadcast', 'Tag' };
+  properties = {'UserData','Timeout', 'Name', 'EnableBroadcast', 'Tag', ...
+                'ReadAsyncMode', 'BytesAvailableFcn', 'BytesAvailableFcnCount', ...
+                'BytesAvailableFcnMode', 'InputBufferSize'};
 
   if numel (varargin) == 1 && isstruct (varargin{1})
     property = fieldnames (varargin{1});
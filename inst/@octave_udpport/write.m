@@ -54,54 +54,15 @@ function numbytes = write(obj, data, varargin)
     print_usage ();
   endif
 
-  switch (datatype)
-    case {"char" "schar" "int8", "string"}
-      data = int8 (data);
-    case {"uchar" "uint8"}
-      data = uint8 (data);
-    case {"int16" "short"}
-      data = int16 (data);
-    case {"uint16" "ushort"}
-      data = uint16 (data);
-    case {"int32" "int"}
-      data = int32 (data);
-    case {"uint32" "uint"}
-      data = uint32 (data);
-    case {"long" "int64"}
-      data = int64 (data);
-    case {"ulong" "uint64"}
-      data = uint64 (data);
-    case {"single" "float" "float32"}
-      data = single (data);
-    case {"double" "float64"}
-      data = double (data);
-    otherwise
-      error ("datatype not supported");
-  endswitch
-
   if length(data) == 0
     numbytes = 0;
-  else
-    # if a data element > 1 byte, need handle endian
-    tosize = length(typecast(data(1),'uint8'));
-    if tosize > 1
-      [~,~,endian] = computer();
-      e = upper(obj.ByteOrder);
-
-      if e(1) != endian
-        # need change endian
-        data = swapbytes(data);
-      endif
-    endif
- 
-    if !isempty(destinationAddress)
-      if !ischar(destinationAddress)
-        error ("Expected address as a string");
-      endif
-      numbytes = __udpport_write__ (obj, typecast(data,'uint8'), destinationAddress, destinationPort);
-    else
-      numbytes = __udpport_write__ (obj, typecast(data,'uint8'));
+  elseif !isempty(destinationAddress)
+    if !ischar(destinationAddress)
+      error ("Expected address as a string");
     endif
+    numbytes = __udpport_write__ (obj, data, destinationAddress, destinationPort, datatype);
+  else
+    numbytes = __udpport_write__ (obj, data, datatype);
   endif
 endfunction
 
@@ -0,0 +1,44 @@
+## Copyright (C) 2026 John Donoghue <john.donoghue@ieee.org>
+## 
+## This program is free software: you can redistribute it and/or modify it
+## under the terms of the GNU General Public License as published by
+## the Free Software Foundation, either version 3 of the License, or
+## (at your option) any later version.
+## 
+## This program is distributed in the hope that it will be useful, but
+## WITHOUT ANY WARRANTY; without even the implied warranty of
+## MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+## GNU General Public License for more details.
+
+## -*- texinfo -*-
+## @deftypefn {} {@var{struct} = } get (@var{dev})
+## @deftypefnx {} {@var{field} = } get (@var{dev}, @var{property})
+## @deftypefnx {} {@var{values} = } get (@var{dev}, @{@var{property}, @dots{}@})
+## Get the properties of visadev object.
+##
+## All of the properties asked for are fetched in a single call, so
+## the state of an instrument can be read cheaply for logging.
+##
+## @subsubheading Inputs
+## @var{dev} - instance of @var{octave_visadev} class.@*
+## @var{property} - name of property, or cell array of names.@*
+##
+## @subsubheading Outputs
+## When @var{property} was specified, return the value of that property, or
+## a cell array of values for a cell array of names.@*
+## otherwise return the values of all properties as a structure.@*
+##
+## @seealso{@@octave_visadev/set, visadev}
+## @end deftypefn
+
+function retval = get (dev, property)
+
+  if (nargin == 1)
+    retval = __visadev_dispatch__ (dev, "get");
+  elseif (nargin == 2)
+    retval = __visadev_dispatch__ (dev, "get", property);
+  else
+    print_usage ();
+  endif
+
+endfunction
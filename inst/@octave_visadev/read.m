@@ -24,6 +24,9 @@
 ## @var{precision} - Optional precision for the output data read data.
 ## Currently known precision values are uint8 (default), int8, uint16, int16, uint32, int32, uint64, uint64 
 ##
+## Data is read straight into the result in chunks of at most the
+## ReadChunkSize property, and the read stops early at the end of a message.
+##
 ## @subsubheading Outputs
 ## @var{data} - data read from the device
 ##
@@ -90,24 +93,29 @@ function data = read (dev, count, precision)
     error ("precision not supported");
   endswitch
 
-  eoi=0; tmp=[]; count=0;
+  # each read fills as much as it can, and stops early at the end of a
+  # message
+  eoi=0; tmp={}; count=0;
   while ((!eoi) && (toread > 0))
-    tmp1 = __visadev_dispatch__ (dev, "read", toread);
-    if !isempty(tmp1)
-      wasread = numel(tmp1);
+    [tmp1, wasread, eoi] = __visadev_dispatch__ (dev, "read", toread);
+    if wasread > 0
       count = count + wasread;
       toread = toread - wasread;
     else
       break;
     endif
-    tmp = [tmp tmp1];
+    tmp{end+1} = tmp1;
   endwhile
+  tmp = [tmp{:}];
+  if isempty (tmp)
+    tmp = uint8 ([]);
+  endif
 
   data = typecast(tmp,toclass);
 
   if tosize > 1
     [~,~,endian] = computer();
-    e = upper(obj.ByteOrder);
+    e = upper(dev.ByteOrder);
 
     if e(1) != endian
       # need change endian
@@ -0,0 +1,62 @@
+## Copyright (C) 2026 John Donoghue <john.donoghue@ieee.org>
+## 
+## This program is free software: you can redistribute it and/or modify it
+## under the terms of the GNU General Public License as published by
+## the Free Software Foundation, either version 3 of the License, or
+## (at your option) any later version.
+## 
+## This program is distributed in the hope that it will be useful, but
+## WITHOUT ANY WARRANTY; without even the implied warranty of
+## MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+## GNU General Public License for more details.
+
+## -*- texinfo -*-
+## @deftypefn {} set (@var{dev}, @var{property}, @var{value})
+## @deftypefnx {} set (@var{dev}, @var{property}, @var{value}, @dots{})
+## @deftypefnx {} set (@var{dev}, @{@var{property}, @dots{}@}, @{@var{value}, @dots{}@})
+## @deftypefnx {} set (@var{dev}, @var{struct})
+## Set the properties of visadev object.
+##
+## All of the properties given are set in a single call, in the order
+## given, so an instrument can be configured from a saved structure.
+##
+## @subsubheading Inputs
+## @var{dev} - instance of @var{octave_visadev} class.@*
+## @var{property}, @var{value} - property name and the value to set it to.@*
+## @var{struct} - structure of property names and values, as returned by get.@*
+##
+## Readonly properties are an error, so a structure from get should
+## only keep the properties to be set.
+##
+## @subsubheading Outputs
+## None
+##
+## @seealso{@@octave_visadev/get, visadev}
+## @end deftypefn
+
+function set (dev, varargin)
+
+  if (numel (varargin) == 1 && isstruct (varargin{1}))
+    values = varargin{1};
+  else
+    if (numel (varargin) == 2 && iscell (varargin{1}) && iscell (varargin{2}))
+      property = varargin{1};
+      value = varargin{2};
+    elseif (numel (varargin) >= 2 && mod (numel (varargin), 2) == 0)
+      property = varargin(1:2:end);
+      value = varargin(2:2:end);
+    else
+      print_usage ();
+    endif
+
+    if (numel (property) != numel (value))
+      error ("visadev:set:InvalidArgument", ...
+             "PROPERTIES and VALUES must have the same number of elements.");
+    endif
+
+    values = cell2struct (value(:), property(:), 1);
+  endif
+
+  __visadev_dispatch__ (dev, "set", values);
+
+endfunction
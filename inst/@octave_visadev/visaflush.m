@@ -0,0 +1,37 @@
+## Copyright (C) 2026 John Donoghue <john.donoghue@ieee.org>
+## 
+## This program is free software: you can redistribute it and/or modify it
+## under the terms of the GNU General Public License as published by
+## the Free Software Foundation, either version 3 of the License, or
+## (at your option) any later version.
+## 
+## This program is distributed in the hope that it will be useful, but
+## WITHOUT ANY WARRANTY; without even the implied warranty of
+## MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+## GNU General Public License for more details.
+
+## -*- texinfo -*- 
+## @deftypefn {} {} visaflush (@var{dev})
+## Send the writes queued in the VISA write buffer of a visa device.
+##
+## Writes are only queued when the BufferMode property is "manual" or
+## "terminator", and are otherwise sent as they are made. This is
+## equivalent to the viFlush VISA specification function with
+## VI_WRITE_BUF.
+##
+## @subsubheading Inputs
+## @var{dev} - connected visadev device
+##
+## @subsubheading Outputs
+## None
+##
+## @seealso{visadev, flush}
+## @end deftypefn
+
+function visaflush (dev)
+  if (nargin != 1)
+    print_usage ();
+  endif
+
+  __visadev_dispatch__ (dev, 'sendbuffer');
+endfunction
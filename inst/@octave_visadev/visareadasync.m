@@ -0,0 +1,39 @@
+## Copyright (C) 2026 John Donoghue <john.donoghue@ieee.org>
+## 
+## This program is free software: you can redistribute it and/or modify it
+## under the terms of the GNU General Public License as published by
+## the Free Software Foundation, either version 3 of the License, or
+## (at your option) any later version.
+## 
+## This program is distributed in the hope that it will be useful, but
+## WITHOUT ANY WARRANTY; without even the implied warranty of
+## MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+## GNU General Public License for more details.
+
+## -*- texinfo -*- 
+## @deftypefn {} {} visareadasync (@var{dev}, @var{count})
+## Start an asynchronous read of up to @var{count} bytes from a visa device.
+##
+## This is equivalent to the viReadAsync VISA specification
+## function. The call returns straight away, and the data, once
+## the read completes, is returned by the next read, readline or
+## readbinblock of the device. The TransferStatus property shows
+## whether the read is still in progress.
+##
+## @subsubheading Inputs
+## @var{dev} - connected visadev device@*
+## @var{count} - maximum number of bytes to read
+##
+## @subsubheading Outputs
+## None
+##
+## @seealso{visadev, visawaitasync, visastopasync, visawriteasync}
+## @end deftypefn
+
+function visareadasync (dev, count)
+  if (nargin < 2)
+    print_usage ();
+  endif
+
+  __visadev_dispatch__ (dev, 'readasync', count);
+endfunction
@@ -0,0 +1,32 @@
+## Copyright (C) 2026 John Donoghue <john.donoghue@ieee.org>
+## 
+## This program is free software: you can redistribute it and/or modify it
+## under the terms of the GNU General Public License as published by
+## the Free Software Foundation, either version 3 of the License, or
+## (at your option) any later version.
+## 
+## This program is distributed in the hope that it will be useful, but
+## WITHOUT ANY WARRANTY; without even the implied warranty of
+## MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+## GNU General Public License for more details.
+
+## -*- texinfo -*- 
+## @deftypefn {} {} visastopasync (@var{dev})
+## Stop the asynchronous reads and writes of a visa device.
+##
+## This is equivalent to the viTerminate VISA specification
+## function. Any data a read received before it was stopped is
+## kept for the next read.
+##
+## @subsubheading Inputs
+## @var{dev} - connected visadev device
+##
+## @subsubheading Outputs
+## None
+##
+## @seealso{visadev, visareadasync, visawriteasync, visawaitasync}
+## @end deftypefn
+
+function visastopasync (dev)
+  __visadev_dispatch__ (dev, 'stopasync');
+endfunction
@@ -0,0 +1,38 @@
+## Copyright (C) 2026 John Donoghue <john.donoghue@ieee.org>
+## 
+## This program is free software: you can redistribute it and/or modify it
+## under the terms of the GNU General Public License as published by
+## the Free Software Foundation, either version 3 of the License, or
+## (at your option) any later version.
+## 
+## This program is distributed in the hope that it will be useful, but
+## WITHOUT ANY WARRANTY; without even the implied warranty of
+## MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+## GNU General Public License for more details.
+
+## -*- texinfo -*- 
+## @deftypefn {} {@var{done} =} visawaitasync (@var{dev})
+## @deftypefnx {} {@var{done} =} visawaitasync (@var{dev}, @var{timeout})
+## Wait for the asynchronous reads and writes of a visa device to complete.
+##
+## This waits on the VISA I/O completion event. An error is raised
+## if a transfer failed.
+##
+## @subsubheading Inputs
+## @var{dev} - connected visadev device@*
+## @var{timeout} - seconds to wait, 0 to only check, or Inf
+## (the default) to wait until all complete
+##
+## @subsubheading Outputs
+## @var{done} - true if no transfers are still in progress
+##
+## @seealso{visadev, visareadasync, visawriteasync, visastopasync}
+## @end deftypefn
+
+function done = visawaitasync (dev, timeout)
+  if (nargin < 2)
+    timeout = Inf;
+  endif
+
+  done = __visadev_dispatch__ (dev, 'waitasync', timeout);
+endfunction
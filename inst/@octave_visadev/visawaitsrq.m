@@ -0,0 +1,46 @@
+## Copyright (C) 2026 John Donoghue <john.donoghue@ieee.org>
+## 
+## This program is free software: you can redistribute it and/or modify it
+## under the terms of the GNU General Public License as published by
+## the Free Software Foundation, either version 3 of the License, or
+## (at your option) any later version.
+## 
+## This program is distributed in the hope that it will be useful, but
+## WITHOUT ANY WARRANTY; without even the implied warranty of
+## MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+## GNU General Public License for more details.
+
+## -*- texinfo -*- 
+## @deftypefn {} {@var{srq} =} visawaitsrq (@var{dev})
+## @deftypefnx {} {[@var{srq}, @var{stb}] =} visawaitsrq (@var{dev}, @var{timeout})
+## Wait for a service request from a visa device.
+##
+## This waits on the VISA VI_EVENT_SERVICE_REQ event, rather than
+## polling the status byte. Service requests are queued from the
+## first call, or from when the EnableSRQ property is set, so set
+## EnableSRQ before the command that will request service.
+##
+## @subsubheading Inputs
+## @var{dev} - connected visadev device@*
+## @var{timeout} - seconds to wait, 0 to only check, or Inf
+## (the default) to wait until a service request
+##
+## @subsubheading Outputs
+## @var{srq} - true if the instrument requested service@*
+## @var{stb} - the status byte, read with viReadSTB after a service
+## request, or 0 if there was none
+##
+## @seealso{visadev, visastatus}
+## @end deftypefn
+
+function [srq, stb] = visawaitsrq (dev, timeout)
+  if (nargin < 2)
+    timeout = Inf;
+  endif
+
+  if (nargout > 1)
+    [srq, stb] = __visadev_dispatch__ (dev, 'waitsrq', timeout);
+  else
+    srq = __visadev_dispatch__ (dev, 'waitsrq', timeout);
+  endif
+endfunction
@@ -0,0 +1,38 @@
+## Copyright (C) 2026 John Donoghue <john.donoghue@ieee.org>
+## 
+## This program is free software: you can redistribute it and/or modify it
+## under the terms of the GNU General Public License as published by
+## the Free Software Foundation, either version 3 of the License, or
+## (at your option) any later version.
+## 
+## This program is distributed in the hope that it will be useful, but
+## WITHOUT ANY WARRANTY; without even the implied warranty of
+## MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+## GNU General Public License for more details.
+
+## -*- texinfo -*- 
+## @deftypefn {} {} visawriteasync (@var{dev}, @var{data})
+## Start an asynchronous write of @var{data} to a visa device.
+##
+## This is equivalent to the viWriteAsync VISA specification
+## function. The call returns straight away, with the data written
+## while Octave goes on, and NumBytesWritten is updated when the
+## write completes.
+##
+## @subsubheading Inputs
+## @var{dev} - connected visadev device@*
+## @var{data} - char or uint8 data to write
+##
+## @subsubheading Outputs
+## None
+##
+## @seealso{visadev, visawaitasync, visastopasync, visareadasync}
+## @end deftypefn
+
+function visawriteasync (dev, data)
+  if (nargin < 2)
+    print_usage ();
+  endif
+
+  __visadev_dispatch__ (dev, 'writeasync', data);
+endfunction
@@ -76,6 +76,6 @@ function numbytes = write(obj, data, precision)
     endif
   endif
 
-  numbytes = __visadev_dispatch__ (obj, "write", typecast(data,'uint8'));
+  numbytes = __visadev_dispatch__ (obj, "write", data);
 
 endfunction
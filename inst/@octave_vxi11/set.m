@@ -0,0 +1,88 @@
+## Copyright (C) 2026 John Donoghue <john.donoghue@ieee.org>
+##
+## This program is free software: you can redistribute it and/or modify it
+## under the terms of the GNU General Public License as published by
+## the Free Software Foundation, either version 3 of the License, or
+## (at your option) any later version.
+##
+## This program is distributed in the hope that it will be useful, but
+## WITHOUT ANY WARRANTY; without even the implied warranty of
+## MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+## GNU General Public License for more details.
+
+## -*- texinfo -*-
+## @deftypefn {} set (@var{obj}, @var{property},@var{value})
+## @deftypefnx {} set (@var{obj}, @var{property},@var{value},@dots{})
+## Set the properties of vxi11 object.
+##
+## @subsubheading Inputs
+## If @var{property} is a cell so must be @var{value}, it sets the values of
+## all matching properties.
+##
+## The function also accepts property-value pairs.
+##
+## @subsubheading Properties
+## @table @var
+## @item 'Timeout'
+## Set the time in seconds the instrument waits to complete a read or
+## write. (Default: 10)
+##
+## @item 'LockTimeout'
+## Set the time in seconds to wait for a lock held by another link.
+## (Default: 10)
+##
+## @item 'TermChar'
+## Set a character that ends a read, as a character or value 0 to 255, or
+## empty for none. (Default: empty)
+##
+## @item 'EnableSRQ'
+## Set true to have the instrument report service requests on an interrupt
+## channel, for vxi11_waitsrq. (Default: false)
+##
+## @end table
+##
+## @subsubheading Outputs
+## None
+##
+## @seealso{@@octave_vxi11/get}
+## @end deftypefn
+
+function set (vxi11, varargin)
+
+  properties = {'Timeout', 'LockTimeout', 'TermChar', 'EnableSRQ'};
+
+  if numel (varargin) == 1 && isstruct (varargin{1})
+    property = fieldnames (varargin{1});
+    func  = @(x) getfield (varargin{1}, x);
+    value = cellfun (func, property, 'UniformOutput', false);
+  elseif numel (varargin) == 2 && iscell (varargin{1}) && iscell (varargin{2})
+    %% The arguments are two cells, expecting fields and values.
+    property = varargin{1};
+    value = varargin{2};
+  else
+    property = {varargin{1:2:end}};
+    value = {varargin{2:2:end}};
+  endif
+
+  if numel (property) != numel (value)
+    error ('vxi11:set:InvalidArgument', ...
+           'PROPERIES and VALUES must have the same number of elements.');
+  endif
+
+  valid     = ismember (property, properties);
+  not_found = {property{!valid}};
+
+  if !isempty (not_found)
+    msg = @(x) error ("vxi11:set:InvalidArgument", ...
+                      "Property '%s' not found in vxi11 object.\n",x);
+    cellfun (msg, not_found);
+  endif
+
+  property = {property{valid}};
+  value = {value{valid}};
+
+  for i=1:length(property)
+    __vxi11_properties__ (vxi11, property{i}, value{i});
+  endfor
+
+endfunction
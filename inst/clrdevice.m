@@ -15,9 +15,9 @@
 
 ## -*- texinfo -*-
 ## @deftypefn {} {} clrdevice (@var{obj})
-## Send clear command to Clear GPIB instrument.
+## Send clear command to Clear GPIB or HiSLIP instrument.
 ##
-## @var{obj} is a GPIB object
+## @var{obj} is a GPIB or HiSLIP object
 ##
 ## @end deftypefn
 
@@ -30,8 +30,10 @@ if (nargin < 1)
   print_usage();
 end
 
-if (!isa (obj,'octave_gpib'))
-  error ('clrdevice: need octave_gpib object');
+if (isa (obj,'octave_hislip'))
+  __hislip_properties__ (obj, 'clear');
+elseif (isa (obj,'octave_gpib'))
+  __gpib_clrdevice__ (obj);
+else
+  error ('clrdevice: need octave_gpib or octave_hislip object');
 end
-
-__gpib_clrdevice__ (obj);
@@ -26,8 +26,9 @@
 ## @var{interface} is the instrument interface to query. When provided, instrhwinfo
 ## will provide information on the specified interface.
 ##
-## Currently only interface "serialport","i2c" and "spi" and is supported, which will provide a list of
-## available serial ports or i2c ports.
+## Currently only interface "serialport","i2c", "spi" and "visa" and is supported, which will provide a list of
+## available serial ports, i2c ports or visa resources. The visa resources are
+## from the list kept by visadevlist.
 ##
 ## @subsubheading Outputs
 ## If an output variable is provided, the function will store the information
@@ -136,6 +137,10 @@ function out = instrhwinfo (interface)
       out = [];
     endif
 
+  elseif (strcmpi (interface, "visa"))
+    lst = visadevlist ();
+    out = {lst.ResourceName};
+
    else
     error ("Interface '%s' not yet implemented...", interface);
   endif
@@ -0,0 +1,154 @@
+## Copyright (C) 2026 John Donoghue <john.donoghue@ieee.org>
+##
+## This program is free software: you can redistribute it and/or modify it
+## under the terms of the GNU General Public License as published by
+## the Free Software Foundation, either version 3 of the License, or
+## (at your option) any later version.
+##
+## This program is distributed in the hope that it will be useful, but
+## WITHOUT ANY WARRANTY; without even the implied warranty of
+## MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+## GNU General Public License for more details.
+
+## -*- texinfo -*-
+## @deftypefn {} {[@var{ready}, @var{idx}] =} instrwait (@var{devs})
+## @deftypefnx {} {[@var{ready}, @var{idx}] =} instrwait (@var{devs}, @var{timeout})
+## Wait until any of a set of instrument devices has data to read.
+##
+## The devices are waited on together without polling, so a single loop
+## can service many devices. Data already buffered by a previous readline
+## or by a continuous ReadAsyncMode counts as readable.
+##
+## A TCPSERVER without a client is readable when a client is connecting.
+##
+## @subsubheading Inputs
+## @var{devs} - cell array of TCPCLIENT, TCPSERVER, UDPPORT, SERIALPORT or
+## HISLIP objects, or a single object
+##
+## @var{timeout} - optional time in seconds to wait. A value of -1
+## (default) waits until a device is readable and 0 checks without waiting.
+##
+## @subsubheading Outputs
+## @var{ready} - logical array, true for each device that has data to read
+##
+## @var{idx} - indexes of the devices that have data to read
+##
+## @seealso{read, readline}
+## @end deftypefn
+
+function [ready, idx] = instrwait (devs, timeout)
+
+  if nargin < 1
+    print_usage ();
+  endif
+
+  if ! iscell (devs)
+    devs = {devs};
+  endif
+
+  if nargin < 2
+    timeout = -1;
+  elseif ! isscalar (timeout) || ! isreal (timeout)
+    error ("instrwait: expected timeout to be a number of seconds");
+  endif
+
+  start = tic;
+
+  while true
+    [fds, ready] = waitinfo (devs);
+
+    if any (ready)
+      break;
+    endif
+
+    if timeout >= 0
+      left = max (timeout - toc (start), 0) * 1000;
+    else
+      left = -1;
+    endif
+
+    % devices that can not be polled are checked every 10ms
+    if any (fds < 0) && (left < 0 || left > 10)
+      ms = 10;
+    else
+      ms = left;
+    endif
+
+    ready = __instr_poll__ (fds, ms);
+
+    if any (ready) || (timeout >= 0 && toc (start) >= timeout)
+      break;
+    endif
+  endwhile
+
+  idx = find (ready);
+
+endfunction
+
+function [fds, pending] = waitinfo (devs)
+
+  n = numel (devs);
+  fds = -ones (1, n);
+  pending = false (1, n);
+
+  for i = 1:n
+    switch (typeinfo (devs{i}))
+      case "octave_tcpclient"
+        info = __tcpclient_properties__ (devs{i}, "waitinfo");
+      case "octave_tcpserver"
+        info = __tcpserver_properties__ (devs{i}, "waitinfo");
+      case "octave_udpport"
+        info = __udpport_properties__ (devs{i}, "waitinfo");
+      case "octave_serialport"
+        info = __srlp_properties__ (devs{i}, "__waitinfo__");
+      case "octave_hislip"
+        info = __hislip_properties__ (devs{i}, "waitinfo");
+      otherwise
+        error ("instrwait: device %d is not a supported instrument object", i);
+    endswitch
+
+    fds(i) = info(1);
+    pending(i) = info(2);
+  endfor
+
+endfunction
+
+%!error instrwait
+%!error <not a supported instrument object> instrwait ({1})
+
+%!test
+%! a = udpport ();
+%! b = udpport ();
+%! [ready, idx] = instrwait ({a, b}, 0);
+%! assert (ready, [false false]);
+%! assert (isempty (idx));
+%! write (a, "hello", "127.0.0.1", b.LocalPort);
+%! [ready, idx] = instrwait ({a, b}, 1);
+%! assert (ready, [false true]);
+%! assert (idx, 2);
+%! assert (char (read (b, 5)), "hello");
+%! clear a b
+
+%!test
+%! a = udpport ();
+%! start = tic;
+%! assert (instrwait (a, 0.2), false);
+%! assert (toc (start) >= 0.2);
+%! clear a
+
+%!test
+%! a = udpport ("Timeout", 1);
+%! write (a, "one\ntwo\n", "127.0.0.1", a.LocalPort);
+%! assert (readline (a), "one");
+%! # the rest of the datagram is already buffered
+%! assert (instrwait (a, 0), true);
+%! clear a
+
+%!test
+%! a = udpport ();
+%! a.ReadAsyncMode = "continuous";
+%! assert (instrwait (a, 0), false);
+%! write (a, "async", "127.0.0.1", a.LocalPort);
+%! assert (instrwait (a, 1), true);
+%! assert (char (read (a, 5)), "async");
+%! clear a
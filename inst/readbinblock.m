@@ -66,7 +66,12 @@ function data = readbinblock (dev, varargin)
   endif
 
   if nargin > 1
-    switch (varargin{1})
+    datatype = varargin{1};
+  else
+    datatype = "uint8";
+  endif
+
+  switch (datatype)
     case {"string"}
       toclass = "char";
     case {"char" "schar" "int8"}
@@ -91,24 +96,40 @@ function data = readbinblock (dev, varargin)
       toclass = "double";
     otherwise
       error ("datatype not supported");
-    endswitch
-  else
-    toclass = "uint8";
-  endif
+  endswitch
 
-  # read and numbytesavailable
-  types_with_read = { "octave_udpport", "octave_serialport", ...
-                      "octave_tcpclient", "octave_tcpserver", ...
-                      "octave_udpport", "octave_visadev" };
-
-  if sum(strcmp(type, types_with_read)) > 0
-    has_read = 1;
-  else
-    has_read = 0;
-  endif
+  # instruments that parse the block natively
+  switch (type)
+    case "octave_tcpclient"
+      data = __tcpclient_readbinblock__ (dev, datatype);
+      return;
+    case "octave_tcpserver"
+      data = __tcpserver_readbinblock__ (dev, datatype);
+      return;
+    case "octave_udpport"
+      data = __udpport_readbinblock__ (dev, datatype);
+      return;
+    case "octave_serialport"
+      data = __srlp_readbinblock__ (dev, datatype);
+      return;
+    case "octave_visadev"
+      data = __visadev_dispatch__ (dev, "readbinblock", datatype);
+      return;
+    case "octave_gpib"
+      data = __gpib_readbinblock__ (dev, datatype);
+      return;
+    case "octave_usbtmc"
+      data = __usbtmc_readbinblock__ (dev, datatype);
+      return;
+    case "octave_vxi11"
+      data = __vxi11_readbinblock__ (dev, datatype);
+      return;
+    case "octave_hislip"
+      data = __hislip_readbinblock__ (dev, datatype);
+      return;
+  endswitch
 
   data = uint8([]);
-  sz = -1;
 
   # Dataformat: # D <dsizenumn> <data...> \n
   # hdr: '#'
@@ -120,11 +141,7 @@ function data = readbinblock (dev, varargin)
   # scan for start of header
   tmp = 1;
   while !isempty(tmp) && tmp != '#'
-    if has_read
-      tmp = read (dev, 1);
-    else
-      tmp = fread (dev, 1);
-    endif
+    tmp = fread (dev, 1);
   endwhile
 
   if isempty(tmp)
@@ -133,11 +150,7 @@ function data = readbinblock (dev, varargin)
   endif
 
   # get data size size byte
-  if has_read
-    tmp = read (dev, 1);
-  else
-    tmp = fread (dev, 1);
-  endif
+  tmp = fread (dev, 1);
 
   if isempty(tmp)
     data = [];
@@ -149,12 +162,7 @@ function data = readbinblock (dev, varargin)
   pos = 0;
   dsize = [];
   while (pos < len)
-    
-    if has_read
-      tmp = read (dev, len-pos);
-    else
-      tmp = fread (dev, len-pos);
-    endif
+    tmp = fread (dev, len-pos);
 
     if isempty(tmp)
       data = [];
@@ -167,11 +175,7 @@ function data = readbinblock (dev, varargin)
 
   len = str2num(char(dsize));
  
-  if has_read
-    tdata = read (dev, len);
-  else
-    tdata = fread(dev, len);
-  endif
+  tdata = fread(dev, len);
 
   while !isempty (tdata)
     data = [data tdata];
@@ -181,36 +185,16 @@ function data = readbinblock (dev, varargin)
       break;
     endif
 
-    if has_read
-      tdata = read (dev, len-pos);
-    else
-      tdata = fread(dev, len-pos);
-    endif
-
+    tdata = fread(dev, len-pos);
   endwhile
 
   # end byte
-  if has_read
-    eol = read (dev, 1);
-  else
-    eol = fread(dev, 1);
-  endif
+  eol = fread(dev, 1);
 
   assert(eol, uint8(10))
 
   if !strcmp(toclass, 'uint8')
     data = typecast(data,toclass);
-
-    # need sawp bytes
-    if has_read == 1
-      [~,~,endian] = computer();
-      e = upper(dev.ByteOrder);
-
-      if e(1) != endian
-        # need change endian
-        data = swapbytes(data);
-      endif
-    endif
   endif
 endfunction
 
@@ -310,3 +294,15 @@ endfunction
 %!
 %! clear a
 
+
+%!test
+%! # native tcp block
+%! s = tcpserver (0);
+%! c = tcpclient ("127.0.0.1", s.ServerPort, "Timeout", 1);
+%! st = s.Connected;
+%! x = rand (1, 10000);
+%! writebinblock (s, x, "double");
+%! assert (readbinblock (c, "double"), x);
+%! writebinblock (s, "hello", "string");
+%! assert (readbinblock (c, "string"), "hello");
+%! clear c s
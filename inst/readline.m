@@ -34,68 +34,19 @@ function data = readline (dev)
     error ('expected instrument control device');
   endif
 
-  types_with_confterminator = { "octave_udpport", "octave_serialport", ...
-                                "octave_tcpclient", "octave_tcpserver", "octave_udpport" };
-
-  if sum(strcmp(type, types_with_confterminator)) > 0
-    terminator = dev.Terminator;
-    if iscell(terminator) && length(terminator) > 1
-      # user read terminator
-      terminator = terminator{1};
-    endif
-
-    if ! ischar (terminator)
-      terminator = char(terminator);
-    else
-      if strcmpi(terminator, "lf")
-        terminator = "\n";
-      elseif strcmpi(terminator, "cr")
-        terminator = "\r";
-      elseif strcmpi(terminator, "cr/lf")
-        terminator = "\r\n";
-      endif
-    endif
-
-    data = "";
-    idx = 0;
-
-    len = length(terminator);
-
-    tdata = read (dev, len);
-    while !isempty (tdata) && idx == 0
-      data = [data char(tdata)];
-      idx = index (data, terminator);
-      if (idx > 0)
-        if (idx > 1)
-          data = data(1:idx-1);
-        else
-          data = "";
-        endif
-      else
-        # read more data
-        tdata = read (dev, 1);
-      endif
-    endwhile
-  elseif strcmp(type, "octave_visadev")
-    terminator = "\n";
-
-    data = "";
-    idx = 0;
-    tdata = read(dev, 1);
-    while !isempty(tdata) && idx == 0
-      data = [data  char(tdata)];
-      idx = index(data, terminator);
-      if (idx > 0)
-        if (idx > 1)
-          data = data(1:idx-1);
-        else
-          data = "";
-        endif
-      else
-        tdata = read(dev, 1);
-      endif
-    endwhile
- 
+  # instruments with a configurable terminator read the line natively
+  if strcmp (type, "octave_tcpclient")
+    data = __tcpclient_readline__ (dev);
+  elseif strcmp (type, "octave_tcpserver")
+    data = __tcpserver_readline__ (dev);
+  elseif strcmp (type, "octave_udpport")
+    data = __udpport_readline__ (dev);
+  elseif strcmp (type, "octave_serialport")
+    data = __srlp_readline__ (dev);
+  elseif strcmp (type, "octave_visadev")
+    data = __visadev_dispatch__ (dev, "readline");
+  elseif strcmp (type, "octave_hislip")
+    data = __hislip_readline__ (dev);
   else
     terminator = "\n";
 
@@ -18,11 +18,18 @@
 ## @deftypefnx {} {[@var{out},@var{statusByte}] =} spoll (@var{obj})
 ## Serial polls GPIB instruments.
 ##
-## @var{obj} is a GPIB object or a cell array of GPIB objects
+## @var{obj} is a GPIB, VXI11 or HISLIP object or a cell array of GPIB objects
 ##
 ## @var{out} GPIB objects ready for service
 ## @var{statusByte} status Byte
 ##
+## A cell array of GPIB objects on the same board is polled in a single
+## bus transaction.
+##
+## A VXI11 object reads the status byte with the device_readstb call, and a
+## HISLIP object with an AsyncStatusQuery.
+##
+## @seealso{gpib_findrqs, gpib_waitsrq, vxi11_waitsrq, hislip_waitsrq}
 ## @end deftypefn
 
 ## TODO: 
@@ -39,10 +46,12 @@ if iscell (obj) && numel (obj) > 0
     error ("obj contains wrong elements");
   end
   
+  all_status = uint8 (__gpib_allspoll__ (obj));
+
   out = {};
   statusByte = [];
   for i = 1:numel (obj)
-    tmp_status = uint8 (__gpib_spoll__ (obj{i}));
+    tmp_status = all_status(i);
     if (bitget (tmp_status,7) == 0)
       out{end+1} = obj{i};
       statusByte(end+1) = tmp_status;
@@ -51,14 +60,20 @@ if iscell (obj) && numel (obj) > 0
   
   return
   
-elseif (!isa (obj,'octave_gpib'))
-  error ('spoll: need octave_gpib object');
+elseif (!isa (obj,'octave_gpib') && !isa (obj,'octave_vxi11') && !isa (obj,'octave_hislip'))
+  error ('spoll: need octave_gpib, octave_vxi11 or octave_hislip object');
 end
 
 out = [];
 statusByte = [];
 
-tmp_status = uint8 (__gpib_spoll__ (obj));
+if (isa (obj,'octave_vxi11'))
+  tmp_status = uint8 (__vxi11_readstb__ (obj));
+elseif (isa (obj,'octave_hislip'))
+  tmp_status = uint8 (__hislip_properties__ (obj, 'readstb'));
+else
+  tmp_status = uint8 (__gpib_spoll__ (obj));
+end
 if (bitget (tmp_status,7) == 0)
   out = obj;
   statusByte = tmp_status;
@@ -53,6 +53,45 @@ function writebinblock (dev, data, datatype)
     error ('expected data as a string or 1 by N row vector');
   endif
 
+  switch (datatype)
+    case {"string" "char" "schar" "int8" "uchar" "uint8" "int16" "short" ...
+          "uint16" "ushort" "int32" "int" "uint32" "uint" "long" "int64" ...
+          "ulong" "uint64" "single" "float" "float32" "double" "float64"}
+    otherwise
+      error ("datatype not supported");
+  endswitch
+
+  # instruments that build the block natively
+  switch (type)
+    case "octave_tcpclient"
+      __tcpclient_writebinblock__ (dev, data, datatype);
+      return;
+    case "octave_tcpserver"
+      __tcpserver_writebinblock__ (dev, data, datatype);
+      return;
+    case "octave_udpport"
+      __udpport_writebinblock__ (dev, data, datatype);
+      return;
+    case "octave_serialport"
+      __srlp_writebinblock__ (dev, data, datatype);
+      return;
+    case "octave_visadev"
+      __visadev_dispatch__ (dev, "writebinblock", data, datatype);
+      return;
+    case "octave_gpib"
+      __gpib_writebinblock__ (dev, data, datatype);
+      return;
+    case "octave_usbtmc"
+      __usbtmc_writebinblock__ (dev, data, datatype);
+      return;
+    case "octave_vxi11"
+      __vxi11_writebinblock__ (dev, data, datatype);
+      return;
+    case "octave_hislip"
+      __hislip_writebinblock__ (dev, data, datatype);
+      return;
+  endswitch
+
   switch (datatype)
     case {"string"}
       data = char (data);
@@ -76,25 +115,8 @@ function writebinblock (dev, data, datatype)
       data = single (data);
     case {"double" "float64"}
       data = double (data);
-    otherwise
-      error ("datatype not supported");
   endswitch
 
-  types_with_write = { "octave_udpport", "octave_serialport", ...
-                       "octave_tcpclient", "octave_tcpserver", ...
-                       "octave_udpport", "octave_visadev" };
-
-  if sum(strcmp(type, types_with_write)) > 0
-    # need fix endian
-    [~,~,endian] = computer();
-    e = upper(dev.ByteOrder);
-
-    if e(1) != endian
-      # need change endian
-      data = swapbytes(data);
-    endif
-  endif
-
   # make byte stream
   data = typecast(data,'uint8');
 
@@ -103,11 +125,7 @@ function writebinblock (dev, data, datatype)
   # fix the hdr for X = num digits for the %d size
   hdr(2) = num2str(numel(hdr)-2);
 
-  if sum(strcmp(type, types_with_write)) > 0
-    write (dev, [uint8(hdr) data uint8("\n")]);
-  else
-    fwrite (dev, [uint8(hdr) data uint8("\n")]);
-  endif
+  fwrite (dev, [uint8(hdr) data uint8("\n")]);
 
 endfunction
 
@@ -63,7 +63,7 @@ function writeline (dev, data)
     endif
 
     write (dev, [data terminator]);
-  elseif strcmp(type, "octave_visadev")
+  elseif strcmp(type, "octave_visadev") || strcmp(type, "octave_hislip")
     terminator = "\n";
     write (dev, [data terminator]);
   else
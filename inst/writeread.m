@@ -12,22 +12,68 @@
 
 ## -*- texinfo -*- 
 ## @deftypefn {} {@var{data} =} writeread (@var{dev}, @var{command})
+## @deftypefnx {} {@var{data} =} writeread (@var{dev}, @var{command}, @var{timeout})
 ## write a ASCII command and read data from a instrument device.
 ##
+## For TCPCLIENT, TCPSERVER, UDPPORT, SERIALPORT and VISADEV objects the
+## command and output terminator are sent in a single write and the
+## response line is read natively. For HISLIP objects the command is sent
+## as one message and the whole response message is read.
+##
 ## @subsubheading Inputs
 ## @var{dev} - connected device
 ##
 ## @var{command} - ASCII command
 ##
+## @var{timeout} - optional timeout in seconds for the response, used
+## instead of the object Timeout for TCPCLIENT, TCPSERVER, UDPPORT and
+## HISLIP objects.
+##
 ## @subsubheading Outputs
 ## @var{data} - ASCII data read
 ##
 ## @seealso{readline, writeline}
 ## @end deftypefn
 
-function data = writeread (dev, cmd)
-  writeline(dev, cmd);
-  data = readline(dev);
+function data = writeread (dev, cmd, timeout)
+
+  if nargin < 2
+    error ('expected instrument control device and command');
+  endif
+
+  type = typeinfo(dev);
+  if !strncmp(type, "octave_", 7)
+    error ('expected instrument control device');
+  endif
+
+  if !ischar(cmd)
+    error ("Expected command to be characters");
+  endif
+
+  if nargin < 3
+    tmo = {};
+  else
+    tmo = {timeout*1000};
+  endif
+
+  switch (type)
+    case "octave_tcpclient"
+      data = __tcpclient_writeread__ (dev, cmd, tmo{:});
+    case "octave_tcpserver"
+      data = __tcpserver_writeread__ (dev, cmd, tmo{:});
+    case "octave_udpport"
+      data = __udpport_writeread__ (dev, cmd, tmo{:});
+    case "octave_serialport"
+      data = __srlp_writeread__ (dev, cmd);
+    case "octave_visadev"
+      data = __visadev_dispatch__ (dev, "writeread", cmd);
+    case "octave_hislip"
+      data = __hislip_writeread__ (dev, cmd, tmo{:});
+    otherwise
+      writeline(dev, cmd);
+      data = readline(dev);
+  endswitch
+
 endfunction
 
 %!error writeread
@@ -42,3 +88,15 @@ endfunction
 %! data = writeread(a, "hello");
 %! assert(data, "hello");
 %! clear a
+
+%!test
+%! s = tcpserver (0);
+%! c = tcpclient ("127.0.0.1", s.ServerPort, "Timeout", 1);
+%! st = s.Connected;
+%! write (s, "+1.0E+00\n");
+%! data = writeread (c, "MEAS:VOLT?");
+%! assert (data, "+1.0E+00");
+%! assert (char (readline (s)), "MEAS:VOLT?");
+%! data = writeread (c, "MEAS:VOLT?", 0.1);
+%! assert (data, "");
+%! clear c s
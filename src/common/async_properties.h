@@ -0,0 +1,252 @@
+// Copyright (C) 2026 John Donoghue <john.donoghue@ieee.org>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+
+#ifndef OCTAVE_ASYNC_PROPERTIES_H
+#define OCTAVE_ASYNC_PROPERTIES_H
+
+#include "async_reader.h"
+#include "receive_buffer.h"
+
+#include <algorithm>
+
+// Property handlers shared by the classes that support a background
+// reader. T must provide
+//
+//   octave_async_reader & get_async (void)
+//   void set_readasyncmode (bool continuous)
+//   octave_value get_input_terminator (void) const
+//   void dispatch_callbacks (void)
+//   int wait_fd (bool &pending)
+//
+// and have an input event hook function named by T::async_hook ().
+
+// set the callback, starting the background reader when one is set
+template <typename T>
+void
+octave_async_configure (T *obj, octave_async_reader::callback_mode mode, int count, const octave_value &fcn)
+{
+  octave_async_reader &async = obj->get_async ();
+
+  async.set_callback (mode, count, octave_terminator_string (obj->get_input_terminator ()), fcn);
+
+  if (mode != octave_async_reader::callback_off && fcn.is_defined ())
+    {
+      if (! async.is_running ())
+        obj->set_readasyncmode (true);
+      octave_async_callbacks<T>::add (obj, T::async_hook ());
+    }
+  else
+    octave_async_callbacks<T>::remove (obj);
+}
+
+template <typename T>
+octave_value_list
+octave_async_readasyncmode (T *obj, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  if (args.length () > 0)
+    {
+      std::string mode = args(0).string_value ();
+      std::transform (mode.begin (), mode.end (), mode.begin (), ::tolower);
+
+      if (mode == "continuous")
+        obj->set_readasyncmode (true);
+      else if (mode == "manual")
+        obj->set_readasyncmode (false);
+      else
+        (*current_liboctave_error_handler) ("ReadAsyncMode must be 'continuous' or 'manual'");
+
+      return octave_value ();
+    }
+
+  return octave_value (obj->get_async ().is_running () ? "continuous" : "manual");
+}
+
+template <typename T>
+octave_value_list
+octave_async_bytesavailablefcn (T *obj, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  octave_async_reader &async = obj->get_async ();
+
+  if (args.length () > 0)
+    {
+      octave_value fcn;
+
+      if (args(0).is_function_handle () || (args(0).is_string () && ! args(0).string_value ().empty ()))
+        fcn = args(0);
+      else if (args(0).numel () > 0)
+        (*current_liboctave_error_handler) ("BytesAvailableFcn must be a function handle");
+
+      octave_async_configure (obj, async.get_callback_mode (), async.get_callback_count (), fcn);
+      return octave_value ();
+    }
+
+  octave_value fcn = async.get_callback ();
+  return fcn.is_defined () ? fcn : octave_value (Matrix ());
+}
+
+template <typename T>
+octave_value_list
+octave_async_bytesavailablefcncount (T *obj, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  octave_async_reader &async = obj->get_async ();
+
+  if (args.length () > 0)
+    {
+      int count = args(0).int_value ();
+      if (count < 1)
+        (*current_liboctave_error_handler) ("BytesAvailableFcnCount must be a positive integer");
+
+      octave_async_configure (obj, async.get_callback_mode (), count, async.get_callback ());
+      return octave_value ();
+    }
+
+  return octave_value (async.get_callback_count ());
+}
+
+template <typename T>
+octave_value_list
+octave_async_bytesavailablefcnmode (T *obj, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  octave_async_reader &async = obj->get_async ();
+
+  if (args.length () > 0)
+    {
+      std::string mode = args(0).string_value ();
+      std::transform (mode.begin (), mode.end (), mode.begin (), ::tolower);
+
+      octave_async_reader::callback_mode m;
+      if (mode == "off")
+        m = octave_async_reader::callback_off;
+      else if (mode == "byte")
+        m = octave_async_reader::callback_byte;
+      else if (mode == "terminator")
+        m = octave_async_reader::callback_terminator;
+      else
+        (*current_liboctave_error_handler) ("BytesAvailableFcnMode must be 'off', 'byte' or 'terminator'");
+
+      octave_async_configure (obj, m, async.get_callback_count (), async.get_callback ());
+      return octave_value ();
+    }
+
+  switch (async.get_callback_mode ())
+    {
+    case octave_async_reader::callback_byte:
+      return octave_value ("byte");
+    case octave_async_reader::callback_terminator:
+      return octave_value ("terminator");
+    default:
+      return octave_value ("off");
+    }
+}
+
+template <typename T>
+octave_value_list
+octave_async_inputbuffersize (T *obj, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  octave_async_reader &async = obj->get_async ();
+
+  if (args.length () > 0)
+    {
+      int size = args(0).int_value ();
+      if (size < 1)
+        (*current_liboctave_error_handler) ("InputBufferSize must be a positive integer");
+      if (async.is_running ())
+        (*current_liboctave_error_handler) ("InputBufferSize can not be set while ReadAsyncMode is 'continuous'");
+
+      async.set_buffer_size (size);
+      return octave_value ();
+    }
+
+  return octave_value (async.get_buffer_size ());
+}
+
+template <typename T>
+octave_value_list
+octave_async_numbytesdropped (T *obj, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (obj->get_async ().get_dropped ());
+}
+
+// [fd, pending] for instrwait. T must provide int wait_fd (bool &pending),
+// returning the descriptor to poll, or -1 if it can not be polled, and
+// setting pending if data is already buffered
+template <typename T>
+octave_value_list
+octave_async_waitinfo (T *obj, const octave_value_list& args, int)
+{
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  bool pending = false;
+  int fd = obj->wait_fd (pending);
+
+  Matrix info (1, 2);
+  info(0, 0) = fd;
+  info(0, 1) = pending;
+
+  return octave_value (info);
+}
+
+// configureCallback (obj, mode [, count], fcn)
+template <typename T>
+octave_value_list
+octave_async_configurecallback (T *obj, const octave_value_list& args, int)
+{
+  if (args.length () < 1 || args.length () > 3)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  octave_async_reader &async = obj->get_async ();
+
+  std::string mode = args(0).string_value ();
+  std::transform (mode.begin (), mode.end (), mode.begin (), ::tolower);
+
+  if (mode == "off" && args.length () == 1)
+    octave_async_configure (obj, octave_async_reader::callback_off, async.get_callback_count (), octave_value ());
+  else if (mode == "terminator" && args.length () == 2 && args(1).is_function_handle ())
+    octave_async_configure (obj, octave_async_reader::callback_terminator, async.get_callback_count (), args(1));
+  else if (mode == "byte" && args.length () == 3 && args(2).is_function_handle ())
+    {
+      int count = args(1).int_value ();
+      if (count < 1)
+        (*current_liboctave_error_handler) ("count must be a positive integer");
+      octave_async_configure (obj, octave_async_reader::callback_byte, count, args(2));
+    }
+  else
+    (*current_liboctave_error_handler) ("expected 'off', 'terminator' and a function handle, or 'byte', a count and a function handle");
+
+  return octave_value ();
+}
+
+#endif
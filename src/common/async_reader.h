@@ -0,0 +1,477 @@
+// Copyright (C) 2026 John Donoghue <john.donoghue@ieee.org>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+
+#ifndef OCTAVE_ASYNC_READER_H
+#define OCTAVE_ASYNC_READER_H
+
+#include <octave/oct.h>
+#include <octave/oct-map.h>
+#include <octave/quit.h>
+
+#ifdef HAVE_OCTAVE_INTERPRETER_H
+#  include <octave/interpreter.h>
+#endif
+#include <octave/parse.h>
+
+#include "receive_buffer.h"
+
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <string>
+#include <vector>
+#include <set>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <functional>
+#include <condition_variable>
+
+#ifndef __WIN32__
+#  include <unistd.h>
+#  include <fcntl.h>
+#endif
+
+// Single producer, single consumer byte ring buffer. The producer only
+// moves head and the consumer only moves tail, so neither side takes a
+// lock. Both are free running counters, wrapped with the power of two
+// size mask.
+class octave_ring_buffer
+{
+public:
+  octave_ring_buffer (void) : mask (0), head (0), tail (0) { }
+
+  // only while neither side is running
+  void resize (size_t capacity)
+  {
+    size_t n = 1;
+    while (n < capacity)
+      n <<= 1;
+    buf.assign (n, 0);
+    mask = n - 1;
+    head = 0;
+    tail = 0;
+  }
+
+  size_t capacity (void) const { return buf.size (); }
+
+  size_t size (void) const
+  {
+    return head.load (std::memory_order_acquire) - tail.load (std::memory_order_acquire);
+  }
+
+  // producer: append up to len bytes, returning the number that fitted
+  size_t write (const uint8_t *data, size_t len)
+  {
+    size_t h = head.load (std::memory_order_relaxed);
+    size_t space = buf.size () - (h - tail.load (std::memory_order_acquire));
+    if (len > space)
+      len = space;
+
+    size_t pos = h & mask;
+    size_t first = buf.size () - pos;
+    if (first > len)
+      first = len;
+    memcpy (&buf[pos], data, first);
+    memcpy (&buf[0], data + first, len - first);
+
+    head.store (h + len, std::memory_order_release);
+    return len;
+  }
+
+  // consumer: remove up to len bytes, returning the number copied
+  size_t read (uint8_t *data, size_t len)
+  {
+    size_t t = tail.load (std::memory_order_relaxed);
+    size_t avail = head.load (std::memory_order_acquire) - t;
+    if (len > avail)
+      len = avail;
+
+    size_t pos = t & mask;
+    size_t first = buf.size () - pos;
+    if (first > len)
+      first = len;
+    memcpy (data, &buf[pos], first);
+    memcpy (data + first, &buf[0], len - first);
+
+    tail.store (t + len, std::memory_order_release);
+    return len;
+  }
+
+  // consumer: discard everything currently buffered
+  void clear (void)
+  {
+    tail.store (head.load (std::memory_order_acquire), std::memory_order_release);
+  }
+
+private:
+  std::vector<uint8_t> buf;
+  size_t mask;
+  std::atomic<size_t> head;
+  std::atomic<size_t> tail;
+};
+
+// Background reader for a device, used when ReadAsyncMode is
+// "continuous". A thread calls readfn (uint8_t *buf, unsigned int len,
+// int timeout_ms), which returns the bytes read, 0 on a timeout or < 0
+// when the device is closed or fails, and keeps the data in a bounded
+// ring buffer. Data that does not fit is dropped and counted.
+//
+// readfn runs on the reader thread so must not call any octave function.
+//
+// BytesAvailableFcn callbacks are counted by the reader thread and run
+// on the interpreter thread by dispatch ().
+//
+// wait_fd () gives a descriptor that polls readable once the thread has
+// stored more data, for waiting on several devices at once.
+class octave_async_reader
+{
+public:
+  typedef std::function<int (uint8_t *, unsigned int, int)> read_function;
+
+  enum callback_mode
+  {
+    callback_off,
+    callback_byte,
+    callback_terminator
+  };
+
+  octave_async_reader (void)
+    : running (false), failed (false), stopping (false), dropped (0),
+      received (0), terms (0), term_match (0), base (0), fired (0),
+      mode (callback_off), count (64), buffer_size (1048576)
+  {
+    notify[0] = notify[1] = -1;
+  }
+
+  ~octave_async_reader (void)
+  {
+    stop ();
+#ifndef __WIN32__
+    if (notify[0] >= 0)
+      {
+        ::close (notify[0]);
+        ::close (notify[1]);
+      }
+#endif
+  }
+
+  bool is_running (void) const { return running; }
+
+  void start (read_function fn)
+  {
+    stop ();
+
+    ring.resize (buffer_size);
+#ifndef __WIN32__
+    if (notify[0] < 0 && ::pipe (notify) == 0)
+      {
+        ::fcntl (notify[0], F_SETFL, ::fcntl (notify[0], F_GETFL) | O_NONBLOCK);
+        ::fcntl (notify[1], F_SETFL, ::fcntl (notify[1], F_GETFL) | O_NONBLOCK);
+      }
+#endif
+    readfn = fn;
+    failed = false;
+    stopping = false;
+    running = true;
+    worker = std::thread (&octave_async_reader::run, this);
+  }
+
+  // must be called before the device the reader uses is closed
+  void stop (void)
+  {
+    if (worker.joinable ())
+      {
+        stopping = true;
+        worker.join ();
+      }
+    running = false;
+  }
+
+  // stop, moving any data not yet read to rx so that later reads still
+  // return it
+  void stop (octave_receive_buffer &rx)
+  {
+    stop ();
+
+    while (ring.size () > 0)
+      {
+        rx.fill (0,
+          [this] (uint8_t *buf, unsigned int len)
+          {
+            return static_cast<int> (ring.read (buf, len));
+          },
+          [this] (void)
+          {
+            return static_cast<int> (ring.size ());
+          });
+      }
+  }
+
+  size_t available (void) const { return ring.size (); }
+
+  // true once the reader has stopped on an error
+  bool has_failed (void) const { return failed; }
+
+  // read up to len bytes, waiting up to timeout ms (forever if < 0) for
+  // all of them. Returns -1 if nothing could be read because the reader
+  // stopped on an error.
+  int read (uint8_t *buf, unsigned int len, double timeout)
+  {
+    size_t got = ring.read (buf, len);
+
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now ()
+      + std::chrono::microseconds (static_cast<long long> (timeout > 0 ? timeout * 1000 : 0));
+
+    while (got < len && timeout != 0)
+      {
+        if (failed)
+          break;
+
+        if (timeout > 0 && std::chrono::steady_clock::now () >= deadline)
+          break;
+
+        OCTAVE_QUIT;
+
+        // wake at least every 100ms to allow a ctrl-c
+        std::chrono::steady_clock::time_point wake = std::chrono::steady_clock::now ()
+          + std::chrono::milliseconds (100);
+        if (timeout > 0 && deadline < wake)
+          wake = deadline;
+
+        {
+          std::unique_lock<std::mutex> lock (mutex);
+          data_ready.wait_until (lock, wake, [this] (void) { return ring.size () > 0 || failed; });
+        }
+
+        got += ring.read (buf + got, len - got);
+      }
+
+    if (got == 0 && failed)
+      return -1;
+
+    return got;
+  }
+
+  void clear (void) { ring.clear (); }
+
+  // descriptor to poll for data stored after this call, or -1 if there
+  // is none. Check available () after calling it, as data stored before
+  // the call does not wake the poll.
+  int wait_fd (void)
+  {
+#ifndef __WIN32__
+    if (notify[0] >= 0)
+      {
+        char tmp[64];
+        while (::read (notify[0], tmp, sizeof (tmp)) > 0) { }
+      }
+#endif
+    return notify[0];
+  }
+
+  // bytes dropped because the ring buffer was full
+  double get_dropped (void) const { return static_cast<double> (dropped.load ()); }
+
+  int get_buffer_size (void) const { return buffer_size; }
+
+  // takes effect the next time the reader is started
+  void set_buffer_size (int size) { buffer_size = size; }
+
+  // callback settings, used from the interpreter thread
+  void set_callback (callback_mode m, int cnt, const std::string &term, const octave_value &fcn)
+  {
+    std::lock_guard<std::mutex> lock (mutex);
+    mode = m;
+    count = cnt;
+    terminator = term;
+    callback = fcn;
+    term_match = 0;
+    base = (m == callback_terminator ? terms.load () : received.load ());
+    fired = 0;
+  }
+
+  // follow a change of the input terminator, for terminator callbacks
+  void set_terminator (const std::string &term)
+  {
+    std::lock_guard<std::mutex> lock (mutex);
+    if (term != terminator)
+      {
+        terminator = term;
+        term_match = 0;
+      }
+  }
+
+  callback_mode get_callback_mode (void) const { return mode; }
+  int get_callback_count (void) const { return count; }
+  octave_value get_callback (void) const { return callback; }
+
+  // run any callbacks due since the last call, passing obj and an
+  // event struct. Must be called from the interpreter thread.
+  void dispatch (const octave_value &obj)
+  {
+    if (mode == callback_off || ! callback.is_defined ())
+      return;
+
+    while (true)
+      {
+        uint64_t due = (mode == callback_terminator ? terms.load () - base : (received.load () - base) / count);
+        if (fired >= due)
+          break;
+        fired++;
+
+        octave_scalar_map evt;
+        evt.assign ("Type", "BytesAvailable");
+        evt.assign ("BytesAvailableFcnCount", count);
+        // datenum of the current time
+        evt.assign ("AbsTime", 719529.0 + static_cast<double> (::time (0)) / 86400.0);
+
+        octave_value_list args;
+        args(0) = obj;
+        args(1) = evt;
+        OCTAVE__FEVAL (callback, args, 0);
+      }
+  }
+
+private:
+  void run (void)
+  {
+    std::vector<uint8_t> chunk (65536);
+
+    while (! stopping)
+      {
+        int n = readfn (&chunk[0], chunk.size (), 100);
+        if (n < 0)
+          {
+            std::lock_guard<std::mutex> lock (mutex);
+            failed = true;
+            data_ready.notify_all ();
+            wake_waiters ();
+            break;
+          }
+        if (n == 0)
+          continue;
+
+        size_t stored = ring.write (&chunk[0], n);
+        if (stored < static_cast<size_t> (n))
+          dropped += n - stored;
+
+        std::lock_guard<std::mutex> lock (mutex);
+        received += n;
+        if (mode == callback_terminator)
+          count_terminators (&chunk[0], n);
+        data_ready.notify_all ();
+        wake_waiters ();
+      }
+  }
+
+  void wake_waiters (void)
+  {
+#ifndef __WIN32__
+    // a full pipe already wakes the poll, so a failed write is fine
+    if (notify[1] >= 0 && ::write (notify[1], "", 1) < 0) { }
+#endif
+  }
+
+  // called with the mutex held
+  void count_terminators (const uint8_t *data, size_t len)
+  {
+    size_t tlen = terminator.length ();
+    if (tlen == 0)
+      return;
+
+    for (size_t i = 0; i < len; i++)
+      {
+        if (data[i] == static_cast<uint8_t> (terminator[term_match]))
+          term_match++;
+        else
+          term_match = (data[i] == static_cast<uint8_t> (terminator[0])) ? 1 : 0;
+
+        if (term_match == tlen)
+          {
+            terms++;
+            term_match = 0;
+          }
+      }
+  }
+
+  octave_ring_buffer ring;
+  read_function readfn;
+  std::thread worker;
+  std::mutex mutex;
+  std::condition_variable data_ready;
+  int notify[2];
+
+  std::atomic<bool> running;
+  std::atomic<bool> failed;
+  std::atomic<bool> stopping;
+  std::atomic<uint64_t> dropped;
+  std::atomic<uint64_t> received;
+  std::atomic<uint64_t> terms;
+  size_t term_match;
+  uint64_t base;
+  uint64_t fired;
+
+  callback_mode mode;
+  int count;
+  int buffer_size;
+  std::string terminator;
+  octave_value callback;
+};
+
+// Objects of type T that have a BytesAvailableFcn set. Their callbacks
+// are run from an input event hook, so they fire while octave is idle at
+// the prompt as well as whenever the object is read.
+template <typename T>
+class octave_async_callbacks
+{
+public:
+  static void add (T *obj, const char *hook)
+  {
+    objects ().insert (obj);
+
+    static bool hooked = false;
+    if (! hooked)
+      {
+        hooked = true;
+        octave_value_list args;
+        args(0) = octave_value (hook);
+        OCTAVE__FEVAL (std::string ("add_input_event_hook"), args, 0);
+      }
+  }
+
+  static void remove (T *obj) { objects ().erase (obj); }
+
+  static void dispatch_all (void)
+  {
+    // a callback may delete an object, so work on a copy
+    std::set<T *> current = objects ();
+    for (typename std::set<T *>::iterator it = current.begin (); it != current.end (); ++it)
+      {
+        if (objects ().count (*it))
+          (*it)->dispatch_callbacks ();
+      }
+  }
+
+private:
+  static std::set<T *> & objects (void)
+  {
+    static std::set<T *> list;
+    return list;
+  }
+};
+
+#endif
@@ -0,0 +1,221 @@
+// Copyright (C) 2026 John Donoghue <john.donoghue@ieee.org>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+
+#ifndef OCTAVE_BINBLOCK_H
+#define OCTAVE_BINBLOCK_H
+
+#include "byte_view.h"
+#include "receive_buffer.h"
+#include "typed_data.h"
+
+#include <stdio.h>
+
+// IEEE 488.2 binblock
+//
+//   #<A><B><C>
+//
+// <A> one ASCII digit giving the number of digits in <B>
+// <B> ASCII number of bytes in <C>
+// <C> binary data, followed by a LF terminator
+//
+// A <A> of 0 is an indefinite length block, where <C> runs up to the LF.
+
+// make sure at least len bytes are in rx, reading more as needed
+template <typename R, typename C>
+bool
+octave_binblock_need (octave_receive_buffer &rx, size_t len, R readfn, C chunkfn)
+{
+  while (rx.size () < len)
+    {
+      if (rx.fill (len - rx.size (), readfn, chunkfn) <= 0)
+        return false;
+    }
+  return true;
+}
+
+// read a binblock as the given type, discarding any data before the '#'.
+// Data is read through rx, using readfn (uint8_t *buf, unsigned int len)
+// and asking for chunkfn () bytes at a time, except for the block data
+// which is read directly into the result. The LF after the block is only
+// taken if it is buffered or availfn () is > 0, meaning more data can be
+// read without waiting, so a block ended by EOI or END alone does not
+// wait for the timeout. Returns an empty array if no complete header is
+// read.
+template <typename R, typename C, typename A>
+octave_value
+octave_read_binblock (octave_receive_buffer &rx, const octave_data_type &type, bool swap, R readfn, C chunkfn, A availfn)
+{
+  octave_value empty = octave_read_typed (type, 0, false, readfn);
+
+  // scan for start of header
+  while (true)
+    {
+      const uint8_t *p = 0;
+      if (rx.size () > 0)
+        p = static_cast<const uint8_t *> (memchr (rx.peek (), '#', rx.size ()));
+      if (p)
+        {
+          rx.consume (p - rx.peek ());
+          break;
+        }
+      rx.clear ();
+      if (! octave_binblock_need (rx, 1, readfn, chunkfn))
+        return empty;
+    }
+
+  if (! octave_binblock_need (rx, 2, readfn, chunkfn))
+    return empty;
+
+  const uint8_t *hdr = rx.peek ();
+  if (hdr[1] < '0' || hdr[1] > '9')
+    {
+      rx.consume (1);
+      return empty;
+    }
+
+  size_t digits = hdr[1] - '0';
+
+  if (digits == 0)
+    {
+      // indefinite length, ends at the LF
+      rx.consume (2);
+
+      std::string block;
+      rx.read_line ("\n", block, readfn, chunkfn);
+
+      size_t count = block.length () / type.size;
+      return octave_read_typed (type, count, swap,
+        [&block] (uint8_t *buf, unsigned int len)
+        {
+          memcpy (buf, block.data (), len);
+          return static_cast<int> (len);
+        });
+    }
+
+  if (! octave_binblock_need (rx, 2 + digits, readfn, chunkfn))
+    return empty;
+
+  size_t len = 0;
+  hdr = rx.peek ();
+  for (size_t i = 0; i < digits; i++)
+    {
+      if (hdr[2+i] < '0' || hdr[2+i] > '9')
+        {
+          rx.consume (1);
+          return empty;
+        }
+      len = len * 10 + (hdr[2+i] - '0');
+    }
+  rx.consume (2 + digits);
+
+  // read the block data, taking what is already buffered first
+  size_t remaining = len;
+  auto payload = [&rx, &readfn, &remaining] (uint8_t *buf, unsigned int n)
+    {
+      size_t got = rx.take (buf, n);
+      while (got < n)
+        {
+          int r = readfn (buf + got, n - got);
+          if (r <= 0)
+            break;
+          got += r;
+        }
+      remaining -= got;
+      return static_cast<int> (got);
+    };
+
+  octave_value data = octave_read_typed (type, len / type.size, swap, payload);
+
+  // any part value at the end of the block
+  uint8_t tail[8];
+  if (remaining > 0 && remaining < type.size)
+    payload (tail, remaining);
+
+  // trailing terminator
+  if (remaining == 0 && (rx.size () > 0 || availfn () > 0)
+      && octave_binblock_need (rx, 1, readfn, chunkfn) && *rx.peek () == '\n')
+    rx.consume (1);
+
+  return data;
+}
+
+// read a binblock from a stream, where chunkfn () is the number of bytes
+// available
+template <typename R, typename C>
+octave_value
+octave_read_binblock (octave_receive_buffer &rx, const octave_data_type &type, bool swap, R readfn, C chunkfn)
+{
+  return octave_read_binblock (rx, type, swap, readfn, chunkfn, chunkfn);
+}
+
+// write data as a binblock of the given type, passing the header, data
+// and LF terminator to writefn (const octave_write_part *parts, int n)
+// as the parts of a single gathered write, so that the data is not copied
+template <typename F>
+int
+octave_write_binblock_parts (const octave_value &v, const octave_data_type &type, bool swap, F writefn)
+{
+  return octave_write_typed (v, type, swap,
+    [&writefn] (uint8_t *buf, unsigned int len)
+    {
+      char hdr[32];
+      int hlen = snprintf (hdr, sizeof (hdr), "#0%u", len);
+      if (hlen - 2 > 9)
+        error ("writebinblock: data too large for a binblock");
+      hdr[1] = '0' + (hlen - 2);
+
+      static const uint8_t lf = '\n';
+
+      octave_write_part parts[3];
+      parts[0].data = reinterpret_cast<const uint8_t *> (hdr);
+      parts[0].len = hlen;
+      parts[1].data = buf;
+      parts[1].len = len;
+      parts[2].data = &lf;
+      parts[2].len = 1;
+
+      return writefn (parts, 3);
+    });
+}
+
+// write data as a binblock of the given type, with the header, data and
+// LF terminator copied into one buffer for a single
+// writefn (uint8_t *buf, unsigned int len) call, for the devices where
+// each write is a message of its own
+template <typename F>
+int
+octave_write_binblock (const octave_value &v, const octave_data_type &type, bool swap, F writefn)
+{
+  return octave_write_binblock_parts (v, type, swap,
+    [&writefn] (const octave_write_part *parts, int n)
+    {
+      size_t total = 0;
+      for (int i = 0; i < n; i++)
+        total += parts[i].len;
+
+      std::vector<uint8_t> block (total);
+      size_t at = 0;
+      for (int i = 0; i < n; i++)
+        {
+          if (parts[i].len > 0)
+            memcpy (&block[at], parts[i].data, parts[i].len);
+          at += parts[i].len;
+        }
+
+      return writefn (&block[0], block.size ());
+    });
+}
+
+#endif
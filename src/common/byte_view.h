@@ -0,0 +1,98 @@
+// Copyright (C) 2026 John Donoghue <john.donoghue@ieee.org>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+
+#ifndef OCTAVE_BYTE_VIEW_H
+#define OCTAVE_BYTE_VIEW_H
+
+#include <octave/oct.h>
+#include <octave/int8NDArray.h>
+#include <octave/uint8NDArray.h>
+#include <octave/int16NDArray.h>
+#include <octave/uint16NDArray.h>
+#include <octave/int32NDArray.h>
+#include <octave/uint32NDArray.h>
+#include <octave/int64NDArray.h>
+#include <octave/uint64NDArray.h>
+
+#include <stdint.h>
+#include <memory>
+
+// Read only view of the bytes of a char, integer or floating point array,
+// in memory order, without converting or copying the data. The array is
+// held by the view so the bytes stay valid for as long as it exists.
+class octave_byte_view
+{
+public:
+  // when bytes_only is set, only char, int8 and uint8 values are accepted
+  octave_byte_view (const octave_value &v, bool bytes_only = false)
+    : ptr (0), len (0)
+  {
+    if (v.is_string ())
+      hold (v.char_array_value ());
+    else if (v.is_uint8_type ())
+      hold (v.uint8_array_value ());
+    else if (v.is_int8_type ())
+      hold (v.int8_array_value ());
+    else if (bytes_only)
+      return;
+    else if (v.is_uint16_type ())
+      hold (v.uint16_array_value ());
+    else if (v.is_int16_type ())
+      hold (v.int16_array_value ());
+    else if (v.is_uint32_type ())
+      hold (v.uint32_array_value ());
+    else if (v.is_int32_type ())
+      hold (v.int32_array_value ());
+    else if (v.is_uint64_type ())
+      hold (v.uint64_array_value ());
+    else if (v.is_int64_type ())
+      hold (v.int64_array_value ());
+    else if (v.is_single_type ())
+      hold (v.float_array_value ());
+    else if (v.is_double_type ())
+      hold (v.array_value ());
+  }
+
+  bool is_valid (void) const { return holder.get () != 0; }
+
+  // the transport write functions take a non const buffer, but do not
+  // modify it
+  uint8_t * data (void) const { return const_cast<uint8_t *> (ptr); }
+
+  unsigned int length (void) const { return len; }
+
+private:
+  template <typename A>
+  void hold (const A &a)
+  {
+    std::shared_ptr<A> p (new A (a));
+    holder = p;
+    ptr = reinterpret_cast<const uint8_t *> (p->data ());
+    len = p->numel () * sizeof (typename A::element_type);
+  }
+
+  std::shared_ptr<void> holder;
+  const uint8_t *ptr;
+  unsigned int len;
+};
+
+// a part of a gathered write
+struct octave_write_part
+{
+  const uint8_t *data;
+  unsigned int len;
+};
+
+#endif
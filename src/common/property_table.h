@@ -0,0 +1,95 @@
+// Copyright (C) 2026 John Donoghue <john.donoghue@ieee.org>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+
+#ifndef OCTAVE_PROPERTY_TABLE_H
+#define OCTAVE_PROPERTY_TABLE_H
+
+#include <octave/oct.h>
+
+#include <algorithm>
+#include <cctype>
+#include <string>
+#include <unordered_map>
+
+// A property handler is called with an empty args list to get the
+// property value, or with the value(s) to set it to.
+template <typename T>
+struct octave_property
+{
+  const char * name;
+  octave_value_list (*handler) (T *, const octave_value_list &, int);
+  bool visible; // shown as a field and accessible using obj.Name
+};
+
+// Lookup table of the properties of a class, built once from a NULL
+// terminated array of octave_property and used directly by subsref,
+// subsasgn and the __*_properties__ functions rather than going through
+// feval and a chain of string compares.
+template <typename T>
+class octave_property_table
+{
+public:
+  typedef octave_property<T> property_type;
+
+  octave_property_table (const property_type *props)
+  {
+    for (const property_type *p = props; p->name != NULL; p++)
+      {
+        exact[p->name] = p;
+        nocase[lower (p->name)] = p;
+
+        if (p->visible)
+          names.append (std::string (p->name));
+      }
+  }
+
+  // exact match of name
+  const property_type * find_exact (const std::string &name) const
+  {
+    typename map_type::const_iterator it = exact.find (name);
+    return it != exact.end () ? it->second : NULL;
+  }
+
+  // case insensitive match of name
+  const property_type * find (const std::string &name) const
+  {
+    typename map_type::const_iterator it = nocase.find (lower (name));
+    return it != nocase.end () ? it->second : NULL;
+  }
+
+  // exact match of a visible property name, as used for obj.Name
+  const property_type * find_field (const std::string &name) const
+  {
+    const property_type *p = find_exact (name);
+    return (p && p->visible) ? p : NULL;
+  }
+
+  string_vector fieldnames (void) const { return names; }
+
+private:
+  typedef std::unordered_map<std::string, const property_type *> map_type;
+
+  static std::string lower (std::string s)
+  {
+    std::transform (s.begin (), s.end (), s.begin (), ::tolower);
+    return s;
+  }
+
+  map_type exact;
+  map_type nocase;
+  string_vector names;
+};
+
+#endif
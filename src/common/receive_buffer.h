@@ -0,0 +1,226 @@
+// Copyright (C) 2026 John Donoghue <john.donoghue@ieee.org>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+
+#ifndef OCTAVE_RECEIVE_BUFFER_H
+#define OCTAVE_RECEIVE_BUFFER_H
+
+#include <octave/oct.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+// convert a Terminator property value ("lf", "cr", "cr/lf" or a character
+// code) to the terminator bytes
+inline std::string
+octave_terminator_string (const octave_value &t)
+{
+  if (t.is_string ())
+    {
+      std::string term = t.string_value ();
+      std::transform (term.begin (), term.end (), term.begin (), ::tolower);
+      if (term == "lf")
+        return "\n";
+      else if (term == "cr")
+        return "\r";
+      else if (term == "cr/lf")
+        return "\r\n";
+      return term;
+    }
+  return std::string (1, static_cast<char> (t.int_value ()));
+}
+
+// Bytes received from a device but not yet returned to the caller.
+// readline reads in chunks, so any data following a terminator is kept
+// here and returned first by the next read.
+class octave_receive_buffer
+{
+public:
+  octave_receive_buffer (void) : start (0) { }
+
+  size_t size (void) const { return data.size () - start; }
+
+  void clear (void)
+  {
+    data.clear ();
+    start = 0;
+  }
+
+  // copy up to len buffered bytes to buf, returning the number copied
+  size_t take (uint8_t *buf, size_t len)
+  {
+    size_t n = std::min (len, size ());
+    if (n > 0)
+      {
+        memcpy (buf, &data[start], n);
+        start += n;
+        if (start == data.size ())
+          clear ();
+      }
+    return n;
+  }
+
+  const uint8_t * peek (void) const { return data.data () + start; }
+
+  void consume (size_t len)
+  {
+    start += std::min (len, size ());
+    if (start == data.size ())
+      clear ();
+  }
+
+  // append data read with readfn (uint8_t *buf, unsigned int len) to the
+  // buffer, asking for chunkfn () bytes but at least len, and returning
+  // the readfn result
+  template <typename R, typename C>
+  int fill (unsigned int len, R readfn, C chunkfn)
+  {
+    holder h (*this);
+
+    int want = chunkfn ();
+    if (want > max_chunk)
+      want = max_chunk;
+    if (want < static_cast<int> (len))
+      want = len;
+
+    return h.read (readfn, want);
+  }
+
+  // read until term is found, returning the text before it in line and
+  // keeping anything after it buffered. More data is read with
+  // readfn (uint8_t *buf, unsigned int len), asking for chunkfn () bytes
+  // (at least 1) at a time. If readfn returns no data, line is set to
+  // everything read so far and false is returned.
+  template <typename R, typename C>
+  bool read_line (const std::string &term, std::string &line, R readfn, C chunkfn)
+  {
+    holder h (*this);
+    const std::vector<uint8_t> &pending = h.pending;
+
+    size_t tlen = term.length ();
+    size_t scan = h.offset;
+
+    while (true)
+      {
+        size_t pos = find (pending, scan, term);
+        if (pos != std::string::npos)
+          {
+            line.assign (reinterpret_cast<const char *> (pending.data () + h.offset), pos - h.offset);
+            h.offset = pos + tlen;
+            return true;
+          }
+
+        // a terminator may start in the last tlen-1 bytes
+        if (pending.size () - h.offset >= tlen)
+          scan = pending.size () - tlen + 1;
+
+        int want = chunkfn ();
+        if (want < 1)
+          want = 1;
+        else if (want > max_chunk)
+          want = max_chunk;
+
+        if (h.read (readfn, want) <= 0)
+          {
+            line.assign (reinterpret_cast<const char *> (pending.data () + h.offset), pending.size () - h.offset);
+            h.offset = pending.size ();
+            return false;
+          }
+      }
+  }
+
+private:
+  static const int max_chunk = 65536;
+
+  // Holds the buffered data out of the buffer while the device is read,
+  // so that readfn and chunkfn see the device, and puts it back with
+  // what was read when it goes, also when readfn throws.
+  class holder
+  {
+  public:
+    holder (octave_receive_buffer &b) : offset (b.start), rx (b)
+    {
+      pending.swap (b.data);
+      b.start = 0;
+      used = pending.size ();
+    }
+
+    ~holder (void)
+    {
+      // a throw from readfn leaves room for a read that did not happen
+      pending.resize (used);
+      if (offset < used)
+        {
+          // readfn may have buffered more data, as a visadev completing
+          // an asynchronous read does, which follows what is held
+          if (rx.size () > 0)
+            pending.insert (pending.end (), rx.peek (), rx.peek () + rx.size ());
+          rx.data.swap (pending);
+          rx.start = offset;
+        }
+    }
+
+    // append up to want bytes read with readfn
+    template <typename R>
+    int read (R readfn, int want)
+    {
+      pending.resize (used + want);
+      int got = readfn (&pending[used], want);
+      if (got > 0)
+        used += got;
+      pending.resize (used);
+      return got;
+    }
+
+    std::vector<uint8_t> pending;
+    // start of the data not yet returned
+    size_t offset;
+
+  private:
+    octave_receive_buffer &rx;
+    // bytes of pending holding data
+    size_t used;
+  };
+
+  static size_t find (const std::vector<uint8_t> &buf, size_t from, const std::string &term)
+  {
+    size_t tlen = term.length ();
+    if (tlen == 0 || buf.size () < tlen)
+      return std::string::npos;
+
+    const uint8_t *base = buf.data ();
+    const uint8_t *p = base + from;
+    const uint8_t *last = base + buf.size () - tlen;
+    const uint8_t first = term[0];
+
+    while (p <= last)
+      {
+        p = static_cast<const uint8_t *> (memchr (p, first, last - p + 1));
+        if (! p)
+          break;
+        if (memcmp (p, term.data (), tlen) == 0)
+          return p - base;
+        p++;
+      }
+    return std::string::npos;
+  }
+
+  std::vector<uint8_t> data;
+  size_t start;
+};
+
+#endif
@@ -0,0 +1,146 @@
+// Copyright (C) 2026 John Donoghue <john.donoghue@ieee.org>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+
+#ifndef OCTAVE_SOCKET_UTIL_H
+#define OCTAVE_SOCKET_UTIL_H
+
+#include "byte_view.h"
+
+#include <string.h>
+#include <string>
+#include <vector>
+
+#ifndef __WIN32__
+#  include <errno.h>
+#  include <unistd.h>
+#  include <sys/types.h>
+#  include <sys/socket.h>
+#  include <sys/uio.h>
+#  include <netinet/in.h>
+#  include <netdb.h>
+#  include <arpa/inet.h>
+#else
+#  include <winsock2.h>
+#endif
+
+// set the address of in from a dotted address or a host name, returning
+// false if the name is not known
+inline bool
+octave_lookup_addr (const std::string &ip, sockaddr_in *in)
+{
+  in->sin_addr.s_addr = inet_addr (ip.c_str());
+
+  if (in->sin_addr.s_addr == INADDR_NONE)
+    {
+      struct hostent * host = gethostbyname (ip.c_str());
+      if (!host)
+        return false;
+
+      memcpy(&in->sin_addr, host->h_addr_list[0], host->h_length);
+    }
+
+  return true;
+}
+
+inline int
+octave_close_socket (int fd)
+{
+#ifndef __WIN32__
+  return ::close (fd);
+#else
+  return ::closesocket (fd);
+#endif
+}
+
+// Send parts as a single gathered write, to addr if it is given. On a
+// datagram socket the parts go as one datagram; on a stream socket what
+// one send does not take is sent by the next. Returns the number of bytes
+// sent, or -1 on an error before any were.
+inline int
+octave_send_parts (int sock, const octave_write_part *parts, int nparts,
+                   const struct sockaddr *addr = 0, int addrlen = 0)
+{
+#ifndef __WIN32__
+  std::vector<struct iovec> iov (nparts);
+  size_t total = 0;
+  for (int i = 0; i < nparts; i++)
+    {
+      iov[i].iov_base = const_cast<uint8_t *> (parts[i].data);
+      iov[i].iov_len = parts[i].len;
+      total += parts[i].len;
+    }
+
+  size_t sent = 0;
+  size_t first = 0;
+  while (sent < total)
+    {
+      struct msghdr msg;
+      memset (&msg, 0, sizeof (msg));
+      msg.msg_name = const_cast<struct sockaddr *> (addr);
+      msg.msg_namelen = addrlen;
+      msg.msg_iov = &iov[first];
+      msg.msg_iovlen = iov.size () - first;
+
+      ssize_t ret = ::sendmsg (sock, &msg, 0);
+      if (ret < 0)
+        {
+          if (errno == EINTR)
+            continue;
+          return sent > 0 ? static_cast<int> (sent) : -1;
+        }
+
+      sent += ret;
+      if (addr)
+        break;
+
+      // step past what went
+      while (ret > 0)
+        {
+          if (static_cast<size_t> (ret) >= iov[first].iov_len)
+            {
+              ret -= iov[first].iov_len;
+              first++;
+            }
+          else
+            {
+              iov[first].iov_base = static_cast<char *> (iov[first].iov_base) + ret;
+              iov[first].iov_len -= ret;
+              ret = 0;
+            }
+        }
+    }
+
+  return static_cast<int> (sent);
+#else
+  std::vector<WSABUF> bufs (nparts);
+  for (int i = 0; i < nparts; i++)
+    {
+      bufs[i].buf = reinterpret_cast<char *> (const_cast<uint8_t *> (parts[i].data));
+      bufs[i].len = parts[i].len;
+    }
+
+  // a blocking stream socket sends everything before returning
+  DWORD sent = 0;
+  int ret;
+  if (addr)
+    ret = ::WSASendTo (sock, &bufs[0], nparts, &sent, 0, addr, addrlen, NULL, NULL);
+  else
+    ret = ::WSASend (sock, &bufs[0], nparts, &sent, 0, NULL, NULL);
+
+  return ret == 0 ? static_cast<int> (sent) : -1;
+#endif
+}
+
+#endif
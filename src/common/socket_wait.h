@@ -0,0 +1,165 @@
+// Copyright (C) 2026 John Donoghue <john.donoghue@ieee.org>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+
+#ifndef OCTAVE_SOCKET_WAIT_H
+#define OCTAVE_SOCKET_WAIT_H
+
+#include <octave/oct.h>
+#include <octave/quit.h>
+
+#include <chrono>
+
+#ifndef __WIN32__
+#  include <errno.h>
+#  include <poll.h>
+#  include <time.h>
+#else
+#  include <winsock2.h>
+#endif
+
+// Absolute deadline for a read, on the monotonic clock so that it is not
+// affected by changes to the time of day. A timeout < 0 never expires.
+class octave_deadline
+{
+public:
+  typedef std::chrono::steady_clock clock;
+
+  explicit octave_deadline (double timeout_ms)
+    : forever (timeout_ms < 0),
+      end (clock::now () + std::chrono::microseconds (static_cast<long long> (timeout_ms > 0 ? timeout_ms * 1000 : 0)))
+  { }
+
+  bool is_forever (void) const { return forever; }
+
+  bool expired (void) const { return ! forever && clock::now () >= end; }
+
+  // time left, or a negative value if forever
+  std::chrono::nanoseconds remaining (void) const
+  {
+    if (forever)
+      return std::chrono::nanoseconds (-1);
+
+    std::chrono::nanoseconds left = std::chrono::duration_cast<std::chrono::nanoseconds> (end - clock::now ());
+    return left.count () > 0 ? left : std::chrono::nanoseconds (0);
+  }
+
+private:
+  bool forever;
+  clock::time_point end;
+};
+
+// Wait until sock is readable or the deadline passes, returning 1 if it
+// is readable, 0 on a timeout and -1 on an error. The wait is made in
+// slices of at most 100ms, so that a ctrl-c is acted on between them.
+inline int
+octave_wait_readable (int sock, const octave_deadline &deadline)
+{
+  const std::chrono::nanoseconds max_wait = std::chrono::milliseconds (100);
+
+#ifndef __WIN32__
+  struct pollfd pfd;
+  pfd.fd = sock;
+  pfd.events = POLLIN;
+#endif
+
+  while (true)
+    {
+      OCTAVE_QUIT;
+
+      std::chrono::nanoseconds wait = deadline.remaining ();
+      if (wait.count () < 0 || wait > max_wait)
+        wait = max_wait;
+
+#ifndef __WIN32__
+      pfd.revents = 0;
+
+#  ifdef __linux__
+      struct timespec ts;
+      ts.tv_sec = wait.count () / 1000000000;
+      ts.tv_nsec = wait.count () % 1000000000;
+      int ret = ::ppoll (&pfd, 1, &ts, NULL);
+#  else
+      // round up, so as not to wake before the deadline
+      int ret = ::poll (&pfd, 1, (wait.count () + 999999) / 1000000);
+#  endif
+
+      if (ret < 0)
+        {
+          if (errno == EINTR)
+            continue;
+          return -1;
+        }
+
+      // a hangup or error is readable, so that the recv reports it
+      if (pfd.revents & (POLLIN | POLLHUP | POLLERR))
+        return 1;
+#else
+      fd_set readfds;
+      FD_ZERO (&readfds);
+      FD_SET (sock, &readfds);
+
+      long usec = wait.count () / 1000;
+      struct timeval tv;
+      tv.tv_sec = usec / 1000000;
+      tv.tv_usec = usec % 1000000;
+
+      int ret = ::select (sock+1, &readfds, NULL, NULL, &tv);
+      if (ret < 0)
+        return -1;
+      if (ret > 0)
+        return 1;
+#endif
+
+      if (deadline.expired ())
+        return 0;
+    }
+}
+
+// Wait up to ms for sock to become readable, for use on threads other
+// than the interpreter thread. Returns as octave_wait_readable.
+inline int
+octave_poll_readable (int sock, int ms)
+{
+#ifndef __WIN32__
+  struct pollfd pfd;
+  pfd.fd = sock;
+  pfd.events = POLLIN;
+  pfd.revents = 0;
+
+  int ret = ::poll (&pfd, 1, ms);
+  if (ret < 0)
+    return errno == EINTR ? 0 : -1;
+  if (ret == 0)
+    return 0;
+
+  return 1;
+#else
+  fd_set readfds;
+  FD_ZERO (&readfds);
+  FD_SET (sock, &readfds);
+
+  struct timeval tv;
+  tv.tv_sec = ms / 1000;
+  tv.tv_usec = (ms % 1000) * 1000;
+
+  int ret = ::select (sock+1, &readfds, NULL, NULL, &tv);
+  if (ret < 0)
+    return -1;
+
+  return ret > 0 ? 1 : 0;
+#endif
+}
+
+#endif
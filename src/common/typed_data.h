@@ -0,0 +1,405 @@
+// Copyright (C) 2026 John Donoghue <john.donoghue@ieee.org>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+
+#ifndef OCTAVE_TYPED_DATA_H
+#define OCTAVE_TYPED_DATA_H
+
+#include <octave/oct.h>
+#include <octave/int8NDArray.h>
+#include <octave/uint8NDArray.h>
+#include <octave/int16NDArray.h>
+#include <octave/uint16NDArray.h>
+#include <octave/int32NDArray.h>
+#include <octave/uint32NDArray.h>
+#include <octave/int64NDArray.h>
+#include <octave/uint64NDArray.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+// the byte swap has SSSE3 and AVX2 kernels, built for those targets
+// whatever the compiler flags, and chosen by what the cpu supports
+#if (defined (__GNUC__) || defined (__clang__)) && (defined (__x86_64__) || defined (__i386__))
+#  define OCTAVE_SWAP_BYTES_SIMD 1
+#  include <immintrin.h>
+#endif
+
+// datatypes accepted by the read and write functions of the instrument
+// objects
+enum octave_data_type_id
+{
+  octave_data_string,
+  octave_data_int8,
+  octave_data_uint8,
+  octave_data_int16,
+  octave_data_uint16,
+  octave_data_int32,
+  octave_data_uint32,
+  octave_data_int64,
+  octave_data_uint64,
+  octave_data_single,
+  octave_data_double
+};
+
+struct octave_data_type
+{
+  octave_data_type_id id;
+  unsigned int size;
+};
+
+// look up a precision name as used by read, write, fread and fwrite.
+// returns false for an unknown name
+inline bool
+octave_data_type_lookup (const std::string &name, octave_data_type &type)
+{
+  static const struct
+  {
+    const char *name;
+    octave_data_type_id id;
+    unsigned int size;
+  } types[] =
+  {
+    { "string",  octave_data_string, 1 },
+    { "char",    octave_data_int8,   1 },
+    { "schar",   octave_data_int8,   1 },
+    { "int8",    octave_data_int8,   1 },
+    { "uchar",   octave_data_uint8,  1 },
+    { "uint8",   octave_data_uint8,  1 },
+    { "int16",   octave_data_int16,  2 },
+    { "short",   octave_data_int16,  2 },
+    { "uint16",  octave_data_uint16, 2 },
+    { "ushort",  octave_data_uint16, 2 },
+    { "int32",   octave_data_int32,  4 },
+    { "int",     octave_data_int32,  4 },
+    { "uint32",  octave_data_uint32, 4 },
+    { "uint",    octave_data_uint32, 4 },
+    { "int64",   octave_data_int64,  8 },
+    { "long",    octave_data_int64,  8 },
+    { "uint64",  octave_data_uint64, 8 },
+    { "ulong",   octave_data_uint64, 8 },
+    { "single",  octave_data_single, 4 },
+    { "float",   octave_data_single, 4 },
+    { "float32", octave_data_single, 4 },
+    { "double",  octave_data_double, 8 },
+    { "float64", octave_data_double, 8 }
+  };
+
+  for (size_t i = 0; i < sizeof (types) / sizeof (types[0]); i++)
+    {
+      if (name == types[i].name)
+        {
+          type.id = types[i].id;
+          type.size = types[i].size;
+          return true;
+        }
+    }
+  return false;
+}
+
+inline bool
+octave_host_is_big_endian (void)
+{
+  const uint16_t one = 1;
+  return *reinterpret_cast<const uint8_t *> (&one) == 0;
+}
+
+// true if values in the byteorder ("little-endian" or "big-endian") of an
+// object need swapping to or from the host order
+inline bool
+octave_byteorder_needs_swap (const std::string &byteorder)
+{
+  bool big = (! byteorder.empty () && byteorder[0] == 'b');
+  return big != octave_host_is_big_endian ();
+}
+
+template <unsigned int N>
+inline void
+octave_swap_bytes_scalar (uint8_t *dst, const uint8_t *src, size_t count)
+{
+  for (size_t i = 0; i < count; i++, src += N, dst += N)
+    {
+      uint8_t tmp[N];
+      memcpy (tmp, src, N);
+      std::reverse (tmp, tmp + N);
+      memcpy (dst, tmp, N);
+    }
+}
+
+// the byte swap kernels, fastest last
+enum octave_swap_bytes_kernel
+{
+  octave_swap_bytes_scalar_kernel,
+  octave_swap_bytes_ssse3_kernel,
+  octave_swap_bytes_avx2_kernel
+};
+
+#ifdef OCTAVE_SWAP_BYTES_SIMD
+// shuffle mask reversing each value of size bytes in 16 bytes, repeated
+// for 32
+inline void
+octave_swap_bytes_mask (uint8_t *m, unsigned int size)
+{
+  for (unsigned int i = 0; i < 32; i++)
+    m[i] = (i % 16) / size * size + (size - 1 - i % size);
+}
+
+// swap the bytes of whole 16 byte blocks of total bytes, returning the
+// number of bytes done
+__attribute__ ((target ("ssse3"))) inline size_t
+octave_swap_bytes_ssse3 (uint8_t *dst, const uint8_t *src, size_t total, unsigned int size)
+{
+  uint8_t m[32];
+  octave_swap_bytes_mask (m, size);
+
+  const __m128i mask16 = _mm_loadu_si128 (reinterpret_cast<const __m128i *> (m));
+  size_t pos = 0;
+  for (; pos + 16 <= total; pos += 16)
+    {
+      __m128i v = _mm_loadu_si128 (reinterpret_cast<const __m128i *> (src + pos));
+      _mm_storeu_si128 (reinterpret_cast<__m128i *> (dst + pos), _mm_shuffle_epi8 (v, mask16));
+    }
+  return pos;
+}
+
+// as octave_swap_bytes_ssse3, 32 bytes at a time
+__attribute__ ((target ("avx2"))) inline size_t
+octave_swap_bytes_avx2 (uint8_t *dst, const uint8_t *src, size_t total, unsigned int size)
+{
+  uint8_t m[32];
+  octave_swap_bytes_mask (m, size);
+
+  const __m256i mask32 = _mm256_loadu_si256 (reinterpret_cast<const __m256i *> (m));
+  size_t pos = 0;
+  for (; pos + 32 <= total; pos += 32)
+    {
+      __m256i v = _mm256_loadu_si256 (reinterpret_cast<const __m256i *> (src + pos));
+      _mm256_storeu_si256 (reinterpret_cast<__m256i *> (dst + pos), _mm256_shuffle_epi8 (v, mask32));
+    }
+
+  const __m128i mask16 = _mm_loadu_si128 (reinterpret_cast<const __m128i *> (m));
+  for (; pos + 16 <= total; pos += 16)
+    {
+      __m128i v = _mm_loadu_si128 (reinterpret_cast<const __m128i *> (src + pos));
+      _mm_storeu_si128 (reinterpret_cast<__m128i *> (dst + pos), _mm_shuffle_epi8 (v, mask16));
+    }
+  return pos;
+}
+#endif
+
+// the fastest byte swap kernel the cpu supports
+inline octave_swap_bytes_kernel
+octave_swap_bytes_best_kernel (void)
+{
+#ifdef OCTAVE_SWAP_BYTES_SIMD
+  static const octave_swap_bytes_kernel best = [] (void) -> octave_swap_bytes_kernel
+    {
+      __builtin_cpu_init ();
+      if (__builtin_cpu_supports ("avx2"))
+        return octave_swap_bytes_avx2_kernel;
+      if (__builtin_cpu_supports ("ssse3"))
+        return octave_swap_bytes_ssse3_kernel;
+      return octave_swap_bytes_scalar_kernel;
+    } ();
+  return best;
+#else
+  return octave_swap_bytes_scalar_kernel;
+#endif
+}
+
+// reverse the bytes of count values of size bytes each from src into dst
+// with the given kernel, which the cpu must support. src and dst may be
+// the same buffer.
+inline void
+octave_swap_bytes (uint8_t *dst, const uint8_t *src, size_t count, unsigned int size,
+                   octave_swap_bytes_kernel kernel)
+{
+  if (size < 2)
+    {
+      if (dst != src)
+        memmove (dst, src, count * size);
+      return;
+    }
+
+  size_t done = 0;
+
+#ifdef OCTAVE_SWAP_BYTES_SIMD
+  // the shuffles reverse values that do not straddle 16 bytes
+  if (16 % size == 0)
+    {
+      if (kernel == octave_swap_bytes_avx2_kernel)
+        done = octave_swap_bytes_avx2 (dst, src, count * size, size) / size;
+      else if (kernel == octave_swap_bytes_ssse3_kernel)
+        done = octave_swap_bytes_ssse3 (dst, src, count * size, size) / size;
+    }
+#endif
+
+  src += done * size;
+  dst += done * size;
+  count -= done;
+
+  switch (size)
+    {
+    case 2:
+      octave_swap_bytes_scalar<2> (dst, src, count);
+      break;
+    case 4:
+      octave_swap_bytes_scalar<4> (dst, src, count);
+      break;
+    case 8:
+      octave_swap_bytes_scalar<8> (dst, src, count);
+      break;
+    default:
+      for (size_t i = 0; i < count; i++, src += size, dst += size)
+        {
+          if (dst != src)
+            memcpy (dst, src, size);
+          std::reverse (dst, dst + size);
+        }
+      break;
+    }
+}
+
+// reverse the bytes of count values of size bytes each from src into dst,
+// with the fastest kernel the cpu supports. src and dst may be the same
+// buffer.
+inline void
+octave_swap_bytes (uint8_t *dst, const uint8_t *src, size_t count, unsigned int size)
+{
+  octave_swap_bytes (dst, src, count, size, octave_swap_bytes_best_kernel ());
+}
+
+// read up to count values of array type A directly into the result using
+// readfn (uint8_t *buf, unsigned int len), which returns the number of
+// bytes read. A trailing partial value is dropped.
+template <typename A, typename F>
+octave_value
+octave_read_typed_array (unsigned int count, bool swap, F readfn)
+{
+  typedef typename A::element_type T;
+
+  A data (dim_vector (1, count));
+  uint8_t *buf = reinterpret_cast<uint8_t *> (data.fortran_vec ());
+
+  int bytes_read = 0;
+  if (count > 0)
+    bytes_read = readfn (buf, count * sizeof (T));
+
+  unsigned int n = (bytes_read > 0) ? bytes_read / sizeof (T) : 0;
+
+  if (swap)
+    octave_swap_bytes (buf, buf, n, sizeof (T));
+
+  data.resize (dim_vector (1, n));
+
+  return octave_value (data);
+}
+
+template <typename F>
+octave_value
+octave_read_typed (const octave_data_type &type, unsigned int count, bool swap, F readfn)
+{
+  switch (type.id)
+    {
+    case octave_data_string:
+      return octave_read_typed_array<charNDArray> (count, false, readfn);
+    case octave_data_int8:
+      return octave_read_typed_array<int8NDArray> (count, false, readfn);
+    case octave_data_uint8:
+      return octave_read_typed_array<uint8NDArray> (count, false, readfn);
+    case octave_data_int16:
+      return octave_read_typed_array<int16NDArray> (count, swap, readfn);
+    case octave_data_uint16:
+      return octave_read_typed_array<uint16NDArray> (count, swap, readfn);
+    case octave_data_int32:
+      return octave_read_typed_array<int32NDArray> (count, swap, readfn);
+    case octave_data_uint32:
+      return octave_read_typed_array<uint32NDArray> (count, swap, readfn);
+    case octave_data_int64:
+      return octave_read_typed_array<int64NDArray> (count, swap, readfn);
+    case octave_data_uint64:
+      return octave_read_typed_array<uint64NDArray> (count, swap, readfn);
+    case octave_data_single:
+      return octave_read_typed_array<FloatNDArray> (count, swap, readfn);
+    case octave_data_double:
+    default:
+      return octave_read_typed_array<NDArray> (count, swap, readfn);
+    }
+}
+
+// write the values of data using writefn (uint8_t *buf, unsigned int len),
+// swapping into a temporary buffer when needed.
+template <typename A, typename F>
+int
+octave_write_typed_array (const A &data, bool swap, F writefn)
+{
+  typedef typename A::element_type T;
+
+  const uint8_t *buf = reinterpret_cast<const uint8_t *> (data.data ());
+  unsigned int len = data.numel () * sizeof (T);
+
+  if (! swap || sizeof (T) == 1)
+    return writefn (const_cast<uint8_t *> (buf), len);
+
+  std::vector<uint8_t> swapped (len);
+  octave_swap_bytes (&swapped[0], buf, data.numel (), sizeof (T));
+
+  return writefn (&swapped[0], len);
+}
+
+// convert v to the given type, as the matching octave conversion function
+// would, and write it
+template <typename F>
+int
+octave_write_typed (const octave_value &val, const octave_data_type &type, bool swap, F writefn)
+{
+  if (val.is_string ())
+    {
+      if (type.size == 1)
+        return octave_write_typed_array (val.char_array_value (), false, writefn);
+    }
+
+  const octave_value v = val.is_string () ? octave_value (val.array_value (true)) : val;
+
+  switch (type.id)
+    {
+    case octave_data_string:
+    case octave_data_int8:
+      return octave_write_typed_array (v.int8_array_value (), false, writefn);
+    case octave_data_uint8:
+      return octave_write_typed_array (v.uint8_array_value (), false, writefn);
+    case octave_data_int16:
+      return octave_write_typed_array (v.int16_array_value (), swap, writefn);
+    case octave_data_uint16:
+      return octave_write_typed_array (v.uint16_array_value (), swap, writefn);
+    case octave_data_int32:
+      return octave_write_typed_array (v.int32_array_value (), swap, writefn);
+    case octave_data_uint32:
+      return octave_write_typed_array (v.uint32_array_value (), swap, writefn);
+    case octave_data_int64:
+      return octave_write_typed_array (v.int64_array_value (), swap, writefn);
+    case octave_data_uint64:
+      return octave_write_typed_array (v.uint64_array_value (), swap, writefn);
+    case octave_data_single:
+      return octave_write_typed_array (v.float_array_value (), swap, writefn);
+    case octave_data_double:
+    default:
+      return octave_write_typed_array (v.array_value (), swap, writefn);
+    }
+}
+
+#endif
@@ -0,0 +1,70 @@
+// Copyright (C) 2026   John Donoghue   <john.donoghue@ieee.org>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+
+#include <octave/oct.h>
+
+#ifdef HAVE_CONFIG_H
+#include "../config.h"
+#endif
+
+#ifdef BUILD_GPIB
+#include "gpib_class.h"
+#endif
+
+// PKG_ADD: autoload ("__gpib_allspoll__", "gpib.oct");
+DEFUN_DLD (__gpib_allspoll__, args, nargout,
+        "-*- texinfo -*-\n\
+@deftypefn {} {@var{sb} = } __gpib_allspoll__ (@var{devs})\n \
+\n\
+serial poll several devices on a gpib bus at once.\n \
+\n\
+@var{devs} - cell array of @var{octave_gpib} objects on the same board.@*\
+\n\
+Upon successful completion, __gpib_allspoll__() shall return the status byte of each device in @var{sb}.\n \
+@end deftypefn")
+{
+#ifndef BUILD_GPIB
+  error ("gpib: Your system doesn't support the GPIB interface");
+  return octave_value ();
+#else
+  if (args.length () != 1)
+    {
+      print_usage ();
+      return octave_value (-1);
+    }
+
+  std::vector<int> pads;
+  std::vector<int> status;
+
+  int board = octave_gpib::bus_devices (args (0), pads, "spoll");
+  if (board < 0)
+    return octave_value ();
+
+  if (octave_gpib::bus_spoll (board, pads, status) < 0)
+    return octave_value ();
+
+  Matrix sb (1, status.size ());
+  for (size_t i = 0; i < status.size (); i++)
+    sb(0, i) = status[i];
+
+  return octave_value (sb);
+#endif
+}
+
+#if 0
+%!error <Invalid call to __gpib_allspoll__> __gpib_allspoll__ ()
+
+%!error <Invalid call to __gpib_allspoll__> __gpib_allspoll__ (1, 2)
+#endif
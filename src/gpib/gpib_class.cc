@@ -15,7 +15,6 @@
 // along with this program; if not, see <http://www.gnu.org/licenses/>.
 
 #include <octave/oct.h>
-#include <octave/unwind-prot.h>
 
 #ifdef HAVE_CONFIG_H
 #include "../config.h"
@@ -33,6 +32,7 @@
 #define GPIB_USEBLOCKREAD
 
 #include "gpib_class.h"
+#include "../common/socket_wait.h"
 
 DEFINE_OV_TYPEID_FUNCTIONS_AND_DATA (octave_gpib, "octave_gpib", "octave_gpib");
 
@@ -41,6 +41,17 @@ static void close_fd (int fd)
   ibonl(fd,0);
 }
 
+// errors after which the descriptor is no longer usable, so it is
+// reopened and the call tried again
+static bool stale_descriptor (int gperr)
+{
+  if (! (gperr & ERR))
+    return false;
+
+  int localiberr = ThreadIberr ();
+  return localiberr == EDVR || localiberr == ENEB;
+}
+
 octave_gpib::octave_gpib ()
 {
   static bool type_registered = false;
@@ -53,6 +64,8 @@ octave_gpib::octave_gpib ()
  
   minor = -1;
   gpibid = -1;
+  fd = -1;
+  async_op = async_none;
 }
 
 octave_gpib::~octave_gpib ()
@@ -90,13 +103,43 @@ octave_gpib::open (int minor, int gpibid, int sad, int timeout, int send_eoi, in
   this->send_eoi = send_eoi;
   this->eos_mode = eos_mode;
 
+  // the descriptor is kept open for the lifetime of the object
+  if (device ("gpib") < 0)
+    return -1;
+
   return 1;
 }
 
+int
+octave_gpib::device (const char *who)
+{
+  if (fd < 0)
+    {
+      fd = ibdev (minor, gpibid, sad, timeout, send_eoi, eos_mode);
+      if (fd < 0)
+        {
+          error ("%s: error opening gpib device...", who);
+          return -1;
+        }
+    }
+
+  return fd;
+}
+
+void
+octave_gpib::reopen (void)
+{
+  if (fd >= 0)
+    {
+      close_fd (fd);
+      fd = -1;
+    }
+}
+
 int
 octave_gpib::read (uint8_t *buf, unsigned int len, bool *eoi)
 {
-  int gperr,fd;
+  int gperr;
   int bytes_read = 0;
 
   if (this->minor < 0)
@@ -105,20 +148,26 @@ octave_gpib::read (uint8_t *buf, unsigned int len, bool *eoi)
       return -1;
     }
 
-  fd = ibdev (this->minor, this->gpibid, this->sad, this->timeout, this->send_eoi, this->eos_mode);
-  if (fd < 0)
+  if (async_pending ())
     {
-      error ("gpib_read: error opening gpib device...");
+      error ("gpib_read: an asynchronous operation is in progress");
       return -1;
     }
 
-  // set up a frame to close fd
-  OCTAVE__UNWIND_PROTECT frame;
-  frame.add_fcn (close_fd, fd);
+  if (device ("gpib_read") < 0)
+    return -1;
 
 #if defined(GPIB_USEBLOCKREAD)
   // blocking read - not interruptable
   gperr = ibrd (fd,(void *)buf,len);
+  if (stale_descriptor (gperr))
+    {
+      reopen ();
+      if (device ("gpib_read") < 0)
+        return -1;
+      gperr = ibrd (fd,(void *)buf,len);
+    }
+
   if (gperr & ERR)
     {
       if (gperr & TIMO)
@@ -184,7 +233,13 @@ octave_gpib::read (uint8_t *buf, unsigned int len, bool *eoi)
 int
 octave_gpib::write (const std::string &str)
 {
-  int gperr,fd;
+  return write ((uint8_t *)str.c_str (), str.length ());
+}
+
+int
+octave_gpib::write (uint8_t *buf, unsigned int len)
+{
+  int gperr;
 
   if (minor < 0)
     {
@@ -192,90 +247,226 @@ octave_gpib::write (const std::string &str)
       return -1;
     }
 
-  fd = ibdev (minor, gpibid, sad, timeout, send_eoi, eos_mode);
-  if (fd < 0)
+  if (async_pending ())
     {
-      error ("gpib_read: error opening gpib device...");
+      error ("gpib_write: an asynchronous operation is in progress");
       return -1;
     }
 
-  // set up a frame to close fd
-  OCTAVE__UNWIND_PROTECT frame;
-  frame.add_fcn (close_fd, fd);
+  if (device ("gpib_write") < 0)
+    return -1;
+
+  gperr = ibwrt (fd, buf, len);
+  if (stale_descriptor (gperr))
+    {
+      reopen ();
+      if (device ("gpib_write") < 0)
+        return -1;
+      gperr = ibwrt (fd, buf, len);
+    }
 
-  gperr = ibwrt (fd,str.c_str (), str.length ());
   if (gperr & ERR) 
     {
       // warning: can not write
-      if (ThreadIberr () != ENOL) 
+      if (ThreadIberr() != ENOL) 
         {
           // ENOL is handled by library
           error ("gpib: can not write gpib data to device");
         }
     }
 
-    return gperr;
+  return gperr;
 }
 
 int
-octave_gpib::write (uint8_t *buf, unsigned int len)
+octave_gpib::read_async (unsigned int len)
 {
-  int gperr,fd;
+  int gperr;
 
   if (minor < 0)
     {
-      error ("gpib_write: Interface must be opened first...");
+      error ("gpib_read: Interface must be opened first...");
       return -1;
     }
 
-  fd = ibdev(minor, gpibid, sad, timeout, send_eoi, eos_mode);
-  if (fd < 0)
+  if (async_pending ())
     {
-      error ("gpib_write: error opening gpib device...");
+      error ("gpib_read: an asynchronous operation is already in progress");
       return -1;
     }
 
-  // set up a frame to close fd
-  OCTAVE__UNWIND_PROTECT frame;
-  frame.add_fcn (close_fd, fd);
+  if (device ("gpib_read") < 0)
+    return -1;
 
-  gperr = ibwrt (fd, buf, len);
-  if (gperr & ERR) 
+  async_buffer = uint8NDArray (dim_vector (1, len));
+
+  gperr = ibrda (fd, async_buffer.fortran_vec (), len);
+  if (stale_descriptor (gperr))
     {
-      // warning: can not write
-      if (ThreadIberr() != ENOL) 
-        {
-          // ENOL is handled by library
-          error ("gpib: can not write gpib data to device");
-        }
+      reopen ();
+      if (device ("gpib_read") < 0)
+        return -1;
+      gperr = ibrda (fd, async_buffer.fortran_vec (), len);
     }
 
+  if (gperr & ERR)
+    {
+      error ("gpib_read: Error while starting read: %d\n", ThreadIberr ());
+      return -1;
+    }
+
+  async_op = async_read;
+
   return gperr;
 }
 
 int
-octave_gpib::spoll (char *rqs)
+octave_gpib::write_async (const uint8_t *buf, unsigned int len)
 {
-  int gperr,fd;
+  int gperr;
 
   if (minor < 0)
     {
-      error("gpib_spoll: Interface must be opened first...");
+      error ("gpib_write: Interface must be opened first...");
       return -1;
     }
 
-  fd = ibdev (minor, gpibid, sad, timeout, send_eoi, eos_mode);
-  if (fd < 0)
+  if (async_pending ())
+    {
+      error ("gpib_write: an asynchronous operation is already in progress");
+      return -1;
+    }
+
+  if (device ("gpib_write") < 0)
+    return -1;
+
+  // the data must stay valid until the write completes
+  async_buffer = uint8NDArray (dim_vector (1, len));
+  memcpy (async_buffer.fortran_vec (), buf, len);
+
+  gperr = ibwrta (fd, async_buffer.fortran_vec (), len);
+  if (stale_descriptor (gperr))
+    {
+      reopen ();
+      if (device ("gpib_write") < 0)
+        return -1;
+      gperr = ibwrta (fd, async_buffer.fortran_vec (), len);
+    }
+
+  if (gperr & ERR)
+    {
+      error ("gpib_write: Error while starting write: %d\n", ThreadIberr ());
+      return -1;
+    }
+
+  async_op = async_write;
+
+  return gperr;
+}
+
+// restores the descriptor timeout changed while waiting, including when
+// the wait is interrupted
+class gpib_timeout_restore
+{
+public:
+  gpib_timeout_restore (int ud, int tmo) : fd (ud), timeout (tmo) { }
+  ~gpib_timeout_restore (void) { ibtmo (fd, timeout); }
+private:
+  int fd;
+  int timeout;
+};
+
+// wait up to waittime seconds (< 0 forever, 0 only checks) for any of
+// the mask bits on ud, whose timeout is currently tmo
+static int
+wait_status (int ud, int mask, int tmo, double waittime)
+{
+  int gperr;
+
+  if (waittime == 0)
+    return ibwait (ud, 0);
+
+  octave_deadline deadline (waittime < 0 ? -1 : waittime * 1000);
+
+  // ibwait gives up after the descriptor timeout, so wait in 100ms
+  // steps to check for a ctrl-c and the requested time
+  gpib_timeout_restore restore (ud, tmo);
+  ibtmo (ud, T100ms);
+
+  while (true)
     {
-      error ("gpib_spoll: error opening gpib device...");
+      OCTAVE_QUIT;
+
+      gperr = ibwait (ud, mask | TIMO);
+      if ((gperr & mask) || ((gperr & ERR) && ! (gperr & TIMO)))
+        break;
+
+      if (deadline.expired ())
+        break;
+    }
+
+  return gperr;
+}
+
+int
+octave_gpib::wait_async (double waittime, int *count, bool *eoi)
+{
+  int gperr;
+
+  if (! async_pending ())
+    {
+      error ("gpib_wait: no asynchronous operation in progress");
       return -1;
     }
 
-  // set up a frame to close fd
-  OCTAVE__UNWIND_PROTECT frame;
-  frame.add_fcn (close_fd, fd);
+  gperr = wait_status (fd, CMPL, timeout, waittime);
+
+  if ((gperr & ERR) && ! (gperr & TIMO))
+    {
+      async_op = async_none;
+      error ("gpib_wait: Error while waiting: %d - %d\n", gperr, ThreadIberr ());
+      return -1;
+    }
+
+  if (! (gperr & CMPL))
+    return 0;
+
+  *count = ThreadIbcnt ();
+  *eoi = (gperr & END) ? true : false;
+
+  if (async_op == async_read)
+    async_buffer.resize (dim_vector (1, *count));
+  else
+    async_buffer = uint8NDArray ();
+
+  async_op = async_none;
+
+  return 1;
+}
+
+int
+octave_gpib::spoll (char *rqs)
+{
+  int gperr;
+
+  if (minor < 0)
+    {
+      error("gpib_spoll: Interface must be opened first...");
+      return -1;
+    }
+
+  if (device ("gpib_spoll") < 0)
+    return -1;
 
   gperr = ibrsp (fd,rqs);
+  if (stale_descriptor (gperr))
+    {
+      reopen ();
+      if (device ("gpib_spoll") < 0)
+        return -1;
+      gperr = ibrsp (fd,rqs);
+    }
+
   if (gperr & ERR)
     {
       error ("gpib_spoll: some error occured: %d",  ThreadIberr ());
@@ -286,29 +477,156 @@ octave_gpib::spoll (char *rqs)
   return gperr;
 }
 
+// The bus level functions address the board by its index, which
+// linux-gpib accepts as the board descriptor.
+
 int
-octave_gpib::trigger()
+octave_gpib::bus_devices (const octave_value &devs, std::vector<int> &pads, const char *who)
 {
-  int gperr,fd;
+  octave_value_list list;
 
-  if (this->minor < 0)
+  if (devs.OV_ISCELL ())
+    list = octave_value_list (devs.cell_value ());
+  else
+    list = octave_value_list (devs);
+
+  if (list.length () == 0)
     {
-      error ("gpib_trigger: Interface must be opened first...");
+      error ("%s: expected at least one gpib object", who);
       return -1;
     }
 
-  fd = ibdev(minor, gpibid, sad, timeout, send_eoi, eos_mode);
-  if (fd < 0)
+  int board = -1;
+  pads.clear ();
+
+  for (octave_idx_type i = 0; i < list.length (); i++)
+    {
+      if (list (i).type_id () != octave_gpib::static_type_id ())
+        {
+          error ("%s: element %ld is not a gpib object", who, static_cast<long> (i+1));
+          return -1;
+        }
+
+      const octave_gpib &dev = dynamic_cast<const octave_gpib &> (list (i).get_rep ());
+
+      if (dev.get_board () < 0)
+        {
+          error ("%s: Interface must be opened first...", who);
+          return -1;
+        }
+
+      if (board >= 0 && dev.get_board () != board)
+        {
+          error ("%s: all gpib objects must be on the same board", who);
+          return -1;
+        }
+
+      board = dev.get_board ();
+      pads.push_back (dev.get_address ());
+    }
+
+  return board;
+}
+
+int
+octave_gpib::bus_spoll (int board, const std::vector<int> &pads, std::vector<int> &status)
+{
+  std::vector<Addr4882_t> addrs (pads.size () + 1);
+  std::vector<short> results (pads.size (), 0);
+
+  for (size_t i = 0; i < pads.size (); i++)
+    addrs[i] = MakeAddr (pads[i], 0);
+  addrs[pads.size ()] = NOADDR;
+
+  // one serial poll sequence for every device, rather than one per device
+  AllSpoll (board, addrs.data (), results.data ());
+
+  if (ThreadIbsta () & ERR)
+    {
+      error ("gpib_spoll: some error occured: %d", ThreadIberr ());
+      return -1;
+    }
+
+  status.resize (pads.size ());
+  for (size_t i = 0; i < pads.size (); i++)
+    status[i] = results[i] & 0xff;
+
+  return 0;
+}
+
+int
+octave_gpib::bus_find_rqs (int board, const std::vector<int> &pads, int *status)
+{
+  std::vector<Addr4882_t> addrs (pads.size () + 1);
+  short result = 0;
+
+  for (size_t i = 0; i < pads.size (); i++)
+    addrs[i] = MakeAddr (pads[i], 0);
+  addrs[pads.size ()] = NOADDR;
+
+  FindRQS (board, addrs.data (), &result);
+
+  if (ThreadIbsta () & ERR)
+    {
+      // ETAB means no device was requesting service
+      if (ThreadIberr () == ETAB)
+        return -1;
+
+      error ("gpib_findrqs: some error occured: %d", ThreadIberr ());
+      return -2;
+    }
+
+  // FindRQS leaves the index of the device in ibcnt
+  *status = result & 0xff;
+
+  return ThreadIbcnt ();
+}
+
+int
+octave_gpib::bus_wait_srq (int board, double waittime)
+{
+  int tmo;
+
+  if (ibask (board, IbaTMO, &tmo) & ERR)
+    {
+      error ("gpib_waitsrq: can not query board %d: %d", board, ThreadIberr ());
+      return -1;
+    }
+
+  int gperr = wait_status (board, SRQI, tmo, waittime);
+
+  if ((gperr & ERR) && ! (gperr & TIMO))
+    {
+      error ("gpib_waitsrq: Error while waiting: %d - %d", gperr, ThreadIberr ());
+      return -1;
+    }
+
+  return (gperr & SRQI) ? 1 : 0;
+}
+
+int
+octave_gpib::trigger()
+{
+  int gperr;
+
+  if (this->minor < 0)
     {
-      error("gpib_trigger: error opening gpib device...");
+      error ("gpib_trigger: Interface must be opened first...");
       return -1;
     }
 
-  // set up a frame to close fd
-  OCTAVE__UNWIND_PROTECT frame;
-  frame.add_fcn (close_fd, fd);
+  if (device ("gpib_trigger") < 0)
+    return -1;
 
   gperr = ibtrg (fd);
+  if (stale_descriptor (gperr))
+    {
+      reopen ();
+      if (device ("gpib_trigger") < 0)
+        return -1;
+      gperr = ibtrg (fd);
+    }
+
   if (gperr & ERR)
     {
       error ("gpib_trigger: some error occured: %d",  ThreadIberr ());
@@ -321,7 +639,7 @@ octave_gpib::trigger()
 int
 octave_gpib::cleardevice()
 {
-  int gperr,fd;
+  int gperr;
 
   if (minor < 0)
     {
@@ -329,18 +647,18 @@ octave_gpib::cleardevice()
       return -1;
     }
 
-  fd = ibdev(minor, gpibid, sad, timeout, send_eoi, eos_mode);
-  if (fd < 0)
+  if (device ("gpib_clear") < 0)
+    return -1;
+
+  gperr = ibclr(fd);
+  if (stale_descriptor (gperr))
     {
-      error("gpib_clear: error opening gpib device...");
-      return -1;
+      reopen ();
+      if (device ("gpib_clear") < 0)
+        return -1;
+      gperr = ibclr(fd);
     }
 
-  // set up a frame to close fd
-  OCTAVE__UNWIND_PROTECT frame;
-  frame.add_fcn (close_fd, fd);
-
-  gperr = ibclr(fd);
   if (gperr & ERR) 
     {
       error ("gpib_clear: some error occured: %d",  ThreadIberr ());
@@ -358,7 +676,7 @@ octave_gpib::set_timeout (int newtimeout)
       error ("gpib_timeout: Interface must be opened first...");
       return -1;
     }
-  if (timeout < 0 || timeout > 17)
+  if (newtimeout < 0 || newtimeout > 17)
     {
       error ("gpib_timeout: timeout must be between 0 and 17");
       return -1;
@@ -366,6 +684,13 @@ octave_gpib::set_timeout (int newtimeout)
 
   timeout = newtimeout;
 
+  // apply to the open descriptor, a reopen picks up the new value anyway
+  if (fd >= 0 && (ibtmo (fd, timeout) & ERR))
+    {
+      error ("gpib_timeout: can not set timeout: %d", ThreadIberr ());
+      return -1;
+    }
+
   return 1;
 }
 
@@ -378,22 +703,23 @@ octave_gpib::get_timeout() const
 int
 octave_gpib::close()
 {
-  int fd,gperr;
+  int gperr;
 
-  if (minor > -1)
+  if (minor > -1 && fd >= 0)
     {
-      fd = ibdev(minor, gpibid, sad, timeout, send_eoi, eos_mode);
-      if (fd < 0)
+      // abandon any asynchronous operation before the buffer goes away
+      if (async_pending ())
         {
-            error("gpib_close: error opening gpib device...");
-            return -1;
+          ibstop (fd);
+          ibwait (fd, 0);
+          async_op = async_none;
         }
 
-      // set up a frame to close fd
-      OCTAVE__UNWIND_PROTECT frame;
-      frame.add_fcn (close_fd, fd);
-
       gperr = ibloc (fd);
+
+      close_fd (fd);
+      fd = -1;
+
       if (gperr & ERR) 
         {
           error ("gpib_close: can not set device to local");
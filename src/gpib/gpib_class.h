@@ -21,6 +21,7 @@
 #include <octave/ov-int32.h>
 
 #include <string>
+#include <vector>
 
 #ifdef HAVE_CONFIG_H
 #  include "../config.h"
@@ -37,7 +38,30 @@ public:
 
   int read(uint8_t*, unsigned int, bool*);
 
+  // asynchronous I/O, one operation at a time. wait_async returns 1 once
+  // the operation has completed, with the data read in async_data (), or
+  // 0 if it is still in progress after waiting
+  int read_async(unsigned int);
+  int write_async(const uint8_t*, unsigned int);
+  int wait_async(double, int*, bool*);
+  bool async_pending() const { return async_op != async_none; }
+  uint8NDArray async_data() const { return async_buffer; }
+
   int spoll(char*);
+
+  // bus level service requests for the devices at the primary addresses
+  // pads on board. bus_find_rqs returns the index of the first device
+  // requesting service, or -1 if none is, and bus_wait_srq returns 1 if
+  // SRQ was asserted within the wait time
+  static int bus_spoll(int, const std::vector<int>&, std::vector<int>&);
+  static int bus_find_rqs(int, const std::vector<int>&, int*);
+  static int bus_wait_srq(int, double);
+  // collects the addresses of a gpib object or cell array of them, which
+  // must all be on the same board, and returns the board
+  static int bus_devices(const octave_value&, std::vector<int>&, const char*);
+
+  int get_board() const { return minor; }
+  int get_address() const { return gpibid; }
   int trigger();
   int cleardevice();
 
@@ -69,6 +93,18 @@ public:
   bool print_as_scalar (void) const { return true;}
 
 private:
+  // open the device descriptor if not already open
+  int device(const char *);
+  // close the descriptor so the next call opens it again
+  void reopen(void);
+
+  int fd;
+
+  enum async_operation { async_none, async_read, async_write };
+  async_operation async_op;
+  // the library reads into or writes from this until the operation completes
+  uint8NDArray async_buffer;
+
   int minor;
   int gpibid;
   int sad;
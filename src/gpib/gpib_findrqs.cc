@@ -0,0 +1,84 @@
+// Copyright (C) 2026   John Donoghue   <john.donoghue@ieee.org>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+
+#include <octave/oct.h>
+
+#ifdef HAVE_CONFIG_H
+#include "../config.h"
+#endif
+
+#ifdef BUILD_GPIB
+#include "gpib_class.h"
+#endif
+
+// PKG_ADD: autoload ("gpib_findrqs", "gpib.oct");
+DEFUN_DLD (gpib_findrqs, args, nargout,
+        "-*- texinfo -*-\n\
+@deftypefn {} {[@var{idx}, @var{sb}] = } gpib_findrqs (@var{devs})\n \
+\n\
+Find the first of a set of gpib devices that is requesting service.\n \
+\n\
+@var{devs} - a @var{octave_gpib} object or cell array of them on the same board.@*\
+\n\
+The devices are serial polled in order until one requesting service is found, \
+all in one bus transaction. gpib_findrqs() shall return the index of the device \
+in @var{idx} and its status byte in @var{sb}, or empty values if no device is \
+requesting service.\n \
+@seealso{gpib_waitsrq, spoll}\n \
+@end deftypefn")
+{
+#ifndef BUILD_GPIB
+  error ("gpib: Your system doesn't support the GPIB interface");
+  return octave_value ();
+#else
+  if (args.length () != 1)
+    {
+      print_usage ();
+      return octave_value (-1);
+    }
+
+  std::vector<int> pads;
+
+  int board = octave_gpib::bus_devices (args (0), pads, "gpib_findrqs");
+  if (board < 0)
+    return octave_value ();
+
+  int status = 0;
+  int idx = octave_gpib::bus_find_rqs (board, pads, &status);
+  if (idx < -1)
+    return octave_value ();
+
+  octave_value_list return_list;
+
+  if (idx < 0)
+    {
+      return_list (0) = Matrix ();
+      return_list (1) = Matrix ();
+    }
+  else
+    {
+      return_list (0) = idx + 1;
+      return_list (1) = status;
+    }
+
+  return return_list;
+#endif
+}
+
+#if 0
+%!error <Invalid call to gpib_findrqs> gpib_findrqs ()
+
+%!error <Invalid call to gpib_findrqs> gpib_findrqs (1, 2)
+#endif
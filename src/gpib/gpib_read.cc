@@ -35,14 +35,19 @@
 DEFUN_DLD (gpib_read, args, nargout,
         "-*- texinfo -*-\n\
 @deftypefn {} {[@var{data}, @var{count}, @var{eoi}] = } gpib_read (@var{gpib}, @var{n})\n \
+@deftypefnx {} {} gpib_read (@var{gpib}, @var{n}, @var{async})\n \
 \n\
 Read from gpib interface.\n \
 \n\
 @var{gpib} - instance of @var{octave_gpib} class.@* \
-@var{n} - number of bytes to attempt to read of type Integer.\n \
+@var{n} - number of bytes to attempt to read of type Integer.@* \
+@var{async} - if true, start the read in the background and return at once.\n \
 \n\
 The gpib_read() shall return number of bytes successfully read in @var{count} as Integer and the bytes themselves in @var{data} as uint8 array.\n \
 @var{eoi} indicates read operation complete \n \
+\n\
+An asynchronous read returns empty data, and the result is collected with gpib_wait().\n \
+@seealso{gpib_wait}\n \
 @end deftypefn")
 {
 #ifndef BUILD_GPIB
@@ -65,29 +70,37 @@ The gpib_read() shall return number of bytes successfully read in @var{count} as
 
   buffer_len = args (1).int_value ();
 
-  OCTAVE_LOCAL_BUFFER (uint8_t, buffer, (buffer_len + 1));
-
-  if (buffer == NULL)
-    {
-      error ("gpib_read: cannot allocate requested memory: %s\n", strerror (errno));
-      return octave_value (-1);
-    }
+  bool async = false;
+  if (args.length () > 2)
+    async = args (2).bool_value ();
 
   octave_gpib* gpib = NULL;
 
   const octave_base_value& rep = args (0).get_rep ();
   gpib = &((octave_gpib &)rep);
 
-  // Read data
+  if (async)
+    {
+      gpib->read_async (buffer_len);
+
+      octave_value_list return_list;
+      return_list (0) = uint8NDArray (dim_vector (1, 0));
+      return_list (1) = 0;
+      return_list (2) = false;
+
+      return return_list;
+    }
+
   bool eoi;
-  int bytes_read = gpib->read (buffer, buffer_len, &eoi);
+  // Read data directly into the result array
+  uint8NDArray data (dim_vector (1, buffer_len));
+
+  int bytes_read = gpib->read (reinterpret_cast<uint8_t *> (data.fortran_vec ()), buffer_len, &eoi);
 
   // Convert data to octave type variables
   octave_value_list return_list;
-  uint8NDArray data(dim_vector (1, bytes_read));
-
-  for (int i = 0; i < bytes_read; i++)
-    data (i) = buffer[i];
+  // trim to the bytes actually read
+  data.resize (dim_vector (1, bytes_read));
 
   return_list (0) = data;
   return_list (1) = bytes_read;
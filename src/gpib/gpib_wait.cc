@@ -0,0 +1,93 @@
+// Copyright (C) 2026   John Donoghue   <john.donoghue@ieee.org>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+
+#include <octave/oct.h>
+
+#ifdef HAVE_CONFIG_H
+#include "../config.h"
+#endif
+
+#ifdef BUILD_GPIB
+#include <octave/uint8NDArray.h>
+
+#include "gpib_class.h"
+#endif
+
+// PKG_ADD: autoload ("gpib_wait", "gpib.oct");
+DEFUN_DLD (gpib_wait, args, nargout,
+        "-*- texinfo -*-\n\
+@deftypefn {} {[@var{done}, @var{data}, @var{count}, @var{eoi}] = } gpib_wait (@var{gpib})\n \
+@deftypefnx {} {[@var{done}, @var{data}, @var{count}, @var{eoi}] = } gpib_wait (@var{gpib}, @var{timeout})\n \
+\n\
+Wait for an asynchronous read or write on a gpib interface to complete.\n \
+\n\
+@var{gpib} - instance of @var{octave_gpib} class.@* \
+@var{timeout} - time in seconds to wait. A value of -1 (default) waits until the operation completes and 0 checks without waiting.\n \
+\n\
+@var{done} is true if the operation has completed. For a read, @var{data} holds the bytes read as uint8 array, \
+and for a write it is empty. @var{count} is the number of bytes transferred and @var{eoi} indicates the read \
+ended with EOI. If the operation is still in progress, gpib_wait() can be called again later.\n \
+@seealso{gpib_read, gpib_write}\n \
+@end deftypefn")
+{
+#ifndef BUILD_GPIB
+  error ("gpib: Your system doesn't support the GPIB interface");
+  return octave_value ();
+#else
+  if (args.length () < 1 || args.length () > 2 || args (0).type_id () != octave_gpib::static_type_id ())
+    {
+      print_usage ();
+      return octave_value (-1);
+    }
+
+  double timeout = -1;
+
+  if (args.length () > 1)
+    {
+      if (! (args (1).OV_ISINTEGER () || args (1).OV_ISFLOAT ()))
+        {
+          print_usage ();
+          return octave_value (-1);
+        }
+
+      timeout = args (1).double_value ();
+    }
+
+  octave_gpib* gpib = NULL;
+
+  const octave_base_value& rep = args (0).get_rep ();
+  gpib = &((octave_gpib &)rep);
+
+  int count = 0;
+  bool eoi = false;
+
+  int done = gpib->wait_async (timeout, &count, &eoi);
+
+  octave_value_list return_list;
+
+  return_list (0) = (done > 0);
+  return_list (1) = (done > 0) ? gpib->async_data () : uint8NDArray (dim_vector (1, 0));
+  return_list (2) = count;
+  return_list (3) = eoi;
+
+  return return_list;
+#endif
+}
+
+#if 0
+%!error <Invalid call to gpib_wait> gpib_wait ()
+
+%!error <Invalid call to gpib_wait> gpib_wait (1)
+#endif
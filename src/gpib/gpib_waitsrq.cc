@@ -0,0 +1,83 @@
+// Copyright (C) 2026   John Donoghue   <john.donoghue@ieee.org>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+
+#include <octave/oct.h>
+
+#ifdef HAVE_CONFIG_H
+#include "../config.h"
+#endif
+
+#ifdef BUILD_GPIB
+#include "gpib_class.h"
+#endif
+
+// PKG_ADD: autoload ("gpib_waitsrq", "gpib.oct");
+DEFUN_DLD (gpib_waitsrq, args, nargout,
+        "-*- texinfo -*-\n\
+@deftypefn {} {@var{srq} = } gpib_waitsrq (@var{gpib})\n \
+@deftypefnx {} {@var{srq} = } gpib_waitsrq (@var{gpib}, @var{timeout})\n \
+\n\
+Wait for a service request on the board of a gpib interface.\n \
+\n\
+@var{gpib} - a @var{octave_gpib} object, or cell array of them on the same board.@* \
+@var{timeout} - time in seconds to wait. A value of -1 (default) waits until a service request and 0 checks without waiting.\n \
+\n\
+gpib_waitsrq() shall return true in @var{srq} if the SRQ line was asserted. \
+gpib_findrqs() or spoll() then finds the device requesting service.\n \
+@seealso{gpib_findrqs, spoll}\n \
+@end deftypefn")
+{
+#ifndef BUILD_GPIB
+  error ("gpib: Your system doesn't support the GPIB interface");
+  return octave_value ();
+#else
+  if (args.length () < 1 || args.length () > 2)
+    {
+      print_usage ();
+      return octave_value (-1);
+    }
+
+  double timeout = -1;
+
+  if (args.length () > 1)
+    {
+      if (! (args (1).OV_ISINTEGER () || args (1).OV_ISFLOAT ()))
+        {
+          print_usage ();
+          return octave_value (-1);
+        }
+
+      timeout = args (1).double_value ();
+    }
+
+  std::vector<int> pads;
+
+  int board = octave_gpib::bus_devices (args (0), pads, "gpib_waitsrq");
+  if (board < 0)
+    return octave_value ();
+
+  int srq = octave_gpib::bus_wait_srq (board, timeout);
+  if (srq < 0)
+    return octave_value ();
+
+  return octave_value (srq > 0);
+#endif
+}
+
+#if 0
+%!error <Invalid call to gpib_waitsrq> gpib_waitsrq ()
+
+%!error <Invalid call to gpib_waitsrq> gpib_waitsrq (1, 2, 3)
+#endif
@@ -25,6 +25,7 @@
 #include <errno.h>
 
 #include "gpib_class.h"
+#include "../common/byte_view.h"
 #endif
 
 
@@ -32,20 +33,24 @@
 DEFUN_DLD (gpib_write, args, nargout,
         "-*- texinfo -*-\n\
 @deftypefn {} {@var{n} = } gpib_write (@var{gpib}, @var{data})\n \
+@deftypefnx {} {} gpib_write (@var{gpib}, @var{data}, @var{async})\n \
 \n\
 Write data to a gpib interface.\n \
 \n\
 @var{gpib} - instance of @var{octave_gpib} class.@* \
-@var{data} - data to be written to the gpib interface. Can be either of String or uint8 type.\n \
+@var{data} - data to be written to the gpib interface. Can be either of String or uint8 type.@* \
+@var{async} - if true, start the write in the background and return at once.\n \
 \n\
 Upon successful completion, gpib_write() shall return the number of bytes written as the result @var{n}.\n \
+An asynchronous write returns 0, and gpib_wait() returns the number of bytes written once it completes.\n \
+@seealso{gpib_wait}\n \
 @end deftypefn")
 {
 #ifndef BUILD_GPIB
   error ("gpib: Your system doesn't support the GPIB interface");
   return octave_value ();
 #else
-  if (args.length () != 2 || args (0).type_id () != octave_gpib::static_type_id ())
+  if (args.length () < 2 || args.length () > 3 || args (0).type_id () != octave_gpib::static_type_id ())
     {
       print_usage();
       return octave_value(-1);
@@ -57,32 +62,22 @@ Upon successful completion, gpib_write() shall return the number of bytes writte
   const octave_base_value& rep = args (0).get_rep ();
   gpib = &((octave_gpib &)rep);
 
-  if (args (1).is_string ()) // String
-    {
-      retval = gpib->write (args (1).string_value ());
-    }
-  else if (args (1).is_uint8_type ()) // uint8_t
-    {
-      NDArray data = args (1).array_value ();
-      OCTAVE_LOCAL_BUFFER (uint8_t, buf, (data.numel ()));
+  octave_byte_view data (args (1), true);
 
-      if (buf == NULL)
-        {
-          error ("gpib_write: cannot allocate requested memory: %s\n", strerror (errno));
-          return octave_value(-1);
-        }
-
-      for (int i = 0; i < data.numel (); i++)
-        buf[i] = static_cast<uint8_t>(data (i));
-
-      retval = gpib->write (buf, data.numel ());
-    }
-  else
+  if (! data.is_valid ())
     {
       print_usage ();
       return octave_value (-1);
     }
 
+  if (args.length () > 2 && args (2).bool_value ())
+    {
+      gpib->write_async (data.data (), data.length ());
+      retval = 0;
+    }
+  else
+    retval = gpib->write (data.data (), data.length ());
+
   return octave_value (retval);
 #endif
 }
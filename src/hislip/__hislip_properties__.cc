@@ -0,0 +1,335 @@
+// Copyright (C) 2026   John Donoghue   <john.donoghue@ieee.org>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+
+#include <octave/oct.h>
+#include <octave/ov-struct.h>
+
+#include <sstream>
+
+#ifdef HAVE_CONFIG_H
+#  include "../config.h"
+#endif
+
+#ifdef BUILD_TCP
+#  include "hislip_class.h"
+
+static octave_value_list
+hislip_name (octave_hislip *hislip, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  if (args.length () > 0)
+    return octave_value (hislip->set_name (args(0).string_value ()));
+
+  return octave_value (hislip->get_name ());
+}
+
+static octave_value_list
+hislip_tag (octave_hislip *hislip, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  if (args.length () > 0)
+    {
+      hislip->set_tag (args(0).string_value ());
+      return octave_value ();
+    }
+
+  return octave_value (hislip->get_tag ());
+}
+
+static octave_value_list
+hislip_type (octave_hislip *hislip, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (hislip->get_type ());
+}
+
+static octave_value_list
+hislip_port (octave_hislip *hislip, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (hislip->get_port ());
+}
+
+static octave_value_list
+hislip_address (octave_hislip *hislip, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (hislip->get_address ());
+}
+
+static octave_value_list
+hislip_device (octave_hislip *hislip, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (hislip->get_device ());
+}
+
+static octave_value_list
+hislip_status (octave_hislip *hislip, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (hislip->get_status ());
+}
+
+static octave_value_list
+hislip_timeout (octave_hislip *hislip, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  if (args.length () > 0)
+    {
+      if (! (args (0).OV_ISINTEGER () || args (0).OV_ISFLOAT ()))
+        (*current_liboctave_error_handler) ("Timeout must be a number of seconds");
+      return octave_value (hislip->set_timeout (args(0).double_value ()));
+    }
+
+  return octave_value (hislip->get_timeout ());
+}
+
+static octave_value_list
+hislip_overlapped (octave_hislip *hislip, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  // the mode is changed by a device clear
+  if (args.length () > 0)
+    {
+      if (! (args (0).OV_ISLOGICAL () || args (0).OV_ISINTEGER () || args (0).OV_ISFLOAT ()))
+        (*current_liboctave_error_handler) ("Overlapped must be true or false");
+      return octave_value (hislip->device_clear (args (0).bool_value () ? 1 : 0));
+    }
+
+  return octave_value (hislip->get_overlapped ());
+}
+
+static octave_value_list
+hislip_sessionid (octave_hislip *hislip, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (hislip->get_session_id ());
+}
+
+static octave_value_list
+hislip_protocolversion (octave_hislip *hislip, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  int v = hislip->get_protocol_version ();
+  std::ostringstream s;
+  s << (v >> 8) << "." << (v & 0xff);
+
+  return octave_value (s.str ());
+}
+
+static octave_value_list
+hislip_maxmessagesize (octave_hislip *hislip, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (hislip->get_max_message_size ());
+}
+
+static octave_value_list
+hislip_numbyteswritten (octave_hislip *hislip, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (hislip->get_numbyteswritten ());
+}
+
+static octave_value_list
+hislip_byteorder (octave_hislip *hislip, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  if (args.length () > 0)
+    return octave_value (hislip->set_byteorder (args(0).string_value ()));
+
+  return octave_value (hislip->get_byteorder ());
+}
+
+static octave_value_list
+hislip_userdata (octave_hislip *hislip, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  if (args.length () > 0)
+    {
+      hislip->set_userdata (args(0));
+      return octave_value ();
+    }
+
+  return octave_value (hislip->get_userdata ());
+}
+
+static octave_value_list
+hislip_flush (octave_hislip *hislip, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () == 0)
+    (*current_liboctave_error_handler) ("invalid property name");
+
+  return octave_value (hislip->flush (args(0).int_value ()));
+}
+
+static octave_value_list
+hislip_clear (octave_hislip *hislip, const octave_value_list& args, int)
+{
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  return octave_value (hislip->device_clear ());
+}
+
+static octave_value_list
+hislip_trigger (octave_hislip *hislip, const octave_value_list& args, int)
+{
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  return octave_value (hislip->trigger ());
+}
+
+static octave_value_list
+hislip_readstb (octave_hislip *hislip, const octave_value_list& args, int)
+{
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  return octave_value (hislip->read_stb ());
+}
+
+static octave_value_list
+hislip_waitinfo (octave_hislip *hislip, const octave_value_list& args, int)
+{
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  bool pending = false;
+  int fd = hislip->wait_fd (pending);
+
+  Matrix info (1, 2);
+  info(0, 0) = fd;
+  info(0, 1) = pending;
+
+  return octave_value (info);
+}
+
+static const octave_property<octave_hislip> hislip_property_list[] =
+{
+  {"Type", hislip_type, true},
+  {"Name", hislip_name, true},
+  {"Address", hislip_address, true},
+  {"Port", hislip_port, true},
+  {"Device", hislip_device, true},
+  {"Status", hislip_status, true},
+  {"Timeout", hislip_timeout, true},
+  {"Overlapped", hislip_overlapped, true},
+  {"SessionID", hislip_sessionid, true},
+  {"ProtocolVersion", hislip_protocolversion, true},
+  {"MaxMessageSize", hislip_maxmessagesize, true},
+  {"NumBytesWritten", hislip_numbyteswritten, true},
+  {"ByteOrder", hislip_byteorder, true},
+  {"UserData", hislip_userdata, true},
+  {"Tag", hislip_tag, true},
+  // hidden
+  {"flush", hislip_flush, false},
+  {"clear", hislip_clear, false},
+  {"trigger", hislip_trigger, false},
+  {"readstb", hislip_readstb, false},
+  {"waitinfo", hislip_waitinfo, false},
+  {NULL, NULL, false}
+};
+
+const octave_property_table<octave_hislip> &
+octave_hislip::properties (void)
+{
+  static const octave_property_table<octave_hislip> table (hislip_property_list);
+  return table;
+}
+#endif
+
+// PKG_ADD: autoload ("__hislip_properties__", "hislip.oct");
+DEFUN_DLD (__hislip_properties__, args, nargout,
+"-*- texinfo -*-\n\
+@deftypefn {} {varargout =} __hislip_properties__ (@var{octave_hislip}, @var{property}, @var{varargin})\n\
+Undocumented internal function.\n\
+@end deftypefn")
+{
+#ifdef BUILD_TCP
+  if (args.length () < 2 ||
+    args(0).type_id () != octave_hislip::static_type_id () ||
+    !args(1).is_string ())
+      (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  const octave_base_value& rep = args(0).get_rep ();
+  octave_hislip* hislip = &((octave_hislip &)rep);
+
+  const octave_property<octave_hislip> *prop = octave_hislip::properties ().find (args(1).string_value ());
+  if (! prop)
+    (*current_liboctave_error_handler) ("invalid property name");
+
+  return prop->handler (hislip, args.slice (2, args.length ()-2), nargout);
+#endif
+    /* never reached in normal operation */
+  (*current_liboctave_error_handler) ("Your system doesn't support the TCP interface");
+}
+#if 0
+%!error <wrong number of arguments> __hislip_properties__ ()
+
+%!error <wrong number of arguments> __hislip_properties__ (1)
+#endif
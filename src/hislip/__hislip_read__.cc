@@ -0,0 +1,154 @@
+// Copyright (C) 2026   John Donoghue   <john.donoghue@ieee.org>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+
+#include <octave/oct.h>
+
+#ifdef HAVE_CONFIG_H
+#include "../config.h"
+#endif
+
+#ifdef BUILD_TCP
+#include <octave/uint8NDArray.h>
+
+#include "hislip_class.h"
+#include "../common/typed_data.h"
+#endif
+
+// PKG_ADD: autoload ("__hislip_read__", "hislip.oct");
+DEFUN_DLD (__hislip_read__, args, nargout,
+        "-*- texinfo -*-\n\
+@deftypefn {} {[@var{data}, @var{count}, @var{eom}] = } __hislip_read__ (@var{hislip}, @var{n}, @var{timeout})\n \
+@deftypefnx {} {[@var{data}, @var{count}, @var{eom}] = } __hislip_read__ (@var{hislip}, @var{n}, @var{timeout}, @var{datatype})\n \
+\n\
+Private function to read from a hislip interface.\n \
+\n\
+@subsubheading Inputs\n \
+@var{hislip} - instance of @var{octave_hislip} class.@* \
+@var{n} - number of bytes to read, or -1 to read to the end of the message@* \
+@var{timeout} - timeout in ms if different from default of type Integer@* \
+@var{datatype} - precision to read as, in which case @var{n} is the number of values to read and @var{count} is the number of values read\n \
+\n\
+@subsubheading Outputs\n \
+@var{data} - data bytes themselves as uint8 array.@* \
+@var{count} - number of bytes successfully read as an Integer@* \
+@var{eom} - true if the read stopped at the end of a message.\n \
+@end deftypefn")
+{
+#ifndef BUILD_TCP
+  error ("hislip: Your system doesn't support the TCP interface");
+  return octave_value ();
+#else
+
+  if (args.length () < 2 || args.length () > 4 || args (0).type_id () != octave_hislip::static_type_id ())
+    {
+      print_usage ();
+      return octave_value (-1);
+    }
+
+  if (! (args (1).OV_ISINTEGER () || args (1).OV_ISFLOAT ()))
+    {
+      print_usage ();
+      return octave_value (-1);
+    }
+
+  if (args.length () > 2 && ! (args (2).OV_ISINTEGER () || args (2).OV_ISFLOAT ()))
+    {
+      print_usage ();
+      return octave_value (-1);
+    }
+
+  const octave_base_value& rep = args (0).get_rep ();
+  octave_hislip* hislip = &((octave_hislip &)rep);
+
+  double timeout = hislip->get_timeout () * 1000;
+  if (args.length () > 2)
+    timeout = args (2).double_value ();
+
+  bool eom = false;
+
+  // Read values of the requested type directly into the result array
+  if (args.length () > 3)
+    {
+      octave_data_type type;
+
+      if (! args (3).is_string () || args (1).int_value () < 0)
+        {
+          print_usage ();
+          return octave_value (-1);
+        }
+      if (! octave_data_type_lookup (args (3).string_value (), type))
+        {
+          error ("__hislip_read__: precision not supported");
+          return octave_value (-1);
+        }
+
+      bool swap = octave_byteorder_needs_swap (hislip->get_byteorder ());
+
+      octave_value data = octave_read_typed (type, args (1).int_value (), swap,
+        [hislip, timeout, &eom] (uint8_t *buf, unsigned int len)
+        {
+          return hislip->read (buf, len, timeout, &eom);
+        });
+
+      octave_value_list return_list;
+      return_list(0) = data;
+      return_list(1) = data.numel ();
+      return_list(2) = eom;
+
+      return return_list;
+    }
+
+  octave_value_list return_list;
+
+  if (args (1).double_value () < 0)
+    {
+      // a whole message, of any length
+      std::string msg;
+      eom = hislip->readline (msg, timeout);
+
+      uint8NDArray data (dim_vector (1, msg.length ()));
+      if (msg.length () > 0)
+        memcpy (data.fortran_vec (), msg.data (), msg.length ());
+
+      return_list(0) = data;
+      return_list(1) = (double)msg.length ();
+      return_list(2) = eom;
+
+      return return_list;
+    }
+
+  unsigned int buffer_len = args (1).int_value ();
+
+  // Read data directly into the result array
+  uint8NDArray data (dim_vector (1, buffer_len));
+
+  int bytes_read = hislip->read (reinterpret_cast<uint8_t *> (data.fortran_vec ()), buffer_len, timeout, &eom);
+
+  // trim to the bytes actually read
+  data.resize (dim_vector (1, bytes_read));
+
+  return_list(0) = data;
+  return_list(1) = bytes_read;
+  return_list(2) = eom;
+
+  return return_list;
+#endif
+}
+
+#if 0
+%!error <Invalid call to __hislip_read__> __hislip_read__ (1)
+
+%!error <Invalid call to __hislip_read__> __hislip_read__ (1, 10, 0)
+#endif
@@ -0,0 +1,110 @@
+// Copyright (C) 2026   John Donoghue   <john.donoghue@ieee.org>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+
+#include <octave/oct.h>
+
+#ifdef HAVE_CONFIG_H
+#include "../config.h"
+#endif
+
+#ifdef BUILD_TCP
+#include "hislip_class.h"
+#include "../common/binblock.h"
+#endif
+
+// PKG_ADD: autoload ("__hislip_readbinblock__", "hislip.oct");
+DEFUN_DLD (__hislip_readbinblock__, args, nargout,
+        "-*- texinfo -*-\n\
+@deftypefn {} {@var{data} = } __hislip_readbinblock__ (@var{hislip})\n \
+@deftypefnx {} {@var{data} = } __hislip_readbinblock__ (@var{hislip}, @var{datatype})\n \
+\n\
+Private function to read a IEEE 488.2 binblock from a hislip interface.\n \
+\n\
+Any data before the '#' of the block header is discarded. The block data is\n \
+read directly into the result and the trailing terminator is consumed.\n \
+\n\
+@subsubheading Inputs\n \
+@var{hislip} - instance of @var{octave_hislip} class.@* \
+@var{datatype} - precision of the block values (default 'uint8').\n \
+\n\
+@subsubheading Outputs\n \
+@var{data} - the block values, or an empty array if no block was read.\n \
+@end deftypefn")
+{
+#ifndef BUILD_TCP
+  error ("hislip: Your system doesn't support the TCP interface");
+  return octave_value ();
+#else
+
+  if (args.length () < 1 || args.length () > 2 || args (0).type_id () != octave_hislip::static_type_id ())
+    {
+      print_usage ();
+      return octave_value (-1);
+    }
+
+  octave_data_type type;
+  octave_data_type_lookup ("uint8", type);
+
+  if (args.length () > 1)
+    {
+      if (! args (1).is_string ())
+        {
+          print_usage ();
+          return octave_value (-1);
+        }
+      if (! octave_data_type_lookup (args (1).string_value (), type))
+        {
+          error ("__hislip_readbinblock__: datatype not supported");
+          return octave_value (-1);
+        }
+    }
+
+  const octave_base_value& rep = args (0).get_rep ();
+  octave_hislip* hislip = &((octave_hislip &)rep);
+
+  double timeout = hislip->get_timeout () * 1000;
+  bool swap = octave_byteorder_needs_swap (hislip->get_byteorder ());
+
+  // the object keeps no receive buffer, so reads are kept small enough
+  // to leave anything after the block in the message. The longest
+  // header, #9 and nine digits, comes in one read, along with the start
+  // of the data, which is taken from rx first
+  octave_receive_buffer rx;
+
+  // the LF after the block is still to come if the last read did not
+  // end with the END of the message
+  bool eom = false;
+
+  return octave_read_binblock (rx, type, swap,
+    [hislip, timeout, &eom] (uint8_t *buf, unsigned int len)
+    {
+      return hislip->read (buf, len, timeout, &eom);
+    },
+    [] (void)
+    {
+      return 11;
+    },
+    [&eom] (void)
+    {
+      return eom ? 0 : 1;
+    });
+#endif
+}
+
+#if 0
+%!error <Invalid call to __hislip_readbinblock__> __hislip_readbinblock__ ()
+
+%!error <Invalid call to __hislip_readbinblock__> __hislip_readbinblock__ (1)
+#endif
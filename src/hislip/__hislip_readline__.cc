@@ -0,0 +1,88 @@
+// Copyright (C) 2026   John Donoghue   <john.donoghue@ieee.org>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+
+#include <octave/oct.h>
+
+#ifdef HAVE_CONFIG_H
+#include "../config.h"
+#endif
+
+#ifdef BUILD_TCP
+#include "hislip_class.h"
+#endif
+
+// PKG_ADD: autoload ("__hislip_readline__", "hislip.oct");
+DEFUN_DLD (__hislip_readline__, args, nargout,
+        "-*- texinfo -*-\n\
+@deftypefn {} {[@var{data}, @var{found}] = } __hislip_readline__ (@var{hislip}, @var{timeout})\n \
+\n\
+Private function to read a whole message from a hislip interface.\n \
+\n\
+The message is read up to the Data End message that marks its END. A\n \
+trailing newline is removed.\n \
+\n\
+@subsubheading Inputs\n \
+@var{hislip} - instance of @var{octave_hislip} class.@* \
+@var{timeout} - timeout in ms if different from default of type Integer\n \
+\n\
+@subsubheading Outputs\n \
+@var{data} - data read, excluding any trailing newline, as a string.@*\n \
+@var{found} - true if the END of the message was read before a timeout.\n \
+@end deftypefn")
+{
+#ifndef BUILD_TCP
+  error ("hislip: Your system doesn't support the TCP interface");
+  return octave_value ();
+#else
+
+  if (args.length () < 1 || args.length () > 2 || args (0).type_id () != octave_hislip::static_type_id ())
+    {
+      print_usage ();
+      return octave_value (-1);
+    }
+
+  if (args.length () > 1 && ! (args (1).OV_ISINTEGER () || args (1).OV_ISFLOAT ()))
+    {
+      print_usage ();
+      return octave_value (-1);
+    }
+
+  octave_hislip* hislip = NULL;
+
+  const octave_base_value& rep = args (0).get_rep ();
+  hislip = &((octave_hislip &)rep);
+
+  double timeout = hislip->get_timeout () * 1000;
+  if (args.length () > 1)
+    {
+      timeout = args (1).double_value ();
+    }
+
+  std::string line;
+  bool found = hislip->readline (line, timeout);
+
+  octave_value_list return_list;
+  return_list(0) = line;
+  return_list(1) = found;
+
+  return return_list;
+#endif
+}
+
+#if 0
+%!error <Invalid call to __hislip_readline__> __hislip_readline__ ()
+
+%!error <Invalid call to __hislip_readline__> __hislip_readline__ (1)
+#endif
@@ -0,0 +1,106 @@
+// Copyright (C) 2026   John Donoghue   <john.donoghue@ieee.org>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+
+#include <octave/oct.h>
+
+#ifdef HAVE_CONFIG_H
+#include "../config.h"
+#endif
+
+#ifdef BUILD_TCP
+#include "hislip_class.h"
+#include "../common/byte_view.h"
+#include "../common/typed_data.h"
+#endif
+
+// PKG_ADD: autoload ("__hislip_write__", "hislip.oct");
+DEFUN_DLD (__hislip_write__, args, nargout,
+        "-*- texinfo -*-\n\
+@deftypefn {} {@var{n} = } __hislip_write__ (@var{hislip}, @var{data})\n \
+@deftypefnx {} {@var{n} = } __hislip_write__ (@var{hislip}, @var{data}, @var{datatype})\n \
+\n\
+Private function to write data to a hislip interface.\n \
+\n\
+@subsubheading Inputs\n \
+@var{hislip} - instance of @var{octave_hislip} class.@* \
+@var{data} - data to be written to the hislip interface as one message. Can be a String, or an integer or floating point array which is written as its raw bytes.@*\
+@var{datatype} - precision to convert @var{data} to before writing, in the byte order of the object.\n \
+\n\
+@subsubheading Outputs\n \
+Upon successful completion, __hislip_write__() shall return the number of bytes written as the result @var{n}.\n \
+@end deftypefn")
+{
+#ifndef BUILD_TCP
+  error("hislip: Your system doesn't support the TCP interface");
+  return octave_value ();
+#else
+  if (args.length () < 2 || args.length () > 3 || args (0).type_id () != octave_hislip::static_type_id ())
+    {
+      print_usage ();
+      return octave_value (-1);
+    }
+
+  octave_hislip *hislip = NULL;
+  int retval;
+
+  const octave_base_value& rep = args (0).get_rep ();
+  hislip = &((octave_hislip &)rep);
+
+  if (args.length () > 2)
+    {
+      octave_data_type type;
+
+      if (! args (2).is_string ())
+        {
+          print_usage ();
+          return octave_value (-1);
+        }
+      if (! octave_data_type_lookup (args (2).string_value (), type))
+        {
+          error ("__hislip_write__: precision not supported");
+          return octave_value (-1);
+        }
+
+      bool swap = octave_byteorder_needs_swap (hislip->get_byteorder ());
+
+      retval = octave_write_typed (args (1), type, swap,
+        [hislip] (uint8_t *buf, unsigned int len)
+        {
+          return hislip->write (buf, len);
+        });
+
+      return octave_value (retval);
+    }
+
+  octave_byte_view data (args (1));
+
+  if (! data.is_valid ())
+    {
+      print_usage ();
+      return octave_value (-1);
+    }
+
+  retval = hislip->write (data.data (), data.length ());
+
+  return octave_value (retval);
+#endif
+}
+
+#if 0
+%!error <Invalid call to __hislip_write> __hislip_write__(1, uint8([104  101  108  108  111]))
+
+%!error <Invalid call to __hislip_write__> __hislip_write__()
+#endif
+
@@ -0,0 +1,83 @@
+// Copyright (C) 2026   John Donoghue   <john.donoghue@ieee.org>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+
+#include <octave/oct.h>
+
+#ifdef HAVE_CONFIG_H
+#include "../config.h"
+#endif
+
+#ifdef BUILD_TCP
+#include "hislip_class.h"
+#include "../common/binblock.h"
+#endif
+
+// PKG_ADD: autoload ("__hislip_writebinblock__", "hislip.oct");
+DEFUN_DLD (__hislip_writebinblock__, args, nargout,
+        "-*- texinfo -*-\n\
+@deftypefn {} {@var{n} = } __hislip_writebinblock__ (@var{hislip}, @var{data}, @var{datatype})\n \
+\n\
+Private function to write data as a IEEE 488.2 binblock to a hislip interface.\n \
+\n\
+The block header, data and terminator are sent as a single message.\n \
+\n\
+@subsubheading Inputs\n \
+@var{hislip} - instance of @var{octave_hislip} class.@* \
+@var{data} - data to write.@* \
+@var{datatype} - precision to convert @var{data} to.\n \
+\n\
+@subsubheading Outputs\n \
+@var{n} - number of bytes written, including the header and terminator.\n \
+@end deftypefn")
+{
+#ifndef BUILD_TCP
+  error ("hislip: Your system doesn't support the TCP interface");
+  return octave_value ();
+#else
+
+  if (args.length () != 3 || args (0).type_id () != octave_hislip::static_type_id () || ! args (2).is_string ())
+    {
+      print_usage ();
+      return octave_value (-1);
+    }
+
+  octave_data_type type;
+
+  if (! octave_data_type_lookup (args (2).string_value (), type))
+    {
+      error ("__hislip_writebinblock__: datatype not supported");
+      return octave_value (-1);
+    }
+
+  const octave_base_value& rep = args (0).get_rep ();
+  octave_hislip* hislip = &((octave_hislip &)rep);
+
+  bool swap = octave_byteorder_needs_swap (hislip->get_byteorder ());
+
+  int retval = octave_write_binblock (args (1), type, swap,
+    [hislip] (uint8_t *buf, unsigned int len)
+    {
+      return hislip->write (buf, len);
+    });
+
+  return octave_value (retval);
+#endif
+}
+
+#if 0
+%!error <Invalid call to __hislip_writebinblock__> __hislip_writebinblock__ ()
+
+%!error <Invalid call to __hislip_writebinblock__> __hislip_writebinblock__ (1, "hello", "uint8")
+#endif
@@ -0,0 +1,258 @@
+// Copyright (C) 2026   John Donoghue   <john.donoghue@ieee.org>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+
+#include <octave/oct.h>
+#include <octave/Matrix.h>
+
+#include <algorithm>
+
+#ifdef HAVE_CONFIG_H
+#  include "../config.h"
+#endif
+
+#ifdef BUILD_TCP
+#  include "hislip_class.h"
+#endif
+
+// PKG_ADD: autoload ("hislip", "hislip.oct");
+DEFUN_DLD (hislip, args, nargout,
+        "-*- texinfo -*-\n\
+@deftypefn {} {@var{hislip} = } hislip (@var{ipaddress})\n \
+@deftypefnx {} {@var{hislip} = } hislip (@var{ipaddress}, @var{device})\n \
+@deftypefnx {} {@var{hislip} = } hislip (@dots{}, [@var{propertyname}, @var{propertyvalue}])\n \
+\n\
+Open a HiSLIP session to an instrument.\n \
+\n\
+HiSLIP carries whole messages, each ended by END, over a synchronous channel, \
+and device clear, status queries and service requests over an asynchronous channel.\n \
+\n\
+@subsubheading Inputs\n \
+@var{ipaddress} - the ip address or host name of the instrument.@* \
+@var{device} - the HiSLIP sub-address of the device, default 'hislip0'.@* \
+@var{propname},@var{propvalue} - property name/value pairs.\n \
+\n \
+Known input properties:\n \
+@table @asis\n \
+@item Port\n \
+port number, default 4880\n \
+@item Name\n \
+name value\n \
+@item Tag\n \
+tag value\n \
+@item Timeout\n \
+Numeric timeout value in seconds or -1 to wait forever, default 10\n \
+@item Overlapped\n \
+true for overlapped mode, in which several queries may be sent before \
+their responses are read, and false for synchronized mode. The default is the instrument's choice.\n \
+@item UserData\n \
+User data value.\n \
+@end table\n \
+\n\
+@subsubheading Outputs\n \
+The hislip() shall return instance of @var{octave_hislip} class as the result @var{hislip}.\n \
+\n \
+@subsubheading Properties\n \
+The hislip object has the following public properties:\n \
+@table @asis\n \
+@item Name\n \
+name assigned to the hislip object\n \
+@item Tag\n \
+user tag assigned to the hislip object\n \
+@item Type\n \
+instrument type 'hislip' (readonly)\n \
+@item Address\n \
+remote host address (readonly)\n \
+@item Port\n \
+remote port number (readonly)\n \
+@item Device\n \
+HiSLIP sub-address (readonly)\n \
+@item Status\n \
+status of the object 'open' or 'closed' (readonly)\n \
+@item Timeout\n \
+timeout value in seconds used for waiting for data\n \
+@item Overlapped\n \
+true in overlapped mode. Setting it clears the device to change the mode.\n \
+@item SessionID\n \
+session id given by the instrument (readonly)\n \
+@item ProtocolVersion\n \
+HiSLIP protocol version in use (readonly)\n \
+@item MaxMessageSize\n \
+largest message the instrument accepts, longer writes are split (readonly)\n \
+@item NumBytesWritten\n \
+number of bytes written (readonly)\n \
+@item ByteOrder\n \
+Byte order for data read or written with a precision\n \
+@item UserData\n \
+User data\n \
+@end table \n \
+@seealso{hislip_waitsrq, clrdevice, trigger, spoll}\n \
+@end deftypefn")
+{
+#ifndef BUILD_TCP
+  error("hislip: Your system doesn't support the TCP interface");
+  return octave_value ();
+#else
+  // Do not open interface if return value is not assigned
+  if (nargout != 1)
+    {
+      print_usage ();
+      return octave_value ();
+    }
+
+  // Default values
+  std::string address;
+  std::string device ("hislip0");
+  std::string name = "";
+  std::string tag = "";
+  int port = 4880;
+  double timeout = 10;
+  int overlap = -1;
+  octave_value userdata = Matrix();
+
+  // Parse the function arguments
+  if (args.length () < 1)
+    {
+      print_usage ();
+      return octave_value ();
+    }
+
+  if (args (0).is_string ())
+    {
+      address = args (0).string_value ();
+    }
+  else
+    {
+       error ("Expected address as a string");
+       return octave_value ();
+    }
+
+  int i = 1;
+
+  // the device comes before any property pairs
+  if ((args.length () & 1) == 0)
+    {
+      if (! args (1).is_string ())
+        {
+          error ("Expected device as a string");
+          return octave_value ();
+        }
+      device = args (1).string_value ();
+      i = 2;
+    }
+
+  // go through the properties
+  for(;i<args.length();i+=2)
+    {
+      if (! args(i).is_string ())
+        {
+          error ("Expected property name/value pairs");
+          return octave_value ();
+        }
+
+      std::string propname = args(i).string_value();
+      octave_value propval = args(i+1);
+
+      std::transform (propname.begin (), propname.end (), propname.begin (), ::tolower);
+
+      if (propname == "port")
+        {
+          if (propval.OV_ISINTEGER () || propval.OV_ISFLOAT ())
+            port = propval.int_value ();
+          else
+            {
+              error ("port must be a integer");
+              return octave_value ();
+            }
+        }
+      else if (propname == "name")
+        {
+          if (propval.is_string ())
+            name = propval.string_value ();
+          else
+            {
+              error ("name must be a string");
+              return octave_value ();
+            }
+        }
+      else if (propname == "tag")
+        {
+          if (propval.is_string ())
+            tag = propval.string_value ();
+          else
+            {
+              error ("tag must be a string");
+              return octave_value ();
+            }
+        }
+      else if (propname == "timeout")
+        {
+          if (propval.OV_ISINTEGER () || propval.OV_ISFLOAT ())
+            timeout = propval.double_value ();
+          else
+            {
+              error ("timeout must be a integer or double");
+              return octave_value ();
+            }
+        }
+      else if (propname == "overlapped")
+        {
+          if (propval.OV_ISLOGICAL () || propval.OV_ISINTEGER () || propval.OV_ISFLOAT ())
+            overlap = propval.bool_value () ? 1 : 0;
+          else
+            {
+              error ("overlapped must be true or false");
+              return octave_value ();
+            }
+        }
+      else if (propname == "userdata")
+        {
+          userdata = propval;
+        }
+      else
+        {
+          error ("unknown property '%s'", propname.c_str ());
+          return octave_value ();
+        }
+    }
+
+  octave_hislip* retval = new octave_hislip ();
+
+  retval->set_timeout (timeout);
+
+  // Open the session
+  if (retval->open (address, port, device, overlap) < 0)
+    {
+      return octave_value ();
+    }
+
+  if (name.length() > 0)
+    retval->set_name (name);
+
+  retval->set_userdata (userdata);
+  retval->set_tag (tag);
+
+  return octave_value (retval);
+#endif
+}
+
+#if 0
+%!error <Invalid call to hislip> hislip ()
+
+%!error <Invalid call to hislip> a = hislip ()
+
+%!error <Expected address as a string> a = hislip (1)
+
+%!error <unknown property> a = hislip ("127.0.0.1", "hislip0", "prop1", 1)
+#endif
@@ -0,0 +1,1040 @@
+// Copyright (C) 2026 John Donoghue <john.donoghue@ieee.org>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+
+#include <octave/oct.h>
+
+#ifdef HAVE_CONFIG_H
+#include "../config.h"
+#endif
+
+#ifdef BUILD_TCP
+#include <iostream>
+#include <string>
+#include <algorithm>
+
+#ifndef __WIN32__
+#include <unistd.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <netdb.h>
+#include <arpa/inet.h>
+#else
+#include <winsock2.h>
+#endif
+
+#ifndef __WIN32__
+#define SOCKETERR errno
+#define STRSOCKETERR strerror(errno)
+#else
+#define SOCKETERR WSAGetLastError()
+#define STRSOCKETERR ""
+#define socklen_t int
+#endif
+
+#ifdef MSG_NOSIGNAL
+#define SEND_FLAGS MSG_NOSIGNAL
+#else
+#define SEND_FLAGS 0
+#endif
+
+#include "hislip_class.h"
+#include "../common/socket_wait.h"
+#include "../common/socket_util.h"
+#include <octave/Matrix.h>
+
+// HiSLIP message types
+enum
+{
+  HISLIP_INITIALIZE = 0,
+  HISLIP_INITIALIZE_RESPONSE = 1,
+  HISLIP_FATAL_ERROR = 2,
+  HISLIP_ERROR = 3,
+  HISLIP_DATA = 6,
+  HISLIP_DATA_END = 7,
+  HISLIP_DEVICE_CLEAR_COMPLETE = 8,
+  HISLIP_DEVICE_CLEAR_ACKNOWLEDGE = 9,
+  HISLIP_TRIGGER = 12,
+  HISLIP_INTERRUPTED = 13,
+  HISLIP_ASYNC_INTERRUPTED = 14,
+  HISLIP_ASYNC_MAXIMUM_MESSAGE_SIZE = 15,
+  HISLIP_ASYNC_MAXIMUM_MESSAGE_SIZE_RESPONSE = 16,
+  HISLIP_ASYNC_INITIALIZE = 17,
+  HISLIP_ASYNC_INITIALIZE_RESPONSE = 18,
+  HISLIP_ASYNC_DEVICE_CLEAR = 19,
+  HISLIP_ASYNC_SERVICE_REQUEST = 20,
+  HISLIP_ASYNC_STATUS_QUERY = 21,
+  HISLIP_ASYNC_STATUS_RESPONSE = 22,
+  HISLIP_ASYNC_DEVICE_CLEAR_ACKNOWLEDGE = 23
+};
+
+#define HISLIP_HEADER_SIZE	16
+#define HISLIP_VERSION		0x0100	/* 1.0 */
+#define HISLIP_VENDOR		0x4f43	/* "OC" */
+#define HISLIP_FIRST_MESSAGE_ID	0xffffff00
+// largest message we accept, as responses are read straight into the
+// caller's buffer this only bounds a single message
+#define HISLIP_MAX_RECEIVE	((uint64_t)1 << 32)
+// control messages other than data are short
+#define HISLIP_MAX_CONTROL	65536
+
+static void
+put_u32 (uint8_t *p, uint32_t v)
+{
+  p[0] = v >> 24;
+  p[1] = v >> 16;
+  p[2] = v >> 8;
+  p[3] = v;
+}
+
+static uint32_t
+get_u32 (const uint8_t *p)
+{
+  return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static void
+put_u64 (uint8_t *p, uint64_t v)
+{
+  put_u32 (p, v >> 32);
+  put_u32 (p + 4, v);
+}
+
+static uint64_t
+get_u64 (const uint8_t *p)
+{
+  return ((uint64_t)get_u32 (p) << 32) | get_u32 (p + 4);
+}
+
+static int
+connect_socket (const sockaddr_in *addr)
+{
+  int fd = socket (AF_INET, SOCK_STREAM, 0);
+  if (fd < 0)
+    return -1;
+
+  // messages are sent whole, so there is nothing to gain by delaying them
+#ifdef __WIN32__
+  DWORD sockval = 1;
+#else
+  int sockval = 1;
+#endif
+  setsockopt (fd, IPPROTO_TCP, TCP_NODELAY, (char*)&sockval, sizeof (sockval));
+
+  if (connect (fd, (const struct sockaddr*)addr, sizeof (*addr)) < 0)
+    {
+      octave_close_socket (fd);
+      return -1;
+    }
+
+  return fd;
+}
+
+static int
+send_all (int fd, const uint8_t *buf, uint64_t len)
+{
+  while (len > 0)
+    {
+      int n = len > 0x40000000 ? 0x40000000 : (int)len;
+      int ret = ::send (fd, reinterpret_cast<const char *> (buf), n, SEND_FLAGS);
+      if (ret <= 0)
+        return -1;
+      buf += ret;
+      len -= ret;
+    }
+  return 0;
+}
+
+// wait for data, then take what is there up to len bytes. Returns 0 on a
+// timeout and -1 on an error or a closed connection
+static int
+recv_some (int fd, uint8_t *buf, uint64_t len, const octave_deadline &deadline)
+{
+  int ready = octave_wait_readable (fd, deadline);
+  if (ready <= 0)
+    return ready;
+
+  int n = len > 0x40000000 ? 0x40000000 : (int)len;
+  int ret = ::recv (fd, reinterpret_cast<char *> (buf), n, 0);
+  return ret > 0 ? ret : -1;
+}
+
+// read exactly len bytes, returning the number read before a timeout or
+// -1 on an error
+static int64_t
+recv_exact (int fd, uint8_t *buf, uint64_t len, const octave_deadline &deadline)
+{
+  uint64_t got = 0;
+  while (got < len)
+    {
+      int ret = recv_some (fd, buf + got, len - got, deadline);
+      if (ret < 0)
+        return -1;
+      if (ret == 0)
+        break;
+      got += ret;
+    }
+  return got;
+}
+
+DEFINE_OV_TYPEID_FUNCTIONS_AND_DATA (octave_hislip, "octave_hislip", "octave_hislip");
+
+octave_hislip::octave_hislip (void)
+: sync_fd (-1), async_fd (-1), timeout (10), name (""), port (4880),
+  byteswritten (0), overlapped (false), session_id (0), protocol_version (0),
+  max_message_size (0), message_id (HISLIP_FIRST_MESSAGE_ID),
+  last_end_id (HISLIP_FIRST_MESSAGE_ID - 2), rmt_delivered (false),
+  hdr_have (0), msg_left (0), msg_end (false), msg_discard (false),
+  srq_count (0), srq_seen (0), last_stb (0)
+{
+  static bool type_registered = false;
+
+  if (! type_registered)
+    {
+      type_registered = true;
+      register_type ();
+    }
+
+  userData = Matrix ();
+  byteOrder = "little-endian";
+}
+
+octave_hislip::~octave_hislip (void)
+{
+  octave_hislip::close ();
+}
+
+octave_value_list
+octave_hislip::subsref (const std::string& type, const std::list<octave_value_list>& idx, int nargout)
+{
+  octave_value_list retval;
+  int skip = 1;
+
+  switch (type[0])
+    {
+    default:
+      error ("octave_hislip object cannot be indexed with %c", type[0]);
+      return retval;
+    case '.':
+      {
+        std::string property = (idx.front ()) (0).string_value ();
+        const octave_property<octave_hislip> *prop = properties ().find_field (property);
+        if (! prop)
+          {
+            error ("Unknown property '%s'", property.c_str());
+            return retval;
+          }
+
+        retval = prop->handler (this, octave_value_list (), 1);
+      }
+      break;
+    }
+
+  if (idx.size () > 1 && type.length () > 1)
+    retval = retval (0).next_subsref (nargout, type, idx, skip);
+
+  return retval;
+}
+
+octave_value
+octave_hislip::subsasgn (const std::string& type, const std::list<octave_value_list>& idx, const octave_value& rhs)
+{
+  octave_value retval;
+
+  switch (type[0])
+    {
+    default:
+      error ("octave_hislip object cannot be indexed with %c", type[0]);
+      break;
+    case '.':
+      if (type.length () == 1)
+        {
+          std::string property = (idx.front ()) (0).string_value ();
+          const octave_property<octave_hislip> *prop = properties ().find_field (property);
+          if (! prop)
+            {
+              error ("Unknown property '%s'", property.c_str());
+              return retval;
+            }
+
+          prop->handler (this, octave_value_list (rhs), 0);
+          OV_COUNT++;
+          retval = octave_value (this);
+        }
+      else if (type.length () > 1 && type[1] == '.')
+        {
+          // pass along any further assignments
+          octave_value_list u = subsref (type.substr (0, 1), idx, 1);
+          if (u.length () > 0)
+            {
+              std::list<octave_value_list> next_idx (idx);
+              next_idx.erase (next_idx.begin ());
+              u (0).subsasgn(type.substr (1), next_idx, rhs);
+              OV_COUNT++;
+              retval = octave_value (this);
+            }
+        }
+      else
+        {
+          error ("octave_hislip invalid index");
+        }
+
+    }
+  return retval;
+}
+
+void
+octave_hislip::print (std::ostream& os, bool pr_as_read_syntax)
+{
+  print_raw (os, pr_as_read_syntax);
+  newline (os);
+}
+
+void
+octave_hislip::print (std::ostream& os, bool pr_as_read_syntax ) const
+{
+  print_raw (os, pr_as_read_syntax);
+  newline (os);
+}
+
+void
+octave_hislip::print_raw (std::ostream& os, bool pr_as_read_syntax) const
+{
+  os << "  HiSLIP Object " << get_name ();
+  newline(os);
+  os << "    Address: " << get_address ();
+  newline(os);
+  os << "       Port: " << get_port ();
+  newline(os);
+  os << "     Device: " << get_device ();
+  newline(os);
+}
+
+int
+octave_hislip::send_message (int fd, int type, int control, uint32_t param, const uint8_t *payload, uint64_t len)
+{
+  uint8_t header[HISLIP_HEADER_SIZE];
+
+  header[0] = 'H';
+  header[1] = 'S';
+  header[2] = type;
+  header[3] = control;
+  put_u32 (header + 4, param);
+  put_u64 (header + 8, len);
+
+  // short messages go out in a single send
+  if (len <= 4096)
+    {
+      uint8_t buf[HISLIP_HEADER_SIZE + 4096];
+      memcpy (buf, header, HISLIP_HEADER_SIZE);
+      if (len > 0)
+        memcpy (buf + HISLIP_HEADER_SIZE, payload, len);
+      return send_all (fd, buf, HISLIP_HEADER_SIZE + len);
+    }
+
+  if (send_all (fd, header, HISLIP_HEADER_SIZE) < 0)
+    return -1;
+
+  return send_all (fd, payload, len);
+}
+
+// read a whole control message, returning 1, 0 on a timeout before it
+// started or -1 on an error. Once a message has started, the rest of it
+// is waited for for up to the timeout even if the caller's deadline has
+// passed, as a message left part read would put the channel out of step.
+// If it still does not come the connection is closed, to be opened again.
+int
+octave_hislip::recv_message (int fd, int &type, int &control, uint32_t &param, std::string &payload, const octave_deadline &deadline)
+{
+  uint8_t header[HISLIP_HEADER_SIZE];
+
+  int64_t got = recv_exact (fd, header, HISLIP_HEADER_SIZE, deadline);
+  if (got <= 0)
+    return got;
+
+  octave_deadline rest (timeout < 0 ? -1 : timeout * 1000);
+
+  int64_t more = recv_exact (fd, header + got, HISLIP_HEADER_SIZE - got, rest);
+  if (more < 0)
+    return -1;
+
+  if (got + more != HISLIP_HEADER_SIZE || header[0] != 'H' || header[1] != 'S')
+    {
+      close ();
+      error ("hislip: incomplete or invalid message, connection closed");
+      return -1;
+    }
+
+  type = header[2];
+  control = header[3];
+  param = get_u32 (header + 4);
+
+  uint64_t len = get_u64 (header + 8);
+  if (len > HISLIP_MAX_CONTROL)
+    {
+      close ();
+      error ("hislip: control message too long, connection closed");
+      return -1;
+    }
+
+  payload.resize (len);
+  if (len > 0)
+    {
+      got = recv_exact (fd, reinterpret_cast<uint8_t *> (&payload[0]), len, rest);
+      if (got < 0)
+        return -1;
+      if (got != (int64_t)len)
+        {
+          close ();
+          error ("hislip: incomplete or invalid message, connection closed");
+          return -1;
+        }
+    }
+
+  return 1;
+}
+
+// read messages on the asynchronous channel until one of type expect,
+// counting any service requests on the way
+int
+octave_hislip::recv_async (int expect, int &control, uint32_t &param, std::string &payload, const octave_deadline &deadline)
+{
+  while (true)
+    {
+      int type;
+      int ret = recv_message (async_fd, type, control, param, payload, deadline);
+      if (ret <= 0)
+        return ret;
+
+      if (type == HISLIP_ASYNC_SERVICE_REQUEST)
+        {
+          srq_count++;
+          last_stb = control;
+        }
+      else if (type == HISLIP_FATAL_ERROR || type == HISLIP_ERROR)
+        {
+          error ("hislip: instrument reported %s error %d: %s",
+                 type == HISLIP_FATAL_ERROR ? "fatal" : "an", control, payload.c_str ());
+          return -1;
+        }
+
+      if (type == expect)
+        return 1;
+    }
+}
+
+// discard the rest of the current message's payload
+int
+octave_hislip::skip_payload (uint64_t len, const octave_deadline &deadline)
+{
+  uint8_t tmp[4096];
+
+  msg_left = len;
+  while (msg_left > 0)
+    {
+      int ret = recv_some (sync_fd, tmp, msg_left < sizeof (tmp) ? msg_left : sizeof (tmp), deadline);
+      if (ret < 0)
+        {
+          error ("hislip: connection lost");
+          return -1;
+        }
+      if (ret == 0)
+        {
+          msg_discard = true;
+          return 0;
+        }
+      msg_left -= ret;
+    }
+
+  msg_discard = false;
+  return 1;
+}
+
+// move on to the next message with data for the caller, returning 1, 0
+// on a timeout or -1 on an error
+int
+octave_hislip::next_data (const octave_deadline &deadline)
+{
+  if (msg_discard && skip_payload (msg_left, deadline) <= 0)
+    return msg_discard ? 0 : -1;
+
+  while (true)
+    {
+      // the header may arrive over more than one read
+      while (hdr_have < HISLIP_HEADER_SIZE)
+        {
+          int ret = recv_some (sync_fd, hdr + hdr_have, HISLIP_HEADER_SIZE - hdr_have, deadline);
+          if (ret < 0)
+            {
+              error ("hislip: connection lost");
+              return -1;
+            }
+          if (ret == 0)
+            return 0;
+          hdr_have += ret;
+        }
+
+      hdr_have = 0;
+
+      if (hdr[0] != 'H' || hdr[1] != 'S')
+        {
+          close ();
+          error ("hislip: invalid message from instrument");
+          return -1;
+        }
+
+      int type = hdr[2];
+      int control = hdr[3];
+      uint32_t param = get_u32 (hdr + 4);
+      uint64_t len = get_u64 (hdr + 8);
+
+      if (type == HISLIP_DATA || type == HISLIP_DATA_END)
+        {
+          msg_left = len;
+          msg_end = (type == HISLIP_DATA_END);
+
+          // when synchronised, only the response to the latest message
+          // is wanted
+          if (overlapped || param == last_end_id)
+            return 1;
+        }
+      else if (type == HISLIP_FATAL_ERROR || type == HISLIP_ERROR)
+        {
+          std::string text (len < HISLIP_MAX_CONTROL ? len : 0, '\0');
+          if (len > 0 && len < HISLIP_MAX_CONTROL)
+            recv_exact (sync_fd, reinterpret_cast<uint8_t *> (&text[0]), len, deadline);
+          if (type == HISLIP_FATAL_ERROR)
+            close ();
+          error ("hislip: instrument reported %s error %d: %s",
+                 type == HISLIP_FATAL_ERROR ? "fatal" : "an", control, text.c_str ());
+          return -1;
+        }
+
+      int ret = skip_payload (len, deadline);
+      if (ret <= 0)
+        return ret;
+    }
+}
+
+int
+octave_hislip::open (const std::string &addr, int p, const std::string &dev, int overlap)
+{
+#ifdef __WIN32__
+  WORD wVersionRequested;
+  WSADATA wsaData;
+  int err;
+
+  wVersionRequested = MAKEWORD( 2, 2 );
+  err = WSAStartup (wVersionRequested, &wsaData);
+  if ( err != 0 )
+    {
+      error( "could not initialize winsock library" );
+      return -1;
+    }
+#endif
+
+  name = "HiSLIP-" + addr;
+  address = addr;
+  port = p;
+  device = dev;
+
+  sockaddr_in remote_addr;
+  memset (&remote_addr, 0, sizeof (remote_addr));
+
+  if (! octave_lookup_addr (address, &remote_addr))
+    {
+      error ("hislip: error looking up remote host : %d - %s\n", SOCKETERR, STRSOCKETERR);
+      return -1;
+    }
+  remote_addr.sin_family = AF_INET;
+  remote_addr.sin_port = htons (port);
+
+  octave_deadline deadline (timeout < 0 ? -1 : timeout * 1000);
+  int type, control;
+  uint32_t param;
+  std::string payload;
+
+  sync_fd = connect_socket (&remote_addr);
+  if (sync_fd < 0)
+    {
+      error ("hislip: error on connect : %d - %s\n", SOCKETERR, STRSOCKETERR);
+      return -1;
+    }
+
+  if (send_message (sync_fd, HISLIP_INITIALIZE, 0, (HISLIP_VERSION << 16) | HISLIP_VENDOR,
+                    reinterpret_cast<const uint8_t *> (device.c_str ()), device.length ()) < 0
+      || recv_message (sync_fd, type, control, param, payload, deadline) <= 0)
+    {
+      close ();
+      error ("hislip: no response to Initialize");
+      return -1;
+    }
+
+  if (type != HISLIP_INITIALIZE_RESPONSE)
+    {
+      close ();
+      error ("hislip: cannot open '%s': %s", device.c_str (), payload.c_str ());
+      return -1;
+    }
+
+  overlapped = (control & 1) != 0;
+  session_id = param & 0xffff;
+  protocol_version = std::min<int> (param >> 16, HISLIP_VERSION);
+
+  async_fd = connect_socket (&remote_addr);
+  if (async_fd < 0)
+    {
+      int err = SOCKETERR;
+      close ();
+      error ("hislip: error on connect of asynchronous channel : %d\n", err);
+      return -1;
+    }
+
+  if (send_message (async_fd, HISLIP_ASYNC_INITIALIZE, 0, session_id, 0, 0) < 0
+      || recv_async (HISLIP_ASYNC_INITIALIZE_RESPONSE, control, param, payload, deadline) <= 0)
+    {
+      close ();
+      error ("hislip: no response to AsyncInitialize");
+      return -1;
+    }
+
+  uint8_t size[8];
+  put_u64 (size, HISLIP_MAX_RECEIVE);
+
+  if (send_message (async_fd, HISLIP_ASYNC_MAXIMUM_MESSAGE_SIZE, 0, 0, size, sizeof (size)) < 0
+      || recv_async (HISLIP_ASYNC_MAXIMUM_MESSAGE_SIZE_RESPONSE, control, param, payload, deadline) <= 0
+      || payload.length () != 8)
+    {
+      close ();
+      error ("hislip: no response to AsyncMaximumMessageSize");
+      return -1;
+    }
+
+  max_message_size = get_u64 (reinterpret_cast<const uint8_t *> (payload.data ()));
+
+  // the mode is chosen by the instrument, and changed with a device clear
+  if (overlap >= 0 && (overlap != 0) != overlapped)
+    {
+      if (device_clear (overlap) < 0)
+        {
+          close ();
+          return -1;
+        }
+    }
+
+  return sync_fd;
+}
+
+int
+octave_hislip::close (void)
+{
+  int retval = -1;
+
+  if (async_fd >= 0)
+    {
+      octave_close_socket (async_fd);
+      async_fd = -1;
+    }
+
+  if (sync_fd >= 0)
+    {
+      octave_close_socket (sync_fd);
+      sync_fd = -1;
+      retval = 0;
+    }
+
+  hdr_have = 0;
+  msg_left = 0;
+  msg_end = false;
+  msg_discard = false;
+
+  return retval;
+}
+
+int
+octave_hislip::write (const uint8_t *buf, unsigned int len)
+{
+  if (! is_open ())
+    {
+      error ("hislip: Interface must be opened first...");
+      return -1;
+    }
+
+  // when synchronised, a new message abandons any response not yet read
+  if (! overlapped && msg_left > 0)
+    msg_discard = true;
+
+  uint64_t chunk = max_message_size > 0 ? max_message_size : len;
+  unsigned int sent = 0;
+
+  // messages larger than the instrument accepts are split, with END on
+  // the last
+  do
+    {
+      unsigned int n = (len - sent) < chunk ? (len - sent) : (unsigned int)chunk;
+      bool last = (sent + n == len);
+
+      if (send_message (sync_fd, last ? HISLIP_DATA_END : HISLIP_DATA, rmt_delivered ? 1 : 0,
+                        message_id, buf + sent, n) < 0)
+        {
+          error ("hislip: error writing : %d - %s\n", SOCKETERR, STRSOCKETERR);
+          return -1;
+        }
+
+      rmt_delivered = false;
+      if (last)
+        last_end_id = message_id;
+      message_id += 2;
+      sent += n;
+    }
+  while (sent < len);
+
+  byteswritten += len;
+  return len;
+}
+
+int
+octave_hislip::read (uint8_t *buf, unsigned int len, double readtimeout, bool *end)
+{
+  if (end)
+    *end = false;
+
+  if (! is_open ())
+    {
+      error ("hislip: Interface must be opened first...");
+      return 0;
+    }
+
+  // the timeout is for the whole read, not each wait for data
+  octave_deadline deadline (readtimeout);
+  unsigned int bytes_read = 0;
+
+  while (bytes_read < len)
+    {
+      if (msg_left == 0 || msg_discard)
+        {
+          if (next_data (deadline) <= 0)
+            break;
+
+          if (msg_left == 0)
+            {
+              if (msg_end)
+                {
+                  // an empty message ending a response
+                  msg_end = false;
+                  rmt_delivered = true;
+                  if (end)
+                    *end = true;
+                  break;
+                }
+              continue;
+            }
+        }
+
+      uint64_t want = len - bytes_read;
+      if (want > msg_left)
+        want = msg_left;
+
+      int ret = recv_some (sync_fd, buf + bytes_read, want, deadline);
+      if (ret < 0)
+        {
+          error ("hislip: connection lost");
+          break;
+        }
+      if (ret == 0)
+        break;
+
+      bytes_read += ret;
+      msg_left -= ret;
+
+      if (msg_left == 0 && msg_end)
+        {
+          msg_end = false;
+          rmt_delivered = true;
+          if (end)
+            *end = true;
+          break;
+        }
+    }
+
+  return bytes_read;
+}
+
+bool
+octave_hislip::readline (std::string &line, double readtimeout)
+{
+  octave_deadline deadline (readtimeout);
+  bool end = false;
+
+  line.clear ();
+  while (! end)
+    {
+      // read in pieces of at least the size of the message
+      size_t have = line.length ();
+      size_t want = msg_left > 0 && msg_left < (1 << 26) ? msg_left : 4096;
+      line.resize (have + want);
+
+      double left = deadline.is_forever () ? -1
+        : std::chrono::duration<double, std::milli> (deadline.remaining ()).count ();
+      int n = read (reinterpret_cast<uint8_t *> (&line[have]), want, left, &end);
+      line.resize (have + n);
+
+      if (n == 0 && ! end)
+        break;
+    }
+
+  // the END marks the end of the message, a newline may also be sent
+  if (end && line.length () > 0 && line[line.length () - 1] == '\n')
+    line.resize (line.length () - 1);
+  if (end && line.length () > 0 && line[line.length () - 1] == '\r')
+    line.resize (line.length () - 1);
+
+  return end;
+}
+
+bool
+octave_hislip::writeread (const std::string &cmd, std::string &line, double readtimeout)
+{
+  if (write (reinterpret_cast<const uint8_t *> (cmd.c_str ()), cmd.length ()) < 0)
+    return false;
+
+  return readline (line, readtimeout);
+}
+
+int
+octave_hislip::device_clear (int overlap)
+{
+  if (! is_open ())
+    {
+      error ("hislip: Interface must be opened first...");
+      return -1;
+    }
+
+  octave_deadline deadline (timeout < 0 ? -1 : timeout * 1000);
+  int control;
+  uint32_t param;
+  std::string payload;
+
+  if (send_message (async_fd, HISLIP_ASYNC_DEVICE_CLEAR, 0, 0, 0, 0) < 0
+      || recv_async (HISLIP_ASYNC_DEVICE_CLEAR_ACKNOWLEDGE, control, param, payload, deadline) <= 0)
+    {
+      error ("hislip: no response to AsyncDeviceClear");
+      return -1;
+    }
+
+  int want = overlap < 0 ? overlapped : (overlap != 0);
+
+  if (send_message (sync_fd, HISLIP_DEVICE_CLEAR_COMPLETE, want, 0, 0, 0) < 0)
+    {
+      error ("hislip: error writing : %d - %s\n", SOCKETERR, STRSOCKETERR);
+      return -1;
+    }
+
+  // everything on the synchronous channel before the acknowledge is
+  // abandoned
+  if (msg_left > 0 && skip_payload (msg_left, deadline) <= 0)
+    {
+      error ("hislip: no response to DeviceClearComplete");
+      return -1;
+    }
+
+  while (true)
+    {
+      while (hdr_have < HISLIP_HEADER_SIZE)
+        {
+          int ret = recv_some (sync_fd, hdr + hdr_have, HISLIP_HEADER_SIZE - hdr_have, deadline);
+          if (ret <= 0)
+            {
+              error ("hislip: no response to DeviceClearComplete");
+              return -1;
+            }
+          hdr_have += ret;
+        }
+
+      hdr_have = 0;
+
+      int type = hdr[2];
+      if (skip_payload (get_u64 (hdr + 8), deadline) <= 0)
+        {
+          error ("hislip: no response to DeviceClearComplete");
+          return -1;
+        }
+
+      if (type == HISLIP_DEVICE_CLEAR_ACKNOWLEDGE)
+        {
+          overlapped = (hdr[3] & 1) != 0;
+          break;
+        }
+    }
+
+  message_id = HISLIP_FIRST_MESSAGE_ID;
+  last_end_id = HISLIP_FIRST_MESSAGE_ID - 2;
+  rmt_delivered = false;
+  msg_end = false;
+
+  return 1;
+}
+
+int
+octave_hislip::trigger (void)
+{
+  if (! is_open ())
+    {
+      error ("hislip: Interface must be opened first...");
+      return -1;
+    }
+
+  if (send_message (sync_fd, HISLIP_TRIGGER, rmt_delivered ? 1 : 0, message_id, 0, 0) < 0)
+    {
+      error ("hislip: error writing : %d - %s\n", SOCKETERR, STRSOCKETERR);
+      return -1;
+    }
+
+  rmt_delivered = false;
+  message_id += 2;
+
+  return 1;
+}
+
+int
+octave_hislip::read_stb (void)
+{
+  if (! is_open ())
+    {
+      error ("hislip: Interface must be opened first...");
+      return -1;
+    }
+
+  octave_deadline deadline (timeout < 0 ? -1 : timeout * 1000);
+  int control;
+  uint32_t param;
+  std::string payload;
+
+  if (send_message (async_fd, HISLIP_ASYNC_STATUS_QUERY, rmt_delivered ? 1 : 0, message_id - 2, 0, 0) < 0
+      || recv_async (HISLIP_ASYNC_STATUS_RESPONSE, control, param, payload, deadline) <= 0)
+    {
+      error ("hislip: no response to AsyncStatusQuery");
+      return -1;
+    }
+
+  return control;
+}
+
+int
+octave_hislip::wait_srq (double waittime)
+{
+  if (! is_open ())
+    {
+      error ("hislip: Interface must be opened first...");
+      return -1;
+    }
+
+  octave_deadline deadline (waittime < 0 ? -1 : waittime * 1000);
+
+  while (srq_count == srq_seen)
+    {
+      int control;
+      uint32_t param;
+      std::string payload;
+
+      int ret = recv_async (HISLIP_ASYNC_SERVICE_REQUEST, control, param, payload, deadline);
+      if (ret < 0)
+        {
+          error ("hislip: error waiting for a service request");
+          return -1;
+        }
+      if (ret == 0)
+        return 0;
+    }
+
+  srq_seen = srq_count;
+  return 1;
+}
+
+int
+octave_hislip::flush (int mode)
+{
+  int retval = -1;
+
+  if (is_open ())
+    {
+      uint8_t tmpbuffer[1024];
+      if (mode == 0 || mode == 2)
+        {
+          // messages are sent whole, so there is no output to flush
+        }
+      if (mode == 1 || mode == 2)
+        {
+          while (read (tmpbuffer, 1024, 0) > 0) {}
+        }
+      retval = 0;
+    }
+
+  return retval;
+}
+
+int
+octave_hislip::wait_fd (bool &pending)
+{
+  pending = msg_left > 0 && ! msg_discard;
+  return sync_fd;
+}
+
+int
+octave_hislip::set_timeout (double newtimeout)
+{
+  if (newtimeout < -1 )
+    {
+      error ("hislip: timeout value must be -1 or positive");
+      return -1;
+    }
+
+  timeout = newtimeout;
+
+  return 1;
+}
+
+std::string
+octave_hislip::set_name (const std::string &n)
+{
+  if (n.length() == 0 )
+    {
+      error ("hislip: name must be non empty");
+    }
+  else
+    {
+      name = n;
+    }
+
+  return name;
+}
+
+int
+octave_hislip::set_byteorder (const std::string& neworder)
+{
+  std::string order = neworder;
+  std::transform (order.begin (), order.end (), order.begin (), ::tolower);
+  if (order == "big" || order == "big-endian")
+    byteOrder = "big-endian";
+  else if (order == "little" || order == "little-endian")
+    byteOrder = "little-endian";
+  else
+    error ("octave_hislip invalid byteorder");
+
+  return 1;
+}
+
+#endif
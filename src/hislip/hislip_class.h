@@ -0,0 +1,186 @@
+// Copyright (C) 2026 John Donoghue <john.donoghue@ieee.org>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+
+#ifndef HISLIP_CLASS_H
+#define HISLIP_CLASS_H
+
+#include <octave/oct.h>
+
+#include <string>
+#include <stdint.h>
+
+#ifndef __WIN32__
+# include <netinet/in.h>
+#else
+# include <winsock2.h>
+#endif
+
+#ifdef HAVE_CONFIG_H
+#  include "../config.h"
+#endif
+
+#include "../common/property_table.h"
+
+class octave_deadline;
+
+// HiSLIP (IVI-6.1) client. A session is a synchronous channel, which
+// carries the messages to and from the instrument, and an asynchronous
+// channel for device clear, status queries and service requests.
+class octave_hislip : public OCTAVE_BASE_CLASS
+{
+public:
+  octave_hislip (void);
+  ~octave_hislip (void);
+
+  // overlap is the mode to ask for, or -1 for the instrument's choice
+  int open (const std::string &address, int port, const std::string &device, int overlap);
+  int close (void);
+
+  // write len bytes as one message, ended with END
+  int write (const uint8_t *, unsigned int);
+  // read until len bytes or the END of a message. end is set if the read
+  // stopped at an END
+  int read (uint8_t *, unsigned int, double, bool *end = 0);
+  // read a whole message, less a trailing newline
+  bool readline (std::string &, double);
+  bool writeread (const std::string &, std::string &, double);
+
+  // device clear, with the overlap mode to ask for or -1 for no change
+  int device_clear (int overlap = -1);
+  int trigger (void);
+  int read_stb (void);
+  // wait up to waittime seconds (-1 forever) for a service request,
+  // returning 1 if one arrived and 0 on a timeout
+  int wait_srq (double waittime);
+  int get_last_stb (void) const { return last_stb; }
+
+  int flush (int mode);
+  int wait_fd (bool &pending);
+
+  // Overloaded base functions
+  virtual double scalar_value (bool frc_str_conv = false) const
+    {
+        return (double)sync_fd;
+    }
+
+  void print (std::ostream& os, bool pr_as_read_syntax = false);
+  void print (std::ostream& os, bool pr_as_read_syntax = false) const;
+  void print_raw (std::ostream& os, bool pr_as_read_syntax) const;
+
+  // Properties
+  bool is_map (void) const { return true; }
+  bool is_constant (void) const { return true;}
+  bool is_defined (void) const { return true;}
+  bool is_object (void) const { return true; }
+  // 4.4+
+  bool isobject (void) const { return true; }
+
+  // required to use subsasn
+  string_vector map_keys (void) const { return properties ().fieldnames (); }
+  dim_vector dims (void) const { static dim_vector dv(1, 1); return dv; }
+
+  octave_base_value * unique_clone (void) { OV_COUNT++; return this; }
+
+  octave_value_list subsref (const std::string& type, const std::list<octave_value_list>& idx, int nargout);
+
+  octave_value subsref (const std::string& type, const std::list<octave_value_list>& idx)
+  {
+    octave_value_list retval = subsref (type, idx, 1);
+    return (retval.length () > 0 ? retval(0) : octave_value ());
+  }
+
+  octave_value subsasgn (const std::string& type, const std::list<octave_value_list>& idx, const octave_value& rhs);
+
+  static const octave_property_table<octave_hislip> & properties (void);
+
+  bool is_open (void) const { return sync_fd >= 0; }
+  std::string get_status (void) const { return is_open () ? "open" : "closed"; }
+  std::string get_type (void) const { return "hislip"; }
+
+  std::string get_name (void) const { return name; }
+  std::string set_name (const std::string &);
+
+  std::string get_tag (void) const { return tag; }
+  void set_tag (const std::string &newv) { tag = newv; }
+
+  octave_value get_userdata (void) const { return userData; }
+  void set_userdata (const octave_value &newv) { userData = newv; }
+
+  int set_timeout (double);
+  double get_timeout (void) const { return timeout; }
+
+  std::string get_address (void) const { return address; }
+  int get_port (void) const { return port; }
+  std::string get_device (void) const { return device; }
+
+  bool get_overlapped (void) const { return overlapped; }
+  int get_session_id (void) const { return session_id; }
+  int get_protocol_version (void) const { return protocol_version; }
+  double get_max_message_size (void) const { return (double)max_message_size; }
+  unsigned int get_numbyteswritten (void) const { return byteswritten; }
+
+  int set_byteorder (const std::string &);
+  std::string get_byteorder (void) const { return byteOrder; }
+
+private:
+  int sync_fd;
+  int async_fd;
+  double timeout;
+
+  std::string name;
+  std::string tag;
+  std::string address;
+  std::string device;
+  int port;
+  octave_value userData;
+  std::string byteOrder;
+  unsigned int byteswritten;
+
+  bool overlapped;
+  int session_id;
+  int protocol_version;
+  // largest message the instrument accepts
+  uint64_t max_message_size;
+
+  // MessageID of the next message to send, and of the last that ended
+  // with END
+  uint32_t message_id;
+  uint32_t last_end_id;
+  // a whole response has been read since the last message sent
+  bool rmt_delivered;
+
+  // header being received on the synchronous channel, and what is left
+  // of the payload of the message it started
+  uint8_t hdr[16];
+  unsigned int hdr_have;
+  uint64_t msg_left;
+  bool msg_end;
+  bool msg_discard;
+
+  // service requests seen on the asynchronous channel
+  unsigned long srq_count;
+  unsigned long srq_seen;
+  int last_stb;
+
+  int send_message (int fd, int type, int control, uint32_t param, const uint8_t *payload, uint64_t len);
+  int recv_message (int fd, int &type, int &control, uint32_t &param, std::string &payload, const octave_deadline &deadline);
+  int recv_async (int expect, int &control, uint32_t &param, std::string &payload, const octave_deadline &deadline);
+  int next_data (const octave_deadline &deadline);
+  int skip_payload (uint64_t len, const octave_deadline &deadline);
+
+  DECLARE_OV_TYPEID_FUNCTIONS_AND_DATA
+};
+
+#endif
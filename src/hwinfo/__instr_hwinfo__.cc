@@ -40,6 +40,9 @@ Internal private function\n \
 #ifdef BUILD_GPIB
   interfaces (int_count++) = "gpib";
 #endif
+#ifdef BUILD_TCP
+  interfaces (int_count++) = "hislip";
+#endif
 #ifdef BUILD_I2C
   interfaces (int_count++) = "i2c";
 #endif
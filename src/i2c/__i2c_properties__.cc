@@ -22,8 +22,69 @@
 
 #ifdef BUILD_I2C
 #  include "i2c_class.h"
-#endif
 
+static octave_value_list
+i2c_status (octave_i2c *i2c, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (i2c->get_status ());
+}
+
+static octave_value_list
+i2c_name (octave_i2c *i2c, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  if (args.length () > 0)
+    return octave_value (i2c->set_name (args(0).string_value ()));
+
+  return octave_value (i2c->get_name ());
+}
+
+static octave_value_list
+i2c_remoteaddress (octave_i2c *i2c, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  if (args.length () > 0)
+    return octave_value (i2c->set_addr (args(0).int_value ()));
+
+  return octave_value (i2c->get_addr ());
+}
+
+static octave_value_list
+i2c_port (octave_i2c *i2c, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (i2c->get_port ());
+}
+
+static const octave_property<octave_i2c> i2c_property_list[] =
+{
+  {"status", i2c_status, true},
+  {"name", i2c_name, true},
+  {"remoteaddress", i2c_remoteaddress, true},
+  {"port", i2c_port, true},
+  {NULL, NULL, false}
+};
+
+const octave_property_table<octave_i2c> &
+octave_i2c::properties (void)
+{
+  static const octave_property_table<octave_i2c> table (i2c_property_list);
+  return table;
+}
+#endif
 
 // PKG_ADD: autoload ("__i2c_properties__", "i2c.oct");
 DEFUN_DLD (__i2c_properties__, args, nargout,
@@ -41,35 +102,11 @@ Undocumented internal function.\n\
   const octave_base_value& rep = args(0).get_rep ();
   octave_i2c* i2c = &((octave_i2c &)rep);
     
-  std::string property = args(1).string_value ();
-
-  if (args.length () == 2) // get
-    {
-      if (property == "name")
-        return octave_value (i2c->get_name ());
-      else if (property == "remoteaddress")
-        return octave_value (i2c->get_addr ());
-      else if (property == "status")
-        return octave_value (i2c->get_status ());
-      else if (property == "port")
-        return octave_value (i2c->get_port ());
-      else
-        (*current_liboctave_error_handler) ("invalid property name");
-    }
-  else // set
-    {
-      if (property == "name")
-        return octave_value (i2c->set_name (args(2).string_value ()));
-      else if (property == "status")
-        (*current_liboctave_error_handler) ("can not set this property");
-      else if (property == "remoteaddress")
-        return octave_value (i2c->set_addr (args(2).int_value ()));
-      else if (property == "port")
-        (*current_liboctave_error_handler) ("can not set this property");
-      else
-        (*current_liboctave_error_handler) ("invalid property name");
-    }
+  const octave_property<octave_i2c> *prop = octave_i2c::properties ().find_exact (args(1).string_value ());
+  if (! prop)
+    (*current_liboctave_error_handler) ("invalid property name");
 
+  return prop->handler (i2c, args.slice (2, args.length ()-2), nargout);
 #else
     /* never reached in normal operation */
   (*current_liboctave_error_handler) ("Your system doesn't support the I2C interface");
@@ -44,7 +44,6 @@
 DEFINE_OV_TYPEID_FUNCTIONS_AND_DATA (octave_i2c, "octave_i2c", "octave_i2c");
 
 octave_i2c::octave_i2c (void)
-  : fieldnames(4)
 {
   static bool type_registered = false;
 
@@ -56,11 +55,6 @@ octave_i2c::octave_i2c (void)
  
   fd = -1;
   addr = -1;
-
-  fieldnames[0] = "status";
-  fieldnames[1] = "name";
-  fieldnames[2] = "remoteaddress";
-  fieldnames[3] = "port";
 }
 
 octave_i2c::~octave_i2c (void)
@@ -280,12 +274,14 @@ octave_i2c::subsref (const std::string& type, const std::list<octave_value_list>
       break;
     case '.':
       {
-        octave_value_list ovl;
-        // inc ref count as assign this to octave_value
-        OV_COUNT++; 
-        ovl (0) = octave_value (this);
-        ovl (1) = (idx.front ()) (0);
-        retval = OCTAVE__FEVAL (std::string ("__i2c_properties__"), ovl, 1);
+        const octave_property<octave_i2c> *prop = properties ().find_exact ((idx.front ()) (0).string_value ());
+        if (! prop)
+          {
+            error ("invalid property name");
+            return retval;
+          }
+
+        retval = prop->handler (this, octave_value_list (), 1);
       }
       break;
     }
@@ -309,13 +305,14 @@ octave_i2c::subsasgn (const std::string& type, const std::list<octave_value_list
     case '.':
       if (type.length () == 1)
         {
-          octave_value_list ovl;
-          // inc ref count as assign this to octave_value
-          OV_COUNT++; 
-          ovl (0) = octave_value (this);
-          ovl (1) = (idx.front ()) (0);
-          ovl (2) = rhs;
-          OCTAVE__FEVAL (std::string ("__i2c_properties__"), ovl, 0);
+          const octave_property<octave_i2c> *prop = properties ().find_exact ((idx.front ()) (0).string_value ());
+          if (! prop)
+            {
+              error ("invalid property name");
+              return retval;
+            }
+
+          prop->handler (this, octave_value_list (rhs), 0);
  
           OV_COUNT++;
           retval = octave_value (this);
@@ -24,6 +24,8 @@
 #  include "../config.h"
 #endif
 
+#include "../common/property_table.h"
+
 class octave_i2c : public OCTAVE_BASE_CLASS
 {
 public:
@@ -65,7 +67,7 @@ public:
   void print_raw (std::ostream& os, bool pr_as_read_syntax) const;
 
   // required to use subsasn
-  string_vector map_keys (void) const { return fieldnames; }
+  string_vector map_keys (void) const { return properties ().fieldnames (); }
   dim_vector dims (void) const { static dim_vector dv(1, 1); return dv; }
 
   // Properties
@@ -89,12 +91,14 @@ public:
   }
 
   octave_value subsasgn (const std::string& type, const std::list<octave_value_list>& idx, const octave_value& rhs);
+
+  static const octave_property_table<octave_i2c> & properties (void);
+
 private:
   int fd;
   int addr;
   std::string name;
   std::string port;
-  string_vector fieldnames;
 
   DECLARE_OV_TYPEID_FUNCTIONS_AND_DATA
 };
@@ -66,14 +66,6 @@ The i2c_read() shall return number of bytes successfully read in @var{count} as
       buffer_len = args (1).int_value ();
     }
 
-  OCTAVE_LOCAL_BUFFER (uint8_t, buffer, (buffer_len +1));
-
-  if (buffer == NULL)
-    {
-      error ("i2c_read: cannot allocate requested memory: %s\n", strerror (errno));
-      return octave_value (-1);  
-    }
-
   octave_i2c* i2c = NULL;
 
   const octave_base_value& rep = args (0).get_rep();
@@ -81,13 +73,14 @@ The i2c_read() shall return number of bytes successfully read in @var{count} as
 
   int retval;
     
-  retval = i2c->read (buffer, buffer_len);
+  // Read data directly into the result array
+  uint8NDArray data (dim_vector (1, buffer_len));
+
+  retval = i2c->read (reinterpret_cast<uint8_t *> (data.fortran_vec ()), buffer_len);
     
   octave_value_list return_list;
-  uint8NDArray data (dim_vector (1, retval));
-    
-  for (int i = 0; i < retval; i++)
-    data (i) = buffer[i];
+  // trim to the bytes actually read
+  data.resize (dim_vector (1, (retval > 0) ? retval : 0));
 
   return_list (0) = data;
   return_list (1) = retval; 
@@ -24,6 +24,7 @@
 #include <errno.h>
 
 #include "i2c_class.h"
+#include "../common/byte_view.h"
 #endif
 
 // PKG_ADD: autoload ("i2c_write", "i2c.oct");
@@ -57,28 +58,16 @@ Upon successful completion, i2c_write() shall return the number of bytes written
   const octave_base_value& rep = args (0).get_rep ();
   i2c = &((octave_i2c &)rep);
 
-  if (args (1).is_uint8_type ()) // uint8_t
-    {
-      NDArray data = args (1).array_value ();
-      OCTAVE_LOCAL_BUFFER (uint8_t, buf, (data.numel ()));
-
-      if (buf == NULL)
-        {
-          error ("i2c_write: cannot allocate requested memory: %s", strerror (errno));
-          return octave_value (-1);  
-        }
-
-      for (int i = 0; i < data.numel (); i++)
-        buf[i] =  static_cast<uint8_t>(data (i));
+  octave_byte_view data (args (1), true);
 
-      retval = i2c->write (buf, data.numel());
-    }
-  else
+  if (! data.is_valid ())
     {
       error ("i2c_write: expected uint8 data");
       return octave_value (-1);
     }
 
+  retval = i2c->write (data.data (), data.length ());
+
   return octave_value (retval);
 #endif
 }
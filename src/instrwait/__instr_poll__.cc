@@ -0,0 +1,179 @@
+// Copyright (C) 2026   John Donoghue   <john.donoghue@ieee.org>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+
+#include <octave/oct.h>
+#include <octave/quit.h>
+
+#ifdef HAVE_CONFIG_H
+#  include "../config.h"
+#endif
+
+#include <vector>
+#include <chrono>
+
+#ifndef __WIN32__
+#  include <errno.h>
+#  include <poll.h>
+#else
+#  include <winsock2.h>
+#endif
+
+// wait up to ms for any of the descriptors to become readable, setting
+// ready for each one that is. Returns the number ready, or -1 on an error.
+static int
+wait_readable (const std::vector<int> &fds, std::vector<bool> &ready, int ms)
+{
+#ifndef __WIN32__
+  std::vector<struct pollfd> pfds;
+  std::vector<size_t> index;
+
+  for (size_t i = 0; i < fds.size (); i++)
+    {
+      if (fds[i] < 0)
+        continue;
+
+      struct pollfd pfd;
+      pfd.fd = fds[i];
+      pfd.events = POLLIN;
+      pfd.revents = 0;
+      pfds.push_back (pfd);
+      index.push_back (i);
+    }
+
+  int ret = ::poll (pfds.empty () ? 0 : &pfds[0], pfds.size (), ms);
+  if (ret < 0)
+    return errno == EINTR ? 0 : -1;
+
+  // a hangup or error is reported as readable, so that the read reports it
+  for (size_t i = 0; i < pfds.size (); i++)
+    {
+      if (pfds[i].revents & (POLLIN | POLLHUP | POLLERR))
+        ready[index[i]] = true;
+    }
+
+  return ret;
+#else
+  fd_set readfds;
+  FD_ZERO (&readfds);
+
+  bool have_fds = false;
+  for (size_t i = 0; i < fds.size (); i++)
+    {
+      if (fds[i] >= 0)
+        {
+          FD_SET (fds[i], &readfds);
+          have_fds = true;
+        }
+    }
+
+  if (! have_fds)
+    {
+      Sleep (ms);
+      return 0;
+    }
+
+  struct timeval tv;
+  tv.tv_sec = ms / 1000;
+  tv.tv_usec = (ms % 1000) * 1000;
+
+  int ret = ::select (0, &readfds, NULL, NULL, &tv);
+  if (ret < 0)
+    return -1;
+
+  for (size_t i = 0; i < fds.size (); i++)
+    {
+      if (fds[i] >= 0 && FD_ISSET (fds[i], &readfds))
+        ready[i] = true;
+    }
+
+  return ret;
+#endif
+}
+
+DEFUN_DLD (__instr_poll__, args, nargout,
+        "-*- texinfo -*-\n\
+@deftypefn {} {@var{ready} = } __instr_poll__ (@var{fds}, @var{timeout})\n \
+\n\
+Private function to wait for any of a set of descriptors to become readable.\n \
+\n\
+@subsubheading Inputs\n \
+@var{fds} - descriptors to wait on. Negative values are ignored.@* \
+@var{timeout} - time to wait in ms, or -1 to wait forever.\n \
+\n\
+@subsubheading Outputs\n \
+@var{ready} - logical array, true for each readable descriptor.\n \
+@end deftypefn")
+{
+  if (args.length () != 2 || ! (args (0).OV_ISFLOAT () || args (0).OV_ISINTEGER ())
+      || ! (args (1).OV_ISFLOAT () || args (1).OV_ISINTEGER ()))
+    {
+      print_usage ();
+      return octave_value ();
+    }
+
+  NDArray fdarray = args (0).array_value ();
+  double timeout = args (1).double_value ();
+
+  std::vector<int> fds (fdarray.numel ());
+  for (octave_idx_type i = 0; i < fdarray.numel (); i++)
+    fds[i] = static_cast<int> (fdarray (i));
+
+  std::vector<bool> ready (fds.size (), false);
+
+  std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now ()
+    + std::chrono::microseconds (static_cast<long long> (timeout > 0 ? timeout * 1000 : 0));
+
+  while (true)
+    {
+      OCTAVE_QUIT;
+
+      // wait in slices of at most 100ms to allow a ctrl-c
+      int ms = 100;
+      if (timeout >= 0)
+        {
+          std::chrono::milliseconds::rep left = std::chrono::duration_cast<std::chrono::milliseconds>
+            (deadline - std::chrono::steady_clock::now ()).count ();
+          if (left < 0)
+            left = 0;
+          if (left < ms)
+            ms = left;
+        }
+
+      int ret = wait_readable (fds, ready, ms);
+      if (ret < 0)
+        {
+          error ("__instr_poll__: Error while waiting for data");
+          return octave_value ();
+        }
+
+      if (ret > 0 || (timeout >= 0 && std::chrono::steady_clock::now () >= deadline))
+        break;
+    }
+
+  boolNDArray result (dim_vector (1, fds.size ()));
+  for (size_t i = 0; i < fds.size (); i++)
+    result (i) = ready[i];
+
+  return octave_value (result);
+}
+
+#if 0
+%!error <Invalid call to __instr_poll__> __instr_poll__ ()
+
+%!error <Invalid call to __instr_poll__> __instr_poll__ ([1 2])
+
+%!test
+%! assert (__instr_poll__ ([-1 -1], 10), [false false]);
+#endif
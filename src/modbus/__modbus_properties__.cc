@@ -85,6 +85,26 @@ octave_value_list modbus_numretries (octave_modbus* dev, const octave_value_list
 }
 
 
+octave_value_list modbus_pipelinedepth (octave_modbus* dev, const octave_value_list& args, int nargout)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  // Setting new depth
+  if (args.length () > 0)
+    {
+      if ( !(args (0).OV_ISINTEGER () || args (0).OV_ISFLOAT ()) )
+        (*current_liboctave_error_handler) ("argument must be integer or float");
+
+      dev->set_pipeline_depth (args (0).int_value ());
+
+      return octave_value (); // Should it return by default?
+    }
+
+  // Returning current value
+  return octave_value (dev->get_pipeline_depth ());
+}
+
 octave_value_list modbus_userdata (octave_modbus* dev, const octave_value_list& args, int nargout)
 {
   if (args.length () > 1)
@@ -223,6 +243,14 @@ octave_value_list modbus_type (octave_modbus* dev, const octave_value_list& args
 }
 
 
+octave_value_list modbus_status (octave_modbus* dev, const octave_value_list& args, int nargout)
+{
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("read only value");
+
+  return octave_value(dev->get_status());
+}
+
 octave_value_list modbus_transport (octave_modbus* dev, const octave_value_list& args, int nargout)
 {
   if (args.length () > 0)
@@ -233,6 +261,39 @@ octave_value_list modbus_transport (octave_modbus* dev, const octave_value_list&
   return octave_value(dev->get_transport());
 }
 
+static const octave_property<octave_modbus> modbus_property_list[] =
+{
+  // common
+  {"Transport", modbus_transport, true},
+  {"Type", modbus_type, true},
+  {"Name", modbus_name, true},
+  {"Status", modbus_status, true},
+  {"UserData", modbus_userdata, true},
+  {"Port", modbus_port, true},
+  {"NumRetries", modbus_numretries, true},
+  {"Timeout", modbus_timeout, true},
+  {"ByteOrder", modbus_byteorder, true},
+  {"WordOrder", modbus_wordorder, true},
+  // tcp
+  {"DeviceAddress", modbus_deviceaddress, true},
+  {"PipelineDepth", modbus_pipelinedepth, true},
+  // serial
+  {"BaudRate", modbus_baudrate, true},
+  {"DataBits", modbus_databits, true},
+  {"Parity", modbus_parity, true},
+  {"StopBits", modbus_stopbits, true},
+  // internals
+  {"__flush__", modbus_flush, false},
+  {NULL, NULL, false}
+};
+
+const octave_property_table<octave_modbus> &
+octave_modbus::properties (void)
+{
+  static const octave_property_table<octave_modbus> table (modbus_property_list);
+  return table;
+}
+
 #endif
 
 // PKG_ADD: autoload ("__modbus_properties__", "modbus.oct");
@@ -250,44 +311,11 @@ Undocumented internal function.\n\
   const octave_base_value& rep = args (0).get_rep ();
   octave_modbus* dev = &((octave_modbus &)rep);
     
-  std::string property = args (1).string_value ();
-  std::transform (property.begin (), property.end (), property.begin (), ::tolower);
-
-  octave_value_list args2 = args.slice (2, args.length ()-2);
-    
-  if (property == "port")
-    return modbus_port (dev, args2, nargout);
-  else if (property == "baudrate")
-    return modbus_baudrate (dev, args2, nargout);
-  else if (property == "transport")
-    return modbus_transport (dev, args2, nargout);
-  else if (property == "type")
-    return modbus_type (dev, args2, nargout);
-  else if (property == "byteorder")
-    return modbus_byteorder (dev, args2, nargout);
-  else if (property == "wordorder")
-    return modbus_wordorder (dev, args2, nargout);
-  else if (property == "databits")
-    return modbus_databits (dev, args2, nargout);
-  else if (property == "stopbits")
-    return modbus_stopbits (dev, args2, nargout);
-  else if (property == "parity")
-    return modbus_parity (dev, args2, nargout);
-  else if (property == "timeout")
-    return modbus_timeout (dev, args2, nargout);
-  else if (property == "numretries")
-    return modbus_numretries (dev, args2, nargout);
-  else if (property == "deviceaddress")
-    return modbus_deviceaddress (dev, args2, nargout);
-  else if (property == "name")
-    return modbus_name (dev, args2, nargout);
-  else if (property == "userdata")
-    return modbus_userdata (dev, args2, nargout);
-  // internals
-  else if (property == "__flush__")
-    return modbus_flush (dev, args2, nargout);
-  else
+  const octave_property<octave_modbus> *prop = octave_modbus::properties ().find (args (1).string_value ());
+  if (! prop)
     (*current_liboctave_error_handler) ("unknown property");
+
+  return prop->handler (dev, args.slice (2, args.length ()-2), nargout);
 #endif
     /* never reached in normal operation */
   (*current_liboctave_error_handler) ("Your system doesn't support the MODBUS interface");
@@ -21,6 +21,7 @@
 
 #ifdef BUILD_MODBUS
 #include <octave/uint8NDArray.h>
+#include <octave/uint16NDArray.h>
 
 #include <errno.h>
 
@@ -82,14 +83,10 @@ The __modbus_read__() function shall return the read bytes @var{data} as uint8 o
   if (target == "coils" || target == "inputs")
     { 
 
-      OCTAVE_LOCAL_BUFFER (uint8_t, buffer, count);
+      // read directly into the result array
+      uint8NDArray data (dim_vector (1, count));
+      uint8_t *buffer = reinterpret_cast<uint8_t *> (data.fortran_vec ());
 
-      if (buffer == NULL)
-      {
-        error("modbus_read: cannot allocate requested memory: %s\n", strerror(errno));
-        return octave_value();
-      }
-  
       int bytes_read = 0;
       
       if (target == "coils")
@@ -104,23 +101,16 @@ The __modbus_read__() function shall return the read bytes @var{data} as uint8 o
         }
 
       // have data here which should be 0s or 1s
-      uint8NDArray data( dim_vector(1, bytes_read) );
-
-      for (int i = 0; i < bytes_read; i++)
-         data(i) = buffer[i];
+      data.resize (dim_vector (1, bytes_read));
 
       ret_value = data;
     }
   else
     {
-      OCTAVE_LOCAL_BUFFER (uint16_t, buffer, count);
-
-      if (buffer == NULL)
-      {
-        error("modbus_read: cannot allocate requested memory: %s\n", strerror(errno));
-        return octave_value();
-      }
-  
+      // read directly into the result array
+      uint16NDArray data (dim_vector (1, count));
+      uint16_t *buffer = reinterpret_cast<uint16_t *> (data.fortran_vec ());
+
       int regs_read = 0;
       
       if (target == "inputregs")
@@ -134,11 +124,7 @@ The __modbus_read__() function shall return the read bytes @var{data} as uint8 o
 	  return octave_value();
         }
 
-      // have data here which should be 0s or 1s
-      uint16NDArray data( dim_vector(1, regs_read) );
-
-      for (int i = 0; i < regs_read; i++)
-         data(i) = buffer[i];
+      data.resize (dim_vector (1, regs_read));
 
       ret_value = data;
  
@@ -76,6 +76,10 @@ instrument type 'modbus' (readonly)\n \
 Remote port number or serial port name (readonly)\n \
 @item DeviceAddress\n \
 Device address if transport was 'tcpip' (readonly)\n \
+@item PipelineDepth\n \
+number of requests sent before waiting for their responses, when a\n \
+read or write is split into several requests, if transport was 'tcpip'.\n \
+Default 4, and 1 waits for each response in turn\n \
 @item Status\n \
 status of the object 'open' or 'closed' (readonly)\n \
 @item Timeout\n \
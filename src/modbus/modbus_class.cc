@@ -14,6 +14,7 @@
 // along with this program; if not, see <http://www.gnu.org/licenses/>.
 
 #include <octave/oct.h>
+#include <octave/quit.h>
 
 #ifdef HAVE_CONFIG_H
 #include "../config.h"
@@ -24,9 +25,56 @@
 #include <string>
 #include <algorithm>
 #include <sstream>
+#include <deque>
+#include <cstring>
+#include <errno.h>
+
+#ifndef __WIN32__
+#include <sys/socket.h>
+#else
+#include <winsock2.h>
+#endif
 
 #include "modbus_class.h"
 
+// function codes, which older libmodbus keep private
+#ifndef MODBUS_FC_READ_COILS
+#  define MODBUS_FC_READ_COILS                0x01
+#  define MODBUS_FC_READ_DISCRETE_INPUTS      0x02
+#  define MODBUS_FC_READ_HOLDING_REGISTERS    0x03
+#  define MODBUS_FC_READ_INPUT_REGISTERS      0x04
+#  define MODBUS_FC_WRITE_MULTIPLE_COILS      0x0F
+#  define MODBUS_FC_WRITE_MULTIPLE_REGISTERS  0x10
+#endif
+#ifndef MODBUS_MAX_WR_WRITE_REGISTERS
+#  define MODBUS_MAX_WR_WRITE_REGISTERS 121
+#  define MODBUS_MAX_WR_READ_REGISTERS 125
+#endif
+#ifndef MODBUS_TCP_MAX_ADU_LENGTH
+#  define MODBUS_TCP_MAX_ADU_LENGTH 260
+#endif
+#ifndef MODBUS_TCP_SLAVE
+#  define MODBUS_TCP_SLAVE 0xFF
+#endif
+
+// largest count of a single request of a function
+static unsigned int
+max_count (int function)
+{
+  switch (function)
+    {
+      case MODBUS_FC_READ_COILS:
+      case MODBUS_FC_READ_DISCRETE_INPUTS:
+        return MODBUS_MAX_READ_BITS;
+      case MODBUS_FC_WRITE_MULTIPLE_COILS:
+        return MODBUS_MAX_WRITE_BITS;
+      case MODBUS_FC_WRITE_MULTIPLE_REGISTERS:
+        return MODBUS_MAX_WRITE_REGISTERS;
+      default:
+        return MODBUS_MAX_READ_REGISTERS;
+    }
+}
+
 static struct timeval
 to_timeval(long ms)
 {
@@ -48,7 +96,6 @@ to_timeval(long ms)
 DEFINE_OV_TYPEID_FUNCTIONS_AND_DATA (octave_modbus, "octave_modbus", "octave_modbus");
 
 octave_modbus::octave_modbus (void)
-: fieldnames(15)
 {
   static bool type_registered = false;
 
@@ -60,6 +107,8 @@ octave_modbus::octave_modbus (void)
   userData = Matrix ();
   modbus = 0;
   ipport = 0;
+  pipeline_depth = 4;
+  transaction_id = 0;
   name = "";
   timeout = -1;
   retries = 0;
@@ -67,68 +116,50 @@ octave_modbus::octave_modbus (void)
 
   wordorder = "big-endian";
   byteorder = "big-endian";
-
-  // common
-  fieldnames[0] = "Transport";
-  fieldnames[1] = "Type";
-  fieldnames[2] = "Name";
-  fieldnames[3] = "Status";
-  fieldnames[4] = "UserData";
-
-  fieldnames[5] = "Port";
-  fieldnames[6] = "NumRetries";
-  fieldnames[7] = "Timeout";
-  fieldnames[8] = "ByteOrder";
-  fieldnames[9] = "WordOrder";
- 
-  // tcp
-  fieldnames[10] = "DeviceAddress";
-
-  // serial
-  fieldnames[11] = "BaudRate";
-  fieldnames[12] = "DataBits";
-  fieldnames[13] = "Parity";
-  fieldnames[14] = "StopBits";
 }
 
-bool octave_modbus::has_property(const std::string &name) const
+const octave_property<octave_modbus> *
+octave_modbus::find_property (const std::string &name) const
 {
-  for (octave_idx_type i=0; i<fieldnames.numel(); i++)
+  const octave_property<octave_modbus> *prop = properties ().find_field (name);
+
+  if (prop)
     {
-      if (fieldnames[i] == name)
+      // properties available depend on type we are
+      if (name == "DeviceAddress" || name == "PipelineDepth")
         {
-          // properties available depend on type we are
-          if (name == "DeviceAddress")
-            {
-              if(transport != "tcpip") return false;
-            }
-          if (name == "BaudRate")
-            {
-              if(transport != "serialrtu") return false;
-            }
-          if (name == "DataBits")
-            {
-              if(transport != "serialrtu") return false;
-            }
-          if (name == "StopBits")
-            {
-              if(transport != "serialrtu") return false;
-            }
-          if (name == "Parity")
-            {
-              if(transport != "serialrtu") return false;
-            }
-
-	  // if here must be a valid property
-          return true;
+          if(transport != "tcpip") return NULL;
+        }
+      if (name == "BaudRate")
+        {
+          if(transport != "serialrtu") return NULL;
+        }
+      if (name == "DataBits")
+        {
+          if(transport != "serialrtu") return NULL;
+        }
+      if (name == "StopBits")
+        {
+          if(transport != "serialrtu") return NULL;
+        }
+      if (name == "Parity")
+        {
+          if(transport != "serialrtu") return NULL;
         }
     }
-  return false;
+
+  return prop;
+}
+
+bool octave_modbus::has_property(const std::string &name) const
+{
+  return find_property (name) != NULL;
 }
 
 string_vector 
 octave_modbus::map_keys (void) const 
 {
+  string_vector fieldnames = properties ().fieldnames ();
   string_vector actual_fields;
   // get list of fields that are valid
   for (octave_idx_type idx = 0; idx < fieldnames.numel(); idx++)
@@ -154,19 +185,15 @@ octave_modbus::subsref (const std::string& type, const std::list<octave_value_li
     case '.':
       {
 	std::string property = (idx.front ()) (0).string_value ();
-        if (!has_property(property))
+        const octave_property<octave_modbus> *prop = find_property (property);
+        if (! prop)
 	  {
             error ("Unknown property '%s'", property.c_str());
             return retval;
           }
         else
 	  {
-            octave_value_list ovl;
-            // inc ref count as assign this to octave_value
-            OV_COUNT++; 
-            ovl (0) = octave_value (this);
-            ovl (1) = (idx.front ()) (0);
-            retval = OCTAVE__FEVAL (std::string ("__modbus_properties__"), ovl, 1);
+            retval = prop->handler (this, octave_value_list (), 1);
           }
       }
       break;
@@ -192,20 +219,15 @@ octave_modbus::subsasgn (const std::string& type, const std::list<octave_value_l
       if (type.length () == 1)
         {
           std::string property = (idx.front ()) (0).string_value ();
-          if (! has_property(property))
+          const octave_property<octave_modbus> *prop = find_property (property);
+          if (! prop)
 	    {
               error ("Unknown property '%s'", property.c_str());
               return retval;
             }
           else
             {
-              octave_value_list ovl;
-              // inc ref count as assign this to octave_value
-              OV_COUNT++; 
-              ovl (0) = octave_value (this);
-              ovl (1) = (idx.front ()) (0);
-              ovl (2) = rhs;
-              OCTAVE__FEVAL (std::string ("__modbus_properties__"), ovl, 1);
+              prop->handler (this, octave_value_list (rhs), 0);
               OV_COUNT++;
               retval = octave_value (this);
             }
@@ -339,6 +361,8 @@ octave_modbus::print_raw (std::ostream& os, bool pr_as_read_syntax) const
       //os << "          Port: " << get_port ();
       os << "          Port: " << this->get_tcpport();
       newline(os);
+      os << " PipelineDepth: " << this->get_pipeline_depth();
+      newline(os);
     }
   else if(this->transport == "serialrtu")
     {
@@ -392,13 +416,7 @@ octave_modbus::read_bits (int address, uint8_t *buf, unsigned int len)
       return 0;
     }
 
-  // TODO: handle retries as needed depending errno etc
-
-  ssize_t bytes_read = -1;
-
-  bytes_read = modbus_read_bits(this->modbus, address, len, buf);
-
-  return bytes_read;
+  return transfer (MODBUS_FC_READ_COILS, address, buf, len);
 }
 
 int
@@ -410,11 +428,7 @@ octave_modbus::read_input_bits (int address, uint8_t *buf, unsigned int len)
       return 0;
     }
 
-  ssize_t bytes_read = -1;
-
-  bytes_read = modbus_read_input_bits(this->modbus, address, len, buf);
-
-  return bytes_read;
+  return transfer (MODBUS_FC_READ_DISCRETE_INPUTS, address, buf, len);
 }
 
 int
@@ -426,11 +440,7 @@ octave_modbus::read_registers (int address, uint16_t *buf, unsigned int len)
       return 0;
     }
 
-  ssize_t bytes_read = -1;
-
-  bytes_read = modbus_read_registers(this->modbus, address, len, buf);
-
-  return bytes_read;
+  return transfer (MODBUS_FC_READ_HOLDING_REGISTERS, address, buf, len);
 }
 
 int
@@ -442,11 +452,7 @@ octave_modbus::read_input_registers (int address, uint16_t *buf, unsigned int le
       return 0;
     }
 
-  ssize_t bytes_read = -1;
-
-  bytes_read = modbus_read_input_registers(this->modbus, address, len, buf);
-
-  return bytes_read;
+  return transfer (MODBUS_FC_READ_INPUT_REGISTERS, address, buf, len);
 }
 
 int
@@ -458,11 +464,7 @@ octave_modbus::write_bits (int address, const uint8_t *buf, unsigned int len)
       return 0;
     }
 
-  ssize_t regs_wrote = -1;
-
-  regs_wrote = modbus_write_bits(this->modbus, address, len, buf);
-
-  return regs_wrote;
+  return transfer (MODBUS_FC_WRITE_MULTIPLE_COILS, address, (uint8_t *)buf, len);
 }
 
 int
@@ -474,11 +476,7 @@ octave_modbus::write_registers (int address, const uint16_t *buf, unsigned int l
       return 0;
     }
 
-  ssize_t regs_wrote = -1;
-
-  regs_wrote = modbus_write_registers(this->modbus, address, len, buf);
-
-  return regs_wrote;
+  return transfer (MODBUS_FC_WRITE_MULTIPLE_REGISTERS, address, (uint16_t *)buf, len);
 }
 
 int
@@ -490,11 +488,294 @@ octave_modbus::write_read_registers(int wraddress, const uint16_t *wrbuf, unsign
       return 0;
     }
 
-  ssize_t regs_read = -1;
+  if (wrlen <= MODBUS_MAX_WR_WRITE_REGISTERS && rdlen <= MODBUS_MAX_WR_READ_REGISTERS)
+    return modbus_write_and_read_registers(this->modbus, wraddress, wrlen, wrbuf, rdaddress, rdlen, rdbuf);
+
+  // too large for one request, so the writes before the last of them go
+  // first and the reads after the first of them come last, keeping all
+  // of the writes before all of the reads
+  unsigned int wrfirst = wrlen > MODBUS_MAX_WR_WRITE_REGISTERS ? wrlen - MODBUS_MAX_WR_WRITE_REGISTERS : 0;
+  unsigned int rdfirst = std::min (rdlen, (unsigned int)MODBUS_MAX_WR_READ_REGISTERS);
+
+  if (wrfirst > 0 && transfer (MODBUS_FC_WRITE_MULTIPLE_REGISTERS, wraddress, (uint16_t *)wrbuf, wrfirst) < 0)
+    return -1;
+
+  int regs_read = modbus_write_and_read_registers(this->modbus, wraddress + wrfirst, wrlen - wrfirst, wrbuf + wrfirst, rdaddress, rdfirst, rdbuf);
+  if (regs_read < 0 || rdlen == rdfirst)
+    return regs_read;
+
+  if (transfer (MODBUS_FC_READ_HOLDING_REGISTERS, rdaddress + rdfirst, rdbuf + rdfirst, rdlen - rdfirst) < 0)
+    return -1;
+
+  return rdlen;
+}
+
+int
+octave_modbus::transfer (int function, int address, void *buf, unsigned int len)
+{
+  unsigned int max = max_count (function);
+
+  // a request past the last address would wrap round to the first
+  if (address < 0 || address + len > 65536)
+    {
+      errno = EMBXILADD;
+      return -1;
+    }
+
+  if (len > max && transport == "tcpip" && pipeline_depth > 1)
+    return transfer_pipelined (function, address, buf, len);
+
+  // TODO: handle retries as needed depending errno etc
+
+  // one request after another, each waiting for the last
+  uint8_t *bits = static_cast<uint8_t *> (buf);
+  uint16_t *regs = static_cast<uint16_t *> (buf);
+  unsigned int done = 0;
+
+  do
+    {
+      unsigned int count = std::min (len - done, max);
+      int ret = -1;
+
+      switch (function)
+        {
+          case MODBUS_FC_READ_COILS:
+            ret = modbus_read_bits(this->modbus, address + done, count, bits + done);
+            break;
+          case MODBUS_FC_READ_DISCRETE_INPUTS:
+            ret = modbus_read_input_bits(this->modbus, address + done, count, bits + done);
+            break;
+          case MODBUS_FC_READ_HOLDING_REGISTERS:
+            ret = modbus_read_registers(this->modbus, address + done, count, regs + done);
+            break;
+          case MODBUS_FC_READ_INPUT_REGISTERS:
+            ret = modbus_read_input_registers(this->modbus, address + done, count, regs + done);
+            break;
+          case MODBUS_FC_WRITE_MULTIPLE_COILS:
+            ret = modbus_write_bits(this->modbus, address + done, count, bits + done);
+            break;
+          case MODBUS_FC_WRITE_MULTIPLE_REGISTERS:
+            ret = modbus_write_registers(this->modbus, address + done, count, regs + done);
+            break;
+        }
+
+      if (ret < 0)
+        return ret;
+
+      done += count;
+    }
+  while (done < len);
+
+  return done;
+}
+
+// send all of a request on the socket of a link
+static int
+send_request (int fd, const uint8_t *req, int len)
+{
+  int flags = 0;
+#ifdef MSG_NOSIGNAL
+  flags = MSG_NOSIGNAL;
+#endif
+  int sent = 0;
+
+  while (sent < len)
+    {
+      int ret = ::send (fd, reinterpret_cast<const char *>(req + sent), len - sent, flags);
+      if (ret < 0 && errno == EINTR)
+        continue;
+      if (ret <= 0)
+        return -1;
+      sent += ret;
+    }
+
+  return sent;
+}
+
+int
+octave_modbus::transfer_pipelined (int function, int address, void *buf, unsigned int len)
+{
+  unsigned int max = max_count (function);
+  bool is_bits = (function == MODBUS_FC_READ_COILS || function == MODBUS_FC_READ_DISCRETE_INPUTS
+                  || function == MODBUS_FC_WRITE_MULTIPLE_COILS);
+  bool is_write = (function == MODBUS_FC_WRITE_MULTIPLE_COILS || function == MODBUS_FC_WRITE_MULTIPLE_REGISTERS);
+  uint8_t *bits = static_cast<uint8_t *> (buf);
+  uint16_t *regs = static_cast<uint16_t *> (buf);
+  int offset = modbus_get_header_length(this->modbus);
+
+  uint8_t req[MODBUS_TCP_MAX_ADU_LENGTH];
+  uint8_t rsp[MODBUS_TCP_MAX_ADU_LENGTH];
+  // requests sent and not yet answered, by their transaction id.
+  // libmodbus sends raw requests with a transaction id of 0, so the
+  // requests are written to the socket with ids of our own, which tell
+  // the responses apart whatever order the server answers in.
+  struct request
+  {
+    uint16_t tid;
+    unsigned int first;
+    unsigned int count;
+  };
+  std::deque<request> pending;
+  unsigned int sent = 0;
+  unsigned int done = 0;
+
+  // the responses still to come are collected, so that the next request
+  // on the link does not read one of them as its own. If one does not
+  // come within the response timeout, the link is opened again instead.
+  auto fail = [&] (int err)
+    {
+      while (! pending.empty ())
+        {
+          int rsp_len = modbus_receive_confirmation(this->modbus, rsp);
+          if (rsp_len < offset)
+            {
+              modbus_close(this->modbus);
+              modbus_connect(this->modbus);
+              break;
+            }
+          uint16_t tid = (rsp[0] << 8) | rsp[1];
+          for (auto it = pending.begin (); it != pending.end (); ++it)
+            if (it->tid == tid)
+              {
+                pending.erase (it);
+                break;
+              }
+        }
+      errno = err;
+      return -1;
+    };
+
+  while (done < len)
+    {
+      while (sent < len && pending.size () < (size_t)pipeline_depth
+             && octave_interrupt_state <= 0)
+        {
+          unsigned int count = std::min (len - sent, max);
+          unsigned int start = address + sent;
+          uint16_t tid = ++transaction_id;
+          int req_len = 0;
+
+          // MBAP header, with the length filled in below
+          req[req_len++] = tid >> 8;
+          req[req_len++] = tid & 0xff;
+          req[req_len++] = 0;
+          req[req_len++] = 0;
+          req[req_len++] = 0;
+          req[req_len++] = 0;
+          req[req_len++] = slaveid < 0 ? MODBUS_TCP_SLAVE : slaveid;
+
+          req[req_len++] = function;
+          req[req_len++] = start >> 8;
+          req[req_len++] = start & 0xff;
+          req[req_len++] = count >> 8;
+          req[req_len++] = count & 0xff;
+
+          if (is_write && is_bits)
+            {
+              unsigned int nbytes = (count + 7) / 8;
+              req[req_len++] = nbytes;
+              memset (req + req_len, 0, nbytes);
+              for (unsigned int i = 0; i < count; i++)
+                if (bits[sent + i])
+                  req[req_len + i/8] |= 1 << (i % 8);
+              req_len += nbytes;
+            }
+          else if (is_write)
+            {
+              req[req_len++] = count * 2;
+              for (unsigned int i = 0; i < count; i++)
+                {
+                  req[req_len++] = regs[sent + i] >> 8;
+                  req[req_len++] = regs[sent + i] & 0xff;
+                }
+            }
+
+          req[4] = (req_len - 6) >> 8;
+          req[5] = (req_len - 6) & 0xff;
+
+          if (send_request (modbus_get_socket(this->modbus), req, req_len) < 0)
+            return fail (errno);
+
+          pending.push_back ({tid, sent, count});
+          sent += count;
+        }
+
+      // after a ctrl-c no more requests are sent, and it is honoured
+      // once those in flight have been answered, so that none of their
+      // responses is left for the next call to take as its own
+      if (pending.empty ())
+        {
+          OCTAVE_QUIT;
+          errno = EINTR;
+          return -1;
+        }
+
+      int rsp_len = modbus_receive_confirmation(this->modbus, rsp);
+      if (rsp_len < 0)
+        return fail (errno);
+      if (rsp_len < offset + 2)
+        return fail (EMBBADDATA);
+
+      uint16_t tid = (rsp[0] << 8) | rsp[1];
+      auto it = pending.begin ();
+      while (it != pending.end () && it->tid != tid)
+        ++it;
+      if (it == pending.end ())
+        return fail (EMBBADDATA);
+
+      unsigned int first = it->first;
+      unsigned int count = it->count;
+      unsigned int start = address + first;
+      pending.erase (it);
+
+      if (rsp[offset] == (function | 0x80))
+        return fail (MODBUS_ENOBASE + rsp[offset + 1]);
+      if (rsp[offset] != function)
+        return fail (EMBBADDATA);
+
+      if (is_write)
+        {
+          // the address and count written are echoed
+          if (rsp_len < offset + 5
+              || (unsigned int)((rsp[offset + 1] << 8) | rsp[offset + 2]) != (start & 0xffff)
+              || (unsigned int)((rsp[offset + 3] << 8) | rsp[offset + 4]) != count)
+            return fail (EMBBADDATA);
+        }
+      else
+        {
+          unsigned int nbytes = is_bits ? (count + 7) / 8 : count * 2;
+          const uint8_t *data = rsp + offset + 2;
+
+          if (rsp[offset + 1] != nbytes || rsp_len < (int)(offset + 2 + nbytes))
+            return fail (EMBBADDATA);
+
+          for (unsigned int i = 0; i < count; i++)
+            {
+              if (is_bits)
+                bits[first + i] = (data[i/8] >> (i % 8)) & 1;
+              else
+                regs[first + i] = (data[2*i] << 8) | data[2*i + 1];
+            }
+        }
+
+      done += count;
+    }
+
+  return done;
+}
+
+int
+octave_modbus::set_pipeline_depth (int depth)
+{
+  if (depth < 1)
+    {
+      error ("modbus_pipelinedepth: must be 1 or more");
+      return -1;
+    }
 
-  regs_read = modbus_write_and_read_registers(this->modbus, wraddress, wrlen, wrbuf, rdaddress, rdlen, rdbuf);
+  pipeline_depth = depth;
 
-  return regs_read;
+  return 1;
 }
 
 int
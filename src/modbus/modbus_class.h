@@ -26,6 +26,8 @@
 #  include "../config.h"
 #endif
 
+#include "../common/property_table.h"
+
 class octave_modbus : public OCTAVE_BASE_CLASS
 {
 public:
@@ -41,6 +43,8 @@ public:
   int set_slave (int id);
   int get_slave () const { return slaveid; }
 
+  // transfers larger than a single request allows are split into
+  // requests of the largest size the protocol allows
   int read_bits (int address, uint8_t *buf, unsigned int len);
   int read_input_bits (int address, uint8_t *buf, unsigned int len);
   int read_registers (int address, uint16_t *buf, unsigned int len);
@@ -84,6 +88,8 @@ public:
 
   octave_value subsasgn (const std::string& type, const std::list<octave_value_list>& idx, const octave_value& rhs);
 
+  static const octave_property_table<octave_modbus> & properties (void);
+
   std::string get_name (void) const { return name; }
   std::string set_name (const std::string &);
 
@@ -103,6 +109,11 @@ public:
 
   int get_tcpport (void) const { return ipport; }
 
+  // number of requests of a split transfer sent over tcpip before
+  // waiting for their responses
+  int set_pipeline_depth (int depth);
+  int get_pipeline_depth (void) const { return pipeline_depth; }
+
   int set_byteorder(const std::string& /* order */);
 
   std::string get_byteorder() const
@@ -141,6 +152,9 @@ public:
 
 private:
   bool has_property(const std::string &name) const;
+  const octave_property<octave_modbus> * find_property (const std::string &name) const;
+  int transfer (int function, int address, void *buf, unsigned int len);
+  int transfer_pipelined (int function, int address, void *buf, unsigned int len);
 
   modbus_t *modbus;
 
@@ -157,6 +171,9 @@ private:
   // tcpip
   std::string ipaddress;
   int ipport;
+  int pipeline_depth;
+  // last transaction id of a pipelined request
+  uint16_t transaction_id;
 
   // serial
   unsigned long baud;
@@ -165,8 +182,6 @@ private:
   int stopbits;
   std::string sport;
 
-  string_vector fieldnames;
-
   DECLARE_OV_TYPEID_FUNCTIONS_AND_DATA
 };
 
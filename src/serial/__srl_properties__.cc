@@ -24,9 +24,7 @@
 
 #ifdef BUILD_SERIAL
 #include "serial_class.h"
-#endif
 
-#ifdef BUILD_SERIAL
 octave_value_list srl_close (octave_serial* serial, const octave_value_list& args, int nargout)
 {
   serial->close ();
@@ -317,6 +315,35 @@ octave_value_list srl_pinstatus (octave_serial* serial, const octave_value_list&
 
   return octave_value (res);
 }
+
+static const octave_property<octave_serial> srl_property_list[] =
+{
+  {"baudrate", srl_baudrate, true},
+  {"bytesize", srl_bytesize, true},
+  {"dataterminalready", srl_dataterminalready, true},
+  {"parity", srl_parity, true},
+  {"pinstatus", srl_pinstatus, true},
+  {"requesttosend", srl_requesttosend, true},
+  {"stopbits", srl_stopbits, true},
+  {"timeout", srl_timeout, true},
+  {"bytesavailable", srl_bytesavailable, true},
+  {"status", srl_status, true},
+  {"name", srl_name, true},
+  {"type", srl_type, true},
+  {"port", srl_port, true},
+  // internals
+  {"close", srl_close, false},
+  {"flush", srl_flush, false},
+  {"break", srl_break, false},
+  {NULL, NULL, false}
+};
+
+const octave_property_table<octave_serial> &
+octave_serial_common::properties (void)
+{
+  static const octave_property_table<octave_serial> table (srl_property_list);
+  return table;
+}
 #endif
 
 // PKG_ADD: autoload ("__srl_properties__", "serial.oct");
@@ -334,43 +361,11 @@ Undocumented internal function.\n\
   const octave_base_value& rep = args (0).get_rep ();
   octave_serial* serial = &((octave_serial &)rep);
     
-  std::string property = args (1).string_value ();
-  octave_value_list args2 = args.slice (2, args.length ()-2);
-    
-  if (property == "baudrate")
-    return srl_baudrate (serial, args2, nargout);
-  else if (property == "bytesize")
-    return srl_bytesize (serial, args2, nargout);
-  else if (property == "dataterminalready")
-    return srl_dataterminalready (serial, args2, nargout);
-  else if (property == "close")
-    return srl_close (serial, args2, nargout);
-  else if (property == "flush")
-    return srl_flush (serial, args2, nargout);
-  else if (property == "break")
-    return srl_break (serial, args2, nargout);
-  else if (property == "parity")
-    return srl_parity (serial, args2, nargout);
-  else if (property == "pinstatus")
-    return srl_pinstatus (serial, args2, nargout);
-  else if (property == "requesttosend")
-    return srl_requesttosend (serial, args2, nargout);
-  else if (property == "stopbits")
-    return srl_stopbits (serial, args2, nargout);
-  else if (property == "timeout")
-    return srl_timeout (serial, args2, nargout);
-  else if (property == "bytesavailable")
-    return srl_bytesavailable (serial, args2, nargout);
-  else if (property == "status")
-    return srl_status (serial, args2, nargout);
-  else if (property == "name")
-    return srl_name (serial, args2, nargout);
-  else if (property == "type")
-    return srl_type (serial, args2, nargout);
-  else if (property == "port")
-    return srl_port (serial, args2, nargout);
-  else
+  const octave_property<octave_serial> *prop = octave_serial::properties ().find_exact (args (1).string_value ());
+  if (! prop)
     (*current_liboctave_error_handler) ("wrong keyword");
+
+  return prop->handler (serial, args.slice (2, args.length ()-2), nargout);
 #endif
     /* never reached in normal operation */
   (*current_liboctave_error_handler) ("Your system doesn't support the SERIAL interface");
@@ -23,21 +23,7 @@
 #include "serial_class.h"
 
 octave_serial_common::octave_serial_common ()
- : fieldnames(13)
 {
-  fieldnames[0] = "baudrate";
-  fieldnames[1] = "bytesize";
-  fieldnames[2] = "dataterminalready";
-  fieldnames[3] = "parity";
-  fieldnames[4] = "pinstatus";
-  fieldnames[5] = "requesttosend";
-  fieldnames[6] = "stopbits";
-  fieldnames[7] = "timeout";
-  fieldnames[8] = "bytesavailable";
-  fieldnames[9] = "status";
-  fieldnames[10] = "name";
-  fieldnames[11] = "type";
-  fieldnames[12] = "port";
 }
 
 octave_value_list
@@ -53,12 +39,14 @@ octave_serial_common::subsref (const std::string& type, const std::list<octave_v
       break;
     case '.':
       {
-        octave_value_list ovl;
-        // inc ref count as assign this to octave_value
-        OV_COUNT++; 
-        ovl (0) = octave_value (this);
-        ovl (1) = (idx.front ()) (0);
-        retval = OCTAVE__FEVAL (std::string ("__srl_properties__"), ovl, 1);
+        const octave_property<octave_serial> *prop = properties ().find_exact ((idx.front ()) (0).string_value ());
+        if (! prop)
+          {
+            error ("wrong keyword");
+            return retval;
+          }
+
+        retval = prop->handler (static_cast<octave_serial *> (this), octave_value_list (), 1);
       }
       break;
     }
@@ -82,13 +70,14 @@ octave_serial_common::subsasgn (const std::string& type, const std::list<octave_
     case '.':
       if (type.length () == 1)
         {
-          octave_value_list ovl;
-          // inc ref count as assign this to octave_value
-          OV_COUNT++; 
-          ovl (0) = octave_value (this);
-          ovl (1) = (idx.front ()) (0);
-          ovl (2) = rhs;
-          OCTAVE__FEVAL (std::string ("__srl_properties__"), ovl, 0);
+          const octave_property<octave_serial> *prop = properties ().find_exact ((idx.front ()) (0).string_value ());
+          if (! prop)
+            {
+              error ("wrong keyword");
+              return retval;
+            }
+
+          prop->handler (static_cast<octave_serial *> (this), octave_value_list (rhs), 0);
           OV_COUNT++;
           retval = octave_value (this);
         }
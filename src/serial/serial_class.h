@@ -66,6 +66,10 @@
 #  include "../config.h"
 #endif
 
+#include "../common/property_table.h"
+
+class octave_serial;
+
 class octave_serial_common : public OCTAVE_BASE_CLASS
 {
 protected:
@@ -91,7 +95,7 @@ public:
   octave_base_value * unique_clone (void) { OV_COUNT++; return this;}
 
   // required to use subsasn
-  string_vector map_keys (void) const { return fieldnames; }
+  string_vector map_keys (void) const { return properties ().fieldnames (); }
   dim_vector dims (void) const { static dim_vector dv(1, 1); return dv; }
 
   void print (std::ostream& os, bool pr_as_read_syntax = false)
@@ -145,6 +149,8 @@ public:
 
   octave_value subsasgn (const std::string& type, const std::list<octave_value_list>& idx, const octave_value& rhs);
 
+  static const octave_property_table<octave_serial> & properties (void);
+
   std::string get_status () const
   {
     if (fd_is_valid ())
@@ -173,8 +179,6 @@ public:
     name = newname;
   }
 protected:
-  string_vector fieldnames;
-
   std::string name;
   std::string portPath;
 };
@@ -22,6 +22,7 @@
 
 #ifdef BUILD_SERIAL
 #include "serial_class.h"
+#include "../common/byte_view.h"
 #endif
 
 // PKG_ADD: autoload ("srl_write", "serial.oct");
@@ -55,32 +56,16 @@ Upon successful completion, srl_write() shall return the number of bytes written
   const octave_base_value& rep = args (0).get_rep ();
   serial = &((octave_serial &)rep);
 
-  if (args (1).is_string ()) // String
-    {
-      retval = serial->write (args (1).string_value ());
-    }
-  else if (args (1).is_uint8_type ()) // uint8_t
-    {
-      NDArray data = args (1).array_value ();
-      OCTAVE_LOCAL_BUFFER (uint8_t, buf, (data.numel ()));
-
-      if (buf == NULL)
-        {
-          error ("srl_write: cannot allocate requested memory");
-          return octave_value (-1);  
-        }
+  octave_byte_view data (args (1), true);
 
-      for (int i = 0; i < data.numel (); i++)
-        buf[i] =  static_cast<uint8_t>(data(i));
-
-      retval = serial->write (buf, data.numel ());
-    }
-  else
+  if (! data.is_valid ())
     {
       print_usage ();
       return octave_value (-1);
     }
 
+  retval = serial->write (data.data (), data.length ());
+
   return octave_value (retval);
 #endif
 }
@@ -0,0 +1,53 @@
+// Copyright (C) 2026   John Donoghue   <john.donoghue@ieee.org>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+
+#include <octave/oct.h>
+
+#ifdef HAVE_CONFIG_H
+#  include "../config.h"
+#endif
+
+#ifdef BUILD_SERIAL
+#  include "serialport_class.h"
+#endif
+
+// PKG_ADD: autoload ("__srlp_async_callbacks__", "serialport.oct");
+DEFUN_DLD (__srlp_async_callbacks__, args, nargout,
+        "-*- texinfo -*-\n\
+@deftypefn {} {} __srlp_async_callbacks__ ()\n \
+\n\
+Private function to run the BytesAvailableFcn callbacks that are due\n \
+for all serialport objects.\n \
+\n\
+It is installed as an input event hook when the first callback is set.\n \
+@end deftypefn")
+{
+#ifndef BUILD_SERIAL
+  error ("serial: Your system doesn't support the SERIAL interface");
+#else
+  if (args.length () != 0)
+    print_usage ();
+
+  octave_async_callbacks<octave_serialport>::dispatch_all ();
+#endif
+  return octave_value ();
+}
+
+#if 0
+%!error <Invalid call to __srlp_async_callbacks__> __srlp_async_callbacks__ (1)
+
+%!test
+%! __srlp_async_callbacks__ ();
+#endif
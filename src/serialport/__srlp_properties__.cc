@@ -22,9 +22,7 @@
 
 #ifdef BUILD_SERIAL
 #include "serialport_class.h"
-#endif
-
-#ifdef BUILD_SERIAL
+#include "../common/async_properties.h"
 
 octave_value_list srlp_flush (octave_serialport* serialport, const octave_value_list& args, int nargout)
 {
@@ -399,6 +397,45 @@ octave_value_list srlp_pinstatus (octave_serialport* serialport, const octave_va
 
   return octave_value (res);
 }
+
+static const octave_property<octave_serialport> srlp_property_list[] =
+{
+  {"BaudRate", srlp_baudrate, true},
+  {"DataBits", srlp_databits, true},
+  {"Parity", srlp_parity, true},
+  {"StopBits", srlp_stopbits, true},
+  {"Timeout", srlp_timeout, true},
+  {"NumBytesAvailable", srlp_numbytesavailable, true},
+  {"NumBytesWritten", srlp_numbyteswritten, true},
+  {"Port", srlp_port, true},
+  {"FlowControl", srlp_flowcontrol, true},
+  {"UserData", srlp_userdata, true},
+  {"ByteOrder", srlp_byteorder, true},
+  {"Terminator", srlp_terminator, true},
+  {"Tag", srlp_tag, true},
+  {"ReadAsyncMode", octave_async_readasyncmode<octave_serialport>, true},
+  {"BytesAvailableFcn", octave_async_bytesavailablefcn<octave_serialport>, true},
+  {"BytesAvailableFcnCount", octave_async_bytesavailablefcncount<octave_serialport>, true},
+  {"BytesAvailableFcnMode", octave_async_bytesavailablefcnmode<octave_serialport>, true},
+  {"InputBufferSize", octave_async_inputbuffersize<octave_serialport>, true},
+  {"NumBytesDropped", octave_async_numbytesdropped<octave_serialport>, true},
+  // internals
+  {"__flush__", srlp_flush, false},
+  {"__break__", srlp_break, false},
+  {"__pinstatus__", srlp_pinstatus, false},
+  {"__requesttosend__", srlp_requesttosend, false},
+  {"__dataterminalready__", srlp_dataterminalready, false},
+  {"__configurecallback__", octave_async_configurecallback<octave_serialport>, false},
+  {"__waitinfo__", octave_async_waitinfo<octave_serialport>, false},
+  {NULL, NULL, false}
+};
+
+const octave_property_table<octave_serialport> &
+octave_serialport_common::properties (void)
+{
+  static const octave_property_table<octave_serialport> table (srlp_property_list);
+  return table;
+}
 #endif
 
 // PKG_ADD: autoload ("__srlp_properties__", "serialport.oct");
@@ -416,50 +453,11 @@ Undocumented internal function.\n\
   const octave_base_value& rep = args (0).get_rep ();
   octave_serialport* serialport = &((octave_serialport &)rep);
     
-  std::string property = args (1).string_value ();
-  std::transform (property.begin (), property.end (), property.begin (), ::tolower);
-
-  octave_value_list args2 = args.slice (2, args.length ()-2);
-    
-  if (property == "port")
-    return srlp_port (serialport, args2, nargout);
-  else if (property == "baudrate")
-    return srlp_baudrate (serialport, args2, nargout);
-  else if (property == "numbytesavailable")
-    return srlp_numbytesavailable (serialport, args2, nargout);
-  else if (property == "numbyteswritten")
-    return srlp_numbyteswritten (serialport, args2, nargout);
-  else if (property == "byteorder")
-    return srlp_byteorder (serialport, args2, nargout);
-  else if (property == "databits")
-    return srlp_databits (serialport, args2, nargout);
-  else if (property == "stopbits")
-    return srlp_stopbits (serialport, args2, nargout);
-  else if (property == "parity")
-    return srlp_parity (serialport, args2, nargout);
-  else if (property == "flowcontrol")
-    return srlp_flowcontrol (serialport, args2, nargout);
-  else if (property == "timeout")
-    return srlp_timeout (serialport, args2, nargout);
-  else if (property == "userdata")
-    return srlp_userdata (serialport, args2, nargout);
-  else if (property == "terminator")
-    return srlp_terminator (serialport, args2, nargout);
-  else if (property == "tag")
-    return srlp_tag (serialport, args2, nargout);
-  // internals
-  else if (property == "__flush__")
-    return srlp_flush (serialport, args2, nargout);
-  else if (property == "__break__")
-    return srlp_break (serialport, args2, nargout);
-  else if (property == "__pinstatus__")
-    return srlp_pinstatus (serialport, args2, nargout);
-  else if (property == "__requesttosend__")
-    return srlp_requesttosend (serialport, args2, nargout);
-  else if (property == "__dataterminalready__")
-    return srlp_dataterminalready (serialport, args2, nargout);
-  else
+  const octave_property<octave_serialport> *prop = octave_serialport::properties ().find (args (1).string_value ());
+  if (! prop)
     (*current_liboctave_error_handler) ("wrong keyword");
+
+  return prop->handler (serialport, args.slice (2, args.length ()-2), nargout);
 #endif
     /* never reached in normal operation */
   (*current_liboctave_error_handler) ("Your system doesn't support the SERIAL interface");
@@ -26,6 +26,7 @@
 #include <errno.h>
 
 #include "serialport_class.h"
+#include "../common/typed_data.h"
 
 #endif
 
@@ -33,12 +34,14 @@
 DEFUN_DLD (__srlp_read__, args, nargout, 
         "-*- texinfo -*-\n\
 @deftypefn {} {[@var{data}, @var{count}] = } __srlp_read__ (@var{serial}, @var{n})\n \
+@deftypefnx {} {[@var{data}, @var{count}] = } __srlp_read__ (@var{serial}, @var{n}, @var{datatype})\n \
 \n\
 Read from serialport interface.\n \
 \n\
 @subsubheading Inputs\n \
 @var{serial} - instance of @var{octave_serialport} class.@*\
-@var{n} - number of bytes to attempt to read of type Integer.\n \
+@var{n} - number of bytes to attempt to read of type Integer.@*\
+@var{datatype} - precision to read as, in which case @var{n} is the number of values to read and @var{count} is the number of values read.\n \
 \n\
 @subsubheading Outputs\n \
 The __srlp_read__() shall return number of bytes successfully read in @var{count} as Integer and the bytes themselves in @var{data} as uint8 array.\n \
@@ -48,7 +51,7 @@ The __srlp_read__() shall return number of bytes successfully read in @var{count
   error("serial: Your system doesn't support the SERIAL interface");
   return octave_value ();
 #else
-  if (args.length () != 2 || args (0).type_id () != octave_serialport::static_type_id ())
+  if (args.length () < 2 || args.length () > 3 || args (0).type_id () != octave_serialport::static_type_id ())
     {
       print_usage ();
       return octave_value (-1);
@@ -64,28 +67,67 @@ The __srlp_read__() shall return number of bytes successfully read in @var{count
 
   buffer_len = args (1).int_value ();
 
-  OCTAVE_LOCAL_BUFFER (uint8_t, buffer, (buffer_len + 1));
-
-  if (buffer == NULL)
-    {
-      error ("__srlp_read__: cannot allocate requested memory: %s\n", strerror (errno));
-      return octave_value (-1);  
-    }
-
   octave_serialport* serial = NULL;
 
   const octave_base_value& rep = args (0).get_rep ();
   serial = &((octave_serialport &)rep);
 
-  // Read data
-  int bytes_read = serial->read (buffer, buffer_len);
+  // run any BytesAvailableFcn callbacks that are due
+  serial->dispatch_callbacks ();
+
+  // Read values of the requested type directly into the result array,
+  // until count values are read or a read times out
+  if (args.length () > 2)
+    {
+      octave_data_type type;
+
+      if (! args (2).is_string ())
+        {
+          print_usage ();
+          return octave_value (-1);
+        }
+      if (! octave_data_type_lookup (args (2).string_value (), type))
+        {
+          error ("__srlp_read__: precision not supported");
+          return octave_value (-1);
+        }
+
+      int count = args (1).int_value ();
+      if (count < 0)
+        count = 0;
+
+      bool swap = octave_byteorder_needs_swap (serial->get_byteorder ());
+
+      octave_value data = octave_read_typed (type, count, swap,
+        [serial] (uint8_t *buf, unsigned int len)
+        {
+          unsigned int total = 0;
+          while (total < len)
+            {
+              int n = serial->read (buf + total, len - total);
+              if (n <= 0)
+                break;
+              total += n;
+            }
+          return static_cast<int> (total);
+        });
+
+      octave_value_list return_list;
+      return_list (0) = data;
+      return_list (1) = data.numel ();
+
+      return return_list;
+    }
+
+  // Read data directly into the result array
+  uint8NDArray data (dim_vector (1, buffer_len));
+
+  int bytes_read = serial->read (reinterpret_cast<uint8_t *> (data.fortran_vec ()), buffer_len);
 
   // Convert data to octave type variables
   octave_value_list return_list;
-  uint8NDArray data (dim_vector (1, bytes_read));
-
-  for (int i = 0; i < bytes_read; i++)
-    data (i) = buffer[i];
+  // trim to the bytes actually read
+  data.resize (dim_vector (1, bytes_read));
 
   return_list (0) = data;
   return_list (1) = bytes_read;
@@ -0,0 +1,94 @@
+// Copyright (C) 2026   John Donoghue   <john.donoghue@ieee.org>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+
+#include <octave/oct.h>
+
+#ifdef HAVE_CONFIG_H
+#include "../config.h"
+#endif
+
+#ifdef BUILD_SERIAL
+#include "serialport_class.h"
+#include "../common/typed_data.h"
+#endif
+
+// PKG_ADD: autoload ("__srlp_readbinblock__", "serialport.oct");
+DEFUN_DLD (__srlp_readbinblock__, args, nargout,
+        "-*- texinfo -*-\n\
+@deftypefn {} {@var{data} = } __srlp_readbinblock__ (@var{serial})\n \
+@deftypefnx {} {@var{data} = } __srlp_readbinblock__ (@var{serial}, @var{datatype})\n \
+\n\
+Private function to read a IEEE 488.2 binblock from a serialport interface.\n \
+\n\
+Any data before the '#' of the block header is discarded. The block data is\n \
+read directly into the result, in the byte order of the object, and the\n \
+trailing terminator is consumed.\n \
+\n\
+@subsubheading Inputs\n \
+@var{serial} - instance of @var{octave_serialport} class.@* \
+@var{datatype} - precision of the block values (default 'uint8').\n \
+\n\
+@subsubheading Outputs\n \
+@var{data} - the block values, or an empty array if no block was read.\n \
+@end deftypefn")
+{
+#ifndef BUILD_SERIAL
+  error ("serial: Your system doesn't support the SERIAL interface");
+  return octave_value ();
+#else
+
+  if (args.length () < 1 || args.length () > 2 || args (0).type_id () != octave_serialport::static_type_id ())
+    {
+      print_usage ();
+      return octave_value (-1);
+    }
+
+  octave_data_type type;
+  octave_data_type_lookup ("uint8", type);
+
+  if (args.length () > 1)
+    {
+      if (! args (1).is_string ())
+        {
+          print_usage ();
+          return octave_value (-1);
+        }
+      if (! octave_data_type_lookup (args (1).string_value (), type))
+        {
+          error ("__srlp_readbinblock__: datatype not supported");
+          return octave_value (-1);
+        }
+    }
+
+  octave_serialport* serial = NULL;
+
+  const octave_base_value& rep = args (0).get_rep ();
+  serial = &((octave_serialport &)rep);
+
+  // run any BytesAvailableFcn callbacks that are due
+  serial->dispatch_callbacks ();
+
+  octave_value data = serial->readbinblock (type);
+
+  return data;
+#endif
+}
+
+#if 0
+%!error <Invalid call to __srlp_readbinblock__> __srlp_readbinblock__ ()
+
+%!error <Invalid call to __srlp_readbinblock__> __srlp_readbinblock__ (1)
+
+#endif
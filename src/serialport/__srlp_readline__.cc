@@ -0,0 +1,79 @@
+// Copyright (C) 2026   John Donoghue   <john.donoghue@ieee.org>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+
+#include <octave/oct.h>
+
+#ifdef HAVE_CONFIG_H
+#include "../config.h"
+#endif
+
+#ifdef BUILD_SERIAL
+#include "serialport_class.h"
+#endif
+
+// PKG_ADD: autoload ("__srlp_readline__", "serialport.oct");
+DEFUN_DLD (__srlp_readline__, args, nargout,
+        "-*- texinfo -*-\n\
+@deftypefn {} {[@var{data}, @var{found}] = } __srlp_readline__ (@var{serial})\n \
+\n\
+Private function to read a line from serial interface.\n \
+\n\
+Data is read in blocks into a receive buffer on the object and scanned for\n \
+the input terminator. Any data after the terminator is kept for the next read.\n \
+\n\
+@subsubheading Inputs\n \
+@var{serial} - instance of @var{octave_serialport} class.\n \
+\n\
+@subsubheading Outputs\n \
+@var{data} - data read, excluding the terminator, as a string.@*\n \
+@var{found} - true if the terminator was found before a timeout.\n \
+@end deftypefn")
+{
+#ifndef BUILD_SERIAL
+  error ("serial: Your system doesn't support the SERIAL interface");
+  return octave_value ();
+#else
+
+  if (args.length () != 1 || args (0).type_id () != octave_serialport::static_type_id ())
+    {
+      print_usage ();
+      return octave_value (-1);
+    }
+
+  octave_serialport* serial = NULL;
+
+  const octave_base_value& rep = args (0).get_rep ();
+  serial = &((octave_serialport &)rep);
+
+  // run any BytesAvailableFcn callbacks that are due
+  serial->dispatch_callbacks ();
+
+  std::string line;
+  bool found = serial->readline (line);
+
+  octave_value_list return_list;
+  return_list(0) = line;
+  return_list(1) = found;
+
+  return return_list;
+#endif
+}
+
+#if 0
+%!error <Invalid call to __srlp_readline__> __srlp_readline__ ()
+
+%!error <Invalid call to __srlp_readline__> __srlp_readline__ (1)
+
+#endif
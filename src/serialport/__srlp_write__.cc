@@ -22,18 +22,22 @@
 
 #ifdef BUILD_SERIAL
 #include "serialport_class.h"
+#include "../common/byte_view.h"
+#include "../common/typed_data.h"
 #endif
 
 // PKG_ADD: autoload ("__srlp_write__", "serialport.oct");
 DEFUN_DLD (__srlp_write__, args, nargout, 
         "-*- texinfo -*-\n\
 @deftypefn {} {@var{n} = } __srlp_write__ (@var{serial}, @var{data})\n \
+@deftypefnx {} {@var{n} = } __srlp_write__ (@var{serial}, @var{data}, @var{datatype})\n \
 \n\
 Write data to a serialport interface.\n \
 \n\
 @subsubheading Inputs\n \
 @var{serial} - instance of @var{octave_serialport} class.@*\
-@var{data} - data to be written to the serialport interface. Can be either of String or uint8 type.\n \
+@var{data} - data to be written to the serialport interface. Can be a String, or an integer or floating point array which is written as its raw bytes.@*\
+@var{datatype} - precision to convert @var{data} to before writing, in the byte order of the object.\n \
 \n\
 @subsubheading Outputs\n \
 Upon successful completion, __srlp_write__() shall return the number of bytes written as the result @var{n}.\n \
@@ -43,7 +47,7 @@ Upon successful completion, __srlp_write__() shall return the number of bytes wr
   error ("serial: Your system doesn't support the SERIAL interface");
   return octave_value ();
 #else
-  if (args.length () != 2 || args (0).type_id () != octave_serialport::static_type_id ())
+  if (args.length () < 2 || args.length () > 3 || args (0).type_id () != octave_serialport::static_type_id ())
     {
       print_usage ();
       return octave_value (-1);
@@ -55,32 +59,42 @@ Upon successful completion, __srlp_write__() shall return the number of bytes wr
   const octave_base_value& rep = args (0).get_rep ();
   serial = &((octave_serialport &)rep);
 
-  if (args (1).is_string ()) // String
+  if (args.length () > 2)
     {
-      retval = serial->write (args (1).string_value ());
-    }
-  else if (args (1).is_uint8_type ()) // uint8_t
-    {
-      NDArray data = args (1).array_value ();
-      OCTAVE_LOCAL_BUFFER (uint8_t, buf, (data.numel ()));
+      octave_data_type type;
 
-      if (buf == NULL)
+      if (! args (2).is_string ())
         {
-          error ("__srlp_write__: cannot allocate requested memory");
-          return octave_value (-1);  
+          print_usage ();
+          return octave_value (-1);
+        }
+      if (! octave_data_type_lookup (args (2).string_value (), type))
+        {
+          error ("__srlp_write__: precision not supported");
+          return octave_value (-1);
         }
 
-      for (int i = 0; i < data.numel (); i++)
-        buf[i] =  static_cast<uint8_t>(data(i));
+      bool swap = octave_byteorder_needs_swap (serial->get_byteorder ());
 
-      retval = serial->write (buf, data.numel ());
+      retval = octave_write_typed (args (1), type, swap,
+        [serial] (uint8_t *buf, unsigned int len)
+        {
+          return serial->write (buf, len);
+        });
+
+      return octave_value (retval);
     }
-  else
+
+  octave_byte_view data (args (1));
+
+  if (! data.is_valid ())
     {
       print_usage ();
       return octave_value (-1);
     }
 
+  retval = serial->write (data.data (), data.length ());
+
   return octave_value (retval);
 #endif
 }
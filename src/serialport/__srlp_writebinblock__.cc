@@ -0,0 +1,87 @@
+// Copyright (C) 2026   John Donoghue   <john.donoghue@ieee.org>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+
+#include <octave/oct.h>
+
+#ifdef HAVE_CONFIG_H
+#include "../config.h"
+#endif
+
+#ifdef BUILD_SERIAL
+#include "serialport_class.h"
+#include "../common/binblock.h"
+#endif
+
+// PKG_ADD: autoload ("__srlp_writebinblock__", "serialport.oct");
+DEFUN_DLD (__srlp_writebinblock__, args, nargout,
+        "-*- texinfo -*-\n\
+@deftypefn {} {@var{n} = } __srlp_writebinblock__ (@var{serial}, @var{data}, @var{datatype})\n \
+\n\
+Private function to write data as a IEEE 488.2 binblock to a serialport interface.\n \
+\n\
+The block header, data and terminator are sent with a single gathered write,\n \
+without copying the data.\n \
+\n\
+@subsubheading Inputs\n \
+@var{serial} - instance of @var{octave_serialport} class.@* \
+@var{data} - data to write.@* \
+@var{datatype} - precision to convert @var{data} to, in the byte order of the object.\n \
+\n\
+@subsubheading Outputs\n \
+@var{n} - number of bytes written, including the header and terminator.\n \
+@end deftypefn")
+{
+#ifndef BUILD_SERIAL
+  error ("serial: Your system doesn't support the SERIAL interface");
+  return octave_value ();
+#else
+
+  if (args.length () != 3 || args (0).type_id () != octave_serialport::static_type_id () || ! args (2).is_string ())
+    {
+      print_usage ();
+      return octave_value (-1);
+    }
+
+  octave_data_type type;
+
+  if (! octave_data_type_lookup (args (2).string_value (), type))
+    {
+      error ("__srlp_writebinblock__: datatype not supported");
+      return octave_value (-1);
+    }
+
+  octave_serialport* serial = NULL;
+
+  const octave_base_value& rep = args (0).get_rep ();
+  serial = &((octave_serialport &)rep);
+
+  bool swap = octave_byteorder_needs_swap (serial->get_byteorder ());
+
+  int retval = octave_write_binblock_parts (args (1), type, swap,
+    [serial] (const octave_write_part *parts, int nparts)
+    {
+      return serial->write_parts (parts, nparts);
+    });
+
+  return octave_value (retval);
+#endif
+}
+
+#if 0
+%!error <Invalid call to __srlp_writebinblock__> __srlp_writebinblock__ ()
+
+%!error <Invalid call to __srlp_writebinblock__> __srlp_writebinblock__ (1, "hello", "uint8")
+
+#endif
@@ -0,0 +1,80 @@
+// Copyright (C) 2026   John Donoghue   <john.donoghue@ieee.org>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+
+#include <octave/oct.h>
+
+#ifdef HAVE_CONFIG_H
+#include "../config.h"
+#endif
+
+#ifdef BUILD_SERIAL
+#include "serialport_class.h"
+#endif
+
+// PKG_ADD: autoload ("__srlp_writeread__", "serialport.oct");
+DEFUN_DLD (__srlp_writeread__, args, nargout,
+        "-*- texinfo -*-\n\
+@deftypefn {} {[@var{data}, @var{found}] = } __srlp_writeread__ (@var{serial}, @var{cmd})\n \
+\n\
+Private function to send a command to a serial interface and read the response line.\n \
+\n\
+The command and output terminator are sent with a single write, then the\n \
+response is read through the receive buffer as for readline.\n \
+\n\
+@subsubheading Inputs\n \
+@var{serial} - instance of @var{octave_serialport} class.@* \
+@var{cmd} - command to send, as a string.\n \
+\n\
+@subsubheading Outputs\n \
+@var{data} - data read, excluding the terminator, as a string.@*\n \
+@var{found} - true if the terminator was found before a timeout.\n \
+@end deftypefn")
+{
+#ifndef BUILD_SERIAL
+  error ("serial: Your system doesn't support the SERIAL interface");
+  return octave_value ();
+#else
+
+  if (args.length () != 2 || ! args (1).is_string () || args (0).type_id () != octave_serialport::static_type_id ())
+    {
+      print_usage ();
+      return octave_value (-1);
+    }
+
+  octave_serialport* serial = NULL;
+
+  const octave_base_value& rep = args (0).get_rep ();
+  serial = &((octave_serialport &)rep);
+
+  // run any BytesAvailableFcn callbacks that are due
+  serial->dispatch_callbacks ();
+
+  std::string line;
+  bool found = serial->writeread (args (1).string_value (), line);
+
+  octave_value_list return_list;
+  return_list(0) = line;
+  return_list(1) = found;
+
+  return return_list;
+#endif
+}
+
+#if 0
+%!error <Invalid call to __srlp_writeread__> __srlp_writeread__ ()
+
+%!error <Invalid call to __srlp_writeread__> __srlp_writeread__ (1, "*IDN?")
+
+#endif
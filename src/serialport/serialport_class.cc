@@ -21,12 +21,12 @@
 
 #ifdef BUILD_SERIAL
 #include "serialport_class.h"
+#include "../common/binblock.h"
 #include <octave/Matrix.h>
 #include <string>
 #include <algorithm>
 
 octave_serialport_common::octave_serialport_common ()
- : fieldnames(14)
 {
   byteswritten = 0;
   userData = Matrix ();
@@ -34,29 +34,6 @@ octave_serialport_common::octave_serialport_common ()
   interminator = octave_value("lf");
   outterminator = octave_value("lf");
   byteOrder = "little-endian";
-
-  fieldnames[0] = "BaudRate";
-  fieldnames[1] = "DataBits";
-  fieldnames[3] = "Parity";
-  fieldnames[4] = "StopBits";
-  fieldnames[5] = "Timeout";
-  fieldnames[6] = "NumBytesAvailable";
-  fieldnames[7] = "NumBytesWritten";
-  fieldnames[8] = "Port";
-  fieldnames[9] = "FlowControl";
-  fieldnames[10] = "UserData";
-  fieldnames[11] = "ByteOrder";
-  fieldnames[12] = "Terminator";
-  fieldnames[13] = "Tag";
-}
-
-bool octave_serialport_common::has_property(const std::string &name) const
-{
-  for (octave_idx_type i=0; i<fieldnames.numel(); i++)
-    {
-      if (fieldnames[i] == name) return true;
-    }
-  return false;
 }
 
 octave_value_list
@@ -73,19 +50,15 @@ octave_serialport_common::subsref (const std::string& type, const std::list<octa
     case '.':
       {
 	std::string property = (idx.front ()) (0).string_value ();
-        if (!has_property(property))
+        const octave_property<octave_serialport> *prop = properties ().find_field (property);
+        if (! prop)
 	  {
             error ("Unknown property '%s'", property.c_str());
             return retval;
           }
         else
 	  {
-            octave_value_list ovl;
-            // inc ref count as assign this to octave_value
-            OV_COUNT++; 
-            ovl (0) = octave_value (this);
-            ovl (1) = (idx.front ()) (0);
-            retval = OCTAVE__FEVAL (std::string ("__srlp_properties__"), ovl, 1);
+            retval = prop->handler (static_cast<octave_serialport *> (this), octave_value_list (), 1);
 	  }
       }
       break;
@@ -111,21 +84,15 @@ octave_serialport_common::subsasgn (const std::string& type, const std::list<oct
       if (type.length () == 1)
         {
           std::string property = (idx.front ()) (0).string_value ();
-          if (! has_property(property))
+          const octave_property<octave_serialport> *prop = properties ().find_field (property);
+          if (! prop)
 	    {
               error ("Unknown property '%s'", property.c_str());
               return retval;
             }
           else
 	    {
-   
-              octave_value_list ovl;
-              // inc ref count as assign this to octave_value
-              OV_COUNT++; 
-              ovl (0) = octave_value (this);
-              ovl (1) = (idx.front ()) (0);
-              ovl (2) = rhs;
-              OCTAVE__FEVAL (std::string ("__srlp_properties__"), ovl, 0);
+              prop->handler (static_cast<octave_serialport *> (this), octave_value_list (rhs), 0);
               OV_COUNT++;
               retval = octave_value (this);
 	    }
@@ -152,6 +119,56 @@ octave_serialport_common::subsasgn (const std::string& type, const std::list<oct
   return retval;
 }
 
+bool
+octave_serialport_common::readline (std::string &line)
+{
+  octave_serialport *serial = static_cast<octave_serialport *> (this);
+
+  return rxbuf.read_line (octave_terminator_string (interminator), line,
+    [serial] (uint8_t *buf, unsigned int len)
+    {
+      return serial->read (buf, len);
+    },
+    [serial] (void)
+    {
+      return serial->get_numbytesavailable ();
+    });
+}
+
+octave_value
+octave_serialport_common::readbinblock (const octave_data_type &type)
+{
+  octave_serialport *serial = static_cast<octave_serialport *> (this);
+
+  return octave_read_binblock (rxbuf, type, octave_byteorder_needs_swap (byteOrder),
+    [serial] (uint8_t *buf, unsigned int len)
+    {
+      return serial->read (buf, len);
+    },
+    [serial] (void)
+    {
+      return serial->get_numbytesavailable ();
+    });
+}
+
+void
+octave_serialport_common::dispatch_callbacks (void)
+{
+  async.dispatch (octave_value (this, true));
+}
+
+bool
+octave_serialport_common::writeread (const std::string &cmd, std::string &line)
+{
+  octave_serialport *serial = static_cast<octave_serialport *> (this);
+
+  // command and terminator go out in a single write
+  if (serial->write (cmd + octave_terminator_string (outterminator)) < 0)
+    return false;
+
+  return readline (line);
+}
+
 int
 octave_serialport_common::set_byteorder(const std::string& neworder)
 {
@@ -194,6 +211,8 @@ octave_serialport_common::set_input_terminator(const octave_value& t)
   else
     error ("octave_serialport invalid input terminator");
 
+  async.set_terminator (octave_terminator_string (interminator));
+
  return 1;
 }
 
@@ -63,13 +63,21 @@
 #  include "../config.h"
 #endif
 
+#include "../common/property_table.h"
+#include "../common/byte_view.h"
+#include "../common/receive_buffer.h"
+#include "../common/typed_data.h"
+#include "../common/async_reader.h"
+
+class octave_serialport;
+
 class octave_serialport_common : public OCTAVE_BASE_CLASS
 {
 protected:
   octave_serialport_common();
 
-  bool has_property(const std::string &name) const;
 public:
+  static const octave_property_table<octave_serialport> & properties (void);
 
   // os dependent functions
   virtual bool fd_is_valid() const = 0;
@@ -80,6 +88,15 @@ public:
   virtual int get_stopbits() const = 0;
   virtual int get_numbytesavailable() const = 0;
 
+  bool readline (std::string &line);
+  octave_value readbinblock (const octave_data_type &type);
+  bool writeread (const std::string &cmd, std::string &line);
+
+  // background reader, used when ReadAsyncMode is "continuous"
+  octave_async_reader & get_async (void) { return async; }
+  void dispatch_callbacks (void);
+  static const char * async_hook (void) { return "__srlp_async_callbacks__"; }
+
   // Properties
   bool is_constant (void) const { return true;}
   bool is_defined (void) const { return true;}
@@ -90,7 +107,7 @@ public:
   octave_base_value * unique_clone (void) { OV_COUNT++; return this;}
 
   // required to use subsasn
-  string_vector map_keys (void) const { return fieldnames; }
+  string_vector map_keys (void) const { return properties ().fieldnames (); }
   dim_vector dims (void) const { static dim_vector dv(1, 1); return dv; }
 
   void print (std::ostream& os, bool pr_as_read_syntax = false)
@@ -200,7 +217,6 @@ public:
   }
 
 protected:
-  string_vector fieldnames;
   unsigned long byteswritten;
 
   std::string tag;
@@ -209,6 +225,8 @@ protected:
   std::string byteOrder;
   octave_value interminator;
   octave_value outterminator;
+  octave_receive_buffer rxbuf;
+  octave_async_reader async;
   octave_value userData;
 };
 
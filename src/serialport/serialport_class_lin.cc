@@ -22,6 +22,7 @@
 #ifdef BUILD_SERIAL
 #include <iostream>
 #include <string>
+#include <vector>
 #include <algorithm>
 
 #include <stdio.h>
@@ -32,11 +33,38 @@
 #include <sys/ioctl.h>
 #include <sys/socket.h>
 #include <unistd.h>
+#include <poll.h>
+#include <sys/uio.h>
 
 #include "serialport_class.h"
 
 DEFINE_OV_TYPEID_FUNCTIONS_AND_DATA (octave_serialport, "octave_serialport", "octave_serialport");
 
+// read used by the background reader thread, so must not call any octave
+// functions. Returns 0 on a timeout and -1 on an error or a hangup.
+static int
+async_serial_read (int fd, uint8_t *buf, unsigned int len, int ms)
+{
+  struct pollfd pfd;
+  pfd.fd = fd;
+  pfd.events = POLLIN;
+  pfd.revents = 0;
+
+  int ret = ::poll (&pfd, 1, ms);
+  if (ret < 0)
+    return errno == EINTR ? 0 : -1;
+  if (ret == 0)
+    return 0;
+  if (! (pfd.revents & POLLIN))
+    return -1;
+
+  ret = ::read (fd, buf, len);
+  if (ret < 0)
+    return (errno == EINTR || errno == EAGAIN) ? 0 : -1;
+
+  return ret;
+}
+
 octave_serialport::octave_serialport (void)
 : fd (-1)
 {
@@ -121,6 +149,7 @@ octave_serialport::open (const std::string &path)
 
 octave_serialport::~octave_serialport (void)
 {
+  octave_async_callbacks<octave_serialport>::remove (this);
   octave_serialport::close();
 }
 
@@ -133,7 +162,22 @@ octave_serialport::read (uint8_t *buf, unsigned int len)
       return 0;
     }
 
-  size_t bytes_read = 0;
+  // data left over from readline is returned first
+  size_t bytes_read = rxbuf.take (buf, len);
+
+  // data received by the background reader
+  if (async.is_running ())
+    {
+      int n = async.read (buf + bytes_read, len - bytes_read, blocking_read ? -1 : timeout * 1000);
+      if (n < 0)
+        {
+          if (bytes_read == 0)
+            error ("serialport: Error while reading");
+          return bytes_read;
+        }
+      return bytes_read + n;
+    }
+
   ssize_t read_retval = -1;
 
   double maxwait = timeout;
@@ -202,6 +246,54 @@ octave_serialport::write(uint8_t *buf, unsigned int len)
   return ret;
 }
 
+int
+octave_serialport::write_parts(const octave_write_part *parts, int nparts)
+{
+  if (!fd_is_valid ())
+    {
+      error ("serialport: Interface must be opened first...");
+      return -1;
+    }
+
+  std::vector<struct iovec> iov (nparts);
+  for (int i = 0; i < nparts; i++)
+    {
+      iov[i].iov_base = const_cast<uint8_t *> (parts[i].data);
+      iov[i].iov_len = parts[i].len;
+    }
+
+  // a write may take less than all of it, so carry on from where it
+  // stopped
+  int total = 0;
+  size_t first = 0;
+  while (first < iov.size ())
+    {
+      ssize_t ret = ::writev (fd, &iov[first], iov.size () - first);
+      if (ret < 0)
+        {
+          if (errno == EINTR)
+            continue;
+          return total > 0 ? total : -1;
+        }
+
+      total += ret;
+      byteswritten += ret;
+
+      while (first < iov.size () && static_cast<size_t> (ret) >= iov[first].iov_len)
+        {
+          ret -= iov[first].iov_len;
+          first++;
+        }
+      if (ret > 0)
+        {
+          iov[first].iov_base = static_cast<char *> (iov[first].iov_base) + ret;
+          iov[first].iov_len -= ret;
+        }
+    }
+
+  return total;
+}
+
 int
 octave_serialport::set_timeout (double newtimeout)
 {
@@ -569,9 +661,54 @@ octave_serialport::flush (unsigned short queue_selector)
       return false;
     }
 
+  if (queue_selector != 0)
+    {
+      rxbuf.clear ();
+      async.clear ();
+    }
+
   return ::tcflush (fd, flag);
 }
 
+void
+octave_serialport::set_readasyncmode (bool continuous)
+{
+  if (! continuous)
+    {
+      async.stop (rxbuf);
+      return;
+    }
+
+  if (async.is_running ())
+    return;
+
+  if (! fd_is_valid ())
+    {
+      error ("serialport: Interface must be opened first...");
+      return;
+    }
+
+  int port = fd;
+  async.start ([port] (uint8_t *buf, unsigned int len, int ms)
+    {
+      return async_serial_read (port, buf, len, ms);
+    });
+}
+
+int
+octave_serialport::wait_fd (bool &pending)
+{
+  if (async.is_running ())
+    {
+      int wfd = async.wait_fd ();
+      pending = rxbuf.size () > 0 || async.available () > 0 || async.has_failed ();
+      return wfd;
+    }
+
+  pending = rxbuf.size () > 0;
+  return fd;
+}
+
 int
 octave_serialport::sendbreak (unsigned short ms)
 {
@@ -792,6 +929,9 @@ octave_serialport::fd_is_valid (void) const
 void
 octave_serialport::close (void)
 {
+  // the reader must finish before the port is closed
+  async.stop ();
+
   if (fd_is_valid ())
     {
       ::close (fd);
@@ -807,7 +947,7 @@ octave_serialport::get_numbytesavailable (void) const
     {
       ioctl (fd, FIONREAD, &available);
     }
-  return available;
+  return available + rxbuf.size () + async.available ();
 }
 
 #endif
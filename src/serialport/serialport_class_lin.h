@@ -27,6 +27,8 @@ public:
 
   int write(const std::string& /* buffer */);
   int write(uint8_t* /* buffer */, unsigned int /* buffer size */);
+  // the parts are written one after the other, without copying them
+  int write_parts(const octave_write_part* /* parts */, int /* count */);
 
   int read(uint8_t* /* buffer */, unsigned int /* buffer size */);
 
@@ -35,6 +37,9 @@ public:
 
   int flush(unsigned short /* stream select */);
 
+  void set_readasyncmode(bool /* continuous */);
+  int wait_fd(bool & /* pending */);
+
   int sendbreak(unsigned short /* ms */);
 
   int set_timeout(double /* timeout */);
@@ -150,7 +150,8 @@ octave_serialport::read(uint8_t *buf, unsigned int len)
       return 0;
     }
 
-  size_t bytes_read = 0;
+  // data left over from readline is returned first
+  size_t bytes_read = rxbuf.take (buf, len);
   ssize_t read_retval = -1;
 
   double maxwait = timeout;
@@ -223,6 +224,31 @@ octave_serialport::write (uint8_t *buf, unsigned int len)
   return wrote_ret;
 }
 
+int
+octave_serialport::write_parts (const octave_write_part *parts, int nparts)
+{
+  if (! fd_is_valid ())
+    {
+      error("serialport: Interface must be opened first...");
+      return -1;
+    }
+
+  // a serial port is a stream, so the parts go out as they would in one
+  // write
+  int total = 0;
+  for (int i = 0; i < nparts; i++)
+    {
+      DWORD wrote;
+      if (WriteFile (fd, parts[i].data, parts[i].len, &wrote, NULL) != TRUE)
+        return total > 0 ? total : -1;
+      total += wrote;
+      byteswritten += wrote;
+      if (wrote < parts[i].len)
+        break;
+    }
+  return total;
+}
+
 int
 octave_serialport::set_timeout (double newtimeout)
 {
@@ -422,12 +448,33 @@ octave_serialport::flush (unsigned short queue_selector)
       return false;
     }
 
+  if (queue_selector != 0)
+    {
+      rxbuf.clear ();
+      async.clear ();
+    }
+
   if (PurgeComm (fd,flag) == FALSE)
     return -1;
   else
     return true;
 }
 
+void
+octave_serialport::set_readasyncmode (bool continuous)
+{
+  if (continuous)
+    error ("serialport: ReadAsyncMode 'continuous' is not supported on this platform");
+}
+
+int
+octave_serialport::wait_fd (bool &pending)
+{
+  // the handle can not be polled, so instrwait checks it periodically
+  pending = fd_is_valid () && get_numbytesavailable () > 0;
+  return -1;
+}
+
 int
 octave_serialport::sendbreak (unsigned short ms)
 {
@@ -664,6 +711,6 @@ octave_serialport::get_numbytesavailable (void) const
       if (ClearCommError (fd, &err, &stats))
         available = stats.cbInQue;
     }
-  return available;
+  return available + rxbuf.size ();
 }
 #endif
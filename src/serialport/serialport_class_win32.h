@@ -30,6 +30,8 @@ public:
 
   int write(const std::string& /* buffer */);
   int write(uint8_t* /* buffer */, unsigned int /* buffer size */);
+  // the parts are written one after the other, without copying them
+  int write_parts(const octave_write_part* /* parts */, int /* count */);
 
   int read(uint8_t* /* buffer */, unsigned int /* buffer size */);
 
@@ -38,6 +40,9 @@ public:
 
   int flush(unsigned short /* stream select */);
 
+  void set_readasyncmode(bool /* continuous */);
+  int wait_fd(bool & /* pending */);
+
   int sendbreak(unsigned short /* breaktime */);
 
   int set_timeout(double /* timeout */);
@@ -22,8 +22,95 @@
 
 #ifdef BUILD_SPI
 #  include "spi_class.h"
-#endif
 
+static octave_value_list
+spi_status (octave_spi *spi, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (spi->get_status ());
+}
+
+static octave_value_list
+spi_name (octave_spi *spi, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  if (args.length () > 0)
+    return octave_value (spi->set_name (args(0).string_value ()));
+
+  return octave_value (spi->get_name ());
+}
+
+static octave_value_list
+spi_port (octave_spi *spi, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (spi->get_port ());
+}
+
+static octave_value_list
+spi_bitrate (octave_spi *spi, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  if (args.length () > 0)
+    return octave_value (spi->set_bitrate (args(0).int_value ()));
+
+  return octave_value (spi->get_bitrate ());
+}
+
+static octave_value_list
+spi_clockpolarity (octave_spi *spi, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  if (args.length () > 0)
+    return octave_value (spi->set_clockpolarity (args(0).string_value ()));
+
+  return octave_value (spi->get_clockpolarity ());
+}
+
+static octave_value_list
+spi_clockphase (octave_spi *spi, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  if (args.length () > 0)
+    return octave_value (spi->set_clockphase (args(0).string_value ()));
+
+  return octave_value (spi->get_clockphase ());
+}
+
+static const octave_property<octave_spi> spi_property_list[] =
+{
+  {"status", spi_status, true},
+  {"name", spi_name, true},
+  {"port", spi_port, true},
+  {"bitrate", spi_bitrate, true},
+  {"clockpolarity", spi_clockpolarity, true},
+  {"clockphase", spi_clockphase, true},
+  {NULL, NULL, false}
+};
+
+const octave_property_table<octave_spi> &
+octave_spi::properties (void)
+{
+  static const octave_property_table<octave_spi> table (spi_property_list);
+  return table;
+}
+#endif
 
 // PKG_ADD: autoload ("__spi_properties__", "spi.oct");
 DEFUN_DLD (__spi_properties__, args, nargout,
@@ -41,43 +128,11 @@ Undocumented internal function.\n\
   const octave_base_value& rep = args(0).get_rep ();
   octave_spi* spi = &((octave_spi &)rep);
     
-  std::string property = args(1).string_value ();
-
-  if (args.length () == 2) // get
-    {
-      if (property == "name")
-        return octave_value (spi->get_name ());
-      else if (property == "bitrate")
-        return octave_value (spi->get_bitrate ());
-      else if (property == "clockpolarity")
-        return octave_value (spi->get_clockpolarity ());
-      else if (property == "clockphase")
-        return octave_value (spi->get_clockphase ());
-      else if (property == "status")
-        return octave_value (spi->get_status ());
-      else if (property == "port")
-        return octave_value (spi->get_port ());
-      else
-        (*current_liboctave_error_handler) ("invalid property name");
-    }
-  else // set
-    {
-      if (property == "name")
-        return octave_value (spi->set_name (args(2).string_value ()));
-      else if (property == "status")
-        (*current_liboctave_error_handler) ("can not set this property");
-      else if (property == "bitrate")
-        return octave_value (spi->set_bitrate (args(2).int_value ()));
-      else if (property == "clockpolarity")
-        return octave_value (spi->set_clockpolarity (args(2).string_value ()));
-      else if (property == "clockphase")
-        return octave_value (spi->set_clockphase (args(2).string_value ()));
-      else if (property == "port")
-        (*current_liboctave_error_handler) ("can not set this property");
-      else
-        (*current_liboctave_error_handler) ("invalid property name");
-    }
+  const octave_property<octave_spi> *prop = octave_spi::properties ().find_exact (args(1).string_value ());
+  if (! prop)
+    (*current_liboctave_error_handler) ("invalid property name");
 
+  return prop->handler (spi, args.slice (2, args.length ()-2), nargout);
 #else
     /* never reached in normal operation */
   (*current_liboctave_error_handler) ("Your system doesn't support the SPI interface");
@@ -37,7 +37,6 @@
 DEFINE_OV_TYPEID_FUNCTIONS_AND_DATA (octave_spi, "octave_spi", "octave_spi");
 
 octave_spi::octave_spi (void)
-  : fieldnames(6)
 {
   static bool type_registered = false;
 
@@ -50,13 +49,6 @@ octave_spi::octave_spi (void)
   fd = -1;
   mode = 0;
   bitrate = 250000;
-
-  fieldnames[0] = "status";
-  fieldnames[1] = "name";
-  fieldnames[2] = "port";
-  fieldnames[3] = "bitrate";
-  fieldnames[4] = "clockpolarity";
-  fieldnames[5] = "clockphase";
 }
 
 octave_spi::~octave_spi (void)
@@ -381,12 +373,14 @@ octave_spi::subsref (const std::string& type, const std::list<octave_value_list>
       break;
     case '.':
       {
-        octave_value_list ovl;
-        // inc ref count as assign this to octave_value
-        OV_COUNT++; 
-        ovl (0) = octave_value (this);
-        ovl (1) = (idx.front ()) (0);
-        retval = OCTAVE__FEVAL (std::string ("__spi_properties__"), ovl, 1);
+        const octave_property<octave_spi> *prop = properties ().find_exact ((idx.front ()) (0).string_value ());
+        if (! prop)
+          {
+            error ("invalid property name");
+            return retval;
+          }
+
+        retval = prop->handler (this, octave_value_list (), 1);
       }
       break;
     }
@@ -410,13 +404,14 @@ octave_spi::subsasgn (const std::string& type, const std::list<octave_value_list
     case '.':
       if (type.length () == 1)
         {
-          octave_value_list ovl;
-          // inc ref count as assign this to octave_value
-          OV_COUNT++; 
-          ovl (0) = octave_value (this);
-          ovl (1) = (idx.front ()) (0);
-          ovl (2) = rhs;
-          OCTAVE__FEVAL (std::string ("__spi_properties__"), ovl, 0);
+          const octave_property<octave_spi> *prop = properties ().find_exact ((idx.front ()) (0).string_value ());
+          if (! prop)
+            {
+              error ("invalid property name");
+              return retval;
+            }
+
+          prop->handler (this, octave_value_list (rhs), 0);
  
           OV_COUNT++;
           retval = octave_value (this);
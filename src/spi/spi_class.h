@@ -24,6 +24,8 @@
 #  include "../config.h"
 #endif
 
+#include "../common/property_table.h"
+
 #include <linux/spi/spidev.h>
 
 class octave_spi : public OCTAVE_BASE_CLASS
@@ -74,7 +76,7 @@ public:
   void print_raw (std::ostream& os, bool pr_as_read_syntax) const;
 
   // required to use subsasn
-  string_vector map_keys (void) const { return fieldnames; }
+  string_vector map_keys (void) const { return properties ().fieldnames (); }
   dim_vector dims (void) const { static dim_vector dv(1, 1); return dv; }
 
   // Properties
@@ -98,6 +100,8 @@ public:
   }
 
   octave_value subsasgn (const std::string& type, const std::list<octave_value_list>& idx, const octave_value& rhs);
+
+  static const octave_property_table<octave_spi> & properties (void);
 private:
   int fd;
   std::string name;
@@ -105,7 +109,6 @@ private:
   unsigned int bitrate;
   int mode;
 
-  string_vector fieldnames;
 
   DECLARE_OV_TYPEID_FUNCTIONS_AND_DATA
 };
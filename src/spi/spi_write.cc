@@ -23,6 +23,7 @@
 #include <errno.h>
 
 #include "spi_class.h"
+#include "../common/byte_view.h"
 #endif
 
 // PKG_ADD: autoload ("spi_write", "spi.oct");
@@ -56,28 +57,16 @@ Upon successful completion, spi_write() shall return the number of bytes written
   const octave_base_value& rep = args (0).get_rep ();
   spi = &((octave_spi &)rep);
 
-  if (args (1).is_uint8_type ()) // uint8_t
-    {
-      NDArray data = args (1).array_value ();
-      OCTAVE_LOCAL_BUFFER (uint8_t, buf, (data.numel ()));
-
-      if (buf == NULL)
-        {
-          error ("spi_write: cannot allocate requested memory: %s", strerror (errno));
-          return octave_value (-1);  
-        }
-
-      for (int i = 0; i < data.numel (); i++)
-        buf[i] =  static_cast<uint8_t>(data (i));
+  octave_byte_view data (args (1), true);
 
-      retval = spi->write (buf, data.numel());
-    }
-  else
+  if (! data.is_valid ())
     {
       error ("spi_write: expected uint8 data");
       return octave_value (-1);
     }
 
+  retval = spi->write (data.data (), data.length ());
+
   return octave_value (retval);
 #endif
 }
@@ -25,8 +25,130 @@
 
 #ifdef BUILD_TCP
 #  include "tcp_class.h"
-#endif
 
+static octave_value_list
+tcp_type (octave_tcp *tcp, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (tcp->get_type ());
+}
+
+static octave_value_list
+tcp_name (octave_tcp *tcp, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  if (args.length () > 0)
+    return octave_value (tcp->set_name (args(0).string_value ()));
+
+  return octave_value (tcp->get_name ());
+}
+
+static octave_value_list
+tcp_remoteport (octave_tcp *tcp, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (tcp->get_remote_port ());
+}
+
+static octave_value_list
+tcp_remotehost (octave_tcp *tcp, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (tcp->get_remote_addr ());
+}
+
+static octave_value_list
+tcp_localport (octave_tcp *tcp, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (tcp->get_local_port ());
+}
+
+static octave_value_list
+tcp_status (octave_tcp *tcp, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (tcp->get_status ());
+}
+
+static octave_value_list
+tcp_timeout (octave_tcp *tcp, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  if (args.length () > 0)
+    return octave_value (tcp->set_timeout (args(0).double_value ()));
+
+  return octave_value (tcp->get_timeout ());
+}
+
+static octave_value_list
+tcp_bytesavailable (octave_tcp *tcp, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (tcp->get_bytesavailable ());
+}
+
+static octave_value_list
+tcp_flush (octave_tcp *tcp, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () == 0)
+    (*current_liboctave_error_handler) ("invalid property name");
+
+  return octave_value (tcp->flush (args(0).int_value ()));
+}
+
+static const octave_property<octave_tcp> tcp_property_list[] =
+{
+  {"type", tcp_type, true},
+  {"name", tcp_name, true},
+  {"remoteport", tcp_remoteport, true},
+  {"remotehost", tcp_remotehost, true},
+  {"localport", tcp_localport, true},
+  {"status", tcp_status, true},
+  {"timeout", tcp_timeout, true},
+  {"bytesavailable", tcp_bytesavailable, true},
+  // internals
+  {"flush", tcp_flush, false},
+  {NULL, NULL, false}
+};
+
+const octave_property_table<octave_tcp> &
+octave_tcp::properties (void)
+{
+  static const octave_property_table<octave_tcp> table (tcp_property_list);
+  return table;
+}
+#endif
 
 // PKG_ADD: autoload ("__tcp_properties__", "tcp.oct");
 DEFUN_DLD (__tcp_properties__, args, nargout,
@@ -44,51 +166,11 @@ Undocumented internal function.\n\
   const octave_base_value& rep = args(0).get_rep ();
   octave_tcp* tcp = &((octave_tcp &)rep);
     
-  std::string property = args(1).string_value ();
-
-  if (args.length () == 2) // get
-    {
-      if (property == "name")
-        return octave_value (tcp->get_name ());
-      else if (property == "type")
-        return octave_value (tcp->get_type ());
-      else if (property == "remoteport")
-        return octave_value (tcp->get_remote_port ());
-      else if (property == "remotehost")
-        return octave_value (tcp->get_remote_addr ());
-      else if (property == "localport")
-        return octave_value (tcp->get_local_port ());
-      else if (property == "status")
-        return octave_value (tcp->get_status ());
-      else if (property == "timeout")
-        return octave_value (tcp->get_timeout ());
-      else if (property == "bytesavailable")
-        return octave_value (tcp->get_bytesavailable ());
-      else
-        (*current_liboctave_error_handler) ("invalid property name");
-    }
-  else // set
-    {
-      if (property == "name")
-        return octave_value (tcp->set_name (args(2).string_value ()));
-      else if (property == "type")
-        (*current_liboctave_error_handler) ("can not set this property");
-      else if (property == "remoteport")
-        (*current_liboctave_error_handler) ("can not set this property");
-      else if (property == "remotehost")
-        (*current_liboctave_error_handler) ("can not set this property");
-      else if (property == "localport")
-        (*current_liboctave_error_handler) ("can not set this property");
-      else if (property == "status")
-        (*current_liboctave_error_handler) ("can not set this property");
-      else if (property == "timeout")
-        return octave_value (tcp->set_timeout (args(2).double_value ()));
-      else if (property == "flush")
-        return octave_value (tcp->flush (args(2).int_value ()));
-      else
-        (*current_liboctave_error_handler) ("invalid property name");
-    }
+  const octave_property<octave_tcp> *prop = octave_tcp::properties ().find_exact (args(1).string_value ());
+  if (! prop)
+    (*current_liboctave_error_handler) ("invalid property name");
 
+  return prop->handler (tcp, args.slice (2, args.length ()-2), nargout);
 #endif
     /* never reached in normal operation */
   (*current_liboctave_error_handler) ("Your system doesn't support the TCP interface");
@@ -52,23 +52,7 @@
 #endif
 
 #include "tcp_class.h"
-
-static struct timeval
-to_timeval(int ms)
-{
-  struct timeval tv;
-  if(ms <= 0)
-    {
-      tv.tv_usec = 0;
-      tv.tv_sec = 0;
-    }
-    else
-    {
-      tv.tv_usec = (ms % 1000) * 1000;
-      tv.tv_sec = ms/1000;;
-    }
-  return tv;
-}
+#include "../common/socket_wait.h"
 
 static std::string 
 to_ip_str (const sockaddr_in *in)
@@ -90,7 +74,7 @@ to_ip_str (const sockaddr_in *in)
 DEFINE_OV_TYPEID_FUNCTIONS_AND_DATA (octave_tcp, "octave_tcp", "octave_tcp");
 
 octave_tcp::octave_tcp (void)
-: fieldnames(8), fd (-1), timeout(-1), name("")
+: fd (-1), timeout(-1), name("")
 {
   static bool type_registered = false;
 
@@ -99,15 +83,6 @@ octave_tcp::octave_tcp (void)
       type_registered = true;
       register_type ();
     }
-
-  fieldnames[0] = "type";
-  fieldnames[1] = "name";
-  fieldnames[2] = "remoteport";
-  fieldnames[3] = "remotehost";
-  fieldnames[4] = "localport";
-  fieldnames[5] = "status";
-  fieldnames[6] = "timeout";
-  fieldnames[7] = "bytesavailable";
 }
 
 octave_value_list
@@ -123,12 +98,14 @@ octave_tcp::subsref (const std::string& type, const std::list<octave_value_list>
       break;
     case '.':
       {
-        octave_value_list ovl;
-        // inc ref count as assign this to octave_value
-        OV_COUNT++; 
-        ovl (0) = octave_value (this);
-        ovl (1) = (idx.front ()) (0);
-        retval = OCTAVE__FEVAL (std::string ("__tcp_properties__"), ovl, 1);
+        const octave_property<octave_tcp> *prop = properties ().find_exact ((idx.front ()) (0).string_value ());
+        if (! prop)
+          {
+            error ("invalid property name");
+            return retval;
+          }
+
+        retval = prop->handler (this, octave_value_list (), 1);
       }
       break;
     }
@@ -152,13 +129,14 @@ octave_tcp::subsasgn (const std::string& type, const std::list<octave_value_list
     case '.':
       if (type.length () == 1)
         {
-          octave_value_list ovl;
-          // inc ref count as assign this to octave_value
-          OV_COUNT++; 
-          ovl (0) = octave_value (this);
-          ovl (1) = (idx.front ()) (0);
-          ovl (2) = rhs;
-          OCTAVE__FEVAL (std::string ("__tcp_properties__"), ovl, 0);
+          const octave_property<octave_tcp> *prop = properties ().find_exact ((idx.front ()) (0).string_value ());
+          if (! prop)
+            {
+              error ("invalid property name");
+              return retval;
+            }
+
+          prop->handler (this, octave_value_list (rhs), 0);
           OV_COUNT++;
           retval = octave_value (this);
         }
@@ -274,10 +252,6 @@ octave_tcp::print_raw (std::ostream& os, bool pr_as_read_syntax) const
 int
 octave_tcp::read (uint8_t *buf, unsigned int len, double readtimeout)
 {
-  struct timeval tv;
-
-  fd_set readfds;
-
   if (get_fd () < 0)
     {
         error ("tcp_read: Interface must be opened first...");
@@ -287,55 +261,38 @@ octave_tcp::read (uint8_t *buf, unsigned int len, double readtimeout)
   size_t bytes_read = 0;
   ssize_t read_retval = -1;
 
+  // the timeout is for the whole read, not each wait for data
+  octave_deadline deadline (readtimeout);
+
   // While not interrupted in blocking mode
   while (bytes_read < len)
     {
+      int ready = octave_wait_readable (get_fd (), deadline);
+      if (ready < 0)
+        {
+          error ("tcp_read: Error while reading/poll: %d - %s\n", SOCKETERR, STRSOCKETERR);
+          break;
+        }
 
-      OCTAVE_QUIT;
-
-      tv = to_timeval((readtimeout < 0 || readtimeout > 1000) ? 1000 : (int)readtimeout);
-
-      FD_ZERO (&readfds);
-      FD_SET (get_fd (), &readfds);
+      // time out
+      if (ready == 0)
+        break;
 
-      if (::select (get_fd ()+1, &readfds, NULL, NULL, &tv) < 0)
+      read_retval = ::recv(get_fd (), reinterpret_cast<char *>((buf + bytes_read)), len - bytes_read, 0);
+      if (read_retval < 0)
         {
-          error ("tcp_read: Error while reading/select: %d - %s\n", SOCKETERR, STRSOCKETERR);
+          error ("tcp_read: Error while reading: %d - %s\n", SOCKETERR, STRSOCKETERR);
           break;
         }
-
-      if (FD_ISSET (get_fd (), &readfds))
+      else if (read_retval == 0)
         {
-          read_retval = ::recv(get_fd (), reinterpret_cast<char *>((buf + bytes_read)), len - bytes_read, 0);
-          if (read_retval < 0)
-            {
-              error ("tcp_read: Error while reading: %d - %s\n", SOCKETERR, STRSOCKETERR);
-              break;
-            } 
-          else if (read_retval == 0)
-            {
-              error ("tcp_read: Connection lost: %d - %s\n", SOCKETERR, STRSOCKETERR);
-              break;
-            }
-          else
-            {
-              bytes_read += read_retval;
-            }
-        } 
-      else 
+          error ("tcp_read: Connection lost: %d - %s\n", SOCKETERR, STRSOCKETERR);
+          break;
+        }
+      else
         {
-          // time out
-          if (readtimeout >= 0)
-            {
-              // real timeout
-              if (readtimeout <= 1000)
-                break;
-              // timed out 1 sec of an actual timeout
-              else
-                readtimeout -= 1000;
-            }
+          bytes_read += read_retval;
         }
-
     }
 
   return bytes_read;
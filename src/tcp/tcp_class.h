@@ -33,6 +33,8 @@
 #  include "../config.h"
 #endif
 
+#include "../common/property_table.h"
+
 class octave_tcp : public OCTAVE_BASE_CLASS
 {
 public:
@@ -73,7 +75,7 @@ public:
   bool isobject (void) const { return true; }
 
   // required to use subsasn
-  string_vector map_keys (void) const { return fieldnames; }
+  string_vector map_keys (void) const { return properties ().fieldnames (); }
   dim_vector dims (void) const { static dim_vector dv(1, 1); return dv; }
 
   octave_base_value * unique_clone (void) { OV_COUNT++; return this; }
@@ -90,6 +92,8 @@ public:
 
   octave_value subsasgn (const std::string& type, const std::list<octave_value_list>& idx, const octave_value& rhs);
 
+  static const octave_property_table<octave_tcp> & properties (void);
+
   int get_bytesavailable (void) const;
 
   std::string get_name (void) const { return name; }
@@ -107,7 +111,6 @@ public:
 
   int get_local_port (void) const;
 private:
-  string_vector fieldnames;
 
   int fd;
   double timeout;
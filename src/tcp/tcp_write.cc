@@ -23,6 +23,7 @@
 
 #ifdef BUILD_TCP
 #include "tcp_class.h"
+#include "../common/byte_view.h"
 #endif
 
 // PKG_ADD: autoload ("tcp_write", "tcp.oct");
@@ -56,34 +57,16 @@ Upon successful completion, tcp_write() shall return the number of bytes written
   const octave_base_value& rep = args (0).get_rep ();
   tcp = &((octave_tcp &)rep);
 
-  if (args (1).is_string ()) // String
-    {
-      retval = tcp->write (args (1).string_value ());
-    }
-  else if (args (1).is_uint8_type ())
-    {
-      NDArray data = args (1).array_value ();
-      OCTAVE_LOCAL_BUFFER (uint8_t, buf, (data.numel ()));
-
-      // memcpy?
-      if (buf == NULL)
-        {
-          error ("tcp_write: cannot allocate requested memory");
-          return octave_value (-1);
-        }
+  octave_byte_view data (args (1), true);
 
-      for (int i = 0; i < data.numel (); i++)
-        buf[i] = static_cast<uint8_t>(data(i));
-
-      retval = tcp->write (buf, data.numel ());
-
-    }
-  else
+  if (! data.is_valid ())
     {
       print_usage ();
       return octave_value (-1);
     }
 
+  retval = tcp->write (data.data (), data.length ());
+
   return octave_value (retval);
 #endif
 }
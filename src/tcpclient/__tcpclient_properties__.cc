@@ -22,7 +22,7 @@
 
 #ifdef BUILD_TCP
 #  include "tcpclient_class.h"
-#endif
+#  include "../common/async_properties.h"
 
 static octave_value_list get_terminator (octave_tcpclient* tcp)
 {
@@ -73,6 +73,208 @@ static octave_value set_terminator(octave_tcpclient* tcp, const octave_value_lis
   return octave_value();
 }
 
+static octave_value_list
+tcpclient_name (octave_tcpclient *tcpclient, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  if (args.length () > 0)
+    return octave_value (tcpclient->set_name (args(0).string_value ()));
+
+  return octave_value (tcpclient->get_name ());
+}
+
+static octave_value_list
+tcpclient_tag (octave_tcpclient *tcpclient, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  if (args.length () > 0)
+    {
+      tcpclient->set_tag (args(0).string_value ());
+      return octave_value ();
+    }
+
+  return octave_value (tcpclient->get_tag ());
+}
+
+static octave_value_list
+tcpclient_type (octave_tcpclient *tcpclient, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (tcpclient->get_type ());
+}
+
+static octave_value_list
+tcpclient_port (octave_tcpclient *tcpclient, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (tcpclient->get_port ());
+}
+
+static octave_value_list
+tcpclient_address (octave_tcpclient *tcpclient, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (tcpclient->get_address ());
+}
+
+static octave_value_list
+tcpclient_status (octave_tcpclient *tcpclient, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (tcpclient->get_status ());
+}
+
+static octave_value_list
+tcpclient_timeout (octave_tcpclient *tcpclient, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  if (args.length () > 0)
+    return octave_value (tcpclient->set_timeout (args(0).double_value ()));
+
+  return octave_value (tcpclient->get_timeout ());
+}
+
+static octave_value_list
+tcpclient_numbytesavailable (octave_tcpclient *tcpclient, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (tcpclient->get_numbytesavailable ());
+}
+
+static octave_value_list
+tcpclient_numbyteswritten (octave_tcpclient *tcpclient, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (tcpclient->get_numbyteswritten ());
+}
+
+static octave_value_list
+tcpclient_byteorder (octave_tcpclient *tcpclient, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  if (args.length () > 0)
+    return octave_value (tcpclient->set_byteorder (args(0).string_value ()));
+
+  return octave_value (tcpclient->get_byteorder ());
+}
+
+static octave_value_list
+tcpclient_userdata (octave_tcpclient *tcpclient, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  if (args.length () > 0)
+    {
+      tcpclient->set_userdata (args(0));
+      return octave_value ();
+    }
+
+  return octave_value (tcpclient->get_userdata ());
+}
+
+static octave_value_list
+tcpclient_terminator (octave_tcpclient *tcpclient, const octave_value_list& args, int)
+{
+  if (args.length () > 2)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  if (args.length () > 0)
+    return set_terminator (tcpclient, args);
+
+  return get_terminator (tcpclient);
+}
+
+static octave_value_list
+tcpclient_enabletransferdelay (octave_tcpclient *tcpclient, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (tcpclient->get_enabletransferdelay ());
+}
+
+static octave_value_list
+tcpclient_flush (octave_tcpclient *tcpclient, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () == 0)
+    (*current_liboctave_error_handler) ("invalid property name");
+
+  return octave_value (tcpclient->flush (args(0).int_value ()));
+}
+
+static const octave_property<octave_tcpclient> tcpclient_property_list[] =
+{
+  {"Type", tcpclient_type, true},
+  {"Name", tcpclient_name, true},
+  {"Port", tcpclient_port, true},
+  {"Address", tcpclient_address, true},
+  {"Status", tcpclient_status, true},
+  {"Timeout", tcpclient_timeout, true},
+  {"NumBytesAvailable", tcpclient_numbytesavailable, true},
+  {"NumBytesWritten", tcpclient_numbyteswritten, true},
+  {"ByteOrder", tcpclient_byteorder, true},
+  {"UserData", tcpclient_userdata, true},
+  {"Terminator", tcpclient_terminator, true},
+  {"EnableTransferDelay", tcpclient_enabletransferdelay, true},
+  {"Tag", tcpclient_tag, true},
+  {"ReadAsyncMode", octave_async_readasyncmode<octave_tcpclient>, true},
+  {"BytesAvailableFcn", octave_async_bytesavailablefcn<octave_tcpclient>, true},
+  {"BytesAvailableFcnCount", octave_async_bytesavailablefcncount<octave_tcpclient>, true},
+  {"BytesAvailableFcnMode", octave_async_bytesavailablefcnmode<octave_tcpclient>, true},
+  {"InputBufferSize", octave_async_inputbuffersize<octave_tcpclient>, true},
+  {"NumBytesDropped", octave_async_numbytesdropped<octave_tcpclient>, true},
+  // internals
+  {"flush", tcpclient_flush, false},
+  {"configurecallback", octave_async_configurecallback<octave_tcpclient>, false},
+  {"waitinfo", octave_async_waitinfo<octave_tcpclient>, false},
+  {NULL, NULL, false}
+};
+
+const octave_property_table<octave_tcpclient> &
+octave_tcpclient::properties (void)
+{
+  static const octave_property_table<octave_tcpclient> table (tcpclient_property_list);
+  return table;
+}
+#endif
+
 // PKG_ADD: autoload ("__tcpclient_properties__", "tcpclient.oct");
 DEFUN_DLD (__tcpclient_properties__, args, nargout,
 "-*- texinfo -*-\n\
@@ -88,78 +290,12 @@ Undocumented internal function.\n\
     
   const octave_base_value& rep = args(0).get_rep ();
   octave_tcpclient* tcpclient = &((octave_tcpclient &)rep);
-    
-  std::string property = args(1).string_value ();
-  std::transform (property.begin (), property.end (), property.begin (), ::tolower);
-
-  int maxinputs = 3;
-  if (property == "terminator")
-    maxinputs = 4;
 
-  if (args.length () > maxinputs)
-    (*current_liboctave_error_handler) ("wrong number of arguments");
-
-  if (args.length () == 2) // get
-    {
-      if (property == "name")
-        return octave_value (tcpclient->get_name ());
-      else if (property == "tag")
-        return octave_value (tcpclient->get_tag ());
-      else if (property == "type")
-        return octave_value (tcpclient->get_type ());
-      else if (property == "port")
-        return octave_value (tcpclient->get_port ());
-      else if (property == "address")
-        return octave_value (tcpclient->get_address ());
-      else if (property == "status")
-        return octave_value (tcpclient->get_status ());
-      else if (property == "timeout")
-        return octave_value (tcpclient->get_timeout ());
-      else if (property == "numbytesavailable")
-        return octave_value (tcpclient->get_numbytesavailable ());
-      else if (property == "numbyteswritten")
-        return octave_value (tcpclient->get_numbyteswritten ());
-      else if (property == "byteorder")
-        return octave_value (tcpclient->get_byteorder ());
-      else if (property == "userdata")
-        return octave_value (tcpclient->get_userdata ());
-      else if (property == "terminator")
-        return get_terminator (tcpclient);
-      else if (property == "enabletransferdelay")
-        return octave_value(tcpclient->get_enabletransferdelay ());
-      else
-        (*current_liboctave_error_handler) ("invalid property name");
-    }
-  else // set
-    {
-      if (property == "name")
-        return octave_value (tcpclient->set_name (args(2).string_value ()));
-      else if (property == "tag")
-       { tcpclient->set_tag (args(2).string_value ()); return octave_value (); }
-      else if (property == "type")
-        (*current_liboctave_error_handler) ("can not set this property");
-      else if (property == "port")
-        (*current_liboctave_error_handler) ("can not set this property");
-      else if (property == "address")
-        (*current_liboctave_error_handler) ("can not set this property");
-      else if (property == "status")
-        (*current_liboctave_error_handler) ("can not set this property");
-      else if (property == "timeout")
-        return octave_value (tcpclient->set_timeout (args(2).double_value ()));
-      else if (property == "userdata")
-        { tcpclient->set_userdata (args(2)); return octave_value (); }
-      else if (property == "byteorder")
-        return octave_value (tcpclient->set_byteorder (args(2).string_value ()));
-      else if (property == "flush")
-        return octave_value (tcpclient->flush (args(2).int_value ()));
-      else if (property == "terminator")
-        return set_terminator (tcpclient, args.slice (2, args.length ()-2));
-      else if (property == "enabletransferdelay")
-        (*current_liboctave_error_handler) ("can not set this property");
-      else
-        (*current_liboctave_error_handler) ("invalid property name");
-    }
+  const octave_property<octave_tcpclient> *prop = octave_tcpclient::properties ().find (args(1).string_value ());
+  if (! prop)
+    (*current_liboctave_error_handler) ("invalid property name");
 
+  return prop->handler (tcpclient, args.slice (2, args.length ()-2), nargout);
 #endif
     /* never reached in normal operation */
   (*current_liboctave_error_handler) ("Your system doesn't support the TCP interface");
@@ -25,6 +25,7 @@
 #include <errno.h>
 
 #include "tcpclient_class.h"
+#include "../common/typed_data.h"
 
 #endif
 
@@ -32,13 +33,15 @@
 DEFUN_DLD (__tcpclient_read__, args, nargout,
         "-*- texinfo -*-\n\
 @deftypefn {} {[@var{data}, @var{count}] = } __tcpclient_read__ (@var{tcpclient}, @var{n}, @var{timeout})\n \
+@deftypefnx {} {[@var{data}, @var{count}] = } __tcpclient_read__ (@var{tcpclient}, @var{n}, @var{timeout}, @var{datatype})\n \
 \n\
 Private function t read from tcpclient interface.\n \
 \n\
 @subsubheading Inputs\n \
 @var{tcpclient} - instance of @var{octave_tcpclient} class.@* \
 @var{n} - number of bytes to attempt to read of type Integer@* \
-@var{timeout} - timeout in ms if different from default of type Integer\n \
+@var{timeout} - timeout in ms if different from default of type Integer@* \
+@var{datatype} - precision to read as, in which case @var{n} is the number of values to read, or -1 for all available values, and @var{count} is the number of values read\n \
 \n\
 @subsubheading Outputs\n \
 @var{count} - number of bytes successfully read as an Integer@*\n \
@@ -50,7 +53,7 @@ Private function t read from tcpclient interface.\n \
   return octave_value ();
 #else
 
-  if (args.length() < 2 || args.length () > 3 || args (0).type_id () != octave_tcpclient::static_type_id ())
+  if (args.length() < 2 || args.length () > 4 || args (0).type_id () != octave_tcpclient::static_type_id ())
     {
       print_usage ();
       return octave_value (-1);
@@ -75,34 +78,64 @@ Private function t read from tcpclient interface.\n \
 
   buffer_len = args (1).int_value ();
 
-  OCTAVE_LOCAL_BUFFER (uint8_t, buffer, (buffer_len + 1));
-
-  if (buffer == NULL)
-    {
-      error ("tcpclient_read: cannot allocate requested memory: %s\n", strerror(errno));
-      return octave_value (-1);
-    }
-
   octave_tcpclient* tcpclient = NULL;
 
   const octave_base_value& rep = args (0).get_rep ();
   tcpclient = &((octave_tcpclient &)rep);
 
+  // run any BytesAvailableFcn callbacks that are due
+  tcpclient->dispatch_callbacks ();
+
   double timeout = tcpclient->get_timeout () * 1000;
-  if (args.length () == 3)
+  if (args.length () > 2)
     {
       timeout = args (2).double_value ();
     }
 
-  // Read data
-  int bytes_read = tcpclient->read (buffer, buffer_len, timeout);
+  // Read values of the requested type directly into the result array
+  if (args.length () > 3)
+    {
+      octave_data_type type;
+
+      if (! args (3).is_string ())
+        {
+          print_usage ();
+          return octave_value (-1);
+        }
+      if (! octave_data_type_lookup (args (3).string_value (), type))
+        {
+          error ("__tcpclient_read__: precision not supported");
+          return octave_value (-1);
+        }
+
+      int count = args (1).int_value ();
+      if (count < 0)
+        count = tcpclient->get_numbytesavailable () / type.size;
+
+      bool swap = octave_byteorder_needs_swap (tcpclient->get_byteorder ());
+
+      octave_value data = octave_read_typed (type, count, swap,
+        [tcpclient, timeout] (uint8_t *buf, unsigned int len)
+        {
+          return tcpclient->read (buf, len, timeout);
+        });
+
+      octave_value_list return_list;
+      return_list(0) = data;
+      return_list(1) = data.numel ();
+
+      return return_list;
+    }
+
+  // Read data directly into the result array
+  uint8NDArray data (dim_vector (1, buffer_len));
+
+  int bytes_read = tcpclient->read (reinterpret_cast<uint8_t *> (data.fortran_vec ()), buffer_len, timeout);
 
   // Convert data to octave type variables
   octave_value_list return_list;
-  uint8NDArray data (dim_vector (1, bytes_read) );
-
-  for (int i = 0; i < bytes_read; i++)
-    data(i) = buffer[i];
+  // trim to the bytes actually read
+  data.resize (dim_vector (1, bytes_read));
 
   return_list(0) = data;
   return_list(1) = bytes_read;
@@ -21,18 +21,22 @@
 
 #ifdef BUILD_TCP
 #include "tcpclient_class.h"
+#include "../common/byte_view.h"
+#include "../common/typed_data.h"
 #endif
 
 // PKG_ADD: autoload ("__tcpclient_write__", "tcpclient.oct");
 DEFUN_DLD (__tcpclient_write__, args, nargout,
         "-*- texinfo -*-\n\
 @deftypefn {} {@var{n} = } __tcpclient_write__ (@var{tcpclient}, @var{data})\n \
+@deftypefnx {} {@var{n} = } __tcpclient_write__ (@var{tcpclient}, @var{data}, @var{datatype})\n \
 \n\
 Private function to write data to a tcpclient interface.\n \
 \n\
 @subsubheading Inputs\n \
 @var{tcpclient} - instance of @var{octave_tcpclient} class.@* \
-@var{data} - data to be written to the tcpclient interface. Can be either of String or uint8 type.\n \
+@var{data} - data to be written to the tcpclient interface. Can be a String, or an integer or floating point array which is written as its raw bytes.@*\
+@var{datatype} - precision to convert @var{data} to before writing, in the byte order of the object.\n \
 \n\
 @subsubheading Outputs\n \
 Upon successful completion, __tcpclient_write__() shall return the number of bytes written as the result @var{n}.\n \
@@ -42,7 +46,7 @@ Upon successful completion, __tcpclient_write__() shall return the number of byt
   error("tcpclient: Your system doesn't support the TCP interface");
   return octave_value ();
 #else
-  if (args.length () != 2 || args (0).type_id () != octave_tcpclient::static_type_id ())
+  if (args.length () < 2 || args.length () > 3 || args (0).type_id () != octave_tcpclient::static_type_id ())
     {
       print_usage ();
       return octave_value (-1);
@@ -54,34 +58,42 @@ Upon successful completion, __tcpclient_write__() shall return the number of byt
   const octave_base_value& rep = args (0).get_rep ();
   tcpclient = &((octave_tcpclient &)rep);
 
-  if (args (1).is_string ()) // String
+  if (args.length () > 2)
     {
-      retval = tcpclient->write (args (1).string_value ());
-    }
-  else if (args (1).is_uint8_type ())
-    {
-      NDArray data = args (1).array_value ();
-      OCTAVE_LOCAL_BUFFER (uint8_t, buf, (data.numel ()));
+      octave_data_type type;
 
-      // memcpy?
-      if (buf == NULL)
+      if (! args (2).is_string ())
+        {
+          print_usage ();
+          return octave_value (-1);
+        }
+      if (! octave_data_type_lookup (args (2).string_value (), type))
         {
-          error ("tcpclient_write: cannot allocate requested memory");
+          error ("__tcpclient_write__: precision not supported");
           return octave_value (-1);
         }
 
-      for (int i = 0; i < data.numel (); i++)
-        buf[i] = static_cast<uint8_t>(data(i));
+      bool swap = octave_byteorder_needs_swap (tcpclient->get_byteorder ());
 
-      retval = tcpclient->write (buf, data.numel ());
+      retval = octave_write_typed (args (1), type, swap,
+        [tcpclient] (uint8_t *buf, unsigned int len)
+        {
+          return tcpclient->write (buf, len);
+        });
 
+      return octave_value (retval);
     }
-  else
+
+  octave_byte_view data (args (1));
+
+  if (! data.is_valid ())
     {
       print_usage ();
       return octave_value (-1);
     }
 
+  retval = tcpclient->write (data.data (), data.length ());
+
   return octave_value (retval);
 #endif
 }
@@ -0,0 +1,98 @@
+// Copyright (C) 2026   John Donoghue   <john.donoghue@ieee.org>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+
+#include <octave/oct.h>
+
+#ifdef HAVE_CONFIG_H
+#include "../config.h"
+#endif
+
+#ifdef BUILD_TCP
+#include "tcpclient_class.h"
+#include "../common/binblock.h"
+#endif
+
+// PKG_ADD: autoload ("__tcpclient_writebinblock__", "tcpclient.oct");
+DEFUN_DLD (__tcpclient_writebinblock__, args, nargout,
+        "-*- texinfo -*-\n\
+@deftypefn {} {@var{n} = } __tcpclient_writebinblock__ (@var{tcpclient}, @var{data}, @var{datatype})\n \
+\n\
+Private function to write data as a IEEE 488.2 binblock to a tcpclient interface.\n \
+\n\
+The block header, data and terminator are sent with a single gathered write,\n \
+without copying the data.\n \
+\n\
+@subsubheading Inputs\n \
+@var{tcpclient} - instance of @var{octave_tcpclient} class.@* \
+@var{data} - data to write.@* \
+@var{datatype} - precision to convert @var{data} to, in the byte order of the object.\n \
+\n\
+@subsubheading Outputs\n \
+@var{n} - number of bytes written, including the header and terminator.\n \
+@end deftypefn")
+{
+#ifndef BUILD_TCP
+  error ("tcpclient: Your system doesn't support the TCP interface");
+  return octave_value ();
+#else
+
+  if (args.length () != 3 || args (0).type_id () != octave_tcpclient::static_type_id () || ! args (2).is_string ())
+    {
+      print_usage ();
+      return octave_value (-1);
+    }
+
+  octave_data_type type;
+
+  if (! octave_data_type_lookup (args (2).string_value (), type))
+    {
+      error ("__tcpclient_writebinblock__: datatype not supported");
+      return octave_value (-1);
+    }
+
+  octave_tcpclient* tcpclient = NULL;
+
+  const octave_base_value& rep = args (0).get_rep ();
+  tcpclient = &((octave_tcpclient &)rep);
+
+  bool swap = octave_byteorder_needs_swap (tcpclient->get_byteorder ());
+
+  int retval = octave_write_binblock_parts (args (1), type, swap,
+    [tcpclient] (const octave_write_part *parts, int nparts)
+    {
+      return tcpclient->write_parts (parts, nparts);
+    });
+
+  return octave_value (retval);
+#endif
+}
+
+#if 0
+%!error <Invalid call to __tcpclient_writebinblock__> __tcpclient_writebinblock__ ()
+
+%!error <Invalid call to __tcpclient_writebinblock__> __tcpclient_writebinblock__ (1, "hello", "uint8")
+
+%!test
+%! s = tcpserver (0);
+%! c = tcpclient ("127.0.0.1", s.ServerPort, 'Timeout', 1);
+%! st = s.Connected;
+%! assert (__tcpclient_writebinblock__ (c, "hello", "string"), 9);
+%! assert (char (read (s, 9)), "#15hello\n");
+%! c.ByteOrder = "big-endian";
+%! __tcpclient_writebinblock__ (c, [1 2], "uint16");
+%! assert (read (s, 8), uint8 ([35 49 52 0 1 0 2 10]));
+%! clear c s
+
+#endif
@@ -51,23 +51,22 @@
 #endif
 
 #include "tcpclient_class.h"
+#include "../common/socket_wait.h"
+#include "../common/binblock.h"
+#include "../common/socket_util.h"
 #include <octave/Matrix.h>
 
-static struct timeval
-to_timeval(int ms)
+// read used by the background reader thread, so must not call any octave
+// functions. Returns 0 on a timeout and -1 on an error or a closed connection.
+static int
+async_socket_read (int sock, uint8_t *buf, unsigned int len, int ms)
 {
-  struct timeval tv;
-  if(ms <= 0)
-    {
-      tv.tv_usec = 0;
-      tv.tv_sec = 0;
-    }
-  else
-    {
-      tv.tv_usec = (ms % 1000) * 1000;
-      tv.tv_sec = ms/1000;;
-    }
-  return tv;
+  int ret = octave_poll_readable (sock, ms);
+  if (ret <= 0)
+    return ret;
+
+  ret = ::recv (sock, reinterpret_cast<char *> (buf), len, 0);
+  return ret > 0 ? ret : -1;
 }
 
 static std::string 
@@ -87,28 +86,11 @@ to_ip_str (const sockaddr_in *in)
   return n.str ();
 }
 
-static bool 
-lookup_addr (const std::string &ip, sockaddr_in *in)
-{
-  in->sin_addr.s_addr = inet_addr (ip.c_str());
-
-  if (in->sin_addr.s_addr == INADDR_NONE)
-    {
-      struct hostent * host = gethostbyname (ip.c_str());
-      if (!host)
-        return false;
-
-      memcpy(&in->sin_addr, host->h_addr_list[0], host->h_length);
-    }
-
-  return true;
-}
-
 
 DEFINE_OV_TYPEID_FUNCTIONS_AND_DATA (octave_tcpclient, "octave_tcpclient", "octave_tcpclient");
 
 octave_tcpclient::octave_tcpclient (void)
-: fieldnames(13), fd (-1), timeout(-1), name("")
+: fd (-1), timeout(-1), name("")
 {
   static bool type_registered = false;
 
@@ -123,30 +105,6 @@ octave_tcpclient::octave_tcpclient (void)
   byteOrder = "little-endian";
   interminator = octave_value("lf");
   outterminator = octave_value("lf");
-
-  fieldnames[0] = "Type";
-  fieldnames[1] = "Name";
-  fieldnames[2] = "Port";
-  fieldnames[3] = "Address";
-  fieldnames[4] = "Status";
-  fieldnames[5] = "Timeout";
-  fieldnames[6] = "NumBytesAvailable";
-  fieldnames[7] = "NumBytesWritten";
-  fieldnames[8] = "ByteOrder";
-  fieldnames[9] = "UserData";
-  fieldnames[10] = "Terminator";
-  fieldnames[11] = "EnableTransferDelay";
-  fieldnames[12] = "Tag";
-}
-
-bool
-octave_tcpclient::has_property(const std::string &name) const
-{
-  for (octave_idx_type i=0; i<fieldnames.numel(); i++)
-    {
-      if (fieldnames[i] == name) return true;
-    }
-  return false;
 }
 
 octave_value_list
@@ -163,18 +121,14 @@ octave_tcpclient::subsref (const std::string& type, const std::list<octave_value
     case '.':
       {
         std::string property = (idx.front ()) (0).string_value ();
-        if (!has_property(property))
+        const octave_property<octave_tcpclient> *prop = properties ().find_field (property);
+        if (! prop)
           {
             error ("Unknown property '%s'", property.c_str());
             return retval;
           }
 
-        octave_value_list ovl;
-        // inc ref count as assign this to octave_value
-        OV_COUNT++; 
-        ovl (0) = octave_value (this);
-        ovl (1) = (idx.front ()) (0);
-        retval = OCTAVE__FEVAL (std::string ("__tcpclient_properties__"), ovl, 1);
+        retval = prop->handler (this, octave_value_list (), 1);
       }
       break;
     }
@@ -199,19 +153,14 @@ octave_tcpclient::subsasgn (const std::string& type, const std::list<octave_valu
       if (type.length () == 1)
         {
           std::string property = (idx.front ()) (0).string_value ();
-          if (!has_property(property))
+          const octave_property<octave_tcpclient> *prop = properties ().find_field (property);
+          if (! prop)
             {
               error ("Unknown property '%s'", property.c_str());
               return retval;
             }
 
-          octave_value_list ovl;
-          // inc ref count as assign this to octave_value
-          OV_COUNT++; 
-          ovl (0) = octave_value (this);
-          ovl (1) = (idx.front ()) (0);
-          ovl (2) = rhs;
-          OCTAVE__FEVAL (std::string ("__tcpclient_properties__"), ovl, 0);
+          prop->handler (this, octave_value_list (rhs), 0);
           OV_COUNT++;
           retval = octave_value (this);
         }
@@ -260,7 +209,7 @@ octave_tcpclient::open (const std::string &address, int port, int nd)
 
   memset (&remote_addr, 0, sizeof (remote_addr));
 
-  if( !lookup_addr (address, &remote_addr))
+  if( !octave_lookup_addr (address, &remote_addr))
     {
       int err = SOCKETERR;
       octave_tcpclient::close ();
@@ -309,6 +258,7 @@ octave_tcpclient::open (const std::string &address, int port, int nd)
 
 octave_tcpclient::~octave_tcpclient (void)
 {
+  octave_async_callbacks<octave_tcpclient>::remove (this);
   octave_tcpclient::close ();
 }
 
@@ -340,73 +290,149 @@ octave_tcpclient::print_raw (std::ostream& os, bool pr_as_read_syntax) const
 int
 octave_tcpclient::read (uint8_t *buf, unsigned int len, double readtimeout)
 {
-  struct timeval tv;
-
-  fd_set readfds;
-
   if (get_fd () < 0)
     {
         error ("tcpclient_read: Interface must be opened first...");
         return 0;
     }
 
-  size_t bytes_read = 0;
+  // data left over from readline is returned first
+  size_t bytes_read = rxbuf.take (buf, len);
+
+  // data received by the background reader
+  if (async.is_running ())
+    {
+      int n = async.read (buf + bytes_read, len - bytes_read, readtimeout);
+      if (n < 0)
+        {
+          if (bytes_read == 0)
+            error ("tcpclient_read: Connection lost");
+          return bytes_read;
+        }
+      return bytes_read + n;
+    }
   ssize_t read_retval = -1;
 
+  // the timeout is for the whole read, not each wait for data
+  octave_deadline deadline (readtimeout);
+
   // While not interrupted in blocking mode
   while (bytes_read < len)
     {
+      int ready = octave_wait_readable (get_fd (), deadline);
+      if (ready < 0)
+        {
+          error ("tcpclient_read: Error while reading/poll: %d - %s\n", SOCKETERR, STRSOCKETERR);
+          break;
+        }
 
-      OCTAVE_QUIT;
-
-      tv = to_timeval((readtimeout < 0 || readtimeout > 1000) ? 1000 : (int)readtimeout);
-
-      FD_ZERO (&readfds);
-      FD_SET (get_fd (), &readfds);
+      // time out
+      if (ready == 0)
+        break;
 
-      if (::select (get_fd ()+1, &readfds, NULL, NULL, &tv) < 0)
+      read_retval = ::recv(get_fd (), reinterpret_cast<char *>((buf + bytes_read)), len - bytes_read, 0);
+      if (read_retval < 0)
         {
-          error ("tcpclient_read: Error while reading/select: %d - %s\n", SOCKETERR, STRSOCKETERR);
+          error ("tcpclient_read: Error while reading: %d - %s\n", SOCKETERR, STRSOCKETERR);
           break;
         }
-
-      if (FD_ISSET (get_fd (), &readfds))
+      else if (read_retval == 0)
         {
-          read_retval = ::recv(get_fd (), reinterpret_cast<char *>((buf + bytes_read)), len - bytes_read, 0);
-          if (read_retval < 0)
-            {
-              error ("tcpclient_read: Error while reading: %d - %s\n", SOCKETERR, STRSOCKETERR);
-              break;
-            } 
-          else if (read_retval == 0)
-            {
-              error ("tcpclient_read: Connection lost: %d - %s\n", SOCKETERR, STRSOCKETERR);
-              break;
-            }
-          else
-            {
-              bytes_read += read_retval;
-            }
-        } 
-      else 
+          error ("tcpclient_read: Connection lost: %d - %s\n", SOCKETERR, STRSOCKETERR);
+          break;
+        }
+      else
         {
-          // time out
-          if (readtimeout >= 0)
-            {
-              // real timeout
-              if (readtimeout <= 1000)
-                break;
-              // timed out 1 sec of an actual timeout
-              else
-                readtimeout -= 1000;
-            }
+          bytes_read += read_retval;
         }
-
     }
 
   return bytes_read;
 }
 
+bool
+octave_tcpclient::readline (std::string &line, double readtimeout)
+{
+  return rxbuf.read_line (octave_terminator_string (interminator), line,
+    [this, readtimeout] (uint8_t *buf, unsigned int len)
+    {
+      return read (buf, len, readtimeout);
+    },
+    [this] (void)
+    {
+      return get_numbytesavailable ();
+    });
+}
+
+octave_value
+octave_tcpclient::readbinblock (const octave_data_type &type, double readtimeout)
+{
+  return octave_read_binblock (rxbuf, type, octave_byteorder_needs_swap (byteOrder),
+    [this, readtimeout] (uint8_t *buf, unsigned int len)
+    {
+      return read (buf, len, readtimeout);
+    },
+    [this] (void)
+    {
+      return get_numbytesavailable ();
+    });
+}
+
+bool
+octave_tcpclient::writeread (const std::string &cmd, std::string &line, double readtimeout)
+{
+  // command and terminator go out in a single write
+  if (write (cmd + octave_terminator_string (outterminator)) < 0)
+    return false;
+
+  return readline (line, readtimeout);
+}
+
+void
+octave_tcpclient::set_readasyncmode (bool continuous)
+{
+  if (! continuous)
+    {
+      async.stop (rxbuf);
+      return;
+    }
+
+  if (async.is_running ())
+    return;
+
+  if (get_fd () < 0)
+    {
+      error ("tcpclient: Interface must be opened first...");
+      return;
+    }
+
+  int sock = get_fd ();
+  async.start ([sock] (uint8_t *buf, unsigned int len, int ms)
+    {
+      return async_socket_read (sock, buf, len, ms);
+    });
+}
+
+void
+octave_tcpclient::dispatch_callbacks (void)
+{
+  async.dispatch (octave_value (this, true));
+}
+
+int
+octave_tcpclient::wait_fd (bool &pending)
+{
+  if (async.is_running ())
+    {
+      int wfd = async.wait_fd ();
+      pending = rxbuf.size () > 0 || async.available () > 0 || async.has_failed ();
+      return wfd;
+    }
+
+  pending = rxbuf.size () > 0;
+  return get_fd ();
+}
+
 int
 octave_tcpclient::write (const std::string &str)
 {
@@ -437,6 +463,21 @@ octave_tcpclient::write (uint8_t *buf, unsigned int len)
   return wrote;
 }
 
+int
+octave_tcpclient::write_parts (const octave_write_part *parts, int nparts)
+{
+  if (get_fd () < 0)
+    {
+      error ("tcpclient: Interface must be opened first...");
+      return -1;
+    }
+
+  int wrote = octave_send_parts (get_fd (), parts, nparts);
+  if(wrote > 0)
+    byteswritten += wrote;
+  return wrote;
+}
+
 int
 octave_tcpclient::set_timeout (double newtimeout)
 {
@@ -462,13 +503,12 @@ octave_tcpclient::close (void)
 {
   int retval = -1;
 
+  // the reader must finish before the socket is closed
+  async.stop ();
+
   if (get_fd() > 0)
     {
-#ifndef __WIN32__
-      retval = ::close (get_fd ());
-#else
-      retval = ::closesocket (get_fd ());
-#endif
+      retval = octave_close_socket (get_fd ());
       fd = -1;
     }
 
@@ -486,7 +526,7 @@ octave_tcpclient::get_numbytesavailable () const
     }
   ioctl (get_fd (), FIONREAD, &available);
 
-  return available;
+  return available + rxbuf.size () + async.available ();
 }
 
 int
@@ -600,6 +640,8 @@ octave_tcpclient::set_input_terminator(const octave_value& t)
   else
     error ("octave_tcpclient invalid input terminator");
 
+  async.set_terminator (octave_terminator_string (interminator));
+
   return 1;
 }
 
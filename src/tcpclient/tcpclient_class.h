@@ -31,6 +31,12 @@
 #  include "../config.h"
 #endif
 
+#include "../common/property_table.h"
+#include "../common/byte_view.h"
+#include "../common/receive_buffer.h"
+#include "../common/typed_data.h"
+#include "../common/async_reader.h"
+
 class octave_tcpclient : public OCTAVE_BASE_CLASS
 {
 public:
@@ -39,8 +45,20 @@ public:
 
   int write (const std::string &);
   int write (uint8_t *, unsigned int);
+  // the parts are sent as a single gathered write
+  int write_parts (const octave_write_part *, int);
 
   int read (uint8_t *, unsigned int, double);
+  bool readline (std::string &, double);
+  octave_value readbinblock (const octave_data_type &, double);
+  bool writeread (const std::string &, std::string &, double);
+
+  // background reader, used when ReadAsyncMode is "continuous"
+  octave_async_reader & get_async (void) { return async; }
+  void set_readasyncmode (bool continuous);
+  void dispatch_callbacks (void);
+  int wait_fd (bool &pending);
+  static const char * async_hook (void) { return "__tcpclient_async_callbacks__"; }
 
   int open (const std::string &, int, int);
   int close (void);
@@ -69,7 +87,7 @@ public:
   bool isobject (void) const { return true; }
 
   // required to use subsasn
-  string_vector map_keys (void) const { return fieldnames; }
+  string_vector map_keys (void) const { return properties ().fieldnames (); }
   dim_vector dims (void) const { static dim_vector dv(1, 1); return dv; }
 
   octave_base_value * unique_clone (void) { OV_COUNT++; return this; }
@@ -86,6 +104,8 @@ public:
 
   octave_value subsasgn (const std::string& type, const std::list<octave_value_list>& idx, const octave_value& rhs);
 
+  static const octave_property_table<octave_tcpclient> & properties (void);
+
   int get_numbytesavailable (void) const;
   unsigned int get_numbyteswritten (void) const { return byteswritten; }
 
@@ -150,10 +170,6 @@ public:
   }
 
 private:
-  bool has_property(const std::string &name) const;
-
-  string_vector fieldnames;
-
   int fd;
   double timeout;
 
@@ -166,6 +182,8 @@ private:
   unsigned int byteswritten;
   octave_value interminator;
   octave_value outterminator;
+  octave_receive_buffer rxbuf;
+  octave_async_reader async;
   int ndelay;
 
   DECLARE_OV_TYPEID_FUNCTIONS_AND_DATA
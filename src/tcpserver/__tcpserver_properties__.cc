@@ -22,7 +22,7 @@
 
 #ifdef BUILD_TCP
 #  include "tcpserver_class.h"
-#endif
+#  include "../common/async_properties.h"
 
 static octave_value_list get_terminator (octave_tcpserver* tcp)
 {
@@ -73,6 +73,219 @@ static octave_value set_terminator(octave_tcpserver* tcp, const octave_value_lis
   return octave_value();
 }
 
+static octave_value_list
+tcpserver_type (octave_tcpserver *tcpserver, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (tcpserver->get_type ());
+}
+
+static octave_value_list
+tcpserver_name (octave_tcpserver *tcpserver, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  if (args.length () > 0)
+    return octave_value (tcpserver->set_name (args(0).string_value ()));
+
+  return octave_value (tcpserver->get_name ());
+}
+
+static octave_value_list
+tcpserver_serverport (octave_tcpserver *tcpserver, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (tcpserver->get_port ());
+}
+
+static octave_value_list
+tcpserver_serveraddress (octave_tcpserver *tcpserver, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (tcpserver->get_address ());
+}
+
+static octave_value_list
+tcpserver_clientport (octave_tcpserver *tcpserver, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (tcpserver->get_client_port ());
+}
+
+static octave_value_list
+tcpserver_clientaddress (octave_tcpserver *tcpserver, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (tcpserver->get_client_address ());
+}
+
+static octave_value_list
+tcpserver_connected (octave_tcpserver *tcpserver, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  // check connections
+  tcpserver->check_for_connections ();
+
+  return octave_value (tcpserver->get_connected ());
+}
+
+static octave_value_list
+tcpserver_status (octave_tcpserver *tcpserver, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (tcpserver->get_status ());
+}
+
+static octave_value_list
+tcpserver_timeout (octave_tcpserver *tcpserver, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  if (args.length () > 0)
+    return octave_value (tcpserver->set_timeout (args(0).double_value ()));
+
+  return octave_value (tcpserver->get_timeout ());
+}
+
+static octave_value_list
+tcpserver_numbytesavailable (octave_tcpserver *tcpserver, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (tcpserver->get_numbytesavailable ());
+}
+
+static octave_value_list
+tcpserver_numbyteswritten (octave_tcpserver *tcpserver, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (tcpserver->get_numbyteswritten ());
+}
+
+static octave_value_list
+tcpserver_byteorder (octave_tcpserver *tcpserver, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  if (args.length () > 0)
+    return octave_value (tcpserver->set_byteorder (args(0).string_value ()));
+
+  return octave_value (tcpserver->get_byteorder ());
+}
+
+static octave_value_list
+tcpserver_userdata (octave_tcpserver *tcpserver, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  if (args.length () > 0)
+    {
+      tcpserver->set_userdata (args(0));
+      return octave_value ();
+    }
+
+  return octave_value (tcpserver->get_userdata ());
+}
+
+static octave_value_list
+tcpserver_terminator (octave_tcpserver *tcpserver, const octave_value_list& args, int)
+{
+  if (args.length () > 2)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  if (args.length () > 0)
+    return set_terminator (tcpserver, args);
+
+  return get_terminator (tcpserver);
+}
+
+static octave_value_list
+tcpserver_flush (octave_tcpserver *tcpserver, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () == 0)
+    (*current_liboctave_error_handler) ("invalid property name");
+
+  return octave_value (tcpserver->flush (args(0).int_value ()));
+}
+
+static const octave_property<octave_tcpserver> tcpserver_property_list[] =
+{
+  {"Type", tcpserver_type, true},
+  {"Name", tcpserver_name, true},
+  {"ServerPort", tcpserver_serverport, true},
+  {"ServerAddress", tcpserver_serveraddress, true},
+  {"ClientPort", tcpserver_clientport, true},
+  {"ClientAddress", tcpserver_clientaddress, true},
+  {"Connected", tcpserver_connected, true},
+  {"Status", tcpserver_status, true},
+  {"Timeout", tcpserver_timeout, true},
+  {"NumBytesAvailable", tcpserver_numbytesavailable, true},
+  {"NumBytesWritten", tcpserver_numbyteswritten, true},
+  {"ByteOrder", tcpserver_byteorder, true},
+  {"UserData", tcpserver_userdata, true},
+  {"Terminator", tcpserver_terminator, true},
+  {"ReadAsyncMode", octave_async_readasyncmode<octave_tcpserver>, true},
+  {"BytesAvailableFcn", octave_async_bytesavailablefcn<octave_tcpserver>, true},
+  {"BytesAvailableFcnCount", octave_async_bytesavailablefcncount<octave_tcpserver>, true},
+  {"BytesAvailableFcnMode", octave_async_bytesavailablefcnmode<octave_tcpserver>, true},
+  {"InputBufferSize", octave_async_inputbuffersize<octave_tcpserver>, true},
+  {"NumBytesDropped", octave_async_numbytesdropped<octave_tcpserver>, true},
+  // internals
+  {"flush", tcpserver_flush, false},
+  {"configurecallback", octave_async_configurecallback<octave_tcpserver>, false},
+  {"waitinfo", octave_async_waitinfo<octave_tcpserver>, false},
+  {NULL, NULL, false}
+};
+
+const octave_property_table<octave_tcpserver> &
+octave_tcpserver::properties (void)
+{
+  static const octave_property_table<octave_tcpserver> table (tcpserver_property_list);
+  return table;
+}
+#endif
+
 // PKG_ADD: autoload ("__tcpserver_properties__", "tcpserver.oct");
 DEFUN_DLD (__tcpserver_properties__, args, nargout,
 "-*- texinfo -*-\n\
@@ -88,82 +301,12 @@ Undocumented internal function.\n\
     
   const octave_base_value& rep = args(0).get_rep ();
   octave_tcpserver* tcpserver = &((octave_tcpserver &)rep);
-    
-  std::string property = args(1).string_value ();
-  std::transform (property.begin (), property.end (), property.begin (), ::tolower);
-
-  int maxinputs = 3;
-  if (property == "terminator")
-    maxinputs = 4;
 
-  if (args.length () > maxinputs)
-      (*current_liboctave_error_handler) ("wrong number of arguments");
-
-  if (args.length () == 2) // get
-    {
-      if (property == "name")
-        return octave_value (tcpserver->get_name ());
-      else if (property == "type")
-        return octave_value (tcpserver->get_type ());
-      else if (property == "serverport")
-        return octave_value (tcpserver->get_port ());
-      else if (property == "serveraddress")
-        return octave_value (tcpserver->get_address ());
-      else if (property == "clientport")
-        return octave_value (tcpserver->get_client_port ());
-      else if (property == "clientaddress")
-        return octave_value (tcpserver->get_client_address ());
-      else if (property == "status")
-        return octave_value (tcpserver->get_status ());
-      else if (property == "connected")
-        return octave_value (tcpserver->get_connected ());
-      else if (property == "timeout")
-        return octave_value (tcpserver->get_timeout ());
-      else if (property == "numbytesavailable")
-        return octave_value (tcpserver->get_numbytesavailable ());
-      else if (property == "numbyteswritten")
-        return octave_value (tcpserver->get_numbyteswritten ());
-      else if (property == "byteorder")
-        return octave_value (tcpserver->get_byteorder ());
-      else if (property == "userdata")
-        return octave_value (tcpserver->get_userdata ());
-      else if (property == "terminator")
-        return get_terminator (tcpserver);
-      else
-        (*current_liboctave_error_handler) ("invalid property name");
-    }
-  else // set
-    {
-      if (property == "name")
-        return octave_value (tcpserver->set_name (args(2).string_value ()));
-      else if (property == "type")
-        (*current_liboctave_error_handler) ("can not set this property");
-      else if (property == "serverport")
-        (*current_liboctave_error_handler) ("can not set this property");
-      else if (property == "serveraddress")
-        (*current_liboctave_error_handler) ("can not set this property");
-      else if (property == "clientport")
-        (*current_liboctave_error_handler) ("can not set this property");
-      else if (property == "clientaddress")
-        (*current_liboctave_error_handler) ("can not set this property");
-      else if (property == "connected")
-        (*current_liboctave_error_handler) ("can not set this property");
-      else if (property == "status")
-        (*current_liboctave_error_handler) ("can not set this property");
-      else if (property == "timeout")
-        return octave_value (tcpserver->set_timeout (args(2).double_value ()));
-      else if (property == "userdata")
-        { tcpserver->set_userdata (args(2)); return octave_value (); }
-      else if (property == "byteorder")
-        return octave_value (tcpserver->set_byteorder (args(2).string_value ()));
-      else if (property == "flush")
-        return octave_value (tcpserver->flush (args(2).int_value ()));
-      else if (property == "terminator")
-        return set_terminator (tcpserver, args.slice (2, args.length ()-2));
-      else
-        (*current_liboctave_error_handler) ("invalid property name");
-    }
+  const octave_property<octave_tcpserver> *prop = octave_tcpserver::properties ().find (args(1).string_value ());
+  if (! prop)
+    (*current_liboctave_error_handler) ("invalid property name");
 
+  return prop->handler (tcpserver, args.slice (2, args.length ()-2), nargout);
 #endif
     /* never reached in normal operation */
   (*current_liboctave_error_handler) ("Your system doesn't support the TCP interface");
@@ -0,0 +1,107 @@
+// Copyright (C) 2026   John Donoghue   <john.donoghue@ieee.org>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+
+#include <octave/oct.h>
+
+#ifdef HAVE_CONFIG_H
+#include "../config.h"
+#endif
+
+#ifdef BUILD_TCP
+#include "tcpserver_class.h"
+#include "../common/typed_data.h"
+#endif
+
+// PKG_ADD: autoload ("__tcpserver_readbinblock__", "tcpserver.oct");
+DEFUN_DLD (__tcpserver_readbinblock__, args, nargout,
+        "-*- texinfo -*-\n\
+@deftypefn {} {@var{data} = } __tcpserver_readbinblock__ (@var{tcpserver})\n \
+@deftypefnx {} {@var{data} = } __tcpserver_readbinblock__ (@var{tcpserver}, @var{datatype})\n \
+\n\
+Private function to read a IEEE 488.2 binblock from a tcpserver interface.\n \
+\n\
+Any data before the '#' of the block header is discarded. The block data is\n \
+read directly into the result, in the byte order of the object, and the\n \
+trailing terminator is consumed.\n \
+\n\
+@subsubheading Inputs\n \
+@var{tcpserver} - instance of @var{octave_tcpserver} class.@* \
+@var{datatype} - precision of the block values (default 'uint8').\n \
+\n\
+@subsubheading Outputs\n \
+@var{data} - the block values, or an empty array if no block was read.\n \
+@end deftypefn")
+{
+#ifndef BUILD_TCP
+  error ("tcpserver: Your system doesn't support the TCP interface");
+  return octave_value ();
+#else
+
+  if (args.length () < 1 || args.length () > 2 || args (0).type_id () != octave_tcpserver::static_type_id ())
+    {
+      print_usage ();
+      return octave_value (-1);
+    }
+
+  octave_data_type type;
+  octave_data_type_lookup ("uint8", type);
+
+  if (args.length () > 1)
+    {
+      if (! args (1).is_string ())
+        {
+          print_usage ();
+          return octave_value (-1);
+        }
+      if (! octave_data_type_lookup (args (1).string_value (), type))
+        {
+          error ("__tcpserver_readbinblock__: datatype not supported");
+          return octave_value (-1);
+        }
+    }
+
+  octave_tcpserver* tcpserver = NULL;
+
+  const octave_base_value& rep = args (0).get_rep ();
+  tcpserver = &((octave_tcpserver &)rep);
+
+  // run any BytesAvailableFcn callbacks that are due
+  tcpserver->dispatch_callbacks ();
+
+  double timeout = tcpserver->get_timeout () * 1000;
+
+  octave_value data = tcpserver->readbinblock (type, timeout);
+
+  return data;
+#endif
+}
+
+#if 0
+%!error <Invalid call to __tcpserver_readbinblock__> __tcpserver_readbinblock__ ()
+
+%!error <Invalid call to __tcpserver_readbinblock__> __tcpserver_readbinblock__ (1)
+
+%!test
+%! s = tcpserver (0);
+%! c = tcpclient ("127.0.0.1", s.ServerPort, 'Timeout', 1);
+%! st = s.Connected;
+%! write (c, ["noise#15hello\n" "#14" char([0 0 128 63]) "\n"]);
+%! d = __tcpserver_readbinblock__ (s);
+%! assert (d, uint8 ("hello"));
+%! d = __tcpserver_readbinblock__ (s, "single");
+%! assert (d, single (1));
+%! clear c s
+
+#endif
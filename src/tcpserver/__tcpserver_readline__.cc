@@ -0,0 +1,103 @@
+// Copyright (C) 2026   John Donoghue   <john.donoghue@ieee.org>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+
+#include <octave/oct.h>
+
+#ifdef HAVE_CONFIG_H
+#include "../config.h"
+#endif
+
+#ifdef BUILD_TCP
+#include "tcpserver_class.h"
+#endif
+
+// PKG_ADD: autoload ("__tcpserver_readline__", "tcpserver.oct");
+DEFUN_DLD (__tcpserver_readline__, args, nargout,
+        "-*- texinfo -*-\n\
+@deftypefn {} {[@var{data}, @var{found}] = } __tcpserver_readline__ (@var{tcpserver}, @var{timeout})\n \
+\n\
+Private function to read a line from tcpserver interface.\n \
+\n\
+Data is read in blocks into a receive buffer on the object and scanned for\n \
+the input terminator. Any data after the terminator is kept for the next read.\n \
+\n\
+@subsubheading Inputs\n \
+@var{tcpserver} - instance of @var{octave_tcpserver} class.@* \
+@var{timeout} - timeout in ms if different from default of type Integer\n \
+\n\
+@subsubheading Outputs\n \
+@var{data} - data read, excluding the terminator, as a string.@*\n \
+@var{found} - true if the terminator was found before a timeout.\n \
+@end deftypefn")
+{
+#ifndef BUILD_TCP
+  error ("tcpserver: Your system doesn't support the TCP interface");
+  return octave_value ();
+#else
+
+  if (args.length () < 1 || args.length () > 2 || args (0).type_id () != octave_tcpserver::static_type_id ())
+    {
+      print_usage ();
+      return octave_value (-1);
+    }
+
+  if (args.length () > 1 && ! (args (1).OV_ISINTEGER () || args (1).OV_ISFLOAT ()))
+    {
+      print_usage ();
+      return octave_value (-1);
+    }
+
+  octave_tcpserver* tcpserver = NULL;
+
+  const octave_base_value& rep = args (0).get_rep ();
+  tcpserver = &((octave_tcpserver &)rep);
+
+  // run any BytesAvailableFcn callbacks that are due
+  tcpserver->dispatch_callbacks ();
+
+  double timeout = tcpserver->get_timeout () * 1000;
+  if (args.length () > 1)
+    {
+      timeout = args (1).double_value ();
+    }
+
+  std::string line;
+  bool found = tcpserver->readline (line, timeout);
+
+  octave_value_list return_list;
+  return_list(0) = line;
+  return_list(1) = found;
+
+  return return_list;
+#endif
+}
+
+#if 0
+%!error <Invalid call to __tcpserver_readline__> __tcpserver_readline__ ()
+
+%!error <Invalid call to __tcpserver_readline__> __tcpserver_readline__ (1)
+
+%!test
+%! s = tcpserver (0);
+%! c = tcpclient ("127.0.0.1", s.ServerPort, 'Timeout', 1);
+%! st = s.Connected;
+%! write (c, "hello\nworld\n");
+%! [d, f] = __tcpserver_readline__ (s);
+%! assert (d, "hello");
+%! assert (f, true);
+%! assert (read (s, 6), uint8 ("world\n"));
+%! clear c s
+
+#endif
@@ -0,0 +1,95 @@
+// Copyright (C) 2026   John Donoghue   <john.donoghue@ieee.org>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+
+#include <octave/oct.h>
+
+#ifdef HAVE_CONFIG_H
+#include "../config.h"
+#endif
+
+#ifdef BUILD_TCP
+#include "tcpserver_class.h"
+#include "../common/binblock.h"
+#endif
+
+// PKG_ADD: autoload ("__tcpserver_writebinblock__", "tcpserver.oct");
+DEFUN_DLD (__tcpserver_writebinblock__, args, nargout,
+        "-*- texinfo -*-\n\
+@deftypefn {} {@var{n} = } __tcpserver_writebinblock__ (@var{tcpserver}, @var{data}, @var{datatype})\n \
+\n\
+Private function to write data as a IEEE 488.2 binblock to a tcpserver interface.\n \
+\n\
+The block header, data and terminator are sent with a single gathered write,\n \
+without copying the data.\n \
+\n\
+@subsubheading Inputs\n \
+@var{tcpserver} - instance of @var{octave_tcpserver} class.@* \
+@var{data} - data to write.@* \
+@var{datatype} - precision to convert @var{data} to, in the byte order of the object.\n \
+\n\
+@subsubheading Outputs\n \
+@var{n} - number of bytes written, including the header and terminator.\n \
+@end deftypefn")
+{
+#ifndef BUILD_TCP
+  error ("tcpserver: Your system doesn't support the TCP interface");
+  return octave_value ();
+#else
+
+  if (args.length () != 3 || args (0).type_id () != octave_tcpserver::static_type_id () || ! args (2).is_string ())
+    {
+      print_usage ();
+      return octave_value (-1);
+    }
+
+  octave_data_type type;
+
+  if (! octave_data_type_lookup (args (2).string_value (), type))
+    {
+      error ("__tcpserver_writebinblock__: datatype not supported");
+      return octave_value (-1);
+    }
+
+  octave_tcpserver* tcpserver = NULL;
+
+  const octave_base_value& rep = args (0).get_rep ();
+  tcpserver = &((octave_tcpserver &)rep);
+
+  bool swap = octave_byteorder_needs_swap (tcpserver->get_byteorder ());
+
+  int retval = octave_write_binblock_parts (args (1), type, swap,
+    [tcpserver] (const octave_write_part *parts, int nparts)
+    {
+      return tcpserver->write_parts (parts, nparts);
+    });
+
+  return octave_value (retval);
+#endif
+}
+
+#if 0
+%!error <Invalid call to __tcpserver_writebinblock__> __tcpserver_writebinblock__ ()
+
+%!error <Invalid call to __tcpserver_writebinblock__> __tcpserver_writebinblock__ (1, "hello", "uint8")
+
+%!test
+%! s = tcpserver (0);
+%! c = tcpclient ("127.0.0.1", s.ServerPort, 'Timeout', 1);
+%! st = s.Connected;
+%! assert (__tcpserver_writebinblock__ (s, "hello", "string"), 9);
+%! assert (char (read (c, 9)), "#15hello\n");
+%! clear c s
+
+#endif
@@ -0,0 +1,103 @@
+// Copyright (C) 2026   John Donoghue   <john.donoghue@ieee.org>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+
+#include <octave/oct.h>
+
+#ifdef HAVE_CONFIG_H
+#include "../config.h"
+#endif
+
+#ifdef BUILD_TCP
+#include "tcpserver_class.h"
+#endif
+
+// PKG_ADD: autoload ("__tcpserver_writeread__", "tcpserver.oct");
+DEFUN_DLD (__tcpserver_writeread__, args, nargout,
+        "-*- texinfo -*-\n\
+@deftypefn {} {[@var{data}, @var{found}] = } __tcpserver_writeread__ (@var{tcpserver}, @var{cmd}, @var{timeout})\n \
+\n\
+Private function to send a command to a tcpserver interface and read the response line.\n \
+\n\
+The command and output terminator are sent with a single write, then the\n \
+response is read through the receive buffer as for readline.\n \
+\n\
+@subsubheading Inputs\n \
+@var{tcpserver} - instance of @var{octave_tcpserver} class.@* \
+@var{cmd} - command to send, as a string.@* \
+@var{timeout} - timeout in ms if different from default of type Integer\n \
+\n\
+@subsubheading Outputs\n \
+@var{data} - data read, excluding the terminator, as a string.@*\n \
+@var{found} - true if the terminator was found before a timeout.\n \
+@end deftypefn")
+{
+#ifndef BUILD_TCP
+  error ("tcpserver: Your system doesn't support the TCP interface");
+  return octave_value ();
+#else
+
+  if (args.length () < 2 || args.length () > 3 || ! args (1).is_string () || args (0).type_id () != octave_tcpserver::static_type_id ())
+    {
+      print_usage ();
+      return octave_value (-1);
+    }
+
+  if (args.length () > 2 && ! (args (2).OV_ISINTEGER () || args (2).OV_ISFLOAT ()))
+    {
+      print_usage ();
+      return octave_value (-1);
+    }
+
+  octave_tcpserver* tcpserver = NULL;
+
+  const octave_base_value& rep = args (0).get_rep ();
+  tcpserver = &((octave_tcpserver &)rep);
+
+  // run any BytesAvailableFcn callbacks that are due
+  tcpserver->dispatch_callbacks ();
+
+  double timeout = tcpserver->get_timeout () * 1000;
+  if (args.length () > 2)
+    {
+      timeout = args (2).double_value ();
+    }
+
+  std::string line;
+  bool found = tcpserver->writeread (args (1).string_value (), line, timeout);
+
+  octave_value_list return_list;
+  return_list(0) = line;
+  return_list(1) = found;
+
+  return return_list;
+#endif
+}
+
+#if 0
+%!error <Invalid call to __tcpserver_writeread__> __tcpserver_writeread__ ()
+
+%!error <Invalid call to __tcpserver_writeread__> __tcpserver_writeread__ (1, "*IDN?")
+
+%!test
+%! s = tcpserver (0);
+%! c = tcpclient ("127.0.0.1", s.ServerPort, 'Timeout', 1);
+%! st = s.Connected;
+%! write (c, "reply\n");
+%! [d, f] = __tcpserver_writeread__ (s, "*IDN?");
+%! assert (d, "reply");
+%! assert (f, true);
+%! assert (char (read (c, 6)), "*IDN?\n");
+%! clear c s
+#endif
@@ -50,23 +50,22 @@
 #endif
 
 #include "tcpserver_class.h"
+#include "../common/socket_wait.h"
+#include "../common/binblock.h"
+#include "../common/socket_util.h"
 #include <octave/Matrix.h>
 
-static struct timeval
-to_timeval(int ms)
+// read used by the background reader thread, so must not call any octave
+// functions. Returns 0 on a timeout and -1 on an error or a closed connection.
+static int
+async_socket_read (int sock, uint8_t *buf, unsigned int len, int ms)
 {
-  struct timeval tv;
-  if(ms <= 0)
-    {
-      tv.tv_usec = 0;
-      tv.tv_sec = 0;
-    }
-  else
-    {
-      tv.tv_usec = (ms % 1000) * 1000;
-      tv.tv_sec = ms/1000;;
-    }
-  return tv;
+  int ret = octave_poll_readable (sock, ms);
+  if (ret <= 0)
+    return ret;
+
+  ret = ::recv (sock, reinterpret_cast<char *> (buf), len, 0);
+  return ret > 0 ? ret : -1;
 }
 
 static std::string 
@@ -86,23 +85,6 @@ to_ip_str (const sockaddr_in *in)
   return n.str ();
 }
 
-static bool 
-lookup_addr (const std::string &ip, sockaddr_in *in)
-{
-  in->sin_addr.s_addr = inet_addr (ip.c_str());
-
-  if (in->sin_addr.s_addr == INADDR_NONE)
-    {
-      struct hostent * host = gethostbyname (ip.c_str());
-      if (!host)
-        return false;
-
-      memcpy(&in->sin_addr, host->h_addr_list[0], host->h_length);
-    }
-
-  return true;
-}
-
 static std::string
 num2str(int num)
 {
@@ -115,7 +97,7 @@ num2str(int num)
 DEFINE_OV_TYPEID_FUNCTIONS_AND_DATA (octave_tcpserver, "octave_tcpserver", "octave_tcpserver");
 
 octave_tcpserver::octave_tcpserver (void)
-: fieldnames(14), fd (-1), clientfd(-1), timeout(-1), name("")
+: fd (-1), clientfd(-1), timeout(-1), name("")
 {
   static bool type_registered = false;
 
@@ -130,31 +112,6 @@ octave_tcpserver::octave_tcpserver (void)
   byteOrder = "little-endian";
   interminator = octave_value("lf");
   outterminator = octave_value("lf");
-
-  fieldnames[0] = "Type";
-  fieldnames[1] = "Name";
-  fieldnames[2] = "ServerPort";
-  fieldnames[3] = "ServerAddress";
-  fieldnames[4] = "ClientPort";
-  fieldnames[5] = "ClientAddress";
-  fieldnames[6] = "Connected";
-  fieldnames[7] = "Status";
-  fieldnames[8] = "Timeout";
-  fieldnames[9] = "NumBytesAvailable";
-  fieldnames[10] = "NumBytesWritten";
-  fieldnames[11] = "ByteOrder";
-  fieldnames[12] = "UserData";
-  fieldnames[13] = "Terminator";
-}
-
-bool
-octave_tcpserver::has_property(const std::string &name) const
-{
-  for (octave_idx_type i=0; i<fieldnames.numel(); i++)
-    {
-      if (fieldnames[i] == name) return true;
-    }
-  return false;
 }
 
 octave_value_list
@@ -171,21 +128,13 @@ octave_tcpserver::subsref (const std::string& type, const std::list<octave_value
     case '.':
       {
         std::string property = (idx.front ()) (0).string_value ();
-        if (!has_property(property))
+        const octave_property<octave_tcpserver> *prop = properties ().find_field (property);
+        if (! prop)
           {
             error ("Unknown property '%s'", property.c_str());
             return retval;
           }
-        // check connections
-        if (property == "Connected")
-          check_for_connections();
-
-        octave_value_list ovl;
-        // inc ref count as assign this to octave_value
-        OV_COUNT++; 
-        ovl (0) = octave_value (this);
-        ovl (1) = (idx.front ()) (0);
-        retval = OCTAVE__FEVAL (std::string ("__tcpserver_properties__"), ovl, 1);
+        retval = prop->handler (this, octave_value_list (), 1);
       }
       break;
     }
@@ -210,19 +159,14 @@ octave_tcpserver::subsasgn (const std::string& type, const std::list<octave_valu
       if (type.length () == 1)
         {
           std::string property = (idx.front ()) (0).string_value ();
-          if (!has_property(property))
+          const octave_property<octave_tcpserver> *prop = properties ().find_field (property);
+          if (! prop)
             {
               error ("Unknown property '%s'", property.c_str());
               return retval;
             }
 
-          octave_value_list ovl;
-          // inc ref count as assign this to octave_value
-          OV_COUNT++; 
-          ovl (0) = octave_value (this);
-          ovl (1) = (idx.front ()) (0);
-          ovl (2) = rhs;
-          OCTAVE__FEVAL (std::string ("__tcpserver_properties__"), ovl, 0);
+          prop->handler (this, octave_value_list (rhs), 0);
           OV_COUNT++;
           retval = octave_value (this);
         }
@@ -277,7 +221,7 @@ octave_tcpserver::open (const std::string &address, int port)
     local_addr.sin_addr.s_addr = htonl (INADDR_ANY);
   else
     {
-      if (! lookup_addr(address, &local_addr))
+      if (! octave_lookup_addr (address, &local_addr))
         {
           int err = SOCKETERR;
           octave_tcpserver::close ();
@@ -329,6 +273,7 @@ octave_tcpserver::open (const std::string &address, int port)
 
 octave_tcpserver::~octave_tcpserver (void)
 {
+  octave_async_callbacks<octave_tcpserver>::remove (this);
   octave_tcpserver::close ();
 }
 
@@ -362,10 +307,6 @@ octave_tcpserver::print_raw (std::ostream& os, bool pr_as_read_syntax) const
 int
 octave_tcpserver::read (uint8_t *buf, unsigned int len, double readtimeout)
 {
-  struct timeval tv;
-
-  fd_set readfds;
-
   if (get_fd () < 0)
     {
         error ("tcpserver_read: Interface must be opened first...");
@@ -378,65 +319,150 @@ octave_tcpserver::read (uint8_t *buf, unsigned int len, double readtimeout)
         return 0;
     }
 
-  size_t bytes_read = 0;
+  // data left over from readline is returned first
+  size_t bytes_read = rxbuf.take (buf, len);
+
+  // data received by the background reader
+  if (async.is_running ())
+    {
+      int n = async.read (buf + bytes_read, len - bytes_read, readtimeout);
+      if (n < 0)
+        {
+          // connection lost, as for a read without the reader
+          this->clientfd = -1;
+          return bytes_read;
+        }
+      return bytes_read + n;
+    }
   ssize_t read_retval = -1;
 
+  // the timeout is for the whole read, not each wait for data
+  octave_deadline deadline (readtimeout);
+
   // While not interrupted in blocking mode
   while (bytes_read < len)
     {
+      int ready = octave_wait_readable (this->clientfd, deadline);
+      if (ready < 0)
+        {
+          error ("tcpserver_read: Error while reading/poll: %d - %s\n", SOCKETERR, STRSOCKETERR);
+          break;
+        }
 
-      OCTAVE_QUIT;
-
-      tv = to_timeval((readtimeout < 0 || readtimeout > 1000) ? 1000 : (int)readtimeout);
-
-      FD_ZERO (&readfds);
-      FD_SET (this->clientfd, &readfds);
+      // time out
+      if (ready == 0)
+        break;
 
-      if (::select (this->clientfd+1, &readfds, NULL, NULL, &tv) < 0)
+      read_retval = ::recv(this->clientfd, reinterpret_cast<char *>((buf + bytes_read)), len - bytes_read, 0);
+      if (read_retval < 0)
         {
-          error ("tcpserver_read: Error while reading/select: %d - %s\n", SOCKETERR, STRSOCKETERR);
+          error ("tcpserver_read: Error while reading: %d - %s\n", SOCKETERR, STRSOCKETERR);
           break;
         }
-
-      if (FD_ISSET (this->clientfd, &readfds))
+      else if (read_retval == 0)
         {
-          read_retval = ::recv(this->clientfd, reinterpret_cast<char *>((buf + bytes_read)), len - bytes_read, 0);
-          if (read_retval < 0)
-            {
-              error ("tcpserver_read: Error while reading: %d - %s\n", SOCKETERR, STRSOCKETERR);
-              break;
-            } 
-          else if (read_retval == 0)
-            {
-              //error ("tcpserver_read: Connection lost: %d - %s\n", SOCKETERR, STRSOCKETERR);
-	      this->clientfd = -1;
-	      // TODO: call back for disconnected
-              break;
-            }
-          else
-            {
-              bytes_read += read_retval;
-            }
-        } 
-      else 
+          //error ("tcpserver_read: Connection lost: %d - %s\n", SOCKETERR, STRSOCKETERR);
+          this->clientfd = -1;
+          // TODO: call back for disconnected
+          break;
+        }
+      else
         {
-          // time out
-          if (readtimeout >= 0)
-            {
-              // real timeout
-              if (readtimeout <= 1000)
-                break;
-              // timed out 1 sec of an actual timeout
-              else
-                readtimeout -= 1000;
-            }
+          bytes_read += read_retval;
         }
-
     }
 
   return bytes_read;
 }
 
+bool
+octave_tcpserver::readline (std::string &line, double readtimeout)
+{
+  return rxbuf.read_line (octave_terminator_string (interminator), line,
+    [this, readtimeout] (uint8_t *buf, unsigned int len)
+    {
+      return read (buf, len, readtimeout);
+    },
+    [this] (void)
+    {
+      return get_numbytesavailable ();
+    });
+}
+
+octave_value
+octave_tcpserver::readbinblock (const octave_data_type &type, double readtimeout)
+{
+  return octave_read_binblock (rxbuf, type, octave_byteorder_needs_swap (byteOrder),
+    [this, readtimeout] (uint8_t *buf, unsigned int len)
+    {
+      return read (buf, len, readtimeout);
+    },
+    [this] (void)
+    {
+      return get_numbytesavailable ();
+    });
+}
+
+bool
+octave_tcpserver::writeread (const std::string &cmd, std::string &line, double readtimeout)
+{
+  // command and terminator go out in a single write
+  if (write (cmd + octave_terminator_string (outterminator)) < 0)
+    return false;
+
+  return readline (line, readtimeout);
+}
+
+void
+octave_tcpserver::set_readasyncmode (bool continuous)
+{
+  if (! continuous)
+    {
+      async.stop (rxbuf);
+      return;
+    }
+
+  if (async.is_running ())
+    return;
+
+  if (this->clientfd < 0)
+    {
+      error ("tcpserver: Not connected");
+      return;
+    }
+
+  int sock = this->clientfd;
+  async.start ([sock] (uint8_t *buf, unsigned int len, int ms)
+    {
+      return async_socket_read (sock, buf, len, ms);
+    });
+}
+
+void
+octave_tcpserver::dispatch_callbacks (void)
+{
+  async.dispatch (octave_value (this, true));
+}
+
+int
+octave_tcpserver::wait_fd (bool &pending)
+{
+  if (async.is_running ())
+    {
+      int wfd = async.wait_fd ();
+      pending = rxbuf.size () > 0 || async.available () > 0 || async.has_failed ();
+      return wfd;
+    }
+
+  pending = rxbuf.size () > 0;
+
+  // until a client connects, wait for the connection
+  if (clientfd < 0)
+    return fd;
+
+  return clientfd;
+}
+
 int
 octave_tcpserver::write (const std::string &str)
 {
@@ -480,28 +506,42 @@ octave_tcpserver::write (uint8_t *buf, unsigned int len)
 }
 
 int
-octave_tcpserver::check_for_connections ()
+octave_tcpserver::write_parts (const octave_write_part *parts, int nparts)
 {
   if (get_fd () < 0)
     {
+      error ("tcpserver: Interface must be opened first...");
       return -1;
     }
 
-  fd_set ready;
-  struct timeval tv;
+  if (this->clientfd < 0)
+    {
+        error ("tcpserver_read: Not connected");
+        return 0;
+    }
 
-  FD_ZERO (&ready);
-  FD_SET (get_fd (), &ready);
-  tv.tv_sec = 0;
-  tv.tv_usec = 0;
+  int wrote = octave_send_parts (this->clientfd, parts, nparts);
+  if(wrote > 0)
+    byteswritten += wrote;
+  return wrote;
+}
+
+int
+octave_tcpserver::check_for_connections ()
+{
+  if (get_fd () < 0)
+    {
+      return -1;
+    }
 
-  if (::select (get_fd ()+1, &ready, NULL, NULL, &tv) < 0)
+  int ready = octave_poll_readable (get_fd (), 0);
+  if (ready < 0)
     {
-      error ("tcpserver_read: Error while reading/select: %d - %s\n", SOCKETERR, STRSOCKETERR);
+      error ("tcpserver_read: Error while reading/poll: %d - %s\n", SOCKETERR, STRSOCKETERR);
       return -1;
     }
 
-  if (FD_ISSET (get_fd (), &ready))
+  if (ready > 0)
     {
       socklen_t sz = sizeof (remote_addr);
       int client = accept(get_fd(), (sockaddr*)&remote_addr, &sz);
@@ -513,16 +553,20 @@ octave_tcpserver::check_for_connections ()
       else if(this->clientfd >= 0)
         {
           // already have a connection so just close this one
-#ifndef __WIN32__
-          ::close (client);
-#else
-          ::closesocket (client);
-#endif
+          octave_close_socket (client);
 	  return 0;
         }
       else
         {
           this->clientfd = client;
+          rxbuf.clear ();
+
+          // keep reading in the background from the new client
+          if (async.is_running ())
+            {
+              async.stop ();
+              set_readasyncmode (true);
+            }
 
           //warning ("Connected new socket %d", client);
 	  //TODO: connected call back ?
@@ -559,23 +603,18 @@ octave_tcpserver::close (void)
 {
   int retval = -1;
 
+  // the reader must finish before the socket is closed
+  async.stop ();
+
   if(this->clientfd)
     {
-#ifndef __WIN32__
-      retval = ::close (this->clientfd);
-#else
-      retval = ::closesocket (this->clientfd);
-#endif
+      retval = octave_close_socket (this->clientfd);
       clientfd = -1;
     }
 
   if (get_fd() > 0)
     {
-#ifndef __WIN32__
-      retval = ::close (get_fd ());
-#else
-      retval = ::closesocket (get_fd ());
-#endif
+      retval = octave_close_socket (get_fd ());
       fd = -1;
     }
 
@@ -593,7 +632,7 @@ octave_tcpserver::get_numbytesavailable () const
     }
   ioctl (this->clientfd, FIONREAD, &available);
 
-  return available;
+  return available + rxbuf.size () + async.available ();
 }
 
 int
@@ -725,6 +764,8 @@ octave_tcpserver::set_input_terminator(const octave_value& t)
   else
     error ("octave_tcpserver invalid input terminator");
 
+  async.set_terminator (octave_terminator_string (interminator));
+
  return 1;
 }
 
@@ -25,8 +25,144 @@
 
 #ifdef BUILD_UDP
 #  include "udp_class.h"
-#endif
 
+static octave_value_list
+udp_type (octave_udp *udp, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (udp->get_type ());
+}
+
+static octave_value_list
+udp_name (octave_udp *udp, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  if (args.length () > 0)
+    return octave_value (udp->set_name (args(0).string_value ()));
+
+  return octave_value (udp->get_name ());
+}
+
+static octave_value_list
+udp_remoteport (octave_udp *udp, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  if (args.length () > 0)
+    return octave_value (udp->set_remote_port (args(0).int_value ()));
+
+  return octave_value (udp->get_remote_port ());
+}
+
+static octave_value_list
+udp_remotehost (octave_udp *udp, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  if (args.length () > 0)
+    return octave_value (udp->set_remote_addr (args(0).string_value ()));
+
+  return octave_value (udp->get_remote_addr ());
+}
+
+static octave_value_list
+udp_localport (octave_udp *udp, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (udp->get_local_port ());
+}
+
+static octave_value_list
+udp_status (octave_udp *udp, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (udp->get_status ());
+}
+
+static octave_value_list
+udp_timeout (octave_udp *udp, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  if (args.length () > 0)
+    return octave_value (udp->set_timeout (args(0).double_value ()));
+
+  return octave_value (udp->get_timeout ());
+}
+
+static octave_value_list
+udp_bytesavailable (octave_udp *udp, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (udp->get_bytesavailable ());
+}
+
+static octave_value_list
+udp_localhost (octave_udp *udp, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (udp->get_local_addr ());
+}
+
+static octave_value_list
+udp_flush (octave_udp *udp, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () == 0)
+    (*current_liboctave_error_handler) ("invalid property name");
+
+  return octave_value (udp->flush (args(0).int_value ()));
+}
+
+static const octave_property<octave_udp> udp_property_list[] =
+{
+  {"type", udp_type, true},
+  {"name", udp_name, true},
+  {"remoteport", udp_remoteport, true},
+  {"remotehost", udp_remotehost, true},
+  {"localport", udp_localport, true},
+  {"status", udp_status, true},
+  {"timeout", udp_timeout, true},
+  {"bytesavailable", udp_bytesavailable, true},
+  {"localhost", udp_localhost, true},
+  // internals
+  {"flush", udp_flush, false},
+  {NULL, NULL, false}
+};
+
+const octave_property_table<octave_udp> &
+octave_udp::properties (void)
+{
+  static const octave_property_table<octave_udp> table (udp_property_list);
+  return table;
+}
+#endif
 
 // PKG_ADD: autoload ("__udp_properties__", "udp.oct");
 DEFUN_DLD (__udp_properties__, args, nargout,
@@ -44,55 +180,11 @@ Undocumented internal function.\n\
   const octave_base_value& rep = args(0).get_rep ();
   octave_udp* udp = &((octave_udp &)rep);
     
-  std::string property = args(1).string_value ();
-
-  if (args.length () == 2) // get
-    {
-      if (property == "name")
-        return octave_value (udp->get_name ());
-      else if (property == "type")
-        return octave_value (udp->get_type ());
-      else if (property == "remoteport")
-        return octave_value (udp->get_remote_port ());
-      else if (property == "remotehost")
-        return octave_value (udp->get_remote_addr ());
-      else if (property == "localport")
-        return octave_value (udp->get_local_port ());
-      else if (property == "localhost")
-        return octave_value (udp->get_local_addr ());
-      else if (property == "status")
-        return octave_value (udp->get_status ());
-      else if (property == "timeout")
-        return octave_value (udp->get_timeout ());
-      else if (property == "bytesavailable")
-        return octave_value (udp->get_bytesavailable ());
-      else
-        (*current_liboctave_error_handler) ("invalid property name");
-    }
-  else // set
-    {
-      if (property == "name")
-        return octave_value (udp->set_name (args(2).string_value ()));
-      else if (property == "type")
-        (*current_liboctave_error_handler) ("can not set this property");
-      else if (property == "remoteport")
-        return octave_value (udp->set_remote_port (args(2).int_value ()));
-      else if (property == "remotehost")
-        return octave_value (udp->set_remote_addr (args(2).string_value ()));
-      else if (property == "localport")
-        (*current_liboctave_error_handler) ("can not set this property");
-      else if (property == "localhost")
-        (*current_liboctave_error_handler) ("can not set this property");
-      else if (property == "status")
-        (*current_liboctave_error_handler) ("can not set this property");
-      else if (property == "timeout")
-        return octave_value (udp->set_timeout (args(2).double_value ()));
-      else if (property == "flush")
-        return octave_value (udp->flush (args(2).int_value ()));
-      else
-        (*current_liboctave_error_handler) ("invalid property name");
-    }
+  const octave_property<octave_udp> *prop = octave_udp::properties ().find_exact (args(1).string_value ());
+  if (! prop)
+    (*current_liboctave_error_handler) ("invalid property name");
 
+  return prop->handler (udp, args.slice (2, args.length ()-2), nargout);
 #endif
     /* never reached in normal operation */
   (*current_liboctave_error_handler) ("Your system doesn't support the UDP interface");
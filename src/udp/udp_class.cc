@@ -44,6 +44,8 @@
 #endif
 
 #include "udp_class.h"
+#include "../common/socket_wait.h"
+#include "../common/socket_util.h"
 
 #ifndef __WIN32__
 #  define SOCKETERR errno
@@ -54,23 +56,6 @@
 #  define socklen_t int
 #endif
 
-static struct timeval
-to_timeval(int ms)
-{
-  struct timeval tv;
-  if(ms <= 0)
-    {
-      tv.tv_usec = 0;
-      tv.tv_sec = 0;
-    }
-    else
-    {
-      tv.tv_usec = (ms % 1000) * 1000;
-      tv.tv_sec = ms/1000;;
-    }
-  return tv;
-}
-
 static std::string 
 to_ip_str (const sockaddr_in *in)
 {
@@ -88,27 +73,10 @@ to_ip_str (const sockaddr_in *in)
   return n.str ();
 }
 
-static bool 
-lookup_addr (const std::string &ip, sockaddr_in *in)
-{
-  in->sin_addr.s_addr = inet_addr (ip.c_str());
-
-  if (in->sin_addr.s_addr == INADDR_NONE)
-    {
-      struct hostent * host = gethostbyname (ip.c_str());
-      if (!host)
-        return false;
-
-      memcpy(&in->sin_addr, host->h_addr_list[0], host->h_length);
-    }
-
-  return true;
-}
-
 DEFINE_OV_TYPEID_FUNCTIONS_AND_DATA (octave_udp, "octave_udp", "octave_udp");
 
 octave_udp::octave_udp (void)
-: buffer_len(0), fd(-1), timeout(-1), name(""), fieldnames(9)
+: buffer_len(0), fd(-1), timeout(-1), name("")
 {
   static bool type_registered = false;
 
@@ -117,15 +85,6 @@ octave_udp::octave_udp (void)
       type_registered = true;
       register_type ();
     }
-  fieldnames[0] = "type";
-  fieldnames[1] = "name";
-  fieldnames[2] = "remoteport";
-  fieldnames[3] = "remotehost";
-  fieldnames[4] = "localport";
-  fieldnames[5] = "status";
-  fieldnames[6] = "timeout";
-  fieldnames[7] = "bytesavailable";
-  fieldnames[8] = "localhost";
 }
 
 octave_value_list
@@ -141,12 +100,14 @@ octave_udp::subsref (const std::string& type, const std::list<octave_value_list>
       break;
     case '.':
       {
-        octave_value_list ovl;
-        // inc ref count as assign this to octave_value
-        OV_COUNT++; 
-        ovl (0) = octave_value (this);
-        ovl (1) = (idx.front ()) (0);
-        retval = OCTAVE__FEVAL (std::string ("__udp_properties__"), ovl, 1);
+        const octave_property<octave_udp> *prop = properties ().find_exact ((idx.front ()) (0).string_value ());
+        if (! prop)
+          {
+            error ("invalid property name");
+            return retval;
+          }
+
+        retval = prop->handler (this, octave_value_list (), 1);
       }
       break;
     }
@@ -170,13 +131,14 @@ octave_udp::subsasgn (const std::string& type, const std::list<octave_value_list
     case '.':
       if (type.length () == 1)
         {
-          octave_value_list ovl;
-          // inc ref count as assign this to octave_value
-          OV_COUNT++; 
-          ovl (0) = octave_value (this);
-          ovl (1) = (idx.front ()) (0);
-          ovl (2) = rhs;
-          OCTAVE__FEVAL (std::string ("__udp_properties__"), ovl, 0);
+          const octave_property<octave_udp> *prop = properties ().find_exact ((idx.front ()) (0).string_value ());
+          if (! prop)
+            {
+              error ("invalid property name");
+              return retval;
+            }
+
+          prop->handler (this, octave_value_list (rhs), 0);
           OV_COUNT++;
           retval = octave_value (this);
         }
@@ -225,7 +187,7 @@ octave_udp::open (const std::string &address, int port, int localport)
 
   memset (&remote_addr, 0, sizeof (remote_addr));
 
-  if( !lookup_addr (address, &remote_addr))
+  if( !octave_lookup_addr (address, &remote_addr))
     {
       int err = SOCKETERR;
       octave_udp::close ();
@@ -333,9 +295,6 @@ octave_udp::read (uint8_t *buf, unsigned int len, double readtimeout)
 {
   struct sockaddr_in addr;
   socklen_t addrlen = sizeof (addr);
-  struct timeval tv;
-
-  fd_set readfds;
 
   if (get_fd () < 0)
     {
@@ -346,27 +305,24 @@ octave_udp::read (uint8_t *buf, unsigned int len, double readtimeout)
   size_t bytes_read = 0;
   ssize_t read_retval = -1;
 
+  // the timeout is for the whole read, not each wait for data
+  octave_deadline deadline (readtimeout);
+
   // While not interrupted in blocking mode
   while (bytes_read < len)
     {
-      OCTAVE_QUIT;
-
       // need get some data in the buffer
       if (buffer_pos == 0)
         {
           // need read some data first
-          tv = to_timeval((readtimeout < 0 || readtimeout > 1000) ? 1000 : readtimeout);
-
-          FD_ZERO (&readfds);
-          FD_SET (get_fd (), &readfds);
-
-          if (::select(get_fd ()+1, &readfds, NULL, NULL, &tv) < 0)
+          int ready = octave_wait_readable (get_fd (), deadline);
+          if (ready < 0)
             {
-                error("udp_read: Error while reading/select: %d - %s\n", SOCKETERR, STRSOCKETERR);
+                error("udp_read: Error while reading/poll: %d - %s\n", SOCKETERR, STRSOCKETERR);
                 break;
             }
 
-          if (FD_ISSET (get_fd (), &readfds))
+          if (ready > 0)
             {
               int available = get_bytesavailable();
 
@@ -408,15 +364,7 @@ octave_udp::read (uint8_t *buf, unsigned int len, double readtimeout)
           else 
             {
               // Timeout
-              if (readtimeout >= 0)
-                {
-                  // real timeout
-                  if (readtimeout <= 1000)
-                    break;
-                  // timed out 1 sec of an actual timeout
-                  else
-                    readtimeout -= 1000;
-                }
+              break;
             }
         }
 
@@ -517,7 +465,7 @@ octave_udp::set_remote_addr (const std::string &addr)
     {
       error ("udp_remote_addr: value must be non empty");
     }
-  else if ( !lookup_addr(addr, &remote_addr))
+  else if ( !octave_lookup_addr (addr, &remote_addr))
     {
       error ("udp: error looking up remote host : %d - %s\n", SOCKETERR, STRSOCKETERR);
     }
@@ -579,11 +527,7 @@ octave_udp::close (void)
 
   if (get_fd() > 0)
     {
-#ifndef __WIN32__
-      retval = ::close (get_fd ());
-#else
-      retval = ::closesocket (get_fd ());
-#endif
+      retval = octave_close_socket (get_fd ());
       fd = -1;
     }
 
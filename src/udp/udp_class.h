@@ -33,6 +33,8 @@
 #  include "../config.h"
 #endif
 
+#include "../common/property_table.h"
+
 class octave_udp : public OCTAVE_BASE_CLASS
 {
 public:
@@ -73,7 +75,7 @@ public:
   bool isobject (void) const { return true; }
 
   // required to use subsasn
-  string_vector map_keys (void) const { return fieldnames; }
+  string_vector map_keys (void) const { return properties ().fieldnames (); }
   dim_vector dims (void) const { static dim_vector dv(1, 1); return dv; }
 
   // use single copy of each udp socket
@@ -92,6 +94,8 @@ public:
 
   octave_value subsasgn (const std::string& type, const std::list<octave_value_list>& idx, const octave_value& rhs);
 
+  static const octave_property_table<octave_udp> & properties (void);
+
   std::string get_name (void) const { return name; }
   std::string set_name (const std::string &);
 
@@ -125,7 +129,6 @@ private:
   std::string name;
   sockaddr_in remote_addr;
   sockaddr_in local_addr;
-  string_vector fieldnames;
 
   DECLARE_OV_TYPEID_FUNCTIONS_AND_DATA
 };
@@ -76,14 +76,6 @@ The udp_read() shall return number of bytes successfully read in @var{count} as
 
   buffer_len = args(1).int_value();
 
-  OCTAVE_LOCAL_BUFFER (uint8_t, buffer, (buffer_len + 1));
-
-  if (buffer == NULL)
-    {
-      error("udp_read: cannot allocate requested memory: %s\n", strerror(errno));
-      return octave_value(-1);
-    }
-
   octave_udp* udp = NULL;
 
   const octave_base_value& rep = args(0).get_rep();
@@ -95,15 +87,15 @@ The udp_read() shall return number of bytes successfully read in @var{count} as
       timeout = args(2).double_value();
     }
 
-  // Read data
-  int bytes_read = udp->read(buffer, buffer_len, timeout);
+  // Read data directly into the result array
+  uint8NDArray data (dim_vector (1, buffer_len));
+
+  int bytes_read = udp->read(reinterpret_cast<uint8_t *> (data.fortran_vec ()), buffer_len, timeout);
 
   // Convert data to octave type variables
   octave_value_list return_list;
-  uint8NDArray data( dim_vector(1, bytes_read) );
-
-  for (int i = 0; i < bytes_read; i++)
-    data(i) = buffer[i];
+  // trim to the bytes actually read
+  data.resize (dim_vector (1, bytes_read));
 
   return_list(0) = data;
   return_list(1) = bytes_read;
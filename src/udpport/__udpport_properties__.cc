@@ -22,7 +22,7 @@
 
 #ifdef BUILD_UDP
 #  include "udpport_class.h"
-#endif
+#  include "../common/async_properties.h"
 
 static octave_value_list get_terminator (octave_udpport* udp)
 {
@@ -74,6 +74,295 @@ static octave_value set_terminator(octave_udpport* udp, const octave_value_list&
   return octave_value();
 }
 
+static octave_value_list
+udpport_type (octave_udpport *udpport, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (udpport->get_type ());
+}
+
+static octave_value_list
+udpport_name (octave_udpport *udpport, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  if (args.length () > 0)
+    return octave_value (udpport->set_name (args(0).string_value ()));
+
+  return octave_value (udpport->get_name ());
+}
+
+static octave_value_list
+udpport_localport (octave_udpport *udpport, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (udpport->get_local_port ());
+}
+
+static octave_value_list
+udpport_localhost (octave_udpport *udpport, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (udpport->get_local_addr ());
+}
+
+static octave_value_list
+udpport_status (octave_udpport *udpport, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (udpport->get_status ());
+}
+
+static octave_value_list
+udpport_timeout (octave_udpport *udpport, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  if (args.length () > 0)
+    return octave_value (udpport->set_timeout (args(0).double_value ()));
+
+  return octave_value (udpport->get_timeout ());
+}
+
+static octave_value_list
+udpport_numbytesavailable (octave_udpport *udpport, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (udpport->get_bytesavailable ());
+}
+
+static octave_value_list
+udpport_numbyteswritten (octave_udpport *udpport, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (udpport->get_byteswritten ());
+}
+
+static octave_value_list
+udpport_byteorder (octave_udpport *udpport, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  if (args.length () > 0)
+    return octave_value (udpport->set_byteorder (args(0).string_value ()));
+
+  return octave_value (udpport->get_byteorder ());
+}
+
+static octave_value_list
+udpport_userdata (octave_udpport *udpport, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  if (args.length () > 0)
+    {
+      udpport->set_userdata (args(0));
+      return octave_value ();
+    }
+
+  return octave_value (udpport->get_userdata ());
+}
+
+static octave_value_list
+udpport_multicastgroup (octave_udpport *udpport, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  if (args.length () > 0)
+    return octave_value (udpport->set_multicastgroup (args(0).string_value ()));
+
+  return octave_value (udpport->get_multicastgroup ());
+}
+
+static octave_value_list
+udpport_enablemulticast (octave_udpport *udpport, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (udpport->get_multicastgroup ().length () > 0 ? 1 : 0);
+}
+
+static octave_value_list
+udpport_enablemulticastloopback (octave_udpport *udpport, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  if (args.length () > 0)
+    return octave_value (udpport->set_multicastloopback (args(0).int_value ()));
+
+  return octave_value (udpport->get_multicastloopback ());
+}
+
+static octave_value_list
+udpport_enablebroadcast (octave_udpport *udpport, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  if (args.length () > 0)
+    return octave_value (udpport->set_enablebroadcast (args(0).int_value ()));
+
+  return octave_value (udpport->get_enablebroadcast ());
+}
+
+static octave_value_list
+udpport_enableportsharing (octave_udpport *udpport, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (udpport->get_enableportsharing ());
+}
+
+static octave_value_list
+udpport_ipaddressversion (octave_udpport *udpport, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (udpport->get_ipaddressversion ());
+}
+
+static octave_value_list
+udpport_terminator (octave_udpport *udpport, const octave_value_list& args, int)
+{
+  if (args.length () > 2)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  if (args.length () > 0)
+    return set_terminator (udpport, args);
+
+  return get_terminator (udpport);
+}
+
+static octave_value_list
+udpport_tag (octave_udpport *udpport, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  if (args.length () > 0)
+    {
+      udpport->set_tag (args(0).string_value ());
+      return octave_value ();
+    }
+
+  return octave_value (udpport->get_tag ());
+}
+
+static octave_value_list
+udpport_remoteport (octave_udpport *udpport, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (udpport->get_remote_port ());
+}
+
+static octave_value_list
+udpport_remotehost (octave_udpport *udpport, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (udpport->get_remote_addr ());
+}
+
+static octave_value_list
+udpport_flush (octave_udpport *udpport, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () == 0)
+    (*current_liboctave_error_handler) ("invalid property name");
+
+  return octave_value (udpport->flush (args(0).int_value ()));
+}
+
+static const octave_property<octave_udpport> udpport_property_list[] =
+{
+  {"Type", udpport_type, true},
+  {"Name", udpport_name, true},
+  {"LocalPort", udpport_localport, true},
+  {"LocalHost", udpport_localhost, true},
+  {"Status", udpport_status, true},
+  {"Timeout", udpport_timeout, true},
+  {"NumBytesAvailable", udpport_numbytesavailable, true},
+  {"NumBytesWritten", udpport_numbyteswritten, true},
+  {"ByteOrder", udpport_byteorder, true},
+  {"UserData", udpport_userdata, true},
+  {"MulticastGroup", udpport_multicastgroup, true},
+  {"EnableMulticast", udpport_enablemulticast, true},
+  {"EnableMulticastLoopback", udpport_enablemulticastloopback, true},
+  {"EnableBroadcast", udpport_enablebroadcast, true},
+  {"EnablePortSharing", udpport_enableportsharing, true},
+  {"IPAddressVersion", udpport_ipaddressversion, true},
+  {"Terminator", udpport_terminator, true},
+  {"Tag", udpport_tag, true},
+  {"ReadAsyncMode", octave_async_readasyncmode<octave_udpport>, true},
+  {"BytesAvailableFcn", octave_async_bytesavailablefcn<octave_udpport>, true},
+  {"BytesAvailableFcnCount", octave_async_bytesavailablefcncount<octave_udpport>, true},
+  {"BytesAvailableFcnMode", octave_async_bytesavailablefcnmode<octave_udpport>, true},
+  {"InputBufferSize", octave_async_inputbuffersize<octave_udpport>, true},
+  {"NumBytesDropped", octave_async_numbytesdropped<octave_udpport>, true},
+  // internals
+  {"RemotePort", udpport_remoteport, false},
+  {"RemoteHost", udpport_remotehost, false},
+  {"flush", udpport_flush, false},
+  {"configurecallback", octave_async_configurecallback<octave_udpport>, false},
+  {"waitinfo", octave_async_waitinfo<octave_udpport>, false},
+  {NULL, NULL, false}
+};
+
+const octave_property_table<octave_udpport> &
+octave_udpport::properties (void)
+{
+  static const octave_property_table<octave_udpport> table (udpport_property_list);
+  return table;
+}
+#endif
+
 // PKG_ADD: autoload ("__udpport_properties__", "udpport.oct");
 DEFUN_DLD (__udpport_properties__, args, nargout,
 "-*- texinfo -*-\n\
@@ -89,96 +378,12 @@ Undocumented internal function.\n\
     
   const octave_base_value& rep = args(0).get_rep ();
   octave_udpport* udpport = &((octave_udpport &)rep);
-    
-  std::string property = args(1).string_value ();
-  std::transform (property.begin (), property.end (), property.begin (), ::tolower);
-
-  int maxinputs = 3;
-  if (property == "terminator")
-    maxinputs = 4;
-
-  if (args.length () > maxinputs)
-      (*current_liboctave_error_handler) ("wrong number of arguments");
 
-  if (args.length () == 2) // get
-    {
-      if (property == "name")
-        return octave_value (udpport->get_name ());
-      else if (property == "tag")
-        return octave_value (udpport->get_tag ());
-      else if (property == "type")
-        return octave_value (udpport->get_type ());
-      else if (property == "remoteport")
-        return octave_value (udpport->get_remote_port ());
-      else if (property == "remotehost")
-        return octave_value (udpport->get_remote_addr ());
-      else if (property == "localport")
-        return octave_value (udpport->get_local_port ());
-      else if (property == "localhost")
-        return octave_value (udpport->get_local_addr ());
-      else if (property == "status")
-        return octave_value (udpport->get_status ());
-      else if (property == "timeout")
-        return octave_value (udpport->get_timeout ());
-      else if (property == "numbytesavailable")
-        return octave_value (udpport->get_bytesavailable ());
-      else if (property == "numbyteswritten")
-        return octave_value (udpport->get_byteswritten ());
-      else if (property == "userdata")
-        return octave_value (udpport->get_userdata ());
-      else if (property == "terminator")
-        return get_terminator (udpport);
-      else if (property == "multicastgroup")
-        return octave_value (udpport->get_multicastgroup ());
-      else if (property == "enablemulticast")
-        return octave_value (udpport->get_multicastgroup ().length () > 0 ? 1 : 0);
-      else if (property == "enablemulticastloopback")
-        return octave_value (udpport->get_multicastloopback ()); 
-      else if (property == "enableportsharing")
-        return octave_value (udpport->get_enableportsharing ()); 
-      else if (property == "enablebroadcast")
-        return octave_value (udpport->get_enablebroadcast ()); 
-      else if (property == "ipaddressversion")
-        return octave_value (udpport->get_ipaddressversion ()); 
-      else if (property == "byteorder")
-        return octave_value (udpport->get_byteorder ()); 
-      else
-        (*current_liboctave_error_handler) ("invalid property name");
-    }
-  else // set
-    {
-      if (property == "name")
-        return octave_value (udpport->set_name (args(2).string_value ()));
-      else if (property == "tag")
-        { udpport->set_tag (args(2).string_value ()); return octave_value(); }
-      else if (property == "type")
-        (*current_liboctave_error_handler) ("can not set this property");
-      else if (property == "localport")
-        (*current_liboctave_error_handler) ("can not set this property");
-      else if (property == "localhost")
-        (*current_liboctave_error_handler) ("can not set this property");
-      else if (property == "status")
-        (*current_liboctave_error_handler) ("can not set this property");
-      else if (property == "timeout")
-        return octave_value (udpport->set_timeout (args(2).double_value ()));
-      else if (property == "flush")
-        return octave_value (udpport->flush (args(2).int_value ()));
-      else if (property == "terminator")
-        return set_terminator (udpport, args.slice (2, args.length ()-2));
-      else if (property == "userdata")
-        { udpport->set_userdata (args(2)); return octave_value(); } 
-      else if (property == "multicastgroup")
-        return octave_value (udpport->set_multicastgroup (args(2).string_value ()));
-      else if (property == "byteorder")
-        return octave_value (udpport->set_byteorder (args(2).string_value ())); 
-      else if (property == "enablemulticastloopback")
-        return octave_value (udpport->set_multicastloopback (args(2).int_value ()));
-      else if (property == "enablebroadcast")
-        return octave_value (udpport->set_enablebroadcast (args(2).int_value ()));
-      else
-        (*current_liboctave_error_handler) ("invalid property name");
-    }
+  const octave_property<octave_udpport> *prop = octave_udpport::properties ().find (args(1).string_value ());
+  if (! prop)
+    (*current_liboctave_error_handler) ("invalid property name");
 
+  return prop->handler (udpport, args.slice (2, args.length ()-2), nargout);
 #endif
     /* never reached in normal operation */
   (*current_liboctave_error_handler) ("Your system doesn't support the UDP interface");
@@ -25,6 +25,7 @@
 #include <errno.h>
 
 #include "udpport_class.h"
+#include "../common/typed_data.h"
 
 #endif
 
@@ -33,13 +34,15 @@ DEFUN_DLD (__udpport_read__, args, nargout,
         "-*- texinfo -*-\n\
 @deftypefn {} {[@var{data}, @var{count}] = } __udpport_read__ (@var{udpport}, @var{n}, @var{timeout})\n \
 @deftypefnx {} {[@var{data}, @var{count}. @var{srcip}, @var{srcport}] = } __udpport_read__ (@var{udpport}, @var{n}, @var{timeout})\n \
+@deftypefnx {} {[@var{data}, @var{count}. @var{srcip}, @var{srcport}] = } __udpport_read__ (@var{udpport}, @var{n}, @var{timeout}, @var{datatype})\n \
 \n\
 Provate function to read from udpport interface.\n \
 \n\
 @subsubheading Inputs\n \
 @var{udpport} - instance of @var{octave_udpport} class.@* \
 @var{n} - number of bytes to attempt to read of type Integer@* \n \
-@var{timeout} - timeout in ms if different from default of type Integer\n \
+@var{timeout} - timeout in ms if different from default of type Integer@* \
+@var{datatype} - precision to read as, in which case @var{n} is the number of values to read, or -1 for all available values, and @var{count} is the number of values read\n \
 \n\
 @subsubheading Outputs\n \
 The __udpport_read__() shall return number of bytes successfully read in @var{count} as Integer and the bytes themselves in @var{data} as uint8 array.\n \
@@ -51,7 +54,7 @@ Optional outputs are provided for the source ip address and port of the read dat
   return octave_value();
 #else
 
-  if (args.length() < 2 || args.length() > 3 || args(0).type_id() != octave_udpport::static_type_id())
+  if (args.length() < 2 || args.length() > 4 || args(0).type_id() != octave_udpport::static_type_id())
     {
       print_usage();
       return octave_value(-1);
@@ -77,37 +80,69 @@ Optional outputs are provided for the source ip address and port of the read dat
 
   buffer_len = args(1).int_value();
 
-  OCTAVE_LOCAL_BUFFER (uint8_t, buffer, (buffer_len + 1));
-
-  if (buffer == NULL)
-    {
-      error("udpport_read: cannot allocate requested memory: %s\n", strerror(errno));
-      return octave_value(-1);
-    }
-
   octave_udpport* udpport = NULL;
 
   const octave_base_value& rep = args(0).get_rep();
   udpport = &((octave_udpport &)rep);
 
+  // run any BytesAvailableFcn callbacks that are due
+  udpport->dispatch_callbacks ();
+
   double timeout = udpport->get_timeout() * 1000;
-  if (args.length() == 3)
+  if (args.length() > 2)
     {
       timeout = args(2).double_value();
     }
 
-  // Read data
-  int bytes_read = udpport->read(buffer, buffer_len, timeout, &addr);
-
-  // Convert data to octave type variables
   octave_value_list return_list;
-  uint8NDArray data( dim_vector(1, bytes_read) );
+  int bytes_read;
+
+  if (args.length() > 3)
+    {
+      // Read values of the requested type directly into the result array
+      octave_data_type type;
+
+      if (! args(3).is_string())
+        {
+          print_usage();
+          return octave_value(-1);
+        }
+      if (! octave_data_type_lookup (args(3).string_value(), type))
+        {
+          error ("__udpport_read__: precision not supported");
+          return octave_value(-1);
+        }
 
-  for (int i = 0; i < bytes_read; i++)
-    data(i) = buffer[i];
+      int count = args(1).int_value();
+      if (count < 0)
+        count = udpport->get_bytesavailable() / type.size;
+
+      bool swap = octave_byteorder_needs_swap (udpport->get_byteorder());
+
+      bytes_read = 0;
+      octave_value data = octave_read_typed (type, count, swap,
+        [udpport, timeout, &addr, &bytes_read] (uint8_t *buf, unsigned int len)
+        {
+          bytes_read = udpport->read(buf, len, timeout, &addr);
+          return bytes_read;
+        });
 
-  return_list(0) = data;
-  return_list(1) = bytes_read;
+      return_list(0) = data;
+      return_list(1) = data.numel();
+    }
+  else
+    {
+      // Read data directly into the result array
+      uint8NDArray data (dim_vector (1, buffer_len));
+
+      bytes_read = udpport->read(reinterpret_cast<uint8_t *> (data.fortran_vec ()), buffer_len, timeout, &addr);
+
+      // trim to the bytes actually read
+      data.resize (dim_vector (1, bytes_read));
+
+      return_list(0) = data;
+      return_list(1) = bytes_read;
+    }
 
   if (nargout > 2)
     {
@@ -0,0 +1,103 @@
+// Copyright (C) 2026   John Donoghue   <john.donoghue@ieee.org>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+
+#include <octave/oct.h>
+
+#ifdef HAVE_CONFIG_H
+#include "../config.h"
+#endif
+
+#ifdef BUILD_UDP
+#include "udpport_class.h"
+#endif
+
+// PKG_ADD: autoload ("__udpport_readline__", "udpport.oct");
+DEFUN_DLD (__udpport_readline__, args, nargout,
+        "-*- texinfo -*-\n\
+@deftypefn {} {[@var{data}, @var{found}] = } __udpport_readline__ (@var{udpport}, @var{timeout})\n \
+\n\
+Private function to read a line from udpport interface.\n \
+\n\
+Data is read in blocks into a receive buffer on the object and scanned for\n \
+the input terminator. Any data after the terminator is kept for the next read.\n \
+\n\
+@subsubheading Inputs\n \
+@var{udpport} - instance of @var{octave_udpport} class.@* \
+@var{timeout} - timeout in ms if different from default of type Integer\n \
+\n\
+@subsubheading Outputs\n \
+@var{data} - data read, excluding the terminator, as a string.@*\n \
+@var{found} - true if the terminator was found before a timeout.\n \
+@end deftypefn")
+{
+#ifndef BUILD_UDP
+  error ("udpport: Your system doesn't support the UDP interface");
+  return octave_value ();
+#else
+
+  if (args.length () < 1 || args.length () > 2 || args (0).type_id () != octave_udpport::static_type_id ())
+    {
+      print_usage ();
+      return octave_value (-1);
+    }
+
+  if (args.length () > 1 && ! (args (1).OV_ISINTEGER () || args (1).OV_ISFLOAT ()))
+    {
+      print_usage ();
+      return octave_value (-1);
+    }
+
+  octave_udpport* udpport = NULL;
+
+  const octave_base_value& rep = args (0).get_rep ();
+  udpport = &((octave_udpport &)rep);
+
+  // run any BytesAvailableFcn callbacks that are due
+  udpport->dispatch_callbacks ();
+
+  double timeout = udpport->get_timeout () * 1000;
+  if (args.length () > 1)
+    {
+      timeout = args (1).double_value ();
+    }
+
+  std::string line;
+  bool found = udpport->readline (line, timeout);
+
+  octave_value_list return_list;
+  return_list(0) = line;
+  return_list(1) = found;
+
+  return return_list;
+#endif
+}
+
+#if 0
+%!error <Invalid call to __udpport_readline__> __udpport_readline__ ()
+
+%!error <Invalid call to __udpport_readline__> __udpport_readline__ (1)
+
+%!test
+%! a = udpport ();
+%! a.Timeout = 1;
+%! write (a, "hello\nworld\n", "127.0.0.1", a.LocalPort);
+%! [d, f] = __udpport_readline__ (a);
+%! assert (d, "hello");
+%! assert (f, true);
+%! [d, f] = __udpport_readline__ (a);
+%! assert (d, "world");
+%! clear a
+
+#endif
@@ -21,6 +21,8 @@
 
 #ifdef BUILD_UDP
 #  include "udpport_class.h"
+#  include "../common/byte_view.h"
+#  include "../common/typed_data.h"
 #endif
 
 // PKG_ADD: autoload ("__udpport_write__", "udpport.oct");
@@ -28,14 +30,17 @@ DEFUN_DLD (__udpport_write__, args, nargout,
         "-*- texinfo -*-\n\
 @deftypefn {} {@var{n} = } __udpport_write__ (@var{udpport}, @var{data})\n \
 @deftypefnx {} {@var{n} = } __udpport_write__ (@var{udpport}, @var{data}, @var{destipaddress}, @var{destport})\n \
+@deftypefnx {} {@var{n} = } __udpport_write__ (@var{udpport}, @var{data}, @var{datatype})\n \
+@deftypefnx {} {@var{n} = } __udpport_write__ (@var{udpport}, @var{data}, @var{destipaddress}, @var{destport}, @var{datatype})\n \
 \n\
 Provate function to write data to a udpport interface.\n \
 \n\
 @subsubheading Inputs\n \
 @var{udpport} - instance of @var{octave_udpport} class.@* \
-@var{data} - data to be written to the udpport interface. Can be either of String or uint8 type.\n \
+@var{data} - data to be written to the udpport interface. Can be a String, or an integer or floating point array which is written as its raw bytes.@* \
 @var{destipaddress} - ip address to write to.@* \
-@var{destport} - port number to write to.\n \
+@var{destport} - port number to write to.@* \
+@var{datatype} - precision to convert @var{data} to before writing, in the byte order of the object.\n \
 \n\
 If @var{destipaddress}, @var{destport} is not provided, write will go to the address configure from the udpport\n \
 creation or last used for write.\n \
@@ -48,7 +53,7 @@ Upon successful completion, __udpport_write__() shall return the number of bytes
   error("udpport: Your system doesn't support the UDP interface");
   return octave_value();
 #else
-  if ((args.length() != 2 && args.length() != 4) || args(0).type_id() != octave_udpport::static_type_id())
+  if (args.length() < 2 || args.length() > 5 || args(0).type_id() != octave_udpport::static_type_id())
     {
       print_usage();
       return octave_value(-1);
@@ -63,7 +68,7 @@ Upon successful completion, __udpport_write__() shall return the number of bytes
   std::string destip = "";
   int destport = 0;
 
-  if (args.length() == 4)
+  if (args.length() > 3)
     {
       if (!args(2).is_string())
         {
@@ -80,34 +85,43 @@ Upon successful completion, __udpport_write__() shall return the number of bytes
       destport = args(3).int_value();
     }
 
-  if (args(1).is_string()) // String
+  if (args.length() == 3 || args.length() == 5)
     {
-      retval = udpport->write(args(1).string_value(), destip, destport);
-    }
-  else if (args(1).is_uint8_type ())
-    {
-      NDArray data = args(1).array_value();
-      OCTAVE_LOCAL_BUFFER (uint8_t, buf, (data.numel ()));
+      octave_data_type type;
+      const octave_value& typearg = args(args.length() - 1);
 
-      // memcpy?
-      if (buf == NULL)
+      if (! typearg.is_string())
+        {
+          print_usage();
+          return octave_value(-1);
+        }
+      if (! octave_data_type_lookup (typearg.string_value(), type))
         {
-          error("udpport_write: cannot allocate requested memory");
+          error ("__udpport_write__: precision not supported");
           return octave_value(-1);
         }
 
-      for (int i = 0; i < data.numel(); i++)
-        buf[i] = static_cast<uint8_t>(data(i));
+      bool swap = octave_byteorder_needs_swap (udpport->get_byteorder());
 
-      retval = udpport->write(buf, data.numel(), destip, destport);
+      retval = octave_write_typed (args(1), type, swap,
+        [udpport, &destip, destport] (uint8_t *buf, unsigned int len)
+        {
+          return udpport->write(buf, len, destip, destport);
+        });
 
+      return octave_value(retval);
     }
-  else
+
+  octave_byte_view data (args(1));
+
+  if (! data.is_valid ())
     {
       print_usage();
       return octave_value(-1);
     }
 
+  retval = udpport->write(data.data (), data.length (), destip, destport);
+
   return octave_value(retval);
 #endif
 }
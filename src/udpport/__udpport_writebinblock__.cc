@@ -0,0 +1,97 @@
+// Copyright (C) 2026   John Donoghue   <john.donoghue@ieee.org>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+
+#include <octave/oct.h>
+
+#ifdef HAVE_CONFIG_H
+#  include "../config.h"
+#endif
+
+#ifdef BUILD_UDP
+#  include "udpport_class.h"
+#  include "../common/binblock.h"
+#endif
+
+// PKG_ADD: autoload ("__udpport_writebinblock__", "udpport.oct");
+DEFUN_DLD (__udpport_writebinblock__, args, nargout,
+        "-*- texinfo -*-\n\
+@deftypefn {} {@var{n} = } __udpport_writebinblock__ (@var{udpport}, @var{data}, @var{datatype})\n \
+\n\
+Private function to write data as a IEEE 488.2 binblock to a udpport interface.\n \
+\n\
+The block header, data and terminator are sent with a single gathered write,\n \
+without copying the data.\n \
+\n\
+@subsubheading Inputs\n \
+@var{udpport} - instance of @var{octave_udpport} class.@* \
+@var{data} - data to write.@* \
+@var{datatype} - precision to convert @var{data} to, in the byte order of the object.\n \
+\n\
+@subsubheading Outputs\n \
+@var{n} - number of bytes written, including the header and terminator.\n \
+@end deftypefn")
+{
+#ifndef BUILD_UDP
+  error ("udpport: Your system doesn't support the UDP interface");
+  return octave_value ();
+#else
+
+  if (args.length () != 3 || args (0).type_id () != octave_udpport::static_type_id () || ! args (2).is_string ())
+    {
+      print_usage ();
+      return octave_value (-1);
+    }
+
+  octave_data_type type;
+
+  if (! octave_data_type_lookup (args (2).string_value (), type))
+    {
+      error ("__udpport_writebinblock__: datatype not supported");
+      return octave_value (-1);
+    }
+
+  octave_udpport* udpport = NULL;
+
+  const octave_base_value& rep = args (0).get_rep ();
+  udpport = &((octave_udpport &)rep);
+
+  bool swap = octave_byteorder_needs_swap (udpport->get_byteorder ());
+
+  int retval = octave_write_binblock_parts (args (1), type, swap,
+    [udpport] (const octave_write_part *parts, int nparts)
+    {
+      return udpport->write_parts (parts, nparts);
+    });
+
+  return octave_value (retval);
+#endif
+}
+
+#if 0
+%!error <Invalid call to __udpport_writebinblock__> __udpport_writebinblock__ ()
+
+%!error <Invalid call to __udpport_writebinblock__> __udpport_writebinblock__ (1, "hello", "uint8")
+
+%!test
+%! a = udpport ();
+%! a.Timeout = 1;
+%! write (a, "a", "127.0.0.1", a.LocalPort);
+%! flush (a);
+%! a.ByteOrder = "big-endian";
+%! assert (__udpport_writebinblock__ (a, [1 2], "uint16"), 8);
+%! assert (read (a, 8), uint8 ([35 49 52 0 1 0 2 10]));
+%! clear a
+
+#endif
@@ -43,6 +43,9 @@
 #endif
 
 #include "udpport_class.h"
+#include "../common/socket_wait.h"
+#include "../common/binblock.h"
+#include "../common/socket_util.h"
 #include <octave/Matrix.h>
 
 #ifndef __WIN32__
@@ -54,21 +57,17 @@
 #  define socklen_t int
 #endif
 
-static struct timeval
-to_timeval(int ms)
+// read used by the background reader thread, so must not call any octave
+// functions. Returns 0 on a timeout and -1 on an error.
+static int
+async_socket_read (int sock, uint8_t *buf, unsigned int len, int ms)
 {
-  struct timeval tv;
-  if(ms <= 0)
-    {
-      tv.tv_usec = 0;
-      tv.tv_sec = 0;
-    }
-    else
-    {
-      tv.tv_usec = (ms % 1000) * 1000;
-      tv.tv_sec = ms/1000;;
-    }
-  return tv;
+  int ret = octave_poll_readable (sock, ms);
+  if (ret <= 0)
+    return ret;
+
+  ret = ::recv (sock, reinterpret_cast<char *> (buf), len, 0);
+  return ret >= 0 ? ret : -1;
 }
 
 static std::string 
@@ -88,23 +87,6 @@ to_ip_str (const sockaddr_in *in)
   return n.str ();
 }
 
-static bool 
-lookup_addr (const std::string &ip, sockaddr_in *in)
-{
-  in->sin_addr.s_addr = inet_addr (ip.c_str());
-
-  if (in->sin_addr.s_addr == INADDR_NONE)
-    {
-      struct hostent * host = gethostbyname (ip.c_str());
-      if (!host)
-        return false;
-
-      memcpy(&in->sin_addr, host->h_addr_list[0], host->h_length);
-    }
-
-  return true;
-}
-
 int to_ip_port (const sockaddr_in *in, std::string &ip, int &port)
 {
   port = ntohs (in->sin_port);
@@ -115,7 +97,7 @@ int to_ip_port (const sockaddr_in *in, std::string &ip, int &port)
 DEFINE_OV_TYPEID_FUNCTIONS_AND_DATA (octave_udpport, "octave_udpport", "octave_udpport");
 
 octave_udpport::octave_udpport (void)
-: buffer_len(0), fd(-1), timeout(-1), name(""), fieldnames(18)
+: buffer_len(0), fd(-1), timeout(-1), name("")
 {
   static bool type_registered = false;
 
@@ -132,34 +114,6 @@ octave_udpport::octave_udpport (void)
   enablebroadcast = 0;
   interminator = octave_value("lf");
   outterminator = octave_value("lf");
-
-  fieldnames[0] = "Type";
-  fieldnames[1] = "Name";
-  fieldnames[2] = "LocalPort";
-  fieldnames[3] = "LocalHost";
-  fieldnames[4] = "Status";
-  fieldnames[5] = "Timeout";
-  fieldnames[6] = "NumBytesAvailable";
-  fieldnames[7] = "NumBytesWritten";
-  fieldnames[8] = "ByteOrder";
-  fieldnames[9] = "UserData";
-  fieldnames[10] = "MulticastGroup";
-  fieldnames[11] = "EnableMulticast";
-  fieldnames[12] = "EnableMulticastLoopback";
-  fieldnames[13] = "EnableBroadcast";
-  fieldnames[14] = "EnablePortSharing";
-  fieldnames[15] = "IPAddressVersion";
-  fieldnames[16] = "Terminator";
-  fieldnames[17] = "Tag";
-}
-
-bool octave_udpport::has_property(const std::string &name) const
-{
-  for (octave_idx_type i=0; i<fieldnames.numel(); i++)
-    {
-      if (fieldnames[i] == name) return true;
-    }
-  return false;
 }
 
 octave_value_list
@@ -176,19 +130,15 @@ octave_udpport::subsref (const std::string& type, const std::list<octave_value_l
     case '.':
       {
 	std::string property = (idx.front ()) (0).string_value ();
-        if (!has_property(property))
+        const octave_property<octave_udpport> *prop = properties ().find_field (property);
+        if (! prop)
 	  {
             error ("Unknown property '%s'", property.c_str());
             return retval;
           }
         else
 	  {
-            octave_value_list ovl;
-            // inc ref count as assign this to octave_value
-            OV_COUNT++; 
-            ovl (0) = octave_value (this);
-            ovl (1) = (idx.front ()) (0);
-            retval = OCTAVE__FEVAL (std::string ("__udpport_properties__"), ovl, 1);
+            retval = prop->handler (this, octave_value_list (), 1);
 	  }
       }
       break;
@@ -214,19 +164,14 @@ octave_udpport::subsasgn (const std::string& type, const std::list<octave_value_
       if (type.length () == 1)
         {
           std::string property = (idx.front ()) (0).string_value ();
-          if (! has_property(property))
+          const octave_property<octave_udpport> *prop = properties ().find_field (property);
+          if (! prop)
 	    {
               error ("Unknown property '%s'", property.c_str());
               return retval;
             }
 
-          octave_value_list ovl;
-          // inc ref count as assign this to octave_value
-          OV_COUNT++; 
-          ovl (0) = octave_value (this);
-          ovl (1) = (idx.front ()) (0);
-          ovl (2) = rhs;
-          OCTAVE__FEVAL (std::string ("__udpport_properties__"), ovl, 0);
+          prop->handler (this, octave_value_list (rhs), 0);
           OV_COUNT++;
           retval = octave_value (this);
         }
@@ -309,7 +254,7 @@ octave_udpport::open (const std::string &address, int port, int portshare)
     local_addr.sin_addr.s_addr = htonl (INADDR_ANY);
   else
     {
-      lookup_addr(address, &local_addr);
+      octave_lookup_addr (address, &local_addr);
     }
   local_addr.sin_family = AF_INET;
   local_addr.sin_port = htons (port);
@@ -334,6 +279,7 @@ octave_udpport::open (const std::string &address, int port, int portshare)
 
 octave_udpport::~octave_udpport (void)
 {
+  octave_async_callbacks<octave_udpport>::remove (this);
   close();
 }
 
@@ -376,11 +322,11 @@ octave_udpport::get_bytesavailable () const
       return 0;
     }
   if (buffer_pos > 0)
-    return buffer_pos;
+    return buffer_pos + rxbuf.size () + async.available ();
 
   ioctl (get_fd (), FIONREAD, &available);
 
-  return available;
+  return available + rxbuf.size () + async.available ();
 }
 
 int
@@ -408,9 +354,6 @@ octave_udpport::read (uint8_t *buf, unsigned int len, double readtimeout, sockad
 {
   //struct sockaddr_in addr;
   socklen_t addrlen = sizeof (read_addr);
-  struct timeval tv;
-
-  fd_set readfds;
 
   if (get_fd () < 0)
     {
@@ -418,29 +361,44 @@ octave_udpport::read (uint8_t *buf, unsigned int len, double readtimeout, sockad
       return 0;
     }
 
-  size_t bytes_read = 0;
+  // data left over from readline is returned first
+  size_t bytes_read = rxbuf.take (buf, len);
   ssize_t read_retval = -1;
 
+  if (bytes_read > 0 && rdinfo)
+    *rdinfo = read_addr;
+
+  // data received by the background reader
+  if (async.is_running ())
+    {
+      int n = async.read (buf + bytes_read, len - bytes_read, readtimeout);
+      if (n < 0)
+        {
+          if (bytes_read == 0)
+            error ("udpport_read: Error while reading");
+          return bytes_read;
+        }
+      return bytes_read + n;
+    }
+
+  // the timeout is for the whole read, not each wait for data
+  octave_deadline deadline (readtimeout);
+
   // While not interrupted in blocking mode
   while (bytes_read < len)
     {
-      OCTAVE_QUIT;
       // need get some data in the buffer
       if (buffer_pos == 0)
         {
           // need read some data first
-          tv = to_timeval((readtimeout < 0 || readtimeout > 1000) ? 1000 : readtimeout);
- 
-          FD_ZERO (&readfds);
-          FD_SET (get_fd (), &readfds);
-
-          if (::select(get_fd ()+1, &readfds, NULL, NULL, &tv) < 0)
+          int ready = octave_wait_readable (get_fd (), deadline);
+          if (ready < 0)
             {
-                error("udpport_read: Error while reading/select: %d - %s\n", SOCKETERR, STRSOCKETERR);
+                error("udpport_read: Error while reading/poll: %d - %s\n", SOCKETERR, STRSOCKETERR);
                 break;
             }
 
-          if (FD_ISSET (get_fd (), &readfds))
+          if (ready > 0)
             {
               int available = get_bytesavailable();
 
@@ -481,15 +439,7 @@ octave_udpport::read (uint8_t *buf, unsigned int len, double readtimeout, sockad
             else 
               {
                 // Timeout
-                if (readtimeout >= 0)
-                  {
-                    // real timeout
-                    if (readtimeout <= 1000)
-                      break;
-                    // timed out 1 sec of an actual timeout
-                    else
-	              readtimeout -= 1000;
-                  }
+                break;
               }
         }
 
@@ -520,6 +470,105 @@ octave_udpport::read (uint8_t *buf, unsigned int len, double readtimeout, sockad
   return bytes_read;
 }
 
+bool
+octave_udpport::readline (std::string &line, double readtimeout)
+{
+  return rxbuf.read_line (octave_terminator_string (interminator), line,
+    [this, readtimeout] (uint8_t *buf, unsigned int len)
+    {
+      return read (buf, len, readtimeout);
+    },
+    [this] (void)
+    {
+      return get_bytesavailable ();
+    });
+}
+
+octave_value
+octave_udpport::readbinblock (const octave_data_type &type, double readtimeout)
+{
+  return octave_read_binblock (rxbuf, type, octave_byteorder_needs_swap (byteOrder),
+    [this, readtimeout] (uint8_t *buf, unsigned int len)
+    {
+      return read (buf, len, readtimeout);
+    },
+    [this] (void)
+    {
+      return get_bytesavailable ();
+    });
+}
+
+bool
+octave_udpport::writeread (const std::string &cmd, std::string &line, double readtimeout)
+{
+  // command and terminator go out in a single write
+  if (write (cmd + octave_terminator_string (outterminator)) < 0)
+    return false;
+
+  return readline (line, readtimeout);
+}
+
+void
+octave_udpport::set_readasyncmode (bool continuous)
+{
+  if (! continuous)
+    {
+      async.stop (rxbuf);
+      return;
+    }
+
+  if (async.is_running ())
+    return;
+
+  if (get_fd () < 0)
+    {
+      error ("udpport: Interface must be opened first...");
+      return;
+    }
+
+  // a part read datagram is returned first
+  if (buffer_pos > 0)
+    {
+      rxbuf.fill (buffer_pos,
+        [this] (uint8_t *buf, unsigned int len)
+        {
+          memcpy (buf, input_buffer, buffer_pos);
+          return buffer_pos;
+        },
+        [] (void)
+        {
+          return 0;
+        });
+      buffer_pos = 0;
+    }
+
+  int sock = get_fd ();
+  async.start ([sock] (uint8_t *buf, unsigned int len, int ms)
+    {
+      return async_socket_read (sock, buf, len, ms);
+    });
+}
+
+void
+octave_udpport::dispatch_callbacks (void)
+{
+  async.dispatch (octave_value (this, true));
+}
+
+int
+octave_udpport::wait_fd (bool &pending)
+{
+  if (async.is_running ())
+    {
+      int wfd = async.wait_fd ();
+      pending = rxbuf.size () > 0 || async.available () > 0 || async.has_failed ();
+      return wfd;
+    }
+
+  pending = rxbuf.size () > 0 || buffer_pos > 0;
+  return get_fd ();
+}
+
 int
 octave_udpport::write (const std::string &str, const std::string &destip, int destport)
 {
@@ -537,7 +586,7 @@ octave_udpport::write (const std::string &str, const std::string &destip, int de
 
       in.sin_family = AF_INET;
 
-      lookup_addr (destip, &in);
+      octave_lookup_addr (destip, &in);
 
       in.sin_port = htons(destport);
 
@@ -576,7 +625,7 @@ octave_udpport::write (uint8_t *buf, unsigned int len, const std::string &destip
 
       in.sin_family = AF_INET;
 
-      lookup_addr (destip, &in);
+      octave_lookup_addr (destip, &in);
 
       in.sin_port = htons(destport);
 
@@ -599,6 +648,29 @@ octave_udpport::write (uint8_t *buf, unsigned int len, const std::string &destip
   return wrote;
 }
 
+int
+octave_udpport::write_parts (const octave_write_part *parts, int nparts)
+{
+  if (get_fd () < 0)
+    {
+      error("udpport: Interface must be opened first...");
+      return -1;
+    }
+
+  if (remote_addr.sin_port == 0)
+    {
+      error("udpport: No destination address/port previously set");
+      return -1;
+    }
+
+  int wrote = octave_send_parts (get_fd (), parts, nparts,
+                                 (struct sockaddr *)&remote_addr, sizeof (remote_addr));
+  if(wrote > 0)
+    byteswritten += wrote;
+
+  return wrote;
+}
+
 int
 octave_udpport::set_timeout (double newtimeout)
 {
@@ -652,7 +724,7 @@ octave_udpport::set_remote_addr (const std::string &addr)
     {
       error ("udpport_remote_addr: value must be non empty");
     }
-  else if ( !lookup_addr(addr, &remote_addr))
+  else if ( !octave_lookup_addr (addr, &remote_addr))
     {
       error ("udpport: error looking up remote host : %d - %s\n", SOCKETERR, STRSOCKETERR);
     }
@@ -712,13 +784,12 @@ octave_udpport::close (void)
 {
   int retval = -1;
 
+  // the reader must finish before the socket is closed
+  async.stop ();
+
   if (get_fd() > 0)
     {
-#ifndef __WIN32__
-      retval = ::close (get_fd ());
-#else
-      retval = ::closesocket (get_fd ());
-#endif
+      retval = octave_close_socket (get_fd ());
       fd = -1;
     }
 
@@ -827,7 +898,7 @@ octave_udpport::set_multicastgroup (const std::string &addr)
       else
         {
           sockaddr_in in;
-          if (! lookup_addr (addr, &in))
+          if (! octave_lookup_addr (addr, &in))
            {
               error ("Could not resolve address %s", addr.c_str());
            }
@@ -902,6 +973,8 @@ octave_udpport::set_input_terminator(const octave_value& t)
   else
     error ("octave_udpport invalid input terminator");
 
+  async.set_terminator (octave_terminator_string (interminator));
+
   return 1;
 }
 
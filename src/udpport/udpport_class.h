@@ -33,6 +33,12 @@ typedef int socklen_t;
 #  include "../config.h"
 #endif
 
+#include "../common/property_table.h"
+#include "../common/byte_view.h"
+#include "../common/receive_buffer.h"
+#include "../common/typed_data.h"
+#include "../common/async_reader.h"
+
 int to_ip_port (const sockaddr_in *in, std::string &ip, int &port);
 
 class octave_udpport : public OCTAVE_BASE_CLASS
@@ -43,8 +49,20 @@ public:
 
   int write (const std::string &str, const std::string &destip="", int destport=0);
   int write (uint8_t *buf, unsigned int len, const std::string &destip="", int destport=0);
+  // the parts are sent as a single datagram to the remote address
+  int write_parts (const octave_write_part *parts, int nparts);
 
   int read (uint8_t *buf, unsigned int len, double readtimeout, sockaddr_in *rdinfo=0);
+  bool readline (std::string &line, double readtimeout);
+  octave_value readbinblock (const octave_data_type &type, double readtimeout);
+  bool writeread (const std::string &cmd, std::string &line, double readtimeout);
+
+  // background reader, used when ReadAsyncMode is "continuous"
+  octave_async_reader & get_async (void) { return async; }
+  void set_readasyncmode (bool continuous);
+  void dispatch_callbacks (void);
+  int wait_fd (bool &pending);
+  static const char * async_hook (void) { return "__udpport_async_callbacks__"; }
 
   int getsockopt (int level, int opt, void *buf, socklen_t *len);
   int setsockopt (int level, int opt, const void *buf, socklen_t len);
@@ -79,7 +97,7 @@ public:
   bool isobject (void) const { return true; }
 
   // required to use subsasn
-  string_vector map_keys (void) const { return fieldnames; }
+  string_vector map_keys (void) const { return properties ().fieldnames (); }
   dim_vector dims (void) const { static dim_vector dv(1, 1); return dv; }
 
   // use single copy of each udpport socket
@@ -98,6 +116,8 @@ public:
 
   octave_value subsasgn (const std::string& type, const std::list<octave_value_list>& idx, const octave_value& rhs);
 
+  static const octave_property_table<octave_udpport> & properties (void);
+
   std::string get_name (void) const { return name; }
   std::string set_name (const std::string &);
 
@@ -176,7 +196,6 @@ public:
   }
 
 private:
-  bool has_property(const std::string &name) const;
   uint8_t *input_buffer;
   int buffer_len;
   int buffer_pos;
@@ -188,7 +207,6 @@ private:
   std::string tag;
   sockaddr_in remote_addr;
   sockaddr_in local_addr;
-  string_vector fieldnames;
   std::vector<sockaddr_in> multicastaddr;
   octave_value userData;
   int enableportsharing;
@@ -198,6 +216,8 @@ private:
   unsigned int byteswritten;
   octave_value interminator;
   octave_value outterminator;
+  octave_receive_buffer rxbuf;
+  octave_async_reader async;
 
   DECLARE_OV_TYPEID_FUNCTIONS_AND_DATA
 };
@@ -71,14 +71,6 @@ Read from usbtmc slave device.\n \
       buffer_len = args(1).int_value();
     }
 
-  OCTAVE_LOCAL_BUFFER (uint8_t, buffer, (buffer_len + 1));
-
-  if (buffer == NULL)
-    {
-      error ("usbtmc_read: cannot allocate requested memory: %s\n", strerror (errno));
-      return octave_value (-1);
-    }
-
   octave_usbtmc* usbtmc = NULL;
 
   const octave_base_value& rep = args (0).get_rep ();
@@ -86,7 +78,10 @@ Read from usbtmc slave device.\n \
 
   int retval;
 
-  retval = usbtmc->read (buffer, buffer_len);
+  // Read data directly into the result array
+  uint8NDArray data (dim_vector (1, buffer_len));
+
+  retval = usbtmc->read (reinterpret_cast<uint8_t *> (data.fortran_vec ()), buffer_len);
 
   if (retval < 0)
     {
@@ -95,10 +90,8 @@ Read from usbtmc slave device.\n \
     }
 
   octave_value_list return_list;
-  uint8NDArray data (dim_vector (1, retval));
-
-  for (int i = 0; i < retval; i++)
-    data (i) = buffer[i];
+  // trim to the bytes actually read
+  data.resize (dim_vector (1, retval));
 
   return_list (0) = data;
   return_list (1) = retval;
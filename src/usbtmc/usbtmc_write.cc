@@ -26,6 +26,7 @@
 #include <errno.h>
 
 #include "usbtmc_class.h"
+#include "../common/byte_view.h"
 #endif
 
 // PKG_ADD: autoload ("usbtmc_write", "usbtmc.oct");
@@ -60,35 +61,16 @@ Upon successful completion, usbtmc_write() shall return the number of bytes writ
   const octave_base_value& rep = args (0).get_rep ();
   usbtmc = &((octave_usbtmc &)rep);
 
-  const octave_base_value& data = args (1).get_rep ();
+  octave_byte_view data (args (1), true);
 
-  if (data.is_string())
-    {
-      std::string buf = data.string_value ();
-      retval = usbtmc->write ((uint8_t*)buf.c_str (), buf.length ());
-    }
-  else if (data.is_uint8_type ())
-    {
-      NDArray dtmp = data.array_value ();
-      OCTAVE_LOCAL_BUFFER (uint8_t, buf, (data.numel ()));
-
-      if (buf == NULL)
-        {
-          error ("usbtmc_write: cannot allocate requested memory: %s\n", strerror (errno));
-          return octave_value (-1);
-        }
-
-      for (int i = 0; i < dtmp.numel (); i++)
-        buf[i] = static_cast<uint8_t>(dtmp (i));
-
-      retval = usbtmc->write (buf, dtmp.numel ());
-    }
-  else
+  if (! data.is_valid ())
     {
       print_usage ();
       return octave_value (-1);
     }
 
+  retval = usbtmc->write (data.data (), data.length ());
+
   return octave_value (retval);
 #endif
 }
@@ -26,6 +26,8 @@
 #include <errno.h>
 
 #include "visadev_class.h"
+#include "../common/byte_view.h"
+#include "../common/binblock.h"
 
 #endif
 
@@ -80,25 +82,89 @@ Private function to dispatch a function to the visadev interface.\n \
 
       buffer_len = args (2).int_value ();
 
-      OCTAVE_LOCAL_BUFFER (uint8_t, buffer, (buffer_len + 1));
+      // Read data directly into the result array
+      uint8NDArray data (dim_vector (1, buffer_len));
+      bool end = false;
 
-      if (buffer == NULL)
+      int bytes_read = visadev->read (reinterpret_cast<uint8_t *> (data.fortran_vec ()), buffer_len, &end);
+      if (bytes_read < 0)
+        bytes_read = 0;
+
+      // trim to the bytes actually read
+      data.resize (dim_vector (1, bytes_read));
+
+      octave_value_list return_list;
+      return_list (0) = data;
+      return_list (1) = bytes_read;
+      return_list (2) = end;
+      ret_value = return_list;
+
+    }
+  else if (function == "readline")
+    {
+      std::string line;
+      bool found = visadev->readline (line);
+
+      octave_value_list return_list;
+      return_list (0) = line;
+      return_list (1) = found;
+      ret_value = return_list;
+    }
+  else if (function == "writeread")
+    {
+      if (args.length() < 3 || ! args (2).is_string ())
         {
-          error ("cannot allocate requested memory");
-          return octave_value (-1);  
+          error("__visadev_dispatch__(writeread): expects a command string");
+          return octave_value();
         }
-      int bytes_read = visadev->read (buffer, buffer_len);
+
+      std::string line;
+      bool found = visadev->writeread (args (2).string_value (), line);
 
       octave_value_list return_list;
-      uint8NDArray data (dim_vector (1, bytes_read));
+      return_list (0) = line;
+      return_list (1) = found;
+      ret_value = return_list;
+    }
+  else if (function == "readbinblock")
+    {
+      octave_data_type type;
+      octave_data_type_lookup ("uint8", type);
+
+      if (args.length() > 2)
+        {
+          if (! args (2).is_string () || ! octave_data_type_lookup (args (2).string_value (), type))
+            {
+              error("__visadev_dispatch__(readbinblock): datatype not supported");
+              return octave_value();
+            }
+        }
 
-      for (int i = 0; i < bytes_read; i++)
-        data (i) = buffer[i];
+      ret_value = visadev->readbinblock (type);
+    }
+  else if (function == "writebinblock")
+    {
+      octave_data_type type;
 
-      return_list (0) = data;
-      return_list (1) = bytes_read;
-      ret_value = return_list;
+      if (args.length() < 4)
+        {
+          error("__visadev_dispatch__(writebinblock): expects 4 arguments");
+          return octave_value();
+        }
+      if (! args (3).is_string () || ! octave_data_type_lookup (args (3).string_value (), type))
+        {
+          error("__visadev_dispatch__(writebinblock): datatype not supported");
+          return octave_value();
+        }
 
+      bool swap = octave_byteorder_needs_swap (visadev->get_byteorder ());
+
+      int bytes_wrote = octave_write_binblock (args (2), type, swap,
+        [visadev] (uint8_t *buf, unsigned int len)
+        {
+          return visadev->write (buf, len);
+        });
+      ret_value = octave_value(bytes_wrote);
     }
   else if (function == "write")
     {
@@ -107,19 +173,14 @@ Private function to dispatch a function to the visadev interface.\n \
           error("__visadev_dispatch__(write): expects 3 arguments");
           return octave_value();
         }
-      NDArray data = args (2).array_value ();
-      OCTAVE_LOCAL_BUFFER (uint8_t, buf, (data.numel ()));
-
-      if (buf == NULL)
+      octave_byte_view data (args (2));
+      if (! data.is_valid ())
         {
-          error ("cannot allocate requested memory");
-          return octave_value (-1);  
+          error("__visadev_dispatch__(write): expected numeric or char data");
+          return octave_value();
         }
 
-      for (int i = 0; i < data.numel (); i++)
-        buf[i] =  static_cast<uint8_t>(data(i));
-
-     int bytes_wrote = visadev->write (buf, data.numel ());
+     int bytes_wrote = visadev->write (data.data (), data.length ());
      ret_value = octave_value(bytes_wrote);
     }
   else if (function == "properties")
@@ -132,6 +193,59 @@ Private function to dispatch a function to the visadev interface.\n \
         }
       ret_value(0) = fieldnames;
     }
+  else if (function == "get")
+    {
+      // all properties, or those named, in one call
+      if (args.length() < 3)
+        {
+          string_vector keys = visadev->map_keys();
+          octave_scalar_map values;
+          for (octave_idx_type i=0;i<keys.numel();i++)
+            values.assign (keys(i), visadev->get_property_value (keys(i)));
+          ret_value(0) = values;
+        }
+      else if (args (2).is_string ())
+        {
+          ret_value(0) = visadev->get_property_value (args (2).string_value ());
+        }
+      else if (args (2).OV_ISCELL ())
+        {
+          Cell names = args (2).cell_value ();
+          Cell values (names.dims ());
+          for (octave_idx_type i=0;i<names.numel();i++)
+            {
+              if (! names(i).is_string ())
+                {
+                  error("__visadev_dispatch__(get): expected property names to be strings");
+                  return octave_value();
+                }
+              values(i) = visadev->get_property_value (names(i).string_value ());
+            }
+          ret_value(0) = values;
+        }
+      else
+        {
+          error("__visadev_dispatch__(get): expected a property name or cell array of names");
+          return octave_value();
+        }
+    }
+  else if (function == "set")
+    {
+      if (args.length() < 3 || ! args (2).OV_ISSTRUCT () || args (2).numel () != 1)
+        {
+          error("__visadev_dispatch__(set): expected a struct of property values");
+          return octave_value();
+        }
+
+      // set in the order given, as some depend on others
+      octave_scalar_map values = args (2).scalar_map_value ();
+      string_vector keys = values.fieldnames ();
+      for (octave_idx_type i=0;i<keys.numel();i++)
+        {
+          if (! visadev->set_property_value (keys(i), values.getfield (keys(i))))
+            return octave_value();
+        }
+    }
   else if (function == "flush")
     {
       if (args.length() < 3)
@@ -158,6 +272,108 @@ Private function to dispatch a function to the visadev interface.\n \
      int ok = visadev->trigger ();
      ret_value = octave_value(ok);
     }
+  else if (function == "readasync")
+    {
+      if (args.length() < 3)
+        {
+          error("__visadev_dispatch__(readasync): expects 3 arguments");
+          return octave_value();
+        }
+
+      if ( !(args (2).OV_ISINTEGER () || args (2).OV_ISFLOAT ()) || args(2).int_value() <= 0)
+        {
+          error ("Expected length to be a positive number value");
+          return octave_value (-1);
+        }
+
+      int ok = visadev->read_async (args (2).int_value ());
+      ret_value = octave_value(ok);
+    }
+  else if (function == "writeasync")
+    {
+      if (args.length() < 3)
+        {
+          error("__visadev_dispatch__(writeasync): expects 3 arguments");
+          return octave_value();
+        }
+      octave_byte_view data (args (2));
+      if (! data.is_valid ())
+        {
+          error("__visadev_dispatch__(writeasync): expected numeric or char data");
+          return octave_value();
+        }
+
+      int bytes_queued = visadev->write_async (data.data (), data.length ());
+      ret_value = octave_value(bytes_queued);
+    }
+  else if (function == "waitasync")
+    {
+      double waittime = -1;
+
+      if (args.length() > 2)
+        {
+          if ( !(args (2).OV_ISINTEGER () || args (2).OV_ISFLOAT ()))
+            {
+              error ("Expected timeout to be a number value");
+              return octave_value ();
+            }
+          waittime = args (2).double_value ();
+          if (std::isinf (waittime) || waittime < 0)
+            waittime = -1;
+        }
+
+      bool done = visadev->wait_async (waittime);
+      ret_value = octave_value(done);
+    }
+  else if (function == "stopasync")
+    {
+      int ok = visadev->stop_async ();
+      ret_value = octave_value(ok);
+    }
+  else if (function == "waitsrq")
+    {
+      double waittime = -1;
+
+      if (args.length() > 2)
+        {
+          if ( !(args (2).OV_ISINTEGER () || args (2).OV_ISFLOAT ()))
+            {
+              error ("Expected timeout to be a number value");
+              return octave_value ();
+            }
+          waittime = args (2).double_value ();
+          if (std::isinf (waittime) || waittime < 0)
+            waittime = -1;
+        }
+
+      int srq = visadev->wait_srq (waittime);
+      if (srq < 0)
+        return octave_value ();
+
+      octave_value_list return_list;
+      return_list (0) = (srq > 0);
+
+      // the status byte is read after a service request, which for
+      // most instruments also clears it
+      if (nargout > 1)
+        {
+          int stb = (srq > 0) ? visadev->read_stb () : 0;
+          if (stb < 0)
+            return octave_value ();
+          return_list (1) = stb;
+        }
+      ret_value = return_list;
+    }
+  else if (function == "readstb")
+    {
+      int stb = visadev->read_stb ();
+      ret_value = octave_value(stb);
+    }
+  else if (function == "sendbuffer")
+    {
+      int ok = visadev->send_buffered ();
+      ret_value = octave_value(ok);
+    }
  
   else if (function == "setRTS")
     {
@@ -16,6 +16,7 @@ static OCTAVE__DYNAMIC_LIBRARY visa_lib;
 visa_library::visa_library()
 {
   tx = 0x0c;
+  rm = VI_NULL;
   lib_viOpenDefaultRM = 0;
 
   // see if librrary is loaded
@@ -111,11 +112,39 @@ visa_library::visa_library()
   lib_viClear = reinterpret_cast<ViStatus _VI_FUNC (*)(ViSession)>(lib.search ("viClear"));
   lib_viReadSTB = reinterpret_cast<ViStatus _VI_FUNC (*)(ViSession, ViPUInt16)>(lib.search ("viReadSTB"));
   lib_viFlush = reinterpret_cast<ViStatus _VI_FUNC (*)(ViSession, ViUInt16)>(lib.search ("viFlush"));
+  lib_viSetBuf = reinterpret_cast<ViStatus _VI_FUNC (*)(ViSession, ViUInt16, ViUInt32)>(lib.search ("viSetBuf"));
+  lib_viBufRead = reinterpret_cast<ViStatus _VI_FUNC (*)(ViSession,ViPBuf,ViUInt32,ViPUInt32)>(lib.search ("viBufRead"));
+  lib_viBufWrite = reinterpret_cast<ViStatus _VI_FUNC (*)(ViSession,ViPBuf,ViUInt32,ViPUInt32)>(lib.search ("viBufWrite"));
   lib_viAssertTrigger = reinterpret_cast<ViStatus _VI_FUNC (*)(ViSession, ViUInt16)>(lib.search ("viAssertTrigger"));
+  lib_viReadAsync = reinterpret_cast<ViStatus _VI_FUNC (*)(ViSession,ViPBuf,ViUInt32,ViPJobId)>(lib.search ("viReadAsync"));
+  lib_viWriteAsync = reinterpret_cast<ViStatus _VI_FUNC (*)(ViSession,ViBuf,ViUInt32,ViPJobId)>(lib.search ("viWriteAsync"));
+  lib_viEnableEvent = reinterpret_cast<ViStatus _VI_FUNC (*)(ViSession,ViEventType,ViUInt16,ViEventFilter)>(lib.search ("viEnableEvent"));
+  lib_viDisableEvent = reinterpret_cast<ViStatus _VI_FUNC (*)(ViSession,ViEventType,ViUInt16)>(lib.search ("viDisableEvent"));
+  lib_viDiscardEvents = reinterpret_cast<ViStatus _VI_FUNC (*)(ViSession,ViEventType,ViUInt16)>(lib.search ("viDiscardEvents"));
+  lib_viWaitOnEvent = reinterpret_cast<ViStatus _VI_FUNC (*)(ViSession,ViEventType,ViUInt32,ViPEventType,ViPEvent)>(lib.search ("viWaitOnEvent"));
+  lib_viTerminate = reinterpret_cast<ViStatus _VI_FUNC (*)(ViObject,ViUInt16,ViJobId)>(lib.search ("viTerminate"));
 }
 
 visa_library::~visa_library()
 {
+  if (rm != VI_NULL)
+    viClose(rm);
+}
+
+ViStatus visa_library::get_resource_manager(ViPSession vi)
+{
+  if (rm == VI_NULL)
+    {
+      ViStatus status = viOpenDefaultRM(&rm);
+      if (status < VI_SUCCESS)
+        {
+          rm = VI_NULL;
+          return status;
+        }
+    }
+
+  *vi = rm;
+  return VI_SUCCESS;
 }
 
 ViStatus visa_library::viOpenDefaultRM(ViPSession vi)
@@ -241,6 +270,27 @@ ViStatus visa_library::viFlush(ViSession vi, ViUInt16 mask)
 
   return lib_viFlush(vi, mask);
 }
+ViStatus visa_library::viSetBuf(ViSession vi, ViUInt16 mask, ViUInt32 size)
+{
+  if (!lib_viSetBuf)
+    return VI_ERROR_LIBRARY_NFOUND;
+
+  return lib_viSetBuf(vi, mask, size);
+}
+ViStatus visa_library::viBufRead(ViSession  vi, ViPBuf buf, ViUInt32 cnt, ViPUInt32 retCnt)
+{
+  if (!lib_viBufRead)
+    return VI_ERROR_LIBRARY_NFOUND;
+
+  return lib_viBufRead(vi, buf, cnt, retCnt);
+}
+ViStatus visa_library::viBufWrite(ViSession  vi, ViBuf buf, ViUInt32 cnt, ViPUInt32 retCnt)
+{
+  if (!lib_viBufWrite)
+    return VI_ERROR_LIBRARY_NFOUND;
+
+  return lib_viBufWrite(vi, buf, cnt, retCnt);
+}
 
 ViStatus visa_library::viAssertTrigger(ViSession vi, ViUInt16 protocol)
 {
@@ -250,15 +300,77 @@ ViStatus visa_library::viAssertTrigger(ViSession vi, ViUInt16 protocol)
   return lib_viAssertTrigger(vi, protocol);
 }
 
-visa_library * get_visa_library()
+ViStatus visa_library::viReadAsync(ViSession vi, ViPBuf buf, ViUInt32 cnt, ViPJobId jobId)
+{
+  if (!lib_viReadAsync)
+    return VI_ERROR_LIBRARY_NFOUND;
+
+  return lib_viReadAsync(vi, buf, cnt, jobId);
+}
+
+ViStatus visa_library::viWriteAsync(ViSession vi, ViBuf buf, ViUInt32 cnt, ViPJobId jobId)
 {
-  return new visa_library();
+  if (!lib_viWriteAsync)
+    return VI_ERROR_LIBRARY_NFOUND;
+
+  return lib_viWriteAsync(vi, buf, cnt, jobId);
 }
 
-void free_visa_library(visa_library *l)
+ViStatus visa_library::viEnableEvent(ViSession vi, ViEventType eventType, ViUInt16 mechanism, ViEventFilter context)
 {
-  if(l)
+  if (!lib_viEnableEvent)
+    return VI_ERROR_LIBRARY_NFOUND;
+
+  return lib_viEnableEvent(vi, eventType, mechanism, context);
+}
+
+ViStatus visa_library::viDisableEvent(ViSession vi, ViEventType eventType, ViUInt16 mechanism)
+{
+  if (!lib_viDisableEvent)
+    return VI_ERROR_LIBRARY_NFOUND;
+
+  return lib_viDisableEvent(vi, eventType, mechanism);
+}
+
+ViStatus visa_library::viDiscardEvents(ViSession vi, ViEventType eventType, ViUInt16 mechanism)
+{
+  if (!lib_viDiscardEvents)
+    return VI_ERROR_LIBRARY_NFOUND;
+
+  return lib_viDiscardEvents(vi, eventType, mechanism);
+}
+
+ViStatus visa_library::viWaitOnEvent(ViSession vi, ViEventType inEventType, ViUInt32 timeout,
+                                     ViPEventType outEventType, ViPEvent outContext)
+{
+  if (!lib_viWaitOnEvent)
+    return VI_ERROR_LIBRARY_NFOUND;
+
+  return lib_viWaitOnEvent(vi, inEventType, timeout, outEventType, outContext);
+}
+
+ViStatus visa_library::viTerminate(ViObject vi, ViUInt16 degree, ViJobId jobId)
+{
+  if (!lib_viTerminate)
+    return VI_ERROR_LIBRARY_NFOUND;
+
+  return lib_viTerminate(vi, degree, jobId);
+}
+
+static visa_library * shared_visa_library = 0;
+
+visa_library * get_visa_library()
+{
+  // try again for a library that was not found before, as VISA_LIBRARY
+  // may have been set since
+  if (shared_visa_library && !shared_visa_library->is_valid())
     {
-      delete l;
+      delete shared_visa_library;
+      shared_visa_library = 0;
     }
+
+  if (!shared_visa_library)
+    shared_visa_library = new visa_library();
+
+  return shared_visa_library;
 }
@@ -14,6 +14,8 @@
 class visa_library
 {
   int tx;
+  // default resource manager session, shared by everything opened
+  ViSession rm;
   // the functions we currently use - TODO: add all ?
   ViStatus _VI_FUNC (*lib_viOpenDefaultRM)(ViPSession vi); 
   ViStatus _VI_FUNC (*lib_viOpen)(ViSession sesn, ViRsrc name, ViAccessMode mode, ViUInt32 timeout, ViPSession vi);
@@ -35,7 +37,20 @@ class visa_library
   ViStatus _VI_FUNC (*lib_viClear)(ViSession  vi);
   ViStatus _VI_FUNC (*lib_viReadSTB)(ViSession  vi, ViPUInt16 status);
   ViStatus _VI_FUNC (*lib_viFlush)(ViSession vi, ViUInt16 mask);
+  // formatted io buffers
+  ViStatus _VI_FUNC (*lib_viSetBuf)(ViSession vi, ViUInt16 mask, ViUInt32 size);
+  ViStatus _VI_FUNC (*lib_viBufRead)(ViSession  vi, ViPBuf buf, ViUInt32 cnt, ViPUInt32 retCnt);
+  ViStatus _VI_FUNC (*lib_viBufWrite)(ViSession  vi, ViBuf buf, ViUInt32 cnt, ViPUInt32 retCnt);
   ViStatus _VI_FUNC (*lib_viAssertTrigger)(ViSession vi, ViUInt16 protocol);
+  // asynchronous io and events
+  ViStatus _VI_FUNC (*lib_viReadAsync)(ViSession vi, ViPBuf buf, ViUInt32 cnt, ViPJobId jobId);
+  ViStatus _VI_FUNC (*lib_viWriteAsync)(ViSession vi, ViBuf buf, ViUInt32 cnt, ViPJobId jobId);
+  ViStatus _VI_FUNC (*lib_viEnableEvent)(ViSession vi, ViEventType eventType, ViUInt16 mechanism, ViEventFilter context);
+  ViStatus _VI_FUNC (*lib_viDisableEvent)(ViSession vi, ViEventType eventType, ViUInt16 mechanism);
+  ViStatus _VI_FUNC (*lib_viDiscardEvents)(ViSession vi, ViEventType eventType, ViUInt16 mechanism);
+  ViStatus _VI_FUNC (*lib_viWaitOnEvent)(ViSession vi, ViEventType inEventType, ViUInt32 timeout,
+                                    ViPEventType outEventType, ViPEvent outContext);
+  ViStatus _VI_FUNC (*lib_viTerminate)(ViObject vi, ViUInt16 degree, ViJobId jobId);
 
 public:
   visa_library();
@@ -46,6 +61,10 @@ public:
       return lib_viOpenDefaultRM != 0;
   }
 
+  // the default resource manager session, opened on first use and kept
+  // open for the life of the library
+  ViStatus get_resource_manager(ViPSession vi);
+
   ViStatus viOpenDefaultRM(ViPSession vi);
   ViStatus viOpen(ViSession sesn, ViRsrc name, ViAccessMode mode, ViUInt32 timeout, ViPSession vi);
   ViStatus viClose(ViObject  vi);
@@ -66,11 +85,23 @@ public:
   ViStatus viClear(ViSession  vi);
   ViStatus viReadSTB(ViSession  vi, ViPUInt16 status);
   ViStatus viFlush(ViSession vi, ViUInt16 mask);
+  ViStatus viSetBuf(ViSession vi, ViUInt16 mask, ViUInt32 size);
+  ViStatus viBufRead(ViSession  vi, ViPBuf buf, ViUInt32 cnt, ViPUInt32 retCnt);
+  ViStatus viBufWrite(ViSession  vi, ViBuf buf, ViUInt32 cnt, ViPUInt32 retCnt);
   ViStatus viAssertTrigger(ViSession vi, ViUInt16 protocol);
+  ViStatus viReadAsync(ViSession vi, ViPBuf buf, ViUInt32 cnt, ViPJobId jobId);
+  ViStatus viWriteAsync(ViSession vi, ViBuf buf, ViUInt32 cnt, ViPJobId jobId);
+  ViStatus viEnableEvent(ViSession vi, ViEventType eventType, ViUInt16 mechanism, ViEventFilter context);
+  ViStatus viDisableEvent(ViSession vi, ViEventType eventType, ViUInt16 mechanism);
+  ViStatus viDiscardEvents(ViSession vi, ViEventType eventType, ViUInt16 mechanism);
+  ViStatus viWaitOnEvent(ViSession vi, ViEventType inEventType, ViUInt32 timeout,
+                         ViPEventType outEventType, ViPEvent outContext);
+  ViStatus viTerminate(ViObject vi, ViUInt16 degree, ViJobId jobId);
 };
 
 
+// the library is loaded once and shared by all users for the life of
+// the process
 visa_library * get_visa_library();
-void free_visa_library(visa_library *l);
 
 #endif // VISADEV_LIBRARY_H
@@ -64,6 +64,19 @@ number of bytes currently available to read (readonly)\n \
 multicast group socket  is subscribed to (readonly)\n \
 @item Terminator\n \
 Terminator value used for string data (readonly)\n \
+@item ReadChunkSize\n \
+largest number of bytes requested from the instrument by a single viRead, default 1048576\n \
+@item TransferStatus\n \
+asynchronous transfers in progress: \"idle\", \"read\", \"write\" or \"read&write\" (readonly)\n \
+@item EnableSRQ\n \
+queue service requests from the instrument for visawaitsrq\n \
+@item BufferMode\n \
+\"off\" (default) to send each write as it is made, or \"manual\" or \"terminator\"\n \
+to queue writes in the VISA write buffer. Queued writes are sent by visaflush,\n \
+before a read, when the buffer is full and, in \"terminator\" mode, by a write\n \
+ending with the output terminator\n \
+@item BufferSize\n \
+size in bytes of the VISA read and write buffers, default 4096\n \
 @end table \n \
 \n \
 Other properties are available depending on the visadev type and can \n \
@@ -24,8 +24,12 @@
 #include <string>
 #include <algorithm>
 #include <sstream>
+#include <chrono>
+#include <map>
+#include <unordered_map>
 
 #include "visadev_class.h"
+#include "../common/binblock.h"
 #include <octave/Matrix.h>
 
 #include "visa_library.h"
@@ -239,6 +243,11 @@ static struct PropertyMap def_field_map[] = {
   {"UserData", "rw", "obj", 0, convert_nop, convert_nop},
   {"Terminator", "r", "str", 0, convert_nop, convert_nop},
   {"Tag", "rw", "str", 0, convert_nop, convert_nop},
+  {"ReadChunkSize", "rw", "u32", 0, convert_nop, convert_nop},
+  {"TransferStatus", "r", "str", 0, convert_nop, convert_nop},
+  {"EnableSRQ", "rw", "bool", 0, convert_nop, convert_nop},
+  {"BufferMode", "rw", "str", 0, convert_nop, convert_nop},
+  {"BufferSize", "rw", "u32", 0, convert_nop, convert_nop},
 
   // Alias
   // Vendor
@@ -364,6 +373,11 @@ static struct PropertyMap serial_field_map[] = {
   {"UserData", "rw", "obj", 0, convert_nop, convert_nop},
   {"Terminator", "r", "str", 0, convert_nop, convert_nop},
   {"Tag", "rw", "str", 0, convert_nop, convert_nop},
+  {"ReadChunkSize", "rw", "u32", 0, convert_nop, convert_nop},
+  {"TransferStatus", "r", "str", 0, convert_nop, convert_nop},
+  {"EnableSRQ", "rw", "bool", 0, convert_nop, convert_nop},
+  {"BufferMode", "rw", "str", 0, convert_nop, convert_nop},
+  {"BufferSize", "rw", "u32", 0, convert_nop, convert_nop},
 
   {"Model", "r", "str", VI_ATTR_MODEL_NAME, convert_nop, convert_nop},
   {"Vendor", "r", "str", VI_ATTR_MANF_NAME, convert_nop, convert_nop},
@@ -392,6 +406,11 @@ static struct PropertyMap tcp_field_map[] = {
   {"UserData", "rw", "obj", 0, convert_nop, convert_nop},
   {"Terminator", "r", "str", 0, convert_nop, convert_nop},
   {"Tag", "rw", "str", 0, convert_nop, convert_nop},
+  {"ReadChunkSize", "rw", "u32", 0, convert_nop, convert_nop},
+  {"TransferStatus", "r", "str", 0, convert_nop, convert_nop},
+  {"EnableSRQ", "rw", "bool", 0, convert_nop, convert_nop},
+  {"BufferMode", "rw", "str", 0, convert_nop, convert_nop},
+  {"BufferSize", "rw", "u32", 0, convert_nop, convert_nop},
 
   {"Model", "r", "str", VI_ATTR_MODEL_NAME, convert_nop, convert_nop},
   {"Vendor", "r", "str", VI_ATTR_MANF_NAME, convert_nop, convert_nop},
@@ -417,6 +436,11 @@ static struct PropertyMap socket_field_map[] = {
   {"UserData", "rw", "obj", 0, convert_nop, convert_nop},
   {"Terminator", "r", "str", 0, convert_nop, convert_nop},
   {"Tag", "rw", "str", 0, convert_nop, convert_nop},
+  {"ReadChunkSize", "rw", "u32", 0, convert_nop, convert_nop},
+  {"TransferStatus", "r", "str", 0, convert_nop, convert_nop},
+  {"EnableSRQ", "rw", "bool", 0, convert_nop, convert_nop},
+  {"BufferMode", "rw", "str", 0, convert_nop, convert_nop},
+  {"BufferSize", "rw", "u32", 0, convert_nop, convert_nop},
 
   {"Model", "r", "str", VI_ATTR_MODEL_NAME, convert_nop, convert_nop},
   {"Vendor", "r", "str", VI_ATTR_MANF_NAME, convert_nop, convert_nop},
@@ -441,6 +465,11 @@ static struct PropertyMap usb_field_map[] = {
   {"UserData", "rw", "obj", 0, convert_nop, convert_nop},
   {"Terminator", "r", "str", 0, convert_nop, convert_nop},
   {"Tag", "rw", "str", 0, convert_nop, convert_nop},
+  {"ReadChunkSize", "rw", "u32", 0, convert_nop, convert_nop},
+  {"TransferStatus", "r", "str", 0, convert_nop, convert_nop},
+  {"EnableSRQ", "rw", "bool", 0, convert_nop, convert_nop},
+  {"BufferMode", "rw", "str", 0, convert_nop, convert_nop},
+  {"BufferSize", "rw", "u32", 0, convert_nop, convert_nop},
 
   {"Model", "r", "str", VI_ATTR_MODEL_NAME, convert_nop, convert_nop},
   {"Vendor", "r", "str", VI_ATTR_MANF_NAME, convert_nop, convert_nop},
@@ -468,6 +497,11 @@ static struct PropertyMap gpib_field_map[] = {
   {"UserData", "rw", "obj", 0, convert_nop, convert_nop},
   {"Terminator", "r", "str", 0, convert_nop, convert_nop},
   {"Tag", "rw", "str", 0, convert_nop, convert_nop},
+  {"ReadChunkSize", "rw", "u32", 0, convert_nop, convert_nop},
+  {"TransferStatus", "r", "str", 0, convert_nop, convert_nop},
+  {"EnableSRQ", "rw", "bool", 0, convert_nop, convert_nop},
+  {"BufferMode", "rw", "str", 0, convert_nop, convert_nop},
+  {"BufferSize", "rw", "u32", 0, convert_nop, convert_nop},
 
   {"Model", "r", "str", VI_ATTR_MODEL_NAME, convert_nop, convert_nop},
   {"Vendor", "r", "str", VI_ATTR_MANF_NAME, convert_nop, convert_nop},
@@ -495,6 +529,11 @@ static struct PropertyMap pxi_field_map[] = {
   {"UserData", "rw", "obj", 0, convert_nop, convert_nop},
   {"Terminator", "r", "str", 0, convert_nop, convert_nop},
   {"Tag", "rw", "str", 0, convert_nop, convert_nop},
+  {"ReadChunkSize", "rw", "u32", 0, convert_nop, convert_nop},
+  {"TransferStatus", "r", "str", 0, convert_nop, convert_nop},
+  {"EnableSRQ", "rw", "bool", 0, convert_nop, convert_nop},
+  {"BufferMode", "rw", "str", 0, convert_nop, convert_nop},
+  {"BufferSize", "rw", "u32", 0, convert_nop, convert_nop},
 
   {"Model", "r", "str", VI_ATTR_MODEL_NAME, convert_nop, convert_nop},
   {"Vendor", "r", "str", VI_ATTR_MANF_NAME, convert_nop, convert_nop},
@@ -524,6 +563,11 @@ static struct PropertyMap vxi_field_map[] = {
   {"UserData", "rw", "obj", 0, convert_nop, convert_nop},
   {"Terminator", "r", "str", 0, convert_nop, convert_nop},
   {"Tag", "rw", "str", 0, convert_nop, convert_nop},
+  {"ReadChunkSize", "rw", "u32", 0, convert_nop, convert_nop},
+  {"TransferStatus", "r", "str", 0, convert_nop, convert_nop},
+  {"EnableSRQ", "rw", "bool", 0, convert_nop, convert_nop},
+  {"BufferMode", "rw", "str", 0, convert_nop, convert_nop},
+  {"BufferSize", "rw", "u32", 0, convert_nop, convert_nop},
 
   {"Model", "r", "str", VI_ATTR_MODEL_NAME, convert_nop, convert_nop},
   {"Vendor", "r", "str", VI_ATTR_MANF_NAME, convert_nop, convert_nop},
@@ -541,9 +585,25 @@ static struct PropertyMap vxi_field_map[] = {
 
 DEFINE_OV_TYPEID_FUNCTIONS_AND_DATA (octave_visadev, "octave_visadev", "octave_visadev");
 
-std::vector <visa_devinfo> octave_visadev::list_devices()
+// resource lists by the expression they were found with, as a search
+// that discovers TCPIP and USB instruments can take seconds
+struct visa_devlist_cache
 {
+  std::chrono::steady_clock::time_point when;
   std::vector <visa_devinfo> devices;
+};
+
+static std::map <std::string, visa_devlist_cache> devlist_cache;
+
+std::vector <visa_devinfo> octave_visadev::list_devices(const std::string &expr, double max_age)
+{
+  std::vector <visa_devinfo> devices;
+
+  auto now = std::chrono::steady_clock::now ();
+  auto cached = devlist_cache.find (expr);
+  if (cached != devlist_cache.end () && max_age > 0
+      && std::chrono::duration<double> (now - cached->second.when).count () <= max_age)
+    return cached->second.devices;
 
   visa_library * lib = get_visa_library();
   if (!lib || !lib->is_valid())
@@ -552,71 +612,62 @@ std::vector <visa_devinfo> octave_visadev::list_devices()
       return devices;
     }
 
-  ViAccessMode access_mode = VI_NULL;
-  ViUInt32 timeout_ms      = 5000;
-
-  // Communication buffer
-  ViChar buffer[1000];
-  //ViRsrc description[1024];
   ViChar description[1024];
-  ViUInt32 io_bytes;
 
   // Get VISA resource manager
   ViSession resource_manager;
   ViStatus  status;
-  status = lib->viOpenDefaultRM(&resource_manager);
+  status = lib->get_resource_manager(&resource_manager);
   if (status < VI_SUCCESS) 
     {
       error("visadev: Could not open VISA resource manager.");
       return devices;
     }
-  else
-    {
-      // if passed in true ?
-      //viSetAttribute(resource_manager, VI_KTATTR_RETURN_ALL, VI_TRUE );
-      //
-      //strcpy((char*)buffer, "?*INSTR");
-      strcpy((char*)buffer, "?*");
 
-      ViFindList find_list;
-      ViUInt32 ret_cnt;
+  // if passed in true ?
+  //viSetAttribute(resource_manager, VI_KTATTR_RETURN_ALL, VI_TRUE );
+  std::vector <ViChar> pattern (expr.begin (), expr.end ());
+  pattern.push_back (0);
 
-      status = lib->viFindRsrc(resource_manager, buffer, &find_list, &ret_cnt, description); 
-      if (status < VI_SUCCESS)
-        {
-          lib->viClose(resource_manager);
-          return devices;
-        }
+  ViFindList find_list;
+  ViUInt32 ret_cnt;
 
-      while (status >= VI_SUCCESS)
-        {
-          ViUInt16 intf_type, intf_num;
-          ViChar class_name[100];
-          ViChar alias_name[1024];
-          ViChar unalias_name[2046];
-          visa_devinfo d;
+  status = lib->viFindRsrc(resource_manager, pattern.data (), &find_list, &ret_cnt, description); 
+  if (status < VI_SUCCESS)
+    {
+      // nothing matched is a valid, empty list
+      if (status == VI_ERROR_RSRC_NFOUND)
+        devlist_cache[expr] = { now, devices };
+      return devices;
+    }
 
-          d.name = description;
-          d.alias = description;
+  while (status >= VI_SUCCESS)
+    {
+      ViUInt16 intf_type, intf_num;
+      ViChar class_name[100];
+      ViChar alias_name[1024];
+      ViChar unalias_name[2046];
+      visa_devinfo d;
 
-          status = lib->viParseRsrcEx(resource_manager, description, &intf_type, &intf_num, class_name, unalias_name, alias_name);
-          if (status >= VI_SUCCESS)
-            {
-              if (alias_name[0])
-                d.alias = alias_name;
+      d.name = description;
+      d.alias = description;
 
-	      d.type = visa_type_str(intf_type, description);
-            }
-          devices.push_back(d);
+      status = lib->viParseRsrcEx(resource_manager, description, &intf_type, &intf_num, class_name, unalias_name, alias_name);
+      if (status >= VI_SUCCESS)
+        {
+          if (alias_name[0])
+            d.alias = alias_name;
 
-          status = lib->viFindNext(find_list, description)  ;
+          d.type = visa_type_str(intf_type, description);
         }
+      devices.push_back(d);
 
-      lib->viClose(find_list);
-      lib->viClose(resource_manager);
+      status = lib->viFindNext(find_list, description)  ;
     }
 
-  free_visa_library(lib);
+  lib->viClose(find_list);
+
+  devlist_cache[expr] = { now, devices };
 
   return devices;
 }
@@ -640,8 +691,20 @@ octave_visadev::octave_visadev (void)
   interminator = octave_value("lf");
   outterminator = octave_value("lf");
   eoimode = true;
-
-  properties = def_field_map;
+  read_chunk_size = 1048576;
+  read_job = 0;
+  write_job = 0;
+  read_pending = false;
+  write_pending = false;
+  io_events = false;
+  async_error = VI_SUCCESS;
+  async_end = false;
+  srq_events = false;
+  buffer_mode = "off";
+  buffer_size = 4096;
+  write_queued = false;
+
+  set_property_map(def_field_map);
 }
 
 string_vector octave_visadev::map_keys(void) const
@@ -662,21 +725,140 @@ string_vector octave_visadev::map_keys(void) const
 }
 
 
+// name lookup of each of the property maps, built on first use
+static const std::unordered_map<std::string, const PropertyMap *> &
+property_index (const PropertyMap *map)
+{
+  static std::unordered_map<const PropertyMap *, std::unordered_map<std::string, const PropertyMap *>> indexes;
+
+  std::unordered_map<std::string, const PropertyMap *> &index = indexes[map];
+  if (index.empty ())
+    {
+      for (const PropertyMap *p = map; p->name != NULL; p++)
+        index[p->name] = p;
+    }
+
+  return index;
+}
+
+void octave_visadev::set_property_map(PropertyMap *map)
+{
+  properties = map;
+  property_lookup = &property_index (map);
+}
+
 const PropertyMap * octave_visadev::get_property(const std::string &name) const
 {
-  int i = 0;
+  auto it = property_lookup->find (name);
+  return it != property_lookup->end () ? it->second : NULL;
+}
 
-  PropertyMap *p = &properties[i];
-  do
+octave_value
+octave_visadev::get_property_value (const PropertyMap *p)
+{
+  octave_value retval;
+  std::string name = p->name;
+
+  if (p->attr > 0)
     {
-      if (name == p->name)
-        return p;
-      i++;
-      p = &properties[i];
+      retval = get_attribute(p);
+    }
+  // handle some properties we handle specifically
+  else if (name == "ResourceName")
+    {
+      retval = get_name();
+    }
+  else if (name == "Type")
+    {
+      retval = get_type();
+    }
+  else if (name == "Timeout")
+    {
+      retval = get_timeout();
+    }
+  else if (name == "Tag")
+    {
+      retval = get_tag();
+    }
+  else if (name == "UserData")
+    {
+      retval = get_userdata();
+    }
+  else if (name == "Terminator")
+    {
+      octave_value_list ovl;
+      // inc ref count as assign this to octave_value
+      OV_COUNT++; 
+      ovl (0) = octave_value (this);
+      ovl (1) = "terminator";
+      octave_value_list r = OCTAVE__FEVAL (std::string ("__visadev_dispatch__"), ovl, 1);
+      if (r.length () > 0)
+        retval = r(0);
+    }
+  else if (name == "NumBytesWritten")
+    {
+      retval = get_byteswritten();
+    }
+  else if (name == "NumBytesAvailable")
+    {
+      // note we only use this is we didnt have a visa dev attribute prior,
+      // so report the data from completed asynchronous reads
+      if (read_pending)
+        wait_async (0);
+      retval = get_bytesavailable();
+    }
+  else if (name == "Status")
+    {
+      // NOTE: sshould this be a visa status or ours ?
+      retval = get_status();
+    }
+  else if (name == "EOIMode")
+    {
+      retval = get_eoimode();
+    }
+  else if (name == "ByteOrder")
+    {
+      retval = get_byteorder();
+    }
+  else if (name == "ReadChunkSize")
+    {
+      retval = (double)get_read_chunk_size();
+    }
+  else if (name == "TransferStatus")
+    {
+      retval = get_transfer_status();
+    }
+  else if (name == "EnableSRQ")
+    {
+      retval = get_srq_enabled();
+    }
+  else if (name == "BufferMode")
+    {
+      retval = get_buffer_mode();
+    }
+  else if (name == "BufferSize")
+    {
+      retval = (double)get_buffer_size();
+    }
+  else
+    {
+      error ("Unhandled property '%s'", name.c_str());
     }
-  while(p != NULL && p->name != NULL);
 
-  return NULL;
+  return retval;
+}
+
+octave_value
+octave_visadev::get_property_value (const std::string &name)
+{
+  const PropertyMap *p = get_property(name);
+  if (!p)
+    {
+      error ("Unknown property '%s'", name.c_str());
+      return octave_value ();
+    }
+
+  return get_property_value(p);
 }
 
 octave_value_list
@@ -713,67 +895,7 @@ octave_visadev::subsref (const std::string& type, const std::list<octave_value_l
         }
       else
         {
-          if (p->attr > 0)
-            {
-              retval(0) = get_attribute(p);
-            }
-          // handle some properties we handle specifically
-          else if (property == "ResourceName")
-            {
-              retval(0) = get_name();
-            }
-          else if (property == "Type")
-            {
-              retval(0) = get_type();
-            }
-          else if (property == "Timeout")
-            {
-              retval(0) = get_timeout();
-            }
-          else if (property == "Tag")
-            {
-              retval(0) = get_tag();
-            }
-          else if (property == "UserData")
-            {
-              retval(0) = get_userdata();
-            }
-          else if (property == "Terminator")
-            {
-              octave_value_list ovl;
-              // inc ref count as assign this to octave_value
-              OV_COUNT++; 
-              ovl (0) = octave_value (this);
-              ovl (1) = "terminator";
-              retval = OCTAVE__FEVAL (std::string ("__visadev_dispatch__"), ovl, 1);
-            }
-          else if (property == "NumBytesWritten")
-            {
-              retval(0) = get_byteswritten();
-            }
-          else if (property == "NumBytesAvailable")
-            {
-              // note we only use this is we didnt have a visa dev attribute prior
-              retval(0) = (int)0;
-            }
-          else if (property == "Status")
-            {
-              // NOTE: sshould this be a visa status or ours ?
-              retval(0) = get_status();
-            }
-          else if (property == "EIOMode")
-            {
-              retval(0) = get_eoimode();
-            }
-          else if (property == "ByteOrder")
-            {
-              retval(0) = get_byteorder();
-            }
-          else
-            {
-              error ("Unhandled property '%s'", property.c_str());
-              return retval;
-            }
+          retval(0) = get_property_value(p);
         }
         break;
     }
@@ -784,6 +906,131 @@ octave_visadev::subsref (const std::string& type, const std::list<octave_value_l
   return retval;
 }
 
+bool
+octave_visadev::set_property_value (const std::string &name, const octave_value &rhs)
+{
+  const PropertyMap* p = get_property(name);
+  if (!p)
+    {
+      error ("Unknown property '%s'", name.c_str());
+      return false;
+    }
+  else
+    {
+      bool writable = false;
+      const char *mode = p->mode;
+      while (*mode != '\0')
+        {
+          if (*mode == 'w') writable = true;
+          mode ++;
+        }
+
+      if (!writable)
+        {
+          error ("Readonly property '%s'", name.c_str());
+          return false;
+        }
+    }
+
+  if (p->attr > 0)
+    {
+      set_attribute(p, rhs);
+      return true;
+    }
+  else if (name == "Timeout")
+    {
+      if ( !(rhs.OV_ISINTEGER () || rhs.OV_ISFLOAT ()) )
+        {
+          error ("Expected numeric value for property '%s'", name.c_str());
+        }
+      else 
+        {
+          set_timeout(rhs.double_value());
+          return true;
+        }
+    }
+  else if (name == "UserData")
+    {
+      set_userdata (rhs);
+      return true;
+    }
+  else if (name == "ByteOrder")
+    {
+      if (!rhs.is_string())
+        {
+          error ("Expected string value for property '%s'", name.c_str());
+        }
+      else
+        {
+          set_byteorder(rhs.string_value());
+          return true;
+        }
+    }
+  else if (name == "Tag")
+    {
+      if (!rhs.is_string())
+        {
+          error ("Expected string value for property '%s'", name.c_str());
+        }
+      else
+        {
+          set_tag(rhs.string_value());
+          return true;
+        }
+    }
+  else if (name == "ReadChunkSize")
+    {
+      if ( !(rhs.OV_ISINTEGER () || rhs.OV_ISFLOAT ()) || rhs.double_value () < 1)
+        {
+          error ("Expected positive numeric value for property '%s'", name.c_str());
+        }
+      else
+        {
+          set_read_chunk_size(rhs.double_value () > 0xffffffffu ? 0xffffffffu : rhs.ulong_value ());
+          return true;
+        }
+    }
+  else if (name == "EnableSRQ")
+    {
+      if (! (rhs.OV_ISINTEGER () || rhs.OV_ISFLOAT () || rhs.OV_ISLOGICAL ()))
+        {
+          error ("Expected true or false for property '%s'", name.c_str());
+        }
+      else if (set_srq_enabled (rhs.bool_value ()) == 0)
+        {
+          return true;
+        }
+    }
+  else if (name == "BufferMode")
+    {
+      if (!rhs.is_string())
+        {
+          error ("Expected string value for property '%s'", name.c_str());
+        }
+      else if (set_buffer_mode (rhs.string_value ()) == 0)
+        {
+          return true;
+        }
+    }
+  else if (name == "BufferSize")
+    {
+      if ( !(rhs.OV_ISINTEGER () || rhs.OV_ISFLOAT ()) || rhs.double_value () < 1)
+        {
+          error ("Expected positive numeric value for property '%s'", name.c_str());
+        }
+      else if (set_buffer_size (rhs.double_value () > 0xffffffffu ? 0xffffffffu : rhs.ulong_value ()) == 0)
+        {
+          return true;
+        }
+    }
+  else
+    {
+      error ("Unhandled property '%s'", name.c_str());
+    }
+
+  return false;
+}
+
 octave_value
 octave_visadev::subsasgn (const std::string& type, const std::list<octave_value_list>& idx, const octave_value& rhs)
 {
@@ -798,85 +1045,11 @@ octave_visadev::subsasgn (const std::string& type, const std::list<octave_value_
       if (type.length () == 1)
         {
           std::string property = (idx.front ()) (0).string_value ();
-          const PropertyMap* p = get_property(property);
-          if (!p)
-            {
-              error ("Unknown property '%s'", property.c_str());
-              return retval;
-            }
-          else
+          if (set_property_value(property, rhs))
             {
-              bool writable = false;
-              const char *mode = p->mode;
-              while (*mode != '\0')
-                {
-                  if (*mode == 'w') writable = true;
-                  mode ++;
-                }
-
-              if (!writable)
-                {
-                  error ("Readonly property '%s'", property.c_str());
-                  return retval;
-                }
-            }
-
-          if (p->attr > 0)
-            {
-              set_attribute(p, rhs);
-
               OV_COUNT++;
               retval = octave_value (this);
             }
-          else if (property == "Timeout")
-            {
-              if ( !(rhs.OV_ISINTEGER () || rhs.OV_ISFLOAT ()) )
-                {
-                  error ("Expected numeric value for property '%s'", property.c_str());
-                }
-              else 
-	        {
-                  set_timeout(rhs.double_value());
-                  OV_COUNT++;
-                  retval = octave_value (this);
-                }
-	    }
-          else if (property == "UserData")
-            {
-              set_userdata (rhs);
-              OV_COUNT++;
-              retval = octave_value (this);
-	    }
-          else if (property == "ByteOrder")
-            {
-              if (!rhs.is_string())
-	        {
-                  error ("Expected string value for property '%s'", property.c_str());
-                }
-              else
-	        {
-                  set_byteorder(rhs.string_value());
-                  OV_COUNT++;
-                  retval = octave_value (this);
-                }
-            }
-          else if (property == "Tag")
-            {
-              if (!rhs.is_string())
-	        {
-                  error ("Expected string value for property '%s'", property.c_str());
-                }
-              else
-	        {
-                  set_tag(rhs.string_value());
-                  OV_COUNT++;
-                  retval = octave_value (this);
-                }
-            }
-	  else
-	    {
-              error ("Unhandled property '%s'", property.c_str());
-	    }
         }
       else if (type.length () > 1 && type[1] == '.')
         {
@@ -912,6 +1085,7 @@ octave_visadev::open (const std::string &resource)
       lib = get_visa_library();
       if (!lib || !lib->is_valid())
         {
+          lib = 0;
           error("visadev: Could not open VISA library.");
           return -1;
         }
@@ -928,7 +1102,7 @@ octave_visadev::open (const std::string &resource)
   // Get VISA resource manager
   ViSession resource_manager;
   ViStatus  status;
-  status = lib->viOpenDefaultRM(&resource_manager);
+  status = lib->get_resource_manager(&resource_manager);
   if (status < VI_SUCCESS) 
     {
       error("visadev: Could not open VISA resource manager.");
@@ -941,7 +1115,6 @@ octave_visadev::open (const std::string &resource)
   if (status < VI_SUCCESS || instrument == VI_NULL) 
     {
       std::string err = GetStatusMessage(lib, resource_manager, status);
-      lib->viClose(resource_manager);
       error("visadev: Could not open VISA resource - '%s'", err.c_str());
       return -1;
     }
@@ -959,7 +1132,6 @@ octave_visadev::open (const std::string &resource)
     {
       std::string err = GetStatusMessage(lib, resource_manager, status);
       lib->viClose(instrument);
-      lib->viClose(resource_manager);
       instrument =  VI_NULL;
       error("visadev: Could not open VISA resouce - '%s'", err.c_str());
       return -1;
@@ -969,36 +1141,36 @@ octave_visadev::open (const std::string &resource)
     {
       case VI_INTF_ASRL:
         type_str = "serial";
-        properties = serial_field_map;
+        set_property_map(serial_field_map);
         break;
       case VI_INTF_GPIB:
         type_str = "gpib";
-        properties = gpib_field_map;
+        set_property_map(gpib_field_map);
 	break;
       case VI_INTF_VXI:
         type_str = "vxi";
-        properties = vxi_field_map;
+        set_property_map(vxi_field_map);
 	break;
       case VI_INTF_GPIB_VXI:
         type_str = "vxi";
-        properties = vxi_field_map;
+        set_property_map(vxi_field_map);
 	break;
       case VI_INTF_PXI:
         type_str = "pxi";
-        properties = pxi_field_map;
+        set_property_map(pxi_field_map);
 	break;
       case VI_INTF_TCPIP:
         type_str = "tcpip";
-        properties = tcp_field_map;
+        set_property_map(tcp_field_map);
 	if (name.size() >= 8 && name.substr(name.size()-8, 8) == "::SOCKET")
 	  {
             type_str = "socket";
-            properties = socket_field_map;
+            set_property_map(socket_field_map);
           }
 	break;
       case VI_INTF_USB:
         type_str = "usb";
-        properties = usb_field_map;
+        set_property_map(usb_field_map);
 	break;
 
       default:
@@ -1016,9 +1188,6 @@ octave_visadev::open (const std::string &resource)
 octave_visadev::~octave_visadev (void)
 {
   close();
-
-  if(lib)
-    free_visa_library(lib);
 }
 
 void
@@ -1051,13 +1220,16 @@ octave_visadev::print_raw (std::ostream& os, bool pr_as_read_syntax) const
 int
 octave_visadev::get_bytesavailable () const
 {
-  return 0;
+  return rxbuf.size ();
 }
 
 int
-octave_visadev::read (uint8_t *buf, unsigned int len)
+octave_visadev::read (uint8_t *buf, unsigned int len, bool *end)
 {
-  size_t bytes_read = 0;
+  unsigned int bytes_read = 0;
+
+  if (end)
+    *end = false;
 
   if (! is_open())
     {
@@ -1065,26 +1237,528 @@ octave_visadev::read (uint8_t *buf, unsigned int len)
       return 0;
     }
 
-  ViStatus  status;
-  const ViUInt32 buffer_size_B = len;
-  ViByte buffer[buffer_size_B+1];
-  ViUInt32 io_bytes;
+  // data left over from readline or an asynchronous read is returned
+  // first
+  if (read_pending)
+    wait_async (0);
+
+  if (rxbuf.size () > 0)
+    {
+      int count = rxbuf.take (buf, len);
+      if (async_end && rxbuf.size () == 0)
+        {
+          async_end = false;
+          if (end)
+            *end = true;
+        }
+      return count;
+    }
+
+  if (read_pending)
+    {
+      error ("visadev: an asynchronous read is in progress");
+      return -1;
+    }
+
+  // a query still in the write buffer would never be answered
+  if (send_buffered () < 0)
+    return -1;
+
+  bool buffered = (buffer_mode != "off");
+
+  // viRead writes straight into the caller's buffer, a chunk at a time,
+  // until len bytes or the END or termination character of a message
+  while (bytes_read < len)
+    {
+      ViUInt32 want = std::min (len - bytes_read, read_chunk_size);
+      ViUInt32 io_bytes = 0;
+      ViStatus status;
 
-  status = lib->viRead(instrument, buffer, buffer_size_B, &io_bytes);
+      if (buffered)
+        status = lib->viBufRead(instrument, buf + bytes_read, want, &io_bytes);
+      else
+        status = lib->viRead(instrument, buf + bytes_read, want, &io_bytes);
+      bytes_read += io_bytes;
+
+      if (status < VI_SUCCESS)
+        {
+          // a timeout part way through returns what was read
+          if (status == VI_ERROR_TMO && bytes_read > 0)
+            break;
+
+          std::string err = GetStatusMessage(lib, instrument, status);
+          error("visadev: Could not read - '%s'", err.c_str());
+          return -1;
+        }
+
+      // anything other than a full chunk ended the message
+      if (status != VI_SUCCESS_MAX_CNT)
+        {
+          if (end)
+            *end = true;
+          break;
+        }
+
+      OCTAVE_QUIT;
+    }
+
+  return bytes_read;
+}
+
+bool
+octave_visadev::readline (std::string &line)
+{
+  // viRead returns at the end of each message, so read in fixed size
+  // chunks rather than waiting on the bytes available
+  return rxbuf.read_line (octave_terminator_string (interminator), line,
+    [this] (uint8_t *buf, unsigned int len)
+    {
+      return read (buf, len);
+    },
+    [] (void)
+    {
+      return 4096;
+    });
+}
+
+octave_value
+octave_visadev::readbinblock (const octave_data_type &type)
+{
+  // the LF after the block is still to come if the last read did not
+  // reach the END of the message
+  bool end = false;
+
+  return octave_read_binblock (rxbuf, type, octave_byteorder_needs_swap (byteOrder),
+    [this, &end] (uint8_t *buf, unsigned int len)
+    {
+      return read (buf, len, &end);
+    },
+    [] (void)
+    {
+      return 4096;
+    },
+    [&end] (void)
+    {
+      return end ? 0 : 1;
+    });
+}
+
+bool
+octave_visadev::writeread (const std::string &cmd, std::string &line)
+{
+  // command and terminator go out in a single write
+  if (write (cmd + octave_terminator_string (outterminator)) < 0)
+    return false;
+
+  return readline (line);
+}
+
+bool
+octave_visadev::enable_io_events (void)
+{
+  if (io_events)
+    return true;
+
+  ViStatus status = lib->viEnableEvent(instrument, VI_EVENT_IO_COMPLETION, VI_QUEUE, VI_NULL);
   if (status < VI_SUCCESS)
     {
       std::string err = GetStatusMessage(lib, instrument, status);
-      error("visadev: Could not read - '%s'", err.c_str());
+      error("visadev: Could not enable io completion events - '%s'", err.c_str());
+      return false;
+    }
+
+  io_events = true;
+  return true;
+}
+
+int
+octave_visadev::read_async (unsigned int len)
+{
+  if (! is_open())
+    {
+      error ("visadev_readasync: Interface must be opened first...");
       return -1;
     }
 
-  if (io_bytes > 0)
+  if (read_pending)
     {
-      bytes_read = io_bytes;
-      memcpy(&buf[0], buffer, bytes_read);
+      error ("visadev: an asynchronous read is already in progress");
+      return -1;
     }
 
-  return bytes_read;
+  if (! enable_io_events () || send_buffered () < 0)
+    return -1;
+
+  async_rx.resize (len);
+
+  ViStatus status = lib->viReadAsync(instrument, async_rx.data (), len, &read_job);
+  if (status < VI_SUCCESS)
+    {
+      std::string err = GetStatusMessage(lib, instrument, status);
+      error("visadev: Could not start read - '%s'", err.c_str());
+      return -1;
+    }
+
+  read_pending = true;
+  return 0;
+}
+
+int
+octave_visadev::write_async (const uint8_t *buf, unsigned int len)
+{
+  if (! is_open())
+    {
+      error ("visadev_writeasync: Interface must be opened first...");
+      return -1;
+    }
+
+  if (write_pending)
+    {
+      error ("visadev: an asynchronous write is already in progress");
+      return -1;
+    }
+
+  if (! enable_io_events () || send_buffered () < 0)
+    return -1;
+
+  async_tx.assign (buf, buf + len);
+
+  ViStatus status = lib->viWriteAsync(instrument, async_tx.data (), len, &write_job);
+  if (status < VI_SUCCESS)
+    {
+      std::string err = GetStatusMessage(lib, instrument, status);
+      error("visadev: Could not start write - '%s'", err.c_str());
+      return -1;
+    }
+
+  write_pending = true;
+  return len;
+}
+
+void
+octave_visadev::complete_async (ViEvent event)
+{
+  ViJobId job = 0;
+  ViStatus status = VI_SUCCESS;
+  ViUInt32 count = 0;
+
+  lib->viGetAttribute(event, VI_ATTR_JOB_ID, &job);
+  lib->viGetAttribute(event, VI_ATTR_STATUS, &status);
+  lib->viGetAttribute(event, VI_ATTR_RET_COUNT, &count);
+  lib->viClose(event);
+
+  if (read_pending && job == read_job)
+    {
+      read_pending = false;
+      async_end = (status >= VI_SUCCESS && status != VI_SUCCESS_MAX_CNT);
+      if (count > async_rx.size ())
+        count = async_rx.size ();
+      if (count > 0)
+        rxbuf.fill (count,
+          [this, count] (uint8_t *buf, unsigned int)
+          {
+            memcpy (buf, async_rx.data (), count);
+            return (int)count;
+          },
+          [count] (void)
+          {
+            return (int)count;
+          });
+    }
+  else if (write_pending && job == write_job)
+    {
+      write_pending = false;
+      byteswritten += count;
+    }
+
+  // a transfer ended by visastopasync is not an error
+  if (status < VI_SUCCESS && status != VI_ERROR_ABORT && async_error == VI_SUCCESS)
+    async_error = status;
+}
+
+ViStatus
+octave_visadev::wait_event (ViEventType type, double waittime, ViEvent &event)
+{
+  auto start = std::chrono::steady_clock::now ();
+
+  for (;;)
+    {
+      // wait in slices, so that ctrl-c is seen
+      double left = 100;
+      if (waittime >= 0)
+        {
+          double elapsed = std::chrono::duration<double, std::milli> (std::chrono::steady_clock::now () - start).count ();
+          left = std::max (0.0, std::min (left, waittime * 1000 - elapsed));
+        }
+
+      ViEventType outtype;
+      ViStatus status = lib->viWaitOnEvent(instrument, type, (ViUInt32)left, &outtype, &event);
+      if (status != VI_ERROR_TMO || left == 0)
+        return status;
+
+      OCTAVE_QUIT;
+    }
+}
+
+bool
+octave_visadev::wait_async (double waittime)
+{
+  auto start = std::chrono::steady_clock::now ();
+
+  while (is_open () && (read_pending || write_pending))
+    {
+      double left = -1;
+      if (waittime >= 0)
+        {
+          double elapsed = std::chrono::duration<double> (std::chrono::steady_clock::now () - start).count ();
+          left = std::max (0.0, waittime - elapsed);
+        }
+
+      ViEvent event;
+      ViStatus status = wait_event (VI_EVENT_IO_COMPLETION, left, event);
+      if (status >= VI_SUCCESS)
+        complete_async (event);
+      else if (status == VI_ERROR_TMO)
+        break;
+      else
+        {
+          std::string err = GetStatusMessage(lib, instrument, status);
+          error("visadev: Could not wait for transfers - '%s'", err.c_str());
+          return false;
+        }
+    }
+
+  if (async_error != VI_SUCCESS)
+    {
+      std::string err = GetStatusMessage(lib, instrument, async_error);
+      async_error = VI_SUCCESS;
+      error("visadev: Asynchronous transfer failed - '%s'", err.c_str());
+      return false;
+    }
+
+  return ! (read_pending || write_pending);
+}
+
+int
+octave_visadev::stop_async (void)
+{
+  if (! is_open() || ! (read_pending || write_pending))
+    return 0;
+
+  if (read_pending)
+    lib->viTerminate(instrument, VI_NULL, read_job);
+  if (write_pending)
+    lib->viTerminate(instrument, VI_NULL, write_job);
+
+  // terminated transfers still complete, with VI_ERROR_ABORT, which
+  // clears their pending state. One whose completion has not come by
+  // the end of the wait stays pending, as the library may still use
+  // its buffer, and is stopped by a later call or by close. Only if
+  // the wait throws are the transfers given up on, so the object is
+  // not left unable to start another.
+  struct pending_guard
+  {
+    octave_visadev *dev;
+    bool armed;
+    ~pending_guard (void)
+    {
+      if (armed)
+        {
+          dev->read_pending = false;
+          dev->write_pending = false;
+        }
+    }
+  } guard = { this, true };
+
+  bool done = wait_async (1);
+  guard.armed = false;
+
+  return done ? 0 : -1;
+}
+
+int
+octave_visadev::set_srq_enabled (bool enable)
+{
+  if (! is_open())
+    {
+      error ("visadev: Interface must be opened first...");
+      return -1;
+    }
+
+  if (enable == srq_events)
+    return 0;
+
+  ViStatus status;
+  if (enable)
+    status = lib->viEnableEvent(instrument, VI_EVENT_SERVICE_REQ, VI_QUEUE, VI_NULL);
+  else
+    {
+      status = lib->viDisableEvent(instrument, VI_EVENT_SERVICE_REQ, VI_ALL_MECH);
+      lib->viDiscardEvents(instrument, VI_EVENT_SERVICE_REQ, VI_ALL_MECH);
+    }
+
+  if (status < VI_SUCCESS)
+    {
+      std::string err = GetStatusMessage(lib, instrument, status);
+      error("visadev: Could not %s service requests - '%s'", enable ? "enable" : "disable", err.c_str());
+      return -1;
+    }
+
+  srq_events = enable;
+  return 0;
+}
+
+int
+octave_visadev::wait_srq (double waittime)
+{
+  // service requests are only queued once enabled, so the first wait
+  // only sees those that come after it
+  if (! srq_events && set_srq_enabled (true) < 0)
+    return -1;
+
+  if (send_buffered () < 0)
+    return -1;
+
+  ViEvent event;
+  ViStatus status = wait_event (VI_EVENT_SERVICE_REQ, waittime, event);
+  if (status == VI_ERROR_TMO)
+    return 0;
+
+  if (status < VI_SUCCESS)
+    {
+      std::string err = GetStatusMessage(lib, instrument, status);
+      error("visadev: Could not wait for a service request - '%s'", err.c_str());
+      return -1;
+    }
+
+  lib->viClose(event);
+  return 1;
+}
+
+int
+octave_visadev::read_stb (void)
+{
+  if (! is_open())
+    {
+      error ("visadev: Interface must be opened first...");
+      return -1;
+    }
+
+  if (send_buffered () < 0)
+    return -1;
+
+  ViUInt16 stb = 0;
+  ViStatus status = lib->viReadSTB(instrument, &stb);
+  if (status < VI_SUCCESS)
+    {
+      std::string err = GetStatusMessage(lib, instrument, status);
+      error("visadev: Could not read the status byte - '%s'", err.c_str());
+      return -1;
+    }
+
+  return stb;
+}
+
+int
+octave_visadev::set_buffer_mode (const std::string &mode)
+{
+  if (! is_open())
+    {
+      error ("visadev: Interface must be opened first...");
+      return -1;
+    }
+
+  if (mode != "off" && mode != "manual" && mode != "terminator")
+    {
+      error ("visadev: BufferMode must be 'off', 'manual' or 'terminator'");
+      return -1;
+    }
+
+  if (mode == buffer_mode)
+    return 0;
+
+  ViStatus status = VI_SUCCESS;
+  if (buffer_mode == "off")
+    {
+      status = lib->viSetBuf(instrument, VI_READ_BUF | VI_WRITE_BUF, buffer_size);
+      // sending is left to us and to a full buffer
+      if (status >= VI_SUCCESS)
+        lib->viSetAttribute(instrument, VI_ATTR_WR_BUF_OPER_MODE, VI_FLUSH_WHEN_FULL);
+    }
+  else if (mode == "off")
+    {
+      // viRead does not see the read buffer, so anything left in it is
+      // dropped
+      if (send_buffered () < 0)
+        return -1;
+      status = lib->viFlush(instrument, VI_READ_BUF_DISCARD);
+    }
+
+  if (status < VI_SUCCESS)
+    {
+      std::string err = GetStatusMessage(lib, instrument, status);
+      error("visadev: Could not set the buffer mode - '%s'", err.c_str());
+      return -1;
+    }
+
+  buffer_mode = mode;
+  return 0;
+}
+
+int
+octave_visadev::set_buffer_size (unsigned int size)
+{
+  if (is_open() && buffer_mode != "off")
+    {
+      if (send_buffered () < 0)
+        return -1;
+
+      ViStatus status = lib->viSetBuf(instrument, VI_READ_BUF | VI_WRITE_BUF, size);
+      if (status < VI_SUCCESS)
+        {
+          std::string err = GetStatusMessage(lib, instrument, status);
+          error("visadev: Could not set the buffer size - '%s'", err.c_str());
+          return -1;
+        }
+    }
+
+  buffer_size = size;
+  return 0;
+}
+
+int
+octave_visadev::send_buffered (void)
+{
+  if (! write_queued)
+    return 0;
+
+  write_queued = false;
+
+  ViStatus status = lib->viFlush(instrument, VI_WRITE_BUF);
+  if (status < VI_SUCCESS)
+    {
+      std::string err = GetStatusMessage(lib, instrument, status);
+      error("visadev: Could not send buffered data - '%s'", err.c_str());
+      return -1;
+    }
+
+  return 0;
+}
+
+std::string
+octave_visadev::get_transfer_status (void)
+{
+  if (read_pending || write_pending)
+    wait_async (0);
+
+  if (read_pending && write_pending)
+    return "read&write";
+  else if (read_pending)
+    return "read";
+  else if (write_pending)
+    return "write";
+
+  return "idle";
 }
 
 int
@@ -1105,8 +1779,12 @@ octave_visadev::write (const uint8_t *buf, unsigned int len)
 
   ViStatus  status;
   ViUInt32 io_bytes;
+  bool buffered = (buffer_mode != "off");
 
-  status = lib->viWrite(instrument, (ViBuf)buf, len, &io_bytes);
+  if (buffered)
+    status = lib->viBufWrite(instrument, (ViBuf)buf, len, &io_bytes);
+  else
+    status = lib->viWrite(instrument, (ViBuf)buf, len, &io_bytes);
   if (status < VI_SUCCESS)
     {
       std::string err = GetStatusMessage(lib, instrument, status);
@@ -1114,6 +1792,23 @@ octave_visadev::write (const uint8_t *buf, unsigned int len)
       return -1;
     }
 
+  byteswritten += io_bytes;
+
+  if (buffered)
+    {
+      write_queued = true;
+
+      // a complete command goes out straight away
+      if (buffer_mode == "terminator")
+        {
+          std::string term = octave_terminator_string (outterminator);
+          if (term.length () > 0 && len >= term.length ()
+              && memcmp (buf + len - term.length (), term.c_str (), term.length ()) == 0
+              && send_buffered () < 0)
+            return -1;
+        }
+    }
+
   return io_bytes;
 }
 
@@ -1173,10 +1868,27 @@ octave_visadev::close (void)
   int retval = -1;
   if (instrument != VI_NULL)
     {
-      ViSession session_manager;
-      lib->viGetAttribute(instrument, VI_ATTR_RM_SESSION, &session_manager);
+      // end any transfers still in progress, as their buffers go with
+      // the object
+      if (read_pending)
+        lib->viTerminate(instrument, VI_NULL, read_job);
+      if (write_pending)
+        lib->viTerminate(instrument, VI_NULL, write_job);
+      if (io_events)
+        lib->viDisableEvent(instrument, VI_EVENT_IO_COMPLETION, VI_ALL_MECH);
+      if (srq_events)
+        lib->viDisableEvent(instrument, VI_EVENT_SERVICE_REQ, VI_ALL_MECH);
+      // queued writes are sent rather than lost
+      if (write_queued)
+        lib->viFlush(instrument, VI_WRITE_BUF);
+      read_pending = false;
+      write_pending = false;
+      io_events = false;
+      srq_events = false;
+      write_queued = false;
+
+      // the resource manager session is shared, so stays open
       lib->viClose(instrument);
-      lib->viClose(session_manager);
       instrument = VI_NULL;
     }
 
@@ -1206,6 +1918,9 @@ octave_visadev::trigger ()
   ViStatus  status = 0;
   ViUInt16 protocol = VI_TRIG_PROT_DEFAULT;
 
+  if (send_buffered () < 0)
+    return -1;
+
   status = lib->viAssertTrigger(instrument, protocol);
 
   if (status < VI_SUCCESS)
@@ -1235,12 +1950,15 @@ octave_visadev::flush (int mode)
 
   if (mode & 1)
     {
+      write_queued = false;
       mask = mask | VI_WRITE_BUF_DISCARD;
       //status = lib->viFlush(instrument, mask);
     }
 
   if (mode & 2)
     {
+      rxbuf.clear ();
+      async_end = false;
       mask = mask | VI_READ_BUF_DISCARD;
       //status = lib->viFlush(instrument, mask);
     }
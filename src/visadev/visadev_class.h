@@ -21,6 +21,7 @@
 
 #include <string>
 #include <vector>
+#include <unordered_map>
 
 #ifdef HAVE_CONFIG_H
 #  include "../config.h"
@@ -34,6 +35,9 @@
 # endif
 #endif
 
+#include "../common/receive_buffer.h"
+#include "../common/typed_data.h"
+
 struct PropertyMap;
 
 class visa_devinfo
@@ -58,12 +62,53 @@ public:
   octave_visadev (void);
   ~octave_visadev (void);
 
-  static std::vector <visa_devinfo> list_devices();
+  // resources matching the VISA expression, from a cached list if it
+  // is no more than max_age seconds old
+  static std::vector <visa_devinfo> list_devices(const std::string &expr = "?*", double max_age = 0);
 
   int write (const std::string &str);
   int write (const uint8_t *buf, unsigned int len);
 
-  int read (uint8_t *buf, unsigned int len);
+  // read until len bytes or the end of a message, setting end if the
+  // read stopped at the end of a message
+  int read (uint8_t *buf, unsigned int len, bool *end = 0);
+  bool readline (std::string &line);
+  octave_value readbinblock (const octave_data_type &type);
+  bool writeread (const std::string &cmd, std::string &line);
+
+  // asynchronous transfers with viReadAsync and viWriteAsync. Data from
+  // a completed read is returned by the following reads
+  int read_async (unsigned int len);
+  int write_async (const uint8_t *buf, unsigned int len);
+  // collect completed transfers, waiting up to timeout seconds (-1
+  // forever) for all of them, and returning true if none are left
+  bool wait_async (double timeout);
+  int stop_async (void);
+  std::string get_transfer_status (void);
+
+  // service requests queued as VI_EVENT_SERVICE_REQ events. wait_srq
+  // waits up to waittime seconds (-1 forever) for one, returning 1 if
+  // one arrived and 0 on a timeout
+  int set_srq_enabled (bool enable);
+  bool get_srq_enabled (void) const { return srq_events; }
+  int wait_srq (double waittime);
+  int read_stb (void);
+
+  // formatted io buffering. With a mode other than "off", writes are
+  // queued in the VISA write buffer with viBufWrite and sent as one
+  // transfer when it fills, by send_buffered, before any read and, in
+  // "terminator" mode, by a write ending with the output terminator.
+  // Reads go through the VISA read buffer with viBufRead
+  int set_buffer_mode (const std::string &mode);
+  std::string get_buffer_mode (void) const { return buffer_mode; }
+  int set_buffer_size (unsigned int size);
+  unsigned int get_buffer_size (void) const { return buffer_size; }
+  int send_buffered (void);
+
+  // value of a property by name, as used by get and set on many
+  // properties at once. set returns true if the property was set
+  octave_value get_property_value (const std::string &name);
+  bool set_property_value (const std::string &name, const octave_value &value);
 
   //int getsockopt (int level, int opt, void *buf, socklen_t *len);
   //int setsockopt (int level, int opt, const void *buf, socklen_t len);
@@ -169,6 +214,16 @@ public:
     return byteOrder;
   }
 
+  unsigned int get_read_chunk_size() const
+  {
+    return read_chunk_size;
+  }
+
+  void set_read_chunk_size(unsigned int newv)
+  {
+    read_chunk_size = newv;
+  }
+
   int set_input_terminator(const octave_value& /* term */);
   int set_output_terminator(const octave_value& /* term */);
 
@@ -185,13 +240,20 @@ public:
 private:
   class visa_library * lib;
   const PropertyMap* get_property(const std::string &name) const;
+  void set_property_map(PropertyMap *map);
+  octave_value get_property_value(const PropertyMap *p);
   octave_value get_attribute(const PropertyMap *p);
   bool set_attribute(const PropertyMap *p, const octave_value &value);
+  bool enable_io_events (void);
+  void complete_async (ViEvent event);
+  ViStatus wait_event (ViEventType type, double waittime, ViEvent &event);
   
   uint8_t *input_buffer;
   int buffer_len;
   int buffer_pos;
   struct PropertyMap * properties;
+  // name lookup of properties
+  const std::unordered_map<std::string, const PropertyMap *> *property_lookup;
 
   //int fd;
   ViSession instrument;
@@ -204,7 +266,29 @@ private:
   unsigned int byteswritten;
   octave_value interminator;
   octave_value outterminator;
+  octave_receive_buffer rxbuf;
   bool eoimode;
+  // largest count passed to a single viRead
+  unsigned int read_chunk_size;
+
+  // buffers of the asynchronous transfers in progress, which must stay
+  // in place until they complete
+  std::vector<uint8_t> async_rx;
+  std::vector<uint8_t> async_tx;
+  ViJobId read_job;
+  ViJobId write_job;
+  bool read_pending;
+  bool write_pending;
+  bool io_events;
+  ViStatus async_error;
+  // the data from the last asynchronous read ended a message
+  bool async_end;
+  bool srq_events;
+
+  std::string buffer_mode;
+  unsigned int buffer_size;
+  // writes are waiting in the VISA write buffer
+  bool write_queued;
 
   DECLARE_OV_TYPEID_FUNCTIONS_AND_DATA
 };
@@ -21,6 +21,7 @@
 #endif
 
 #ifdef BUILD_VISA
+#  include <algorithm>
 #  include "visadev_class.h"
 #endif
 
@@ -28,14 +29,23 @@
 DEFUN_DLD (visadevlist, args, nargout,
         "-*- texinfo -*-\n\
 @deftypefn {} {@var{resourcelist} = } visadevlist ()\n \
+@deftypefnx {} {@var{resourcelist} = } visadevlist (@var{propertyname}, @var{propertyvalue} @dots{})\n \
 \n\
 List available visadev resources.\n \
 \n\
+The list is kept for a time, as finding the resources can take seconds.\n \
+\n\
 @subsubheading Inputs\n \
 @var{propertyname}, @var{propertyvalue} - property name/value pair\n \
 \n\
 Known input properties:\n \
 @table @asis\n \
+@item Filter\n \
+VISA expression the resource names must match, such as \"TCPIP?*INSTR\" (default \"?*\")\n \
+@item MaxAge\n \
+seconds a previous list for the same filter is used before searching again (default 10)\n \
+@item Refresh\n \
+true to search again regardless of MaxAge\n \
 @end table \n \
 \n\
 @subsubheading Outputs\n \
@@ -52,7 +62,69 @@ Struct properties:\n \
 #else
   octave_value retval;
 
-  std::vector <visa_devinfo> devs = octave_visadev::list_devices();
+  std::string filter = "?*";
+  double max_age = 10;
+
+  if ((args.length () & 1) == 1)
+    {
+      error ("Expected property name/value pairs");
+      return octave_value ();
+    }
+
+  for (int i=0;i<args.length();i+=2)
+    {
+      if (! args(i).is_string ())
+        {
+          error ("Expected property name/value pairs");
+          return octave_value ();
+        }
+
+      std::string propname = args(i).string_value();
+      octave_value propval = args(i+1);
+
+      std::transform (propname.begin (), propname.end (), propname.begin (), ::tolower);
+
+      if (propname == "filter")
+        {
+          if (propval.is_string () && ! propval.string_value ().empty ())
+            filter = propval.string_value ();
+          else
+            {
+              error ("filter must be a non empty string");
+              return octave_value ();
+            }
+        }
+      else if (propname == "maxage")
+        {
+          if (propval.OV_ISINTEGER () || propval.OV_ISFLOAT ())
+            max_age = propval.double_value ();
+          else
+            {
+              error ("maxage must be a number of seconds");
+              return octave_value ();
+            }
+        }
+      else if (propname == "refresh")
+        {
+          if (propval.OV_ISINTEGER () || propval.OV_ISFLOAT () || propval.OV_ISLOGICAL ())
+            {
+              if (propval.bool_value ())
+                max_age = 0;
+            }
+          else
+            {
+              error ("refresh must be true or false");
+              return octave_value ();
+            }
+        }
+      else
+        {
+          error ("unknown property '%s'", propname.c_str ());
+          return octave_value ();
+        }
+    }
+
+  std::vector <visa_devinfo> devs = octave_visadev::list_devices(filter, max_age);
 
   Cell name (dim_vector (1, devs.size()));
   Cell alias (dim_vector (1, devs.size()));
@@ -84,4 +156,12 @@ Struct properties:\n \
 %! assert(isstruct(lst));
 %! assert(isfield(lst, "Alias"));
 %! assert(isfield(lst, "ResourceName"));
+
+%!xtest
+%! lst = visadevlist("Filter", "TCPIP?*INSTR", "Refresh", true);
+%! assert(isstruct(lst));
+%! assert(all(strncmp({lst.ResourceName}, "TCPIP", 5)));
+
+%!error <Expected property name/value pairs> visadevlist("Filter")
+%!error <unknown property> visadevlist("Nothing", 1)
 #endif
@@ -0,0 +1,175 @@
+// Copyright (C) 2026   John Donoghue   <john.donoghue@ieee.org>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+
+#include <octave/oct.h>
+
+#ifdef HAVE_CONFIG_H
+#  include "../config.h"
+#endif
+
+#ifdef BUILD_VXI11
+#  include "vxi11_class.h"
+
+static octave_value_list
+vxi11_type (octave_vxi11 *vxi11, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value ("vxi11");
+}
+
+static octave_value_list
+vxi11_remotehost (octave_vxi11 *vxi11, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (vxi11->get_remote_host ());
+}
+
+static octave_value_list
+vxi11_device (octave_vxi11 *vxi11, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+  if (args.length () > 0)
+    (*current_liboctave_error_handler) ("can not set this property");
+
+  return octave_value (vxi11->get_device ());
+}
+
+static octave_value_list
+vxi11_timeout (octave_vxi11 *vxi11, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  if (args.length () > 0)
+    {
+      if (! (args (0).OV_ISINTEGER () || args (0).OV_ISFLOAT ()))
+        (*current_liboctave_error_handler) ("Timeout must be a number of seconds");
+      return octave_value (vxi11->set_timeout (args(0).double_value ()));
+    }
+
+  return octave_value (vxi11->get_timeout ());
+}
+
+static octave_value_list
+vxi11_locktimeout (octave_vxi11 *vxi11, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  if (args.length () > 0)
+    {
+      if (! (args (0).OV_ISINTEGER () || args (0).OV_ISFLOAT ()))
+        (*current_liboctave_error_handler) ("LockTimeout must be a number of seconds");
+      return octave_value (vxi11->set_lock_timeout (args(0).double_value ()));
+    }
+
+  return octave_value (vxi11->get_lock_timeout ());
+}
+
+static octave_value_list
+vxi11_termchar (octave_vxi11 *vxi11, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  if (args.length () > 0)
+    {
+      // empty for no termination character
+      if (args (0).numel () == 0)
+        return octave_value (vxi11->set_term_char (-1));
+      if (args (0).is_string () && args (0).string_value ().length () == 1)
+        return octave_value (vxi11->set_term_char ((unsigned char)args (0).string_value ()[0]));
+      if (args (0).OV_ISINTEGER () || args (0).OV_ISFLOAT ())
+        return octave_value (vxi11->set_term_char (args (0).int_value ()));
+
+      (*current_liboctave_error_handler) ("TermChar must be a character, a value 0 to 255 or empty");
+    }
+
+  if (vxi11->get_term_char () < 0)
+    return octave_value (Matrix ());
+
+  return octave_value (std::string (1, (char)vxi11->get_term_char ()));
+}
+
+static octave_value_list
+vxi11_enablesrq (octave_vxi11 *vxi11, const octave_value_list& args, int)
+{
+  if (args.length () > 1)
+    (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  if (args.length () > 0)
+    {
+      if (! (args (0).OV_ISLOGICAL () || args (0).OV_ISINTEGER () || args (0).OV_ISFLOAT ()))
+        (*current_liboctave_error_handler) ("EnableSRQ must be true or false");
+      return octave_value (vxi11->set_srq_enabled (args (0).bool_value ()));
+    }
+
+  return octave_value (vxi11->get_srq_enabled ());
+}
+
+static const octave_property<octave_vxi11> vxi11_property_list[] =
+{
+  {"Type", vxi11_type, true},
+  {"RemoteHost", vxi11_remotehost, true},
+  {"Device", vxi11_device, true},
+  {"Timeout", vxi11_timeout, true},
+  {"LockTimeout", vxi11_locktimeout, true},
+  {"TermChar", vxi11_termchar, true},
+  {"EnableSRQ", vxi11_enablesrq, true},
+  {NULL, NULL, false}
+};
+
+const octave_property_table<octave_vxi11> &
+octave_vxi11::properties (void)
+{
+  static const octave_property_table<octave_vxi11> table (vxi11_property_list);
+  return table;
+}
+#endif
+
+// PKG_ADD: autoload ("__vxi11_properties__", "vxi11.oct");
+DEFUN_DLD (__vxi11_properties__, args, nargout,
+"-*- texinfo -*-\n\
+@deftypefn {} {varargout =} __vxi11_properties__ (@var{octave_vxi11}, @var{property}, @var{varargin})\n\
+Undocumented internal function.\n\
+@end deftypefn")
+{
+#ifdef BUILD_VXI11
+  if (args.length () < 2 || args.length () > 3 ||
+    args(0).type_id () != octave_vxi11::static_type_id () ||
+    !args(1).is_string ())
+      (*current_liboctave_error_handler) ("wrong number of arguments");
+
+  const octave_base_value& rep = args(0).get_rep ();
+  octave_vxi11* vxi11 = &((octave_vxi11 &)rep);
+
+  const octave_property<octave_vxi11> *prop = octave_vxi11::properties ().find (args(1).string_value ());
+  if (! prop)
+    (*current_liboctave_error_handler) ("invalid property name");
+
+  return prop->handler (vxi11, args.slice (2, args.length ()-2), nargout);
+#endif
+    /* never reached in normal operation */
+  (*current_liboctave_error_handler) ("Your system doesn't support the VXI11 interface");
+}
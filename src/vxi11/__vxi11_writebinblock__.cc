@@ -0,0 +1,84 @@
+// Copyright (C) 2026   John Donoghue   <john.donoghue@ieee.org>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+
+#include <octave/oct.h>
+
+#ifdef HAVE_CONFIG_H
+#include "../config.h"
+#endif
+
+#ifdef BUILD_VXI11
+#include "vxi11_class.h"
+#include "../common/binblock.h"
+#endif
+
+// PKG_ADD: autoload ("__vxi11_writebinblock__", "vxi11.oct");
+DEFUN_DLD (__vxi11_writebinblock__, args, nargout,
+        "-*- texinfo -*-\n\
+@deftypefn {} {@var{n} = } __vxi11_writebinblock__ (@var{vxi11}, @var{data}, @var{datatype})\n \
+\n\
+Private function to write data as a IEEE 488.2 binblock to a vxi11 interface.\n \
+\n\
+The block header, data and terminator are sent with a single gathered write,\n \
+without copying the data.\n \
+\n\
+@subsubheading Inputs\n \
+@var{vxi11} - instance of @var{octave_vxi11} class.@* \
+@var{data} - data to write.@* \
+@var{datatype} - precision to convert @var{data} to.\n \
+\n\
+@subsubheading Outputs\n \
+@var{n} - number of bytes written, including the header and terminator.\n \
+@end deftypefn")
+{
+#ifndef BUILD_VXI11
+  error ("vxi11: Your system doesn't support the VXI11 interface");
+  return octave_value ();
+#else
+
+  if (args.length () != 3 || args (0).type_id () != octave_vxi11::static_type_id () || ! args (2).is_string ())
+    {
+      print_usage ();
+      return octave_value (-1);
+    }
+
+  octave_data_type type;
+
+  if (! octave_data_type_lookup (args (2).string_value (), type))
+    {
+      error ("__vxi11_writebinblock__: datatype not supported");
+      return octave_value (-1);
+    }
+
+  octave_vxi11* vxi11 = NULL;
+
+  const octave_base_value& rep = args (0).get_rep ();
+  vxi11 = &((octave_vxi11 &)rep);
+
+  int retval = octave_write_binblock_parts (args (1), type, false,
+    [vxi11] (const octave_write_part *parts, int nparts)
+    {
+      return vxi11->write_parts (parts, nparts);
+    });
+
+  return octave_value (retval);
+#endif
+}
+
+#if 0
+%!error <Invalid call to __vxi11_writebinblock__> __vxi11_writebinblock__ ()
+
+%!error <Invalid call to __vxi11_writebinblock__> __vxi11_writebinblock__ (1, "hello", "uint8")
+#endif
@@ -39,6 +39,8 @@ Open vxi11 interface.\n \
 @var{instr} - the instrument name of type String. If omitted defaults to 'inst0'.\n \
 \n\
 The vxi11() shall return instance of @var{octave_vxi11} class as the result @var{vxi11}.\n \
+\n\
+Objects open to the same @var{ip} and @var{instr} share one link to the instrument.\n \
 @end deftypefn")
 {
 #ifndef BUILD_VXI11
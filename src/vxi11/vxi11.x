@@ -155,6 +155,10 @@ struct Device_DocmdResp {
    opaque data_out<>; /* returned data parameter */
 };
 
+struct Device_SrqParms {
+   opaque handle<>; /* handle given to device_enable_srq */
+};
+
 program DEVICE_ASYNC{
    version DEVICE_ASYNC_VERSION {
       Device_Error device_abort (Device_Link) = 1;
@@ -181,3 +185,8 @@ program DEVICE_CORE {
    } = 1;
 } = 0x0607AF;
 
+program DEVICE_INTR {
+   version DEVICE_INTR_VERSION {
+      void device_intr_srq (Device_SrqParms) = 30;
+   } = 1;
+} = 0x0607B1;
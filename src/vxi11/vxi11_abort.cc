@@ -0,0 +1,63 @@
+// Copyright (C) 2026   John Donoghue   <john.donoghue@ieee.org>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+
+#include <octave/oct.h>
+
+#ifdef HAVE_CONFIG_H
+#include "../config.h"
+#endif
+
+#ifdef BUILD_VXI11
+#include "vxi11_class.h"
+#endif
+
+// PKG_ADD: autoload ("vxi11_abort", "vxi11.oct");
+DEFUN_DLD (vxi11_abort, args, nargout,
+"-*- texinfo -*-\n\
+@deftypefn {} {} vxi11_abort (@var{vxi11})\n \
+\n\
+Abort the operation in progress on the link, on the abort channel of the instrument.\n \
+\n\
+A ctrl-c during a vxi11_read or vxi11_write sends the abort itself.\n \
+\n\
+@var{vxi11} - instance of @var{octave_vxi11} class.\n \
+@end deftypefn")
+{
+#ifndef BUILD_VXI11
+  error ("vxi11: Your system doesn't support the VXI11 interface");
+  return octave_value();
+#else
+  if (args.length () != 1 || args (0).type_id () != octave_vxi11::static_type_id())
+    {
+      print_usage ();
+      return octave_value (-1);
+    }
+
+  octave_vxi11* vxi11 = NULL;
+
+  const octave_base_value& rep = args (0).get_rep ();
+  vxi11 = &((octave_vxi11 &)rep);
+
+  vxi11->abort ();
+
+  return octave_value ();
+#endif
+}
+
+#if 0
+%!error <Invalid call to vxi11_abort> vxi11_abort ()
+
+%!error <Invalid call to vxi11_abort> vxi11_abort (1)
+#endif
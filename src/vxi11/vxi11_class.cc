@@ -20,29 +20,384 @@
 //
 
 #include <octave/oct.h>
+#include <octave/quit.h>
 
 #include <string>
 #include <cstring>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <condition_variable>
 
-// open or close vxi11 session only on call of vxi11 or vxi11_close
-#define OPENONCE
+#include <sys/select.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
 
 using std::string;
 
 #include "vxi11_class.h"
+#include "../common/socket_wait.h"
 
 DEFINE_OV_TYPEID_FUNCTIONS_AND_DATA (octave_vxi11, "octave_vxi11", "octave_vxi11");
 
 
 #define	VXI11_DEFAULT_TIMEOUT	10000	/* in ms */
-#define	VXI11_READ_TIMEOUT	2000	/* in ms */
 #define	VXI11_MAX_CLIENTS	256	/* maximum no of unique IP addresses/clients */
 #define	VXI11_NULL_READ_RESP	50	/* vxi11_receive() return value if a query
 					 * times out ON THE INSTRUMENT (and so we have
 					 * to resend the query again) */
 #define	VXI11_NULL_WRITE_RESP	51	/* vxi11_send() return value if a sent command
 					 * times out ON THE INSTURMENT. */
+#define	VXI11_ERR_LINK_INVALID	4	/* invalid link identifier */
+#define	VXI11_ABORT_TIMEOUT	2000	/* in ms, for the abort call */
+#define	VXI11_RPC_MARGIN	5000	/* in ms, added to the RPC timeout */
+#define	VXI11_CLOSE_TIMEOUT	1000	/* in ms, for the RPCs closing a link when destroyed */
 
+// Links are opened by vxi11 () and kept until the last object using them
+// is closed. Objects open to the same host and device share the link, so
+// only the first pays for the portmapper lookup and connection.
+struct vxi11_link
+{
+  std::string key;
+  CLIENT *client;
+  Create_LinkResp link;
+  int refs;
+
+  // abort channel, opened when first needed
+  CLIENT *abort_client;
+  struct sockaddr_in peer;
+
+  // handle given to device_enable_srq, and the service requests seen
+  uint32_t id;
+  bool intr_chan;
+  bool srq_enabled;
+  unsigned long srq_seen;
+};
+
+// note the address of the instrument when the link is made, as the
+// client can not be queried while a call is in progress
+static void
+vxi11_set_peer (vxi11_link *l)
+{
+  int fd;
+  socklen_t len = sizeof (l->peer);
+
+  memset (&l->peer, 0, sizeof (l->peer));
+  if (! clnt_control (l->client, CLGET_FD, (char *)&fd)
+      || ::getpeername (fd, (struct sockaddr *)&l->peer, &len) < 0)
+    l->peer.sin_family = AF_UNSPEC;
+}
+
+// open the abort channel, on the port the instrument gave in the
+// create_link reply
+static CLIENT *
+vxi11_abort_client (vxi11_link *l)
+{
+  if (l->abort_client)
+    return l->abort_client;
+
+  if (l->peer.sin_family != AF_INET)
+    return 0;
+
+  struct sockaddr_in addr = l->peer;
+  addr.sin_port = htons (l->link.abortPort);
+
+  int sock = RPC_ANYSOCK;
+  l->abort_client = clnttcp_create (&addr, DEVICE_ASYNC, DEVICE_ASYNC_VERSION, &sock, 0, 0);
+
+  if (l->abort_client)
+    {
+      struct timeval tv;
+      tv.tv_sec = VXI11_ABORT_TIMEOUT / 1000;
+      tv.tv_usec = (VXI11_ABORT_TIMEOUT % 1000) * 1000;
+      clnt_control (l->abort_client, CLSET_TIMEOUT, (char *)&tv);
+    }
+
+  return l->abort_client;
+}
+
+static int
+vxi11_send_abort (vxi11_link *l)
+{
+  CLIENT *client = vxi11_abort_client (l);
+  if (! client)
+    return -1;
+
+  Device_Error dev_error;
+  memset (&dev_error, 0, sizeof(dev_error));
+
+  if (device_abort_1 (&l->link.lid, &dev_error, client) != RPC_SUCCESS)
+    {
+      clnt_destroy (client);
+      l->abort_client = 0;
+      return -1;
+    }
+
+  return dev_error.error;
+}
+
+// A core channel call can not be interrupted, so while one is running a
+// thread watches for a ctrl-c and passes it on to the instrument on the
+// abort channel, which ends the call with an abort error. The thread is
+// started while any link is open, and only wakes to check for a ctrl-c
+// while a call is running.
+class vxi11_watchdog
+{
+public:
+  static vxi11_watchdog & instance (void)
+  {
+    static vxi11_watchdog w;
+    return w;
+  }
+
+  void acquire (void)
+  {
+    std::lock_guard<std::mutex> lock (mtx);
+    if (users++ == 0)
+      {
+        stop = false;
+        thr = std::thread (&vxi11_watchdog::run, this);
+      }
+  }
+
+  void release (void)
+  {
+    {
+      std::lock_guard<std::mutex> lock (mtx);
+      if (--users > 0)
+        return;
+      stop = true;
+    }
+    cv.notify_all ();
+    thr.join ();
+  }
+
+  void begin_call (vxi11_link *l)
+  {
+    {
+      std::lock_guard<std::mutex> lock (mtx);
+      busy = l;
+      aborted = false;
+    }
+    cv.notify_all ();
+  }
+
+  void end_call (void)
+  {
+    std::unique_lock<std::mutex> lock (mtx);
+    busy = 0;
+    // the link may be closed after this, so wait for an abort being
+    // sent on it to finish
+    cv.wait (lock, [this] (void) { return ! aborting; });
+  }
+
+private:
+  vxi11_watchdog (void) : users (0), stop (false), busy (0), aborted (false), aborting (false) { }
+
+  void run (void)
+  {
+    std::unique_lock<std::mutex> lock (mtx);
+    while (! stop)
+      {
+        if (! busy || aborted)
+          {
+            cv.wait (lock);
+            continue;
+          }
+
+        cv.wait_for (lock, std::chrono::milliseconds (50));
+
+        if (busy && ! aborted && octave_interrupt_state > 0)
+          {
+            // the abort is sent without the lock, which end_call waits on
+            vxi11_link *l = busy;
+            aborted = true;
+            aborting = true;
+            lock.unlock ();
+
+            vxi11_send_abort (l);
+
+            lock.lock ();
+            aborting = false;
+            cv.notify_all ();
+          }
+      }
+  }
+
+  std::mutex mtx;
+  std::condition_variable cv;
+  std::thread thr;
+  int users;
+  bool stop;
+  vxi11_link *busy;
+  bool aborted;
+  bool aborting;
+};
+
+// marks a core channel call as running for its lifetime
+class vxi11_call
+{
+public:
+  vxi11_call (vxi11_link *l) { vxi11_watchdog::instance ().begin_call (l); }
+  ~vxi11_call (void) { vxi11_watchdog::instance ().end_call (); }
+};
+
+// Server for the interrupt channel, on which instruments report service
+// requests with device_intr_srq. It runs on its own thread while any link
+// has service requests enabled, and counts the requests for each handle.
+class vxi11_intr_service
+{
+public:
+  static vxi11_intr_service & instance (void)
+  {
+    static vxi11_intr_service svc;
+    return svc;
+  }
+
+  // start the server if needed, returning its port or -1
+  int acquire (void)
+  {
+    if (users == 0)
+      {
+        if (pipefd[0] < 0)
+          {
+            if (::pipe (pipefd) < 0)
+              return -1;
+            ::fcntl (pipefd[0], F_SETFL, ::fcntl (pipefd[0], F_GETFL) | O_NONBLOCK);
+            ::fcntl (pipefd[1], F_SETFL, ::fcntl (pipefd[1], F_GETFL) | O_NONBLOCK);
+          }
+
+        xprt = svctcp_create (RPC_ANYSOCK, 0, 0);
+        if (! xprt)
+          return -1;
+
+        // not registered with the portmapper, the instrument is given the port
+        if (! svc_register (xprt, DEVICE_INTR, DEVICE_INTR_VERSION, dispatch, 0))
+          {
+            svc_destroy (xprt);
+            xprt = 0;
+            return -1;
+          }
+
+        stop = false;
+        thr = std::thread (&vxi11_intr_service::run, this);
+      }
+
+    users++;
+    return xprt->xp_port;
+  }
+
+  void release (void)
+  {
+    if (users == 0 || --users > 0)
+      return;
+
+    stop = true;
+    thr.join ();
+
+    svc_unregister (DEVICE_INTR, DEVICE_INTR_VERSION);
+    svc_destroy (xprt);
+    xprt = 0;
+  }
+
+  unsigned long count (uint32_t id)
+  {
+    std::lock_guard<std::mutex> lock (mtx);
+    return counts[id];
+  }
+
+  // readable after each service request
+  int wait_fd (void) const { return pipefd[0]; }
+
+  void drain (void)
+  {
+    char tmp[64];
+    while (::read (pipefd[0], tmp, sizeof (tmp)) > 0) { }
+  }
+
+private:
+  vxi11_intr_service (void) : xprt (0), users (0), stop (false)
+  {
+    pipefd[0] = pipefd[1] = -1;
+  }
+
+  void notify (uint32_t id)
+  {
+    {
+      std::lock_guard<std::mutex> lock (mtx);
+      counts[id]++;
+    }
+    if (::write (pipefd[1], "", 1) < 0) { }
+  }
+
+  void run (void)
+  {
+    while (! stop)
+      {
+        // svc_fdset also holds the connections accepted by the server
+        fd_set fds = svc_fdset;
+        struct timeval tv;
+        tv.tv_sec = 0;
+        tv.tv_usec = 200000;
+
+        if (::select (FD_SETSIZE, &fds, NULL, NULL, &tv) > 0)
+          svc_getreqset (&fds);
+      }
+  }
+
+  static void dispatch (struct svc_req *rqstp, SVCXPRT *transp)
+  {
+    if (rqstp->rq_proc == NULLPROC)
+      {
+        svc_sendreply (transp, (xdrproc_t) xdr_void, NULL);
+        return;
+      }
+
+    if (rqstp->rq_proc != device_intr_srq)
+      {
+        svcerr_noproc (transp);
+        return;
+      }
+
+    Device_SrqParms parms;
+    memset (&parms, 0, sizeof (parms));
+
+    if (! svc_getargs (transp, (xdrproc_t) xdr_Device_SrqParms, (caddr_t) &parms))
+      {
+        svcerr_decode (transp);
+        return;
+      }
+
+    uint32_t id;
+    if (parms.handle.handle_len == sizeof (id))
+      {
+        memcpy (&id, parms.handle.handle_val, sizeof (id));
+        instance ().notify (id);
+      }
+
+    svc_sendreply (transp, (xdrproc_t) xdr_void, NULL);
+    svc_freeargs (transp, (xdrproc_t) xdr_Device_SrqParms, (caddr_t) &parms);
+  }
+
+  SVCXPRT *xprt;
+  std::thread thr;
+  int users;
+  std::atomic<bool> stop;
+  int pipefd[2];
+  std::mutex mtx;
+  std::map<uint32_t, unsigned long> counts;
+};
+
+static std::map<std::string, vxi11_link *> &
+vxi11_links (void)
+{
+  static std::map<std::string, vxi11_link *> links;
+  return links;
+}
 
 
 octave_vxi11::octave_vxi11 (void)
@@ -50,6 +405,11 @@ octave_vxi11::octave_vxi11 (void)
   static bool type_registered = false;
 
   this->ip = "";
+  this->conn = 0;
+  this->timeout = VXI11_DEFAULT_TIMEOUT / 1000.0;
+  this->lock_timeout = VXI11_DEFAULT_TIMEOUT / 1000.0;
+  this->term_char = -1;
+  this->in_message = false;
 
   if (! type_registered)
     {
@@ -60,7 +420,72 @@ octave_vxi11::octave_vxi11 (void)
 
 octave_vxi11::~octave_vxi11 (void)
 {
-  this->close ();
+  // an instrument that has gone away must not stop the object going
+  this->release (true);
+}
+
+octave_value_list
+octave_vxi11::subsref (const std::string& type, const std::list<octave_value_list>& idx, int nargout)
+{
+  octave_value_list retval;
+  int skip = 1;
+
+  switch (type[0])
+    {
+    default:
+      error ("octave_vxi11 object cannot be indexed with %c", type[0]);
+      break;
+    case '.':
+      {
+        const octave_property<octave_vxi11> *prop = properties ().find_field ((idx.front ()) (0).string_value ());
+        if (! prop)
+          {
+            error ("invalid property name");
+            return retval;
+          }
+
+        retval = prop->handler (this, octave_value_list (), 1);
+      }
+      break;
+    }
+
+  if (idx.size () > 1 && type.length () > 1)
+    retval = retval (0).next_subsref (nargout, type, idx, skip);
+
+  return retval;
+}
+
+octave_value
+octave_vxi11::subsasgn (const std::string& type, const std::list<octave_value_list>& idx, const octave_value& rhs)
+{
+  octave_value retval;
+
+  switch (type[0])
+    {
+    default:
+      error ("octave_vxi11 object cannot be indexed with %c", type[0]);
+      break;
+    case '.':
+      if (type.length () == 1)
+        {
+          const octave_property<octave_vxi11> *prop = properties ().find_field ((idx.front ()) (0).string_value ());
+          if (! prop)
+            {
+              error ("invalid property name");
+              return retval;
+            }
+
+          prop->handler (this, octave_value_list (rhs), 0);
+          OV_COUNT++;
+          retval = octave_value (this);
+        }
+      else
+        {
+          error ("octave_vxi11 invalid index");
+        }
+
+    }
+  return retval;
 }
 
 void
@@ -86,44 +511,382 @@ octave_vxi11::print_raw (std::ostream& os, bool pr_as_read_syntax) const
 int
 octave_vxi11::open (string ip, string inst)
 {
+  if (this->conn)
+    this->close ();
+
+  std::string key = ip + '\n' + inst;
+  std::map<std::string, vxi11_link *> &links = vxi11_links ();
+  std::map<std::string, vxi11_link *>::iterator it = links.find (key);
+
+  if (it != links.end ())
+    {
+      it->second->refs++;
+      this->conn = it->second;
+    }
+  else
+    {
+      CLIENT *client = 0;
+      Create_LinkResp link;
+
+      if (this->openvxi (ip.c_str (), &client, &link, inst.c_str ()))
+        {
+          error ("vxi11: Cannot open VXI11...");
+          return -1;
+        }
+
+      static uint32_t next_id = 0;
+
+      vxi11_link *l = new vxi11_link;
+      l->key = key;
+      l->client = client;
+      l->link = link;
+      l->refs = 1;
+      l->abort_client = 0;
+      vxi11_set_peer (l);
+      l->id = ++next_id;
+      l->intr_chan = false;
+      l->srq_enabled = false;
+      l->srq_seen = 0;
+
+      vxi11_watchdog::instance ().acquire ();
+
+      links[key] = l;
+      this->conn = l;
+    }
+
   this->ip=ip;
   this->inst=inst;
 
-#ifdef OPENONCE
-  if (this->openvxi (this->ip.c_str(),&this->client,&this->link,this->inst.c_str()))
+  return 0;
+}
+
+int
+octave_vxi11::set_timeout (double newtimeout)
+{
+  if (newtimeout < 0 || newtimeout > 4294967)
     {
-      error ("vxi11: Cannot open VXI11...");
+      error ("vxi11: timeout must be between 0 and 4294967 seconds");
       return -1;
     }
-#endif
+
+  timeout = newtimeout;
+  return 1;
+}
+
+int
+octave_vxi11::set_lock_timeout (double newtimeout)
+{
+  if (newtimeout < 0 || newtimeout > 4294967)
+    {
+      error ("vxi11: lock timeout must be between 0 and 4294967 seconds");
+      return -1;
+    }
+
+  lock_timeout = newtimeout;
+  return 1;
+}
+
+int
+octave_vxi11::set_term_char (int newchar)
+{
+  if (newchar < -1 || newchar > 255)
+    {
+      error ("vxi11: termination character must be between 0 and 255, or -1 for none");
+      return -1;
+    }
+
+  term_char = newchar;
+  return 1;
+}
+
+void
+octave_vxi11::set_rpc_timeout (CLIENT *client)
+{
+  // the link is shared, so set it for the timeouts of this object
+  unsigned long ms = (unsigned long)((timeout + lock_timeout) * 1000) + VXI11_RPC_MARGIN;
+
+  struct timeval tv;
+  tv.tv_sec = ms / 1000;
+  tv.tv_usec = (ms % 1000) * 1000;
+
+  clnt_control (client, CLSET_TIMEOUT, (char *)&tv);
+}
+
+void
+octave_vxi11::drop_link (void)
+{
+  if (this->conn->abort_client)
+    {
+      clnt_destroy (this->conn->abort_client);
+      this->conn->abort_client = 0;
+    }
+
+  // the link is not destroyed on the instrument, which may be
+  // unreachable, but goes with the connection
+  if (this->conn->client)
+    {
+      clnt_destroy (this->conn->client);
+      this->conn->client = 0;
+    }
+}
+
+void
+octave_vxi11::relink (void)
+{
+  bool srq = this->conn->srq_enabled;
+
+  // the old link has failed, so is not closed on the instrument, which
+  // would only wait out another RPC timeout
+  this->drop_link ();
+
+  if (srq)
+    {
+      // the interrupt channel went with the old link
+      this->conn->srq_enabled = false;
+      this->conn->intr_chan = false;
+      vxi11_intr_service::instance ().release ();
+    }
+
+  // errors are raised by openvxi, leaving the client unset
+  this->openvxi (this->ip.c_str (), &this->conn->client, &this->conn->link, this->inst.c_str ());
+
+  vxi11_set_peer (this->conn);
+
+  if (srq)
+    this->set_srq_enabled (true);
+}
+
+int
+octave_vxi11::abort (void)
+{
+  if (this->ip.empty ())
+    {
+      error ("vxi11: setup ip first");
+      return -1;
+    }
+
+  int err = vxi11_send_abort (this->conn);
+  if (err < 0)
+    {
+      error ("vxi11: cannot open the abort channel");
+      return -1;
+    }
+  if (err != 0)
+    {
+      error ("vxi11: abort failed: %d", err);
+      return -1;
+    }
+
   return 0;
 }
 
 int
-octave_vxi11::read(char *buf, unsigned int len)
+octave_vxi11::set_srq_enabled (bool enable)
 {
-  CLIENT *client;
-  Create_LinkResp *link;
+  if (this->ip.empty ())
+    {
+      error ("vxi11: setup ip first");
+      return -1;
+    }
 
-  unsigned long timeout = VXI11_READ_TIMEOUT;
+  vxi11_link *l = this->conn;
+  if (enable == l->srq_enabled)
+    return 1;
 
-  if (this->ip.empty())
+  if (! l->client)
+    this->relink ();
+
+  vxi11_intr_service &svc = vxi11_intr_service::instance ();
+  Device_Error dev_error;
+
+  Device_EnableSrqParms srq_parms;
+  srq_parms.lid = l->link.lid;
+  srq_parms.enable = enable;
+  srq_parms.handle.handle_len = sizeof (l->id);
+  srq_parms.handle.handle_val = (char *)&l->id;
+
+  if (! enable)
     {
-      error("vxi11: setup ip first");
+      memset (&dev_error, 0, sizeof(dev_error));
+      device_enable_srq_1 (&srq_parms, &dev_error, l->client);
+      memset (&dev_error, 0, sizeof(dev_error));
+      destroy_intr_chan_1 (NULL, &dev_error, l->client);
+
+      l->intr_chan = false;
+      l->srq_enabled = false;
+      svc.release ();
+      return 1;
+    }
+
+  int port = svc.acquire ();
+  if (port < 0)
+    {
+      error ("vxi11: cannot start the interrupt channel server");
       return -1;
     }
 
-#ifdef OPENONCE
-  client = this->client;
-  link = this->link;
-#else
-  //std::string inst="inst0";
-  if (this->openvxi(this->ip.c_str(),&client,&link,this->inst.c_str()))
+  if (! l->intr_chan)
+    {
+      // the instrument connects back to the address it was reached from
+      int fd;
+      struct sockaddr_in addr;
+      socklen_t len = sizeof (addr);
+
+      if (! clnt_control (l->client, CLGET_FD, (char *)&fd)
+          || ::getsockname (fd, (struct sockaddr *)&addr, &len) < 0
+          || addr.sin_family != AF_INET)
+        {
+          svc.release ();
+          error ("vxi11: the interrupt channel needs an IPv4 connection");
+          return -1;
+        }
+
+      Device_RemoteFunc remote;
+      remote.hostAddr = ntohl (addr.sin_addr.s_addr);
+      remote.hostPort = port;
+      remote.progNum = DEVICE_INTR;
+      remote.progVers = DEVICE_INTR_VERSION;
+      remote.progFamily = DEVICE_TCP;
+
+      memset (&dev_error, 0, sizeof(dev_error));
+      if (create_intr_chan_1 (&remote, &dev_error, l->client) != RPC_SUCCESS
+          || dev_error.error != 0)
+        {
+          svc.release ();
+          error ("vxi11: cannot create the interrupt channel: %d", (int)dev_error.error);
+          return -1;
+        }
+
+      l->intr_chan = true;
+    }
+
+  memset (&dev_error, 0, sizeof(dev_error));
+  if (device_enable_srq_1 (&srq_parms, &dev_error, l->client) != RPC_SUCCESS
+      || dev_error.error != 0)
     {
-      error("vxi11: Cannot open VXI11...");
+      memset (&dev_error, 0, sizeof(dev_error));
+      destroy_intr_chan_1 (NULL, &dev_error, l->client);
+      l->intr_chan = false;
+      svc.release ();
+      error ("vxi11: cannot enable service requests: %d", (int)dev_error.error);
       return -1;
     }
-#endif
+
+  l->srq_enabled = true;
+  l->srq_seen = svc.count (l->id);
+
+  return 1;
+}
+
+bool
+octave_vxi11::get_srq_enabled (void) const
+{
+  return this->conn && this->conn->srq_enabled;
+}
+
+int
+octave_vxi11::wait_srq (double waittime)
+{
+  if (! this->get_srq_enabled () && this->set_srq_enabled (true) < 0)
+    return -1;
+
+  vxi11_intr_service &svc = vxi11_intr_service::instance ();
+  octave_deadline deadline (waittime < 0 ? -1 : waittime * 1000);
+
+  while (true)
+    {
+      svc.drain ();
+
+      unsigned long count = svc.count (this->conn->id);
+      if (count != this->conn->srq_seen)
+        {
+          this->conn->srq_seen = count;
+          return 1;
+        }
+
+      if (waittime == 0)
+        return 0;
+
+      int ret = octave_wait_readable (svc.wait_fd (), deadline);
+      if (ret < 0)
+        {
+          error ("vxi11: error waiting for a service request");
+          return -1;
+        }
+      if (ret == 0)
+        return 0;
+    }
+}
+
+int
+octave_vxi11::read_stb (void)
+{
+  if (this->ip.empty ())
+    {
+      error ("vxi11: setup ip first");
+      return -1;
+    }
+
+  if (! this->conn->client)
+    this->relink ();
+
+  this->set_rpc_timeout (this->conn->client);
+
+  Device_GenericParms parms;
+  parms.lid = this->conn->link.lid;
+  parms.flags = 0;
+  parms.lock_timeout = (unsigned long)(this->lock_timeout * 1000);
+  parms.io_timeout = (unsigned long)(this->timeout * 1000);
+
+  Device_ReadStbResp resp;
+  memset (&resp, 0, sizeof(resp));
+
+  enum clnt_stat stat;
+  {
+    vxi11_call call (this->conn);
+    stat = device_readstb_1 (&parms, &resp, this->conn->client);
+  }
+
+  if (stat != RPC_SUCCESS)
+    {
+      this->drop_link ();
+      error ("vxi11: cannot read status byte");
+      return -1;
+    }
+
+  if (resp.error != 0)
+    {
+      if (resp.error == VXI11_ERR_ABORT)
+        OCTAVE_QUIT;
+      error ("vxi11: cannot read status byte: %d", (int)resp.error);
+      return -1;
+    }
+
+  return resp.stb;
+}
+
+int
+octave_vxi11::read(char *buf, unsigned int len, bool *eoi)
+{
+  CLIENT *client;
+  Create_LinkResp *link;
+
+  if (this->ip.empty())
+    {
+      error("vxi11: setup ip first");
+      return -1;
+    }
+
+  // a link lost by an earlier failure is opened again
+  if (! this->conn->client)
+    this->relink ();
+
+  client = this->conn->client;
+  link = &this->conn->link;
+  this->set_rpc_timeout (client);
+
+  if (eoi)
+    *eoi = false;
 
   #define RCV_END_BIT	0x04	// An end indicator has been read
   #define RCV_CHR_BIT	0x02	// A termchr is set in flags and a character which matches termChar is transferred
@@ -136,10 +899,10 @@ octave_vxi11::read(char *buf, unsigned int len)
 
   read_parms.lid			= link->lid;
   read_parms.requestSize		= len;
-  read_parms.io_timeout		= timeout;	/* in ms */
-  read_parms.lock_timeout		= timeout;	/* in ms */
-  read_parms.flags		= 0;
-  read_parms.termChar		= 0;
+  read_parms.io_timeout		= (unsigned long)(this->timeout * 1000);	/* in ms */
+  read_parms.lock_timeout		= (unsigned long)(this->lock_timeout * 1000);	/* in ms */
+  read_parms.flags		= (this->term_char >= 0) ? VXI11_FLAG_TERMCHRSET : 0;
+  read_parms.termChar		= (this->term_char >= 0) ? (char)this->term_char : 0;
 
   do
     {
@@ -148,8 +911,18 @@ octave_vxi11::read(char *buf, unsigned int len)
       read_resp.data.data_val = buf + curr_pos;
       read_parms.requestSize = len    - curr_pos;	// Never request more total data than originally specified in len
 
-      if(device_read_1(&read_parms, &read_resp, client) != RPC_SUCCESS)
+      enum clnt_stat stat;
+      {
+        vxi11_call call (this->conn);
+        stat = device_read_1(&read_parms, &read_resp, client);
+      }
+
+      if(stat != RPC_SUCCESS)
         {
+          // the reply to the query is lost with the link, so do not
+          // retry the read, but leave the link to be opened again by
+          // the next call
+          this->drop_link ();
           error ("vxi11: cannot read");
           return -1; /* there is nothing to read. Usually occurs after sending a query
                         which times out on the instrument. If we don't check this first,
@@ -175,6 +948,11 @@ octave_vxi11::read(char *buf, unsigned int len)
            * 23	abort
            * 29	channel already established
            */
+          if (read_resp.error == VXI11_ERR_LINK_INVALID)
+            this->drop_link ();
+          // aborted after a ctrl-c
+          if (read_resp.error == VXI11_ERR_ABORT)
+            OCTAVE_QUIT;
           error ("vxi11: cannot read: %d",(int)read_resp.error);
           return -1;
         }
@@ -185,29 +963,23 @@ octave_vxi11::read(char *buf, unsigned int len)
         }
       if( (read_resp.reason & RCV_END_BIT) || (read_resp.reason & RCV_CHR_BIT) )
         {
+          if (eoi)
+            *eoi = true;
           break;
 	}
       else if( curr_pos == len )
         {
-          error ("xvi11: read error: buffer too small. Read %d bytes without hitting terminator.", (int)curr_pos );
-          return -1;
+          // the rest of the response is left for the next read
+          break;
         }
     } 
   while (1);
 
-#ifndef OPENONCE
-  // close VXI11 session
-  if (this->closevxi (this->ip.c_str (),client,link))
-    {
-      error ("vxi11:Cannot close VXI11...");
-      return -1;
-    }
-#endif
   return curr_pos;
 }
 
 int
-octave_vxi11::write (const char *buf, int len)
+octave_vxi11::write (const char *buf, int len, bool end)
 {
 
   CLIENT *client;
@@ -219,29 +991,21 @@ octave_vxi11::write (const char *buf, int len)
       return -1;
     }
 
-#ifdef OPENONCE
-  client = this->client;
-  link = this->link;
-#else
-  //std::string inst="inst0";
-  if (this->openvxi (this->ip.c_str (),&client,&link,this->inst.c_str ()))
-    {
-      error ("vxi11: Cannot open VXI11...");
-      return -1;
-    }
-#endif
+  if (! this->conn->client)
+    this->relink ();
+
+  client = this->conn->client;
+  link = &this->conn->link;
+  this->set_rpc_timeout (client);
+  bool relinked = false;
 
   //int	vxi11_send(CLIENT *client, VXI11_LINK *link, const char *cmd, unsigned long len) {
   Device_WriteParms write_parms;
   unsigned int	bytes_left = len;
-  char	*send_cmd;
-
-  send_cmd = new char[len];
-  memcpy (send_cmd, buf, len);
 
   write_parms.lid          = link->lid;
-  write_parms.io_timeout   = VXI11_DEFAULT_TIMEOUT;
-  write_parms.lock_timeout = VXI11_DEFAULT_TIMEOUT;
+  write_parms.io_timeout   = (unsigned long)(this->timeout * 1000);
+  write_parms.lock_timeout = (unsigned long)(this->lock_timeout * 1000);
 
   /* We can only write (link->maxRecvSize) bytes at a time, so we sit in a loop,
    * writing a chunk at a time, until we're done. */
@@ -253,7 +1017,7 @@ octave_vxi11::write (const char *buf, int len)
 
       if (bytes_left <= link->maxRecvSize)
         {
-          write_parms.flags		= 8;
+          write_parms.flags		= end ? 8 : 0;
           write_parms.data.data_len	= bytes_left;
         }
       else
@@ -271,11 +1035,33 @@ octave_vxi11::write (const char *buf, int len)
               write_parms.data.data_len	= 4096; /* pretty much anything should be able to cope with 4kB */
             }
         }
-      write_parms.data.data_val	= send_cmd + (len - bytes_left);
+      // only read by the RPC, so sent from the caller's buffer
+      write_parms.data.data_val	= const_cast<char *> (buf) + (len - bytes_left);
 
-      if(device_write_1 (&write_parms, &write_resp, client) != RPC_SUCCESS)
+      bool failed;
+      {
+        vxi11_call call (this->conn);
+        failed = (device_write_1 (&write_parms, &write_resp, client) != RPC_SUCCESS);
+      }
+
+      // nothing has reached the instrument yet, so it is safe to send
+      // everything again on a new link, unless this carries on a message
+      // begun on the old one
+      if ((failed || write_resp.error == VXI11_ERR_LINK_INVALID)
+          && ! relinked && bytes_left == (unsigned int)len && ! this->in_message)
         {
-          delete[] send_cmd;
+          relinked = true;
+          this->relink ();
+          client = this->conn->client;
+          link = &this->conn->link;
+          this->set_rpc_timeout (client);
+          write_parms.lid = link->lid;
+          continue;
+        }
+
+      if (failed)
+        {
+          this->in_message = false;
           error ("vxi11: cannot write");
           return -VXI11_NULL_WRITE_RESP; /* The instrument did not acknowledge the write, just completely
 	   				    dropped it. There was no vxi11 comms error as such, the
@@ -285,52 +1071,109 @@ octave_vxi11::write (const char *buf, int len)
         }
       if (write_resp.error != 0)
         {
+          this->in_message = false;
+          // aborted after a ctrl-c
+          if (write_resp.error == VXI11_ERR_ABORT)
+            OCTAVE_QUIT;
           error("vxi11_user: write error: %d", (int)write_resp.error);
-          delete[] send_cmd;
           return -(write_resp.error);
         }
       bytes_left -= write_resp.size;
     }
   while (bytes_left > 0);
 
-  delete[] send_cmd;
+  this->in_message = ! end;
+
+  return len;
 
-#ifndef OPENONCE
-  // close VXI11 session
-  if (this->closevxi (this->ip.c_str (),client,link))
+}
+
+int
+octave_vxi11::write_parts (const octave_write_part *parts, int nparts)
+{
+  int total = 0;
+
+  // only the last part ends the message
+  for (int i = 0; i < nparts; i++)
     {
-      error ("vxi11:Cannot close VXI11...");
-      return -1;
+      int ret = this->write (reinterpret_cast<const char *> (parts[i].data), parts[i].len, i == nparts - 1);
+      if (ret < 0)
+        return ret;
+      total += ret;
     }
-#endif
-
-  return 0;
 
+  return total;
 }
 
 int
 octave_vxi11::close (void)
+{
+  int retval = this->release (false);
+
+  if (retval < 0)
+    error ("vxi11:Cannot close VXI11...");
+
+  return retval;
+}
+
+int
+octave_vxi11::release (bool quiet)
 {
   int retval = 0;
 
-#ifdef OPENONCE
-  // close VXI11 session
-  if (!this->ip.empty())
+  // close VXI11 session once the last object using it is closed
+  if (this->conn)
     {
-      if (this->closevxi (this->ip.c_str (),this->client,this->link))
+      vxi11_link *l = this->conn;
+      this->conn = 0;
+
+      if (--l->refs == 0)
         {
-          error ("vxi11:Cannot close VXI11...");
-          return -1;
+          vxi11_links ().erase (l->key);
+
+          if (quiet && l->client)
+            {
+              struct timeval tv;
+              tv.tv_sec = VXI11_CLOSE_TIMEOUT / 1000;
+              tv.tv_usec = (VXI11_CLOSE_TIMEOUT % 1000) * 1000;
+              clnt_control (l->client, CLSET_TIMEOUT, (char *)&tv);
+            }
+
+          if (l->srq_enabled && l->client)
+            {
+              Device_Error dev_error;
+              Device_EnableSrqParms srq_parms;
+              srq_parms.lid = l->link.lid;
+              srq_parms.enable = false;
+              srq_parms.handle.handle_len = sizeof (l->id);
+              srq_parms.handle.handle_val = (char *)&l->id;
+
+              memset (&dev_error, 0, sizeof(dev_error));
+              device_enable_srq_1 (&srq_parms, &dev_error, l->client);
+              memset (&dev_error, 0, sizeof(dev_error));
+              destroy_intr_chan_1 (NULL, &dev_error, l->client);
+            }
+          if (l->srq_enabled)
+            vxi11_intr_service::instance ().release ();
+
+          if (l->abort_client)
+            clnt_destroy (l->abort_client);
+
+          vxi11_watchdog::instance ().release ();
+
+          if (l->client && this->closevxi (this->ip.c_str (), l->client, &l->link))
+            retval = -1;
+
+          delete l;
         }
     }
-#endif
   this->ip = "";
 
   return retval;
 }
 
 int
-octave_vxi11::openvxi (const char *ip, CLIENT **client, Create_LinkResp **link, const char *device)
+octave_vxi11::openvxi (const char *ip, CLIENT **client, Create_LinkResp *link, const char *device)
 {
 #ifdef CONST_CLNT_SUPPORT
   const char * tmpip = ip;
@@ -356,11 +1199,13 @@ octave_vxi11::openvxi (const char *ip, CLIENT **client, Create_LinkResp **link,
   link_parms.lock_timeout	= VXI11_DEFAULT_TIMEOUT;
   link_parms.device	= (char *) device;
 
-  *link = (Create_LinkResp *) calloc (1, sizeof(Create_LinkResp));
+  memset (link, 0, sizeof(Create_LinkResp));
 
-  if (create_link_1 (&link_parms, *link, *client) != RPC_SUCCESS)
+  if (create_link_1 (&link_parms, link, *client) != RPC_SUCCESS)
     {
       clnt_perror (*client, tmpip);
+      clnt_destroy (*client);
+      *client = NULL;
       error ("vxi11: Error creating client...");
       return -2;
     }
@@ -383,6 +1228,7 @@ octave_vxi11::closevxi (const char *ip, CLIENT *client, Create_LinkResp *link)
       tmpip[250] = '\0';
 #endif
       clnt_perror (client, tmpip);
+      clnt_destroy (client);
       return -1;
     }
 
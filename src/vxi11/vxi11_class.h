@@ -30,6 +30,12 @@ using std::string;
 #  include "../config.h"
 #endif
 
+#include "../common/property_table.h"
+#include "../common/byte_view.h"
+
+// a link shared by the objects open to the same host and device
+struct vxi11_link;
+
 class octave_vxi11 : public OCTAVE_BASE_CLASS
 {
 public:
@@ -39,9 +45,36 @@ public:
     int open (string, string);
     int close (void);
 
-    // Simple vxi11 commands
-    int write (const char*, int);
-    int read (char*, unsigned int);
+    // Simple vxi11 commands. A write without end leaves the message open,
+    // for the next write to carry on
+    int write (const char*, int, bool end = true);
+    // the parts are sent as one message, without copying them
+    int write_parts (const octave_write_part *, int);
+    // read until len bytes, an END or the termination character. eoi is
+    // set if the read stopped before len bytes
+    int read (char*, unsigned int, bool *eoi = 0);
+
+    double get_timeout (void) const { return timeout; }
+    int set_timeout (double);
+    double get_lock_timeout (void) const { return lock_timeout; }
+    int set_lock_timeout (double);
+    // termination character, or -1 for none
+    int get_term_char (void) const { return term_char; }
+    int set_term_char (int);
+
+    // end the current operation on the link, from the abort channel
+    int abort (void);
+
+    // service requests, reported on the interrupt channel
+    bool get_srq_enabled (void) const;
+    int set_srq_enabled (bool);
+    // wait up to waittime seconds (-1 forever) for a service request,
+    // returning 1 if one arrived and 0 on a timeout
+    int wait_srq (double waittime);
+    int read_stb (void);
+
+    std::string get_remote_host (void) const { return ip; }
+    std::string get_device (void) const { return inst; }
 
     // Overloaded base functions
     string vxi11_value () const
@@ -62,15 +95,56 @@ public:
     bool is_constant (void) const { return true;}
     bool is_defined (void) const { return true;}
     bool print_as_scalar (void) const { return true;}
+    bool is_object (void) const { return true; }
+    // 4.4+
+    bool isobject (void) const { return true; }
+
+    // required to use subsasn
+    string_vector map_keys (void) const { return properties ().fieldnames (); }
+    dim_vector dims (void) const { static dim_vector dv(1, 1); return dv; }
+
+    octave_base_value * unique_clone (void) { OV_COUNT++; return this; }
+
+    octave_value_list subsref (const std::string& type, const std::list<octave_value_list>& idx, int nargout);
+
+    octave_value subsref (const std::string& type, const std::list<octave_value_list>& idx)
+    {
+      octave_value_list retval = subsref (type, idx, 1);
+      return (retval.length () > 0 ? retval(0) : octave_value ());
+    }
+
+    octave_value subsasgn (const std::string& type, const std::list<octave_value_list>& idx, const octave_value& rhs);
+
+    static const octave_property_table<octave_vxi11> & properties (void);
 
 private:
-    CLIENT *client;
-    Create_LinkResp *link;
+    vxi11_link *conn;
     std::string ip;
     std::string inst;
-    std::string device;
 
-    int openvxi (const char *, CLIENT **, Create_LinkResp **, const char *);
+    // in seconds
+    double timeout;
+    double lock_timeout;
+    int term_char;
+    // a write has left a message open
+    bool in_message;
+
+    // RPC timeout, long enough for the instrument to time out first
+    void set_rpc_timeout (CLIENT *);
+
+    // close a link that has failed, leaving it to be opened again by
+    // relink on the next call
+    void drop_link (void);
+
+    // replace a link that has failed with a new one
+    void relink (void);
+
+    // give up this object's use of its link, closing the link with the
+    // last one. Returns -1 if closing it failed; quiet closes it with a
+    // short RPC timeout, for the destructor, which must not throw
+    int release (bool quiet);
+
+    int openvxi (const char *, CLIENT **, Create_LinkResp *, const char *);
     int closevxi (const char *, CLIENT *, Create_LinkResp *);
 
     DECLARE_OV_TYPEID_FUNCTIONS_AND_DATA
@@ -29,7 +29,7 @@ DEFUN_DLD (vxi11_close, args, nargout,
 "-*- texinfo -*-\n\
 @deftypefn {} {} vxi11_close (@var{vxi11})\n \
 \n\
-Close the interface and release a file descriptor.\n \
+Close the interface. The link to the instrument is closed when no other object is using it.\n \
 \n\
 @var{vxi11} - instance of @var{octave_vxi11} class.\n \
 @end deftypefn")
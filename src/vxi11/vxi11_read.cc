@@ -24,20 +24,26 @@
 #ifdef BUILD_VXI11
 #include <octave/uint8NDArray.h>
 
+#include <cmath>
+
 #include "vxi11_class.h"
 #endif
 
 // PKG_ADD: autoload ("vxi11_read", "vxi11.oct");
 DEFUN_DLD (vxi11_read, args, nargout,
 "-*- texinfo -*-\n\
-@deftypefn {} {[@var{data}, @var{count}] = } vxi11_read (@var{vxi11}, @var{n})\n \
+@deftypefn {} {[@var{data}, @var{count}, @var{eoi}] = } vxi11_read (@var{vxi11}, @var{n})\n \
 \n\
 Read from vxi11 slave device.\n \
 \n\
 @var{vxi11} - instance of @var{octave_vxi11} class.@* \
-@var{n} - number of bytes to attempt to read of type Integer.\n \
+@var{n} - number of bytes to attempt to read of type Integer, or Inf to read the whole response.\n \
+\n\
+The read stops after @var{n} bytes, at the end of the response or at the TermChar property. \
+Any of the response not read is left for the next read.\n \
 \n\
 The vxi11_read() shall return number of bytes successfully read in @var{count} as Integer and the bytes themselves in @var{data} as uint8 array.\n \
+@var{eoi} is true if the end of the response or TermChar was reached.\n \
 @end deftypefn")
 {
 #ifndef BUILD_VXI11
@@ -52,6 +58,7 @@ The vxi11_read() shall return number of bytes successfully read in @var{count} a
     }
 
   unsigned int buffer_len = 1;
+  bool read_all = false;
 
   if (args.length () > 1)
     {
@@ -61,15 +68,10 @@ The vxi11_read() shall return number of bytes successfully read in @var{count} a
           return octave_value (-1);
         }
 
-      buffer_len = args (1).int_value ();
-    }
-
-  OCTAVE_LOCAL_BUFFER (char, buffer, (buffer_len + 1));
-
-  if (buffer == NULL)
-    {
-      error ("vxi11_read: cannot allocate requested memory...");
-      return octave_value (-1);
+      if (std::isinf (args (1).double_value ()))
+        read_all = true;
+      else
+        buffer_len = args (1).int_value ();
     }
 
   octave_vxi11* vxi11 = NULL;
@@ -78,18 +80,55 @@ The vxi11_read() shall return number of bytes successfully read in @var{count} a
   vxi11 = &((octave_vxi11 &)rep);
 
   int retval;
+  bool eoi = false;
 
-  retval = vxi11->read (buffer, buffer_len);
+  if (read_all)
+    {
+      // read the whole response, doubling the array as it fills so that
+      // a large transfer takes few requests and copies
+      octave_idx_type size = 65536;
+      octave_idx_type count = 0;
+      uint8NDArray data (dim_vector (1, size));
 
-  octave_value_list return_list;
+      while (! eoi)
+        {
+          if (count == size)
+            {
+              size *= 2;
+              data.resize (dim_vector (1, size));
+            }
+
+          retval = vxi11->read (reinterpret_cast<char *> (data.fortran_vec ()) + count,
+                                size - count, &eoi);
+          if (retval < 0)
+            break;
+
+          count += retval;
+        }
+
+      data.resize (dim_vector (1, count));
 
-  uint8NDArray data( dim_vector(1, (retval > 0) ? retval : 0) );
+      octave_value_list return_list;
+      return_list (0) = data;
+      return_list (1) = (retval < 0) ? retval : count;
+      return_list (2) = eoi;
+
+      return return_list;
+    }
+
+  // Read data directly into the result array
+  uint8NDArray data (dim_vector (1, buffer_len));
+
+  retval = vxi11->read (reinterpret_cast<char *> (data.fortran_vec ()), buffer_len, &eoi);
+
+  octave_value_list return_list;
 
-  for (int i = 0; i < retval; i++)
-      data(i) = static_cast<uint8_t>(buffer[i]);
+  // trim to the bytes actually read
+  data.resize (dim_vector (1, (retval > 0) ? retval : 0));
 
   return_list (0) = data;
   return_list (1) = retval;
+  return_list (2) = eoi;
 
   return return_list;
 #endif
@@ -0,0 +1,92 @@
+// Copyright (C) 2026   John Donoghue   <john.donoghue@ieee.org>
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, see <http://www.gnu.org/licenses/>.
+
+#include <octave/oct.h>
+
+#ifdef HAVE_CONFIG_H
+#include "../config.h"
+#endif
+
+#ifdef BUILD_VXI11
+#include "vxi11_class.h"
+#endif
+
+// PKG_ADD: autoload ("vxi11_waitsrq", "vxi11.oct");
+DEFUN_DLD (vxi11_waitsrq, args, nargout,
+"-*- texinfo -*-\n\
+@deftypefn {} {@var{srq} = } vxi11_waitsrq (@var{vxi11})\n \
+@deftypefnx {} {[@var{srq}, @var{stb}] = } vxi11_waitsrq (@var{vxi11}, @var{timeout})\n \
+\n\
+Wait for a service request from the instrument on the interrupt channel.\n \
+\n\
+@var{vxi11} - instance of @var{octave_vxi11} class.@* \
+@var{timeout} - time in seconds to wait. A value of -1 (default) waits until a service request and 0 checks without waiting.\n \
+\n\
+The interrupt channel is set up by the first call, or by setting EnableSRQ. \
+vxi11_waitsrq() shall return true in @var{srq} if the instrument requested service since the last call, \
+and the status byte in @var{stb} if requested.\n \
+@seealso{spoll}\n \
+@end deftypefn")
+{
+#ifndef BUILD_VXI11
+  error ("vxi11: Your system doesn't support the VXI11 interface");
+  return octave_value ();
+#else
+  if (args.length () < 1 || args.length () > 2 || args (0).type_id () != octave_vxi11::static_type_id ())
+    {
+      print_usage ();
+      return octave_value (-1);
+    }
+
+  double timeout = -1;
+
+  if (args.length () > 1)
+    {
+      if (! (args (1).OV_ISINTEGER () || args (1).OV_ISFLOAT ()))
+        {
+          print_usage ();
+          return octave_value (-1);
+        }
+
+      timeout = args (1).double_value ();
+    }
+
+  const octave_base_value& rep = args (0).get_rep ();
+  octave_vxi11* vxi11 = &((octave_vxi11 &)rep);
+
+  int srq = vxi11->wait_srq (timeout);
+  if (srq < 0)
+    return octave_value ();
+
+  octave_value_list retval;
+  retval(0) = octave_value (srq > 0);
+
+  if (nargout > 1)
+    {
+      int stb = vxi11->read_stb ();
+      if (stb < 0)
+        return octave_value ();
+      retval(1) = octave_value (stb);
+    }
+
+  return retval;
+#endif
+}
+
+#if 0
+%!error <Invalid call to vxi11_waitsrq> vxi11_waitsrq ()
+
+%!error <Invalid call to vxi11_waitsrq> vxi11_waitsrq (1)
+#endif
@@ -23,6 +23,7 @@
 
 #ifdef BUILD_VXI11
 #include "vxi11_class.h"
+#include "../common/byte_view.h"
 #endif
 
 // PKG_ADD: autoload ("vxi11_write", "vxi11.oct");
@@ -54,30 +55,18 @@ Upon successful completion, vxi11_write() shall return the number of bytes writt
   const octave_base_value& rep = args (0).get_rep ();
   vxi11 = &((octave_vxi11 &)rep);
 
-  const octave_base_value& data = args (1).get_rep ();
   int retval;
 
-  if (data.is_string ())
-    {
-      string buf = data.string_value ();
-      retval = vxi11->write (buf.c_str (), buf.length ());
-    }
-  else if (data.is_uint8_type ())
-    {
-      NDArray dtmp = data.array_value ();
-      OCTAVE_LOCAL_BUFFER (char, buf, (dtmp.numel ()));
+  octave_byte_view data (args (1), true);
 
-      for (int i = 0; i < dtmp.numel (); i++)
-          buf[i] = (char)dtmp(i);
-
-      retval = vxi11->write (buf, data.byte_size());
-    }
-  else
+  if (! data.is_valid ())
     {
       print_usage ();
       return octave_value (-1);
     }
 
+  retval = vxi11->write (reinterpret_cast<const char *> (data.data ()), data.length ());
+
   return octave_value (retval);
 #endif
 }